@@ -0,0 +1,137 @@
+#
+# Copyright (c) 2013 Stefan Seefeld
+# All rights reserved.
+#
+# This file is part of OpenVSIP. It is made available under the
+# license contained in the accompanying LICENSE.BSD file.
+#
+# Common variables used throughout the build system
+
+host:=x86_64-unknown-linux-gnu
+
+### Installation ###
+
+PACKAGE_TARNAME := openvsip
+INSTALL := /usr/bin/install -c
+INSTALL_DATA := ${INSTALL} -m 644
+INSTALL_SCRIPT := ${INSTALL}
+INSTALL_PROGRAM := ${INSTALL}
+distname:= $(PACKAGE_TARNAME)
+distfiles:= $(wildcard $(srcdir)/*)
+variant := 
+
+# Order matters for the various directory variables, as autoconf makes some
+# of the variables depend on the values of others.
+prefix := /usr/local
+exec_prefix := ${prefix}
+datarootdir := ${prefix}/share
+datadir := ${datarootdir}
+includedir := ${prefix}/include
+libdir := ${exec_prefix}/lib
+sbindir := ${exec_prefix}/sbin
+bindir := ${exec_prefix}/bin
+docdir := ${datarootdir}/doc/${PACKAGE_TARNAME}
+htmldir := ${docdir}
+pdfdir := ${docdir}
+# The directory for putting build-variant-specific executables.
+variant_bindir := $(bindir)
+# The directory for putting data that is specific to this package.
+# This is not a standard variable name.
+pkgdatadir := $(datadir)/$(PACKAGE_TARNAME)
+cygwin_mount :=
+
+### Compilation ###
+
+# Are we using the intel-win toolchain ?
+INTEL_WIN := 
+# Are we using the ti-cl6x toolchain ?
+TI_CL6X := @TI_CL6X@
+# The path to the archiver. 
+AR := ar
+# The path to the C compiler.
+CC := gcc
+# The path to the C++ compiler.
+CXX := g++
+# The dependency generator.
+CCDEP := gcc -MM -x c
+# The dependency generator.
+CXXDEP := g++ -MM -x c++
+# The DSO linker.
+LDSHARED:= g++ -shared
+# The strip executable.
+STRIP:= strip
+USE_STRIP:= 
+# Preprocessor flags.
+CPPFLAGS :=  
+# C compilation flags.
+CFLAGS :=  -pthread
+# C compilation flags for library files.
+CFLAGS_LIB :=  -pthread -fPIC
+# C++ compilation flags.
+CXXFLAGS :=  -pthread
+# C++ compilation flags for library files.
+CXXFLAGS_LIB :=  -pthread -fPIC
+# The extension for executable programs.
+EXEEXT := 
+# Linker flags.
+LDFLAGS :=  -pthread
+# Libraries to link to.
+LIBS := 
+# Libraries to link to for parallel API.
+MPI_LIBS := 
+# The extension for object files.
+OBJEXT := o
+# The extension for archives.
+LIBEXT := a
+# The QMTest command to use for testing.
+QMTEST := qmtest
+# OVXX library name
+OVXXLIB := ovxx
+
+enable_shared_libs := yes
+enable_cvsip_bindings  := no
+enable_python_bindings  := 
+
+### Third-party package availability ###
+
+have_opencl := 
+have_cuda := 
+have_mkl_vml := 
+have_ipp := 
+have_sal := 
+have_blas := 
+have_lapack := 
+have_mpi := 
+have_shm := 1
+have_cvsip := 
+have_huge_page_pool := 1
+sal_fft := 
+ipp_fft := 
+fftw := 
+cvsip_fft := 
+cuda_fft := 
+have_png := 1
+enable_threading := 1
+
+BOOST_CPPFLAGS := 
+BOOST_LDFLAGS := 
+BOOST_LIBS := 
+PYTHON_CPPFLAGS := 
+PYTHON_LIBS := 
+PYTHON	:= python
+PYTHON_EXT := 
+
+ifdef have_mpi
+enable_parallel := 1
+endif
+
+ifdef variant
+acconfig := config-$(variant).hpp
+variant_def := -DOVXX_VARIANT=$(variant)
+pkgconfig := ovxx-$(variant).pc
+else
+acconfig := config.hpp
+variant_def :=
+pkgconfig := ovxx.pc
+endif
+
@@ -0,0 +1,9 @@
+#!/bin/bash
+# usage: t.sh test.cpp [np]  -- compile and run a test against the shm build
+B=/root/repo/_shm_build
+src=$1; np=${2:-1}
+exe=$B/tbin/$(echo $src | tr '/' '_' | sed 's/\.cpp$//')
+mkdir -p $B/tbin
+g++ -std=gnu++11 -pthread -I$B/src -I$B/../src -I$B/../support -g -O2 -w -o $exe /root/repo/$src -L$B/lib -lovxx || { echo "COMPILE FAIL $src"; exit 1; }
+LD_LIBRARY_PATH=$B/lib timeout 600 /root/repo/bin/ovxx-run -np $np $exe > /dev/null 2>$exe.err
+r=$?; if [ $r = 0 ]; then echo "PASS $src"; else echo "FAIL($r) $src"; head -5 $exe.err; fi
@@ -0,0 +1,80 @@
+########################################################################
+#
+# Contents: Common Makefile harness for utils.
+#
+########################################################################
+
+########################################################################
+# Configuration Variables
+########################################################################
+
+CXX := g++
+CPPFLAGS :=  -I$(top_builddir)/src -I$(top_srcdir)/src -I$(srcdir)
+CXXFLAGS:=  -pthread
+LIBS    := -lvsip_csl -lsvpp 
+LDFLAGS := -L$(top_builddir)/lib  -pthread
+
+### Installation ###
+
+INSTALL := /usr/bin/install -c
+INSTALL_DATA := ${INSTALL} -m 644
+INSTALL_SCRIPT := ${INSTALL}
+INSTALL_PROGRAM := ${INSTALL}
+
+# Order matters for the various directory variables, as autoconf makes some
+# of the variables depend on the values of others.
+prefix := /usr/local
+exec_prefix := ${prefix}
+datarootdir := ${prefix}/share
+datadir := ${datarootdir}
+includedir := ${prefix}/include
+libdir := ${exec_prefix}/lib
+builtin_libdir := @builtin_libdir@
+sbindir := ${exec_prefix}/sbin
+bindir := ${exec_prefix}/bin
+variant_bindir := $(bindir)
+
+vpath %.cpp $(srcdir)
+vpath %.hpp $(srcdir)
+
+########################################################################
+# Build instructions
+########################################################################
+
+define make_dep
+@echo generating dependencies for $(@D)/$(<F)
+$(SHELL) -ec '$(CXX) -M $(CPPFLAGS) $< | \
+  sed "s|$(*F)\\.o[ :]*|$*\\.d $*\\.o : |g" > $@' \
+  || rm -f $@
+endef
+
+define link
+@echo linking $@
+$(CXX) -o $@ $^ $(LDFLAGS) $(LIBS)
+endef
+
+define compile
+@echo compiling $(@D)/$(@F)
+$(CXX) -c $(CPPFLAGS) $(CXXFLAGS) -o $@ $<
+endef
+
+########################################################################
+# Common rules
+########################################################################
+
+all: $(targets)
+
+clean: 
+	rm -f *.o $(targets)
+
+install: $(targets)
+	$(INSTALL) -d $(DESTDIR)$(variant_bindir)
+	for file in $(targets); do \
+	  $(INSTALL) $$file $(DESTDIR)$(variant_bindir)/; \
+	done
+
+
+ifeq (,$(filter $(MAKECMDGOALS), clean))
+include $(deps)
+endif
+
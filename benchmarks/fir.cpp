@@ -10,12 +10,15 @@
 ///   Benchmark for FIR filter.
 
 #include <iostream>
+#include <vector>
 
 #include <vsip/initfin.hpp>
 #include <vsip/support.hpp>
+#include <vsip/matrix.hpp>
 #include <vsip/math.hpp>
 #include <vsip/signal.hpp>
 #include <vsip/selgen.hpp>
+#include <ovxx/signal/fir_bank.hpp>
 #include "benchmark.hpp"
 
 using namespace vsip;
@@ -23,7 +26,8 @@ using namespace vsip;
 // Sweep FIR block size, processing single block
 
 template <obj_state      Save,
-	  typename       T>
+	  typename       T,
+	  alg_hint_type  H = alg_time>
 struct t_fir1 : Benchmark_base
 {
 
@@ -48,7 +52,7 @@ struct t_fir1 : Benchmark_base
 
   void operator()(length_type size, length_type loop, float& time)
   {
-    typedef Fir<T,nonsym,Save> fir_type;
+    typedef Fir<T,nonsym,Save,0,H> fir_type;
 
     Vector<T>   coeff(coeff_size_, T());
     coeff(0) = T(0);
@@ -178,6 +182,72 @@ struct t_fir2 : Benchmark_base
 
 
 
+// Sweep block size, filtering many channels with the same kernel,
+// either with a Fir_bank or with one Fir object per channel.
+
+template <bool           Bank,
+	  typename       T>
+struct t_fir_bank : Benchmark_base
+{
+
+  char const* what() { return Bank ? "t_fir_bank" : "t_fir_channels"; }
+
+  float ops_per_point(length_type)
+  {
+    float ops = channels_ * coeff_size_ *
+      (ovxx::ops_count::traits<T>::mul + ovxx::ops_count::traits<T>::add);
+
+    return ops;
+  }
+
+  int riob_per_point(length_type)
+    { return channels_ * sizeof(T); }
+
+  int wiob_per_point(length_type)
+    { return channels_ * sizeof(T); }
+
+  int mem_per_point(length_type)
+    { return 2 * channels_ * sizeof(T); }
+
+  void operator()(length_type size, length_type loop, float& time)
+  {
+    typedef Fir<T,nonsym,state_save> fir_type;
+    typedef ovxx::signal::Fir_bank<T,nonsym,state_save> bank_type;
+
+    Vector<T>   coeff(coeff_size_, T());
+    coeff(0) = T(1);
+    coeff(1) = T(2);
+
+    Matrix<T>   in (channels_, size, T());
+    Matrix<T>   out(channels_, size);
+
+    timer t1;
+    if (Bank)
+    {
+      bank_type bank(coeff, channels_, size);
+      t1.restart();
+      for (index_type l=0; l<loop; ++l)
+	bank(in, out);
+    }
+    else
+    {
+      std::vector<fir_type> fir(channels_, fir_type(coeff, size));
+      t1.restart();
+      for (index_type l=0; l<loop; ++l)
+	for (index_type c=0; c<channels_; ++c)
+	  fir[c](in.row(c), out.row(c));
+    }
+    time = t1.elapsed();
+  }
+
+  t_fir_bank(length_type coeff_size, length_type channels)
+    : coeff_size_(coeff_size)
+    , channels_  (channels)
+    {}
+
+  length_type coeff_size_;
+  length_type channels_;
+};
 
 
 
@@ -191,6 +261,7 @@ defaults(Loop1P& loop)
   loop.param_["k"]    = "16"; // Kernel size
   loop.param_["d"]    = "1";  // Decimation
   loop.param_["size"] = "0";  // Size
+  loop.param_["m"]    = "64"; // Channels
 }
 
 //  Non-symmetric, non-continuous, where kernel size and decimation 
@@ -207,6 +278,7 @@ benchmark(Loop1P& loop, int what)
   length_type k = atoi(loop.param_["k"].c_str());
   length_type d = atoi(loop.param_["d"].c_str());
   length_type size = atoi(loop.param_["size"].c_str());
+  length_type m = atoi(loop.param_["m"].c_str());
 
   if (size == 0)
     size = 1 << loop.stop_;
@@ -221,12 +293,19 @@ benchmark(Loop1P& loop, int what)
 
   case 11: loop(t_fir1<state_save,    SX>(k, d)); break;
   case 12: loop(t_fir1<state_save,    CX>(k, d)); break;
+  case 13: loop(t_fir1<state_save,    SX, alg_space>(k, d)); break;
+  case 14: loop(t_fir1<state_save,    CX, alg_space>(k, d)); break;
 
   case 21: loop(t_fir2<state_no_save, SX>(k, size)); break;
   case 22: loop(t_fir2<state_no_save, CX>(k, size)); break;
   case 31: loop(t_fir2<state_save,    SX>(k, size)); break;
   case 32: loop(t_fir2<state_save,    CX>(k, size)); break;
 
+  case 41: loop(t_fir_bank<true,  SX>(k, m)); break;
+  case 42: loop(t_fir_bank<true,  CX>(k, m)); break;
+  case 51: loop(t_fir_bank<false, SX>(k, m)); break;
+  case 52: loop(t_fir_bank<false, CX>(k, m)); break;
+
   case 0:
     std::cout
       << "fir -- FIR signal processing object benchmark\n"
@@ -235,8 +314,10 @@ benchmark(Loop1P& loop, int what)
       << "   -2 -- No state save, complex<float>\n"
       << "  -11 -- State save,    float\n"
       << "  -12 -- State save,    complex<float>\n"
+      << "  -13 -- State save,    float,          alg_space\n"
+      << "  -14 -- State save,    complex<float>, alg_space\n"
       << "\n"
-      << "Parameters for cases 1, 2, 11, 12\n"
+      << "Parameters for cases 1, 2, 11, 12, 13, 14\n"
       << "  -p:k <size>  Kernel size (default 16)\n"
       << "  -p:d <size>  Decimation (default 1)\n"
       << "\n"
@@ -249,6 +330,16 @@ benchmark(Loop1P& loop, int what)
       << "Parameters for cases 22, 32\n"
       << "  -p:k <size>  Kernel size (default 16)\n"
       << "  -p:size <size> Problem size (default 1)\n"
+      << "\n"
+      << " Sweep block size, many channels sharing one kernel\n"
+      << "  -41 -- Fir_bank,             float\n"
+      << "  -42 -- Fir_bank,             complex<float>\n"
+      << "  -51 -- One Fir per channel,  float\n"
+      << "  -52 -- One Fir per channel,  complex<float>\n"
+      << "\n"
+      << "Parameters for cases 41, 42, 51, 52\n"
+      << "  -p:k <size>  Kernel size (default 16)\n"
+      << "  -p:m <size>  Number of channels (default 64)\n"
       ;
 
   default: return 0;
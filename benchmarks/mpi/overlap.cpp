@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+/// Description
+///   Benchmark for overlapping a corner turn with FFT work, using
+///   split-phase redistribution.
+
+#include <iostream>
+
+#include <vsip/initfin.hpp>
+#include <vsip/support.hpp>
+#include <vsip/math.hpp>
+#include <vsip/map.hpp>
+#include <vsip/signal.hpp>
+#include <vsip/parallel.hpp>
+#include "benchmark.hpp"
+
+using namespace ovxx;
+
+enum overlap_impl
+{
+  comm_only,    // corner turn only
+  compute_only, // FFTs only
+  sequential,   // corner turn, then FFTs
+  overlapped    // corner turn started, FFTs, corner turn completed
+};
+
+// The corner turn moves a rows x cols matrix from a row- to a
+// column-distribution. In the meantime, each processor computes
+// forward and inverse FFTs on a local rows x cols matrix, such as
+// the previous CPI.
+template <typename T>
+struct t_overlap : Benchmark_base
+{
+  typedef Map<Block_dist, Block_dist>      map_type;
+  typedef Dense<2, T, row2_type, map_type> block_type;
+  typedef Matrix<T, block_type>            view_type;
+  typedef parallel::Redistribution<view_type, view_type> plan_type;
+
+  typedef Fftm<T, T, row, fft_fwd, by_reference, 1, alg_time> fwd_fftm_type;
+  typedef Fftm<T, T, row, fft_inv, by_reference, 1, alg_time> inv_fftm_type;
+
+  char const* what() { return "t_overlap"; }
+  int ops_per_point(length_type cols)
+  {
+    // Count one operation per element moved by the corner turn.
+    if (impl_ == comm_only) return rows_;
+    return static_cast<int>(2 * rows_ * 5 * std::log((double)cols) / std::log(2.0));
+  }
+  int riob_per_point(length_type) { return rows_ * sizeof(T); }
+  int wiob_per_point(length_type) { return rows_ * sizeof(T); }
+  int mem_per_point(length_type)  { return 4 * rows_ * sizeof(T); }
+
+  void operator()(length_type cols, length_type loop, float& time)
+  {
+    // The loop count is calibrated on each processor separately,
+    // but all of them need to take part in the same corner turns.
+    loop = parallel::default_communicator().allreduce(reduce_max, loop);
+
+    processor_type np = num_processors();
+    map_type row_map(np, 1);
+    map_type col_map(1, np);
+
+    view_type A(rows_, cols, T(1), row_map);
+    view_type B(rows_, cols, T(), col_map);
+    Matrix<T> data(rows_, cols, T(1));
+
+    plan_type turn(B, A);
+    fwd_fftm_type fwd(Domain<2>(rows_, cols), 1.f);
+    inv_fftm_type inv(Domain<2>(rows_, cols), 1.f/cols);
+
+    barrier();
+    timer t1;
+    for (index_type l=0; l<loop; ++l)
+    {
+      switch (impl_)
+      {
+      case comm_only:
+	turn();
+	break;
+      case compute_only:
+	fwd(data);
+	inv(data);
+	break;
+      case sequential:
+	turn();
+	fwd(data);
+	inv(data);
+	break;
+      case overlapped:
+	turn.start();
+	fwd(data);
+	inv(data);
+	turn.wait();
+	break;
+      }
+    }
+    barrier();
+    time = t1.elapsed();
+
+    if (impl_ != compute_only)
+      for (index_type r=0; r<B.local().size(0); ++r)
+	for (index_type c=0; c<B.local().size(1); ++c)
+	  test_assert(equal(B.local().get(r, c), T(1)));
+  }
+
+  // Report how much of the communication time the FFTs hide.
+  void diag()
+  {
+    length_type const cols = 4096;
+    length_type const loop = 50;
+    overlap_impl impl = impl_;
+    float comm, compute, both;
+    impl_ = comm_only;    (*this)(cols, loop, comm);
+    impl_ = compute_only; (*this)(cols, loop, compute);
+    impl_ = overlapped;   (*this)(cols, loop, both);
+    impl_ = impl;
+
+    float hidden = comm > 0.f ? (comm + compute - both) / comm : 0.f;
+    hidden = std::max(0.f, std::min(1.f, hidden));
+    if (local_processor() == 0)
+      std::cout << "rows x cols     : " << rows_ << " x " << cols << '\n'
+		<< "corner turn (s) : " << comm / loop << '\n'
+		<< "FFTs (s)        : " << compute / loop << '\n'
+		<< "overlapped (s)  : " << both / loop << '\n'
+		<< "hidden          : " << 100 * hidden << "%" << std::endl;
+  }
+
+  t_overlap(overlap_impl impl, length_type rows) : impl_(impl), rows_(rows) {}
+
+  overlap_impl impl_;
+  length_type  rows_;
+};
+
+void
+defaults(Loop1P& loop)
+{
+  loop.start_      = 4;
+  loop.stop_       = 14;
+  loop.user_param_ = 64;
+}
+
+int
+benchmark(Loop1P& loop, int what)
+{
+  typedef complex<float> T;
+  length_type rows = loop.user_param_;
+
+  switch (what)
+  {
+  case  1: loop(t_overlap<T>(comm_only, rows)); break;
+  case  2: loop(t_overlap<T>(compute_only, rows)); break;
+  case  3: loop(t_overlap<T>(sequential, rows)); break;
+  case  4: loop(t_overlap<T>(overlapped, rows)); break;
+
+  case 0:
+    std::cout
+      << "overlap -- corner turn overlapped with FFTs.\n"
+      << "\n"
+      << "  Each processor corner-turns a distributed rows x cols\n"
+      << "  matrix, and computes forward and inverse FFTs on a local\n"
+      << "  rows x cols matrix.\n"
+      << "\n"
+      << "    -1: corner turn only\n"
+      << "    -2: FFTs only\n"
+      << "    -3: corner turn, then FFTs\n"
+      << "    -4: corner turn started, FFTs, corner turn completed\n"
+      << "\n"
+      << "  The fraction of the communication time hidden behind\n"
+      << "  the FFTs is (T1 + T2 - T4) / T1. With -diag, this is\n"
+      << "  measured and reported for 4096 columns.\n"
+      << "\n"
+      << "  Parameter:\n"
+      << "               default\n"
+      << "               ----------------\n"
+      << "      -param   64  Number of rows\n"
+      << "      -stop    14  Stop at 2^14 columns\n"
+      ;
+  default:
+    return 0;
+  }
+  return 1;
+}
@@ -223,6 +223,9 @@ benchmark(Loop1P& loop, int what)
   case  3: loop(t_prod2<be::generic, float>()); break;
   case  4: loop(t_prod2<be::generic, complex<float> >()); break;
 
+  case  7: loop(t_prod2<be::opt, float>()); break;
+  case  8: loop(t_prod2<be::opt, complex<float> >()); break;
+
 #if VSIP_IMPL_HAVE_BLAS
   case  5: loop(t_prod2<be::blas, float>()); break;
     // The BLAS backend doesn't handle split-complex, so don't attempt
@@ -245,6 +248,8 @@ benchmark(Loop1P& loop, int what)
       << "    -4 -- generic implementation, complex<float>\n"
       << "    -5 --    BLAS implementation, float\n"
       << "    -6 --    BLAS implementation, complex<float> {interleaved only}\n"
+      << "    -7 --  packed implementation, float\n"
+      << "    -8 --  packed implementation, complex<float>\n"
       << "   -11 -- default impl with transpose, float\n"
       << "   -12 -- default impl with transpose, complex<float>\n"
       << "   -13 -- default impl with hermetian, complex<float>\n"
@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+/// Description
+///   Benchmark for corner-turns (matrix transposes).
+
+#include <vsip/initfin.hpp>
+#include <vsip/support.hpp>
+#include <vsip/matrix.hpp>
+#include "benchmark.hpp"
+#include <ovxx/output.hpp>
+#include <iostream>
+
+using namespace vsip;
+
+/// Transpose a `size` x `size` matrix between row-major and
+/// column-major storage of format `F`, either out of place or
+/// in place.
+template <typename T, storage_format_type F, bool InPlace>
+struct t_transpose : Benchmark_base
+{
+  typedef ovxx::Strided<2, T, Layout<2, row2_type, dense, F> > src_block_type;
+  typedef ovxx::Strided<2, T, Layout<2, col2_type, dense, F> > dst_block_type;
+
+  char const* what() { return "t_transpose<T, F, InPlace>"; }
+  int ops_per_point(length_type size)  { return size; }
+  int riob_per_point(length_type size) { return size*sizeof(T); }
+  int wiob_per_point(length_type size) { return size*sizeof(T); }
+  int mem_per_point(length_type size)  { return (InPlace ? 1 : 2)*size*sizeof(T); }
+
+  void operator()(length_type size, length_type loop, float& time) OVXX_NOINLINE
+  {
+    length_type const M = size;
+    length_type const N = size;
+
+    Matrix<T, src_block_type> A(M, N);
+    Matrix<T, dst_block_type> Z(M, N, T());
+
+    for (index_type m=0; m<M; ++m)
+      for (index_type n=0; n<N; ++n)
+	A.put(m, n, T(m*N + n));
+
+    timer t1;
+    if (InPlace)
+      for (index_type l=0; l<loop; ++l)
+	A = A.transpose();
+    else
+      for (index_type l=0; l<loop; ++l)
+	Z = A;
+    time = t1.elapsed();
+
+    for (index_type m=0; m<M; ++m)
+      for (index_type n=0; n<N; ++n)
+      {
+	T expected = InPlace && loop % 2 ? T(n*N + m) : T(m*N + n);
+	if (!equal(InPlace ? A.get(m, n) : Z.get(m, n), expected))
+	{
+	  std::cout << "t_transpose: ERROR" << std::endl;
+	  abort();
+	}
+      }
+  }
+
+  void diag()
+  {
+    using namespace ovxx;
+    length_type const M = 256;
+    length_type const N = 256;
+
+    Matrix<T, src_block_type> A(M, N);
+    Matrix<T, dst_block_type> Z(M, N);
+    if (InPlace)
+      std::cout << assignment::diagnostics(A, A.transpose()) << std::endl;
+    else
+      std::cout << assignment::diagnostics(Z, A) << std::endl;
+  }
+};
+
+
+
+void
+defaults(Loop1P& loop)
+{
+  loop.start_ = 4;
+  loop.stop_ = 12;
+  loop.metric_ = iob_per_sec;
+}
+
+
+
+int
+benchmark(Loop1P& loop, int what)
+{
+  typedef complex<float> cf;
+  typedef complex<double> cd;
+
+  switch (what)
+  {
+  case  1: loop(t_transpose<float,  array, false>()); break;
+  case  2: loop(t_transpose<double, array, false>()); break;
+  case  3: loop(t_transpose<cf, interleaved_complex, false>()); break;
+  case  4: loop(t_transpose<cf, split_complex, false>()); break;
+  case  5: loop(t_transpose<cd, interleaved_complex, false>()); break;
+
+  case 11: loop(t_transpose<float,  array, true>()); break;
+  case 12: loop(t_transpose<double, array, true>()); break;
+  case 13: loop(t_transpose<cf, interleaved_complex, true>()); break;
+  case 14: loop(t_transpose<cf, split_complex, true>()); break;
+
+  case   0:
+    std::cout
+      << "transpose -- corner-turn of a size x size matrix\n"
+      << "    -1:          float,              cols <- rows\n"
+      << "    -2:         double,              cols <- rows\n"
+      << "    -3: complex<float>, interleaved, cols <- rows\n"
+      << "    -4: complex<float>, split,       cols <- rows\n"
+      << "    -5: complex<double>,interleaved, cols <- rows\n"
+      << "   -11:          float,              in place\n"
+      << "   -12:         double,              in place\n"
+      << "   -13: complex<float>, interleaved, in place\n"
+      << "   -14: complex<float>, split,       in place\n"
+      << "\n"
+      << " Notes:\n"
+      << "   The default metric is bytes read and written, in MB/s\n"
+      << "   (divide by 1000 for GB/s).\n"
+      ;
+
+  default:
+    return 0;
+  }
+  return 1;
+}
@@ -115,6 +115,17 @@ if test "$enable_fftw" != "no"; then
     [AC_MSG_RESULT([no.])
      LIBS=$keep_LIBS])
 
+  if test "$enable_fftw_threads" = yes ; then
+    AC_MSG_CHECKING([if FFTW threads can be run by a user-provided pool])
+    AC_LINK_IFELSE(
+      [AC_LANG_PROGRAM([#include <fftw3.h>],
+        [void (*f)(void (*)(void *(*)(char *), char *, size_t, int, void *), void *)
+           = fftw_threads_set_callback; (void)f;])],
+      [AC_MSG_RESULT([yes.])
+       AC_DEFINE_UNQUOTED(OVXX_FFTW_HAVE_THREADS_CALLBACK, 1,
+         [Define to 1 if FFTW provides fftw_threads_set_callback.])],
+      [AC_MSG_RESULT([no.])])
+  fi
   if test "$fftw_has_float" = 1; then
     AC_DEFINE_UNQUOTED(OVXX_FFTW_HAVE_FLOAT, $fftw_has_float,
       [Define to 1 if -lfftw3f was found.])
@@ -15,6 +15,8 @@
 #include <vsip/parallel.hpp>
 #include <iostream>
 #include <ovxx/output.hpp>
+#include <ovxx/domain_utils.hpp>
+#include <memory>
 
 namespace pyvsip
 {
@@ -173,8 +175,43 @@ struct traits<3,T,M>
 template <dimension_type D, typename T>
 bpl::handle<PyArrayObject> make_array_(Block<D, T> &);
 
+// Construct a block sharing the array's data, if possible. This requires
+// the data to be aligned, writable, and in native byte order, and the
+// strides to be positive multiples of the element size. Fortran-ordered
+// and strided arrays are thus adopted, too.
+// Returns a null pointer if the array can't be adopted.
+template <dimension_type D, typename T>
+boost::shared_ptr<Block<D, T> > adopt(bpl::object o)
+{
+  typedef Block<D, T> block_type;
+  PyArrayObject *a = reinterpret_cast<PyArrayObject*>(o.ptr());
+  if (!PyArray_ISALIGNED(a) || !PyArray_ISWRITEABLE(a) || !PyArray_ISNOTSWAPPED(a))
+    return boost::shared_ptr<block_type>();
+  npy_intp *dims = PyArray_SHAPE(a);
+  npy_intp *strides = PyArray_STRIDES(a);
+  Domain<1> dom[D];
+  length_type extent = 1;
+  for (dimension_type d = 0; d != D; ++d)
+  {
+    if (dims[d] == 0) return boost::shared_ptr<block_type>();
+    stride_type stride = 1;
+    if (dims[d] > 1)
+    {
+      if (strides[d] <= 0 || strides[d] % sizeof(T))
+	return boost::shared_ptr<block_type>();
+      stride = strides[d] / sizeof(T);
+    }
+    dom[d] = Domain<1>(0, stride, dims[d]);
+    extent += (dims[d] - 1) * stride;
+  }
+  T *data = static_cast<T*>(PyArray_DATA(a));
+  return boost::shared_ptr<block_type>
+    (new block_type(construct_domain<D>(dom), data, extent, o));
+}
+
 // The one-argument constructor needs some manual dispatching,
 // as the argument may be an array or a length.
+// Arrays are adopted if possible, and copied otherwise.
 template <typename T>
 bpl::object construct(bpl::object o)
 {
@@ -195,17 +232,24 @@ bpl::object construct(bpl::object o)
   {
     case 1:
     {
-      boost::shared_ptr<Block<1, T> > b(new Block<1, T>(dims[0]));
-      bpl::handle<PyArrayObject> ba = make_array_(*b);
-      PyArray_CopyInto(ba.get(), a);
+      boost::shared_ptr<Block<1, T> > b = adopt<1, T>(o);
+      if (!b)
+      {
+	b.reset(new Block<1, T>(dims[0]));
+	bpl::handle<PyArrayObject> ba = make_array_(*b);
+	PyArray_CopyInto(ba.get(), a);
+      }
       return bpl::object(b);
     }
     case 2:
     {
-      Domain<2> dom(dims[0], dims[1]);
-      boost::shared_ptr<Block<2, T> > b(new Block<2, T>(dom));
-      bpl::handle<PyArrayObject> ba = make_array_(*b);
-      PyArray_CopyInto(ba.get(), a);
+      boost::shared_ptr<Block<2, T> > b = adopt<2, T>(o);
+      if (!b)
+      {
+	b.reset(new Block<2, T>(Domain<2>(dims[0], dims[1])));
+	bpl::handle<PyArrayObject> ba = make_array_(*b);
+	PyArray_CopyInto(ba.get(), a);
+      }
       return bpl::object(b);
     }
     default:
@@ -263,6 +307,121 @@ bpl::object make_array(bpl::object o)
   return bpl::object(bpl::handle<>(a));
 }
 
+// The buffer protocol's format string for T.
+template <typename T> char const *buffer_format();
+template <> inline char const *buffer_format<bool>() { return "?";}
+template <> inline char const *buffer_format<int>() { return "i";}
+template <> inline char const *buffer_format<float>() { return "f";}
+template <> inline char const *buffer_format<double>() { return "d";}
+template <> inline char const *buffer_format<complex<float> >() { return "Zf";}
+template <> inline char const *buffer_format<complex<double> >() { return "Zd";}
+
+// Expose a block's data through the buffer protocol, so
+// memoryview(b) and numpy.asarray(b) share it without a copy.
+// As with make_array, the block's storage is pinned while the
+// buffer is in use.
+template <dimension_type D, typename T>
+struct buffer_protocol
+{
+  typedef Block<D, T> block_type;
+
+  // Per-buffer data, held in Py_buffer::internal.
+  struct info
+  {
+    block_type *block;
+    Py_ssize_t shape[D];
+    Py_ssize_t strides[D];
+  };
+
+  static bool requests(int flags, int request)
+  { return (flags & request) == request;}
+
+  // Return true if the data is contiguous in C (row-major) order,
+  // or Fortran (column-major) order if `fortran` is set.
+  static bool is_contiguous(Py_ssize_t const *shape, Py_ssize_t const *strides,
+			    bool fortran)
+  {
+    Py_ssize_t stride = sizeof(T);
+    for (dimension_type i = 0; i != D; ++i)
+    {
+      dimension_type d = fortran ? i : D - 1 - i;
+      if (shape[d] > 1 && strides[d] != stride) return false;
+      stride *= shape[d];
+    }
+    return true;
+  }
+
+  static int get(PyObject *self, Py_buffer *view, int flags)
+  {
+    void *b = bpl::converter::get_lvalue_from_python
+      (self, bpl::converter::registered<block_type>::converters);
+    if (!b)
+    {
+      PyErr_SetString(PyExc_BufferError, "object has no block");
+      return -1;
+    }
+    block_type &block = *static_cast<block_type*>(b);
+    std::unique_ptr<info> i(new info);
+    i->block = &block;
+    for (dimension_type d = 0; d != D; ++d)
+    {
+      i->shape[d] = block.size(D, d);
+      i->strides[d] = block.stride(D, d) * sizeof(T);
+    }
+    bool const c_contiguous = is_contiguous(i->shape, i->strides, false);
+    bool const f_contiguous = is_contiguous(i->shape, i->strides, true);
+    char const *error = 0;
+    if (requests(flags, PyBUF_C_CONTIGUOUS) && !c_contiguous)
+      error = "block is not C-contiguous";
+    else if (requests(flags, PyBUF_F_CONTIGUOUS) && !f_contiguous)
+      error = "block is not Fortran-contiguous";
+    else if (requests(flags, PyBUF_ANY_CONTIGUOUS) &&
+	     !c_contiguous && !f_contiguous)
+      error = "block is not contiguous";
+    // Without strides, the consumer assumes C order.
+    else if (!requests(flags, PyBUF_STRIDES) && !c_contiguous)
+      error = "block is not C-contiguous";
+    if (error)
+    {
+      PyErr_SetString(PyExc_BufferError, error);
+      return -1;
+    }
+    view->buf = block.ptr();
+    view->obj = bpl::incref(self);
+    view->len = block.size() * sizeof(T);
+    view->readonly = 0;
+    view->itemsize = sizeof(T);
+    view->format = (flags & PyBUF_FORMAT) ?
+      const_cast<char *>(buffer_format<T>()) : 0;
+    view->ndim = D;
+    view->shape = (flags & PyBUF_ND) ? i->shape : 0;
+    view->strides = (flags & PyBUF_STRIDES) ? i->strides : 0;
+    view->suboffsets = 0;
+    view->internal = i.release();
+    block.ref_ptr();
+    return 0;
+  }
+  static void release(PyObject *, Py_buffer *view)
+  {
+    info *i = static_cast<info*>(view->internal);
+    i->block->unref_ptr();
+    delete i;
+  }
+
+  // Install the buffer protocol into the given block class.
+  static void define(bpl::object type)
+  {
+    static PyBufferProcs procs;
+    procs.bf_getbuffer = get;
+    procs.bf_releasebuffer = release;
+    PyTypeObject *t = reinterpret_cast<PyTypeObject*>(type.ptr());
+    t->tp_as_buffer = &procs;
+#ifdef Py_TPFLAGS_HAVE_NEWBUFFER
+    t->tp_flags |= Py_TPFLAGS_HAVE_NEWBUFFER;
+#endif
+  }
+};
+
 // Calculate a domain corresponding to the given slice, assuming the given length.
 // To be able to generate a domain we also need the parent block's lay
 // The stride parameter is needed to account for non-unit-stride access (i.e. when
@@ -415,6 +574,8 @@ void define_block(char const *type_name)
   block.setattr("dtype", get_dtype<T>());
   /// Conversion to array.
   block.def("__array__", make_array<D, T>);
+  /// Zero-copy access through the buffer protocol.
+  buffer_protocol<D, T>::define(block);
   block.def("assign", assign<D, T, M>);
   block.def("assign", assign_scalar<D, T, M>);
 
@@ -6,6 +6,7 @@
 // license contained in the accompanying LICENSE.BSD file.
 
 #include <ovxx/python/block.hpp>
+#include <ovxx/python/gil.hpp>
 #include <boost/python.hpp>
 #include <vsip/initfin.hpp>
 #include <vsip/support.hpp>
@@ -17,4 +18,6 @@ namespace bpl = boost::python;
 BOOST_PYTHON_MODULE(library)
 {
   bpl::class_<vsip::vsipl, boost::noncopyable> vsipl("library");
+  // The result type of asynchronous calls in all other modules.
+  ovxx::python::define_future();
 }
@@ -84,6 +84,35 @@ def prod(v, w):
         else:
             return vector(array=numpy.tensordot(array(b1), array(b2), (1,0)))
 
+class _product:
+    """The future result of prod_async."""
+
+    def __init__(self, future):
+        self._future = future
+
+    def done(self):
+        """Return True if the product has been computed."""
+        return self._future.done()
+
+    def wait(self):
+        """Wait for the product to be computed, and return it."""
+        b = self._future.wait()
+        if len(b.shape) == 2:
+            return matrix(block=b)
+        else:
+            return vector(block=b)
+
+def prod_async(v, w):
+    """Start computing the matrix product of v and w in the background.
+    Returns a future; its `wait()` method returns the product."""
+
+    b1 = v.block
+    b2 = w.block
+    if b1.dtype != b2.dtype:
+        raise ValueError, 'Mismatched dtypes %s and %s'%(b1.dtype, b2.dtype)
+    mod = import_module('vsip.math.matvec', b1.dtype)
+    return _product(mod.prod_async(b1, b2))
+
 def prodh(v, w):
     """Return the matrix product of v and the Hermitian of w."""
 
@@ -9,6 +9,7 @@
 #define math_matvec_api_hpp_
 
 #include <ovxx/python/block.hpp>
+#include <ovxx/python/gil.hpp>
 #include <vsip/vector.hpp>
 #include <vsip/matrix.hpp>
 #include <vsip/math.hpp>
@@ -18,10 +19,13 @@ namespace pyvsip
 using namespace ovxx;
 using namespace ovxx::python;
 
+// All functions below compute without holding the GIL.
+
 template <typename T>
 T dot(Block<1, T> const &b1, Block<1, T> const &b2)
 {
   typedef Block<1, T> B;
+  gil_release unlocked;
   return vsip::dot(Vector<T, B>(const_cast<B&>(b1)), Vector<T, B>(const_cast<B&>(b2)));
 }
 
@@ -32,7 +36,10 @@ boost::shared_ptr<Block<2, T> > trans(Block<2, T> const&b)
   boost::shared_ptr<B> block_ptr(new B(Domain<2>(b.size(2, 1), b.size(2, 0))));
   Matrix<T, B> mout(*block_ptr);
   Matrix<T, B> min(const_cast<B&>(b));
-  mout = trans(min);
+  {
+    gil_release unlocked;
+    mout = trans(min);
+  }
   return block_ptr;
 }
 
@@ -43,29 +50,56 @@ boost::shared_ptr<Block<2, T> > herm(Block<2, T> const&b)
   boost::shared_ptr<B> block_ptr(new B(Domain<2>(b.size(2, 1), b.size(2, 0))));
   Matrix<T, B> mout(*block_ptr);
   Matrix<T, B> min(const_cast<B&>(b));
-  mout = herm(min);
+  {
+    gil_release unlocked;
+    mout = herm(min);
+  }
   return block_ptr;
 }
 
+// Compute r = prod(a, b), for vectors (D == 1) and matrices (D == 2).
+template <typename T, dimension_type D1, dimension_type D2, dimension_type D3>
+struct product
+{
+  typedef Block<D1, T> B1;
+  typedef Block<D2, T> B2;
+  typedef Block<D3, T> B3;
+
+  product(B1 const &a, B2 const &b, B3 &r) : a(&a), b(&b), r(&r) {}
+  void operator()()
+  {
+    typename view_of<B1>::type va(const_cast<B1&>(*a));
+    typename view_of<B2>::type vb(const_cast<B2&>(*b));
+    typename view_of<B3>::type vr(*r);
+    vr = vsip::prod(va, vb);
+  }
+
+  B1 const *a;
+  B2 const *b;
+  B3 *r;
+};
+
 template <typename T>
 boost::shared_ptr<Block<1, T> > vmprod(Block<1, T> const &a, Block<2, T> const &b)
 {
-  typedef Block<1, T> B1;
-  typedef Block<2, T> B2;
-  boost::shared_ptr<B1> block_ptr(new B1(b.size(2, 1)));
-  Vector<T, B1> mout(*block_ptr);
-  mout = vsip::prod(Vector<T, B1>(const_cast<B1&>(a)), Matrix<T, B2>(const_cast<B2&>(b)));
+  boost::shared_ptr<Block<1, T> > block_ptr(new Block<1, T>(b.size(2, 1)));
+  product<T, 1, 2, 1> p(a, b, *block_ptr);
+  {
+    gil_release unlocked;
+    p();
+  }
   return block_ptr;
 }
 
 template <typename T>
 boost::shared_ptr<Block<1, T> > mvprod(Block<2, T> const &a, Block<1, T> const &b)
 {
-  typedef Block<2, T> B2;
-  typedef Block<1, T> B1;
-  boost::shared_ptr<B1> block_ptr(new B1(a.size(2, 0)));
-  Vector<T, B1> mout(*block_ptr);
-  mout = vsip::prod(Matrix<T, B2>(const_cast<B2&>(a)), Vector<T, B1>(const_cast<B1&>(b)));
+  boost::shared_ptr<Block<1, T> > block_ptr(new Block<1, T>(a.size(2, 0)));
+  product<T, 2, 1, 1> p(a, b, *block_ptr);
+  {
+    gil_release unlocked;
+    p();
+  }
   return block_ptr;
 }
 
@@ -74,11 +108,47 @@ boost::shared_ptr<Block<2, T> > mmprod(Block<2, T> const &a, Block<2, T> const &
 {
   typedef Block<2, T> B;
   boost::shared_ptr<B> block_ptr(new B(Domain<2>(a.size(2, 0), b.size(2, 1))));
-  Matrix<T, B> mout(*block_ptr);
-  mout = vsip::prod(Matrix<T, B>(const_cast<B&>(a)), Matrix<T, B>(const_cast<B&>(b)));
+  product<T, 2, 2, 2> p(a, b, *block_ptr);
+  {
+    gil_release unlocked;
+    p();
+  }
   return block_ptr;
 }
 
+// The asynchronous variants of the above. The future's result
+// is the product's block.
+template <typename T>
+boost::shared_ptr<future>
+vmprod_async(bpl::back_reference<Block<1, T> &> a, bpl::back_reference<Block<2, T> &> b)
+{
+  boost::shared_ptr<Block<1, T> > block_ptr(new Block<1, T>(b.get().size(2, 1)));
+  product<T, 1, 2, 1> p(a.get(), b.get(), *block_ptr);
+  return boost::shared_ptr<future>
+    (new future(p, bpl::make_tuple(a.source(), b.source()), bpl::object(block_ptr)));
+}
+
+template <typename T>
+boost::shared_ptr<future>
+mvprod_async(bpl::back_reference<Block<2, T> &> a, bpl::back_reference<Block<1, T> &> b)
+{
+  boost::shared_ptr<Block<1, T> > block_ptr(new Block<1, T>(a.get().size(2, 0)));
+  product<T, 2, 1, 1> p(a.get(), b.get(), *block_ptr);
+  return boost::shared_ptr<future>
+    (new future(p, bpl::make_tuple(a.source(), b.source()), bpl::object(block_ptr)));
+}
+
+template <typename T>
+boost::shared_ptr<future>
+mmprod_async(bpl::back_reference<Block<2, T> &> a, bpl::back_reference<Block<2, T> &> b)
+{
+  typedef Block<2, T> B;
+  boost::shared_ptr<B> block_ptr(new B(Domain<2>(a.get().size(2, 0), b.get().size(2, 1))));
+  product<T, 2, 2, 2> p(a.get(), b.get(), *block_ptr);
+  return boost::shared_ptr<future>
+    (new future(p, bpl::make_tuple(a.source(), b.source()), bpl::object(block_ptr)));
+}
+
 template <typename T>
 boost::shared_ptr<Block<2, T> > vmmul(int axis, Block<1, T> const &a, Block<2, T> const &b)
 {
@@ -86,6 +156,7 @@ boost::shared_ptr<Block<2, T> > vmmul(int axis, Block<1, T> const &a, Block<2, T
   typedef Block<2, T> B2;
   boost::shared_ptr<B2> block_ptr(new B2(vsip::Domain<2>(b.size(2, 0), b.size(2, 1))));
   Matrix<T, B2> mout(*block_ptr);
+  gil_release unlocked;
   if (axis==0)
     mout = vsip::vmmul<0>(Vector<T, B1>(const_cast<B1&>(a)), Matrix<T, B2>(const_cast<B2&>(b)));
   else
@@ -113,6 +184,9 @@ void define_api()
   bpl::def("prod", vmprod<T>);
   bpl::def("prod", mvprod<T>);
   bpl::def("prod", mmprod<T>);
+  bpl::def("prod_async", vmprod_async<T>);
+  bpl::def("prod_async", mvprod_async<T>);
+  bpl::def("prod_async", mmprod_async<T>);
   bpl::def("vmmul", vmmul<T>);
   define_complex_api(T());
 }
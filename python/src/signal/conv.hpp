@@ -9,6 +9,7 @@
 #define signal_conv_hpp_
 
 #include <ovxx/python/block.hpp>
+#include <ovxx/python/gil.hpp>
 #include <vsip/signal.hpp>
 #include <ovxx/domain_utils.hpp>
 
@@ -108,6 +109,9 @@ template <typename T>
 void define_conv()
 {
   typedef conv_base<T> conv_type;
+  typedef ovxx::python::Block<1, T> B;
+  using ovxx::python::nogil;
+  using ovxx::python::async;
 
   bpl::class_<conv_type, std::unique_ptr<conv_type>, boost::noncopyable>
     conv("conv", bpl::no_init);
@@ -118,7 +122,8 @@ void define_conv()
   conv.add_property("decimation", &conv_type::decimation);
   conv.add_property("input_size", &conv_type::input_size);
   conv.add_property("output_size", &conv_type::output_size);
-  conv.def("__call__", &conv_type::op);
+  conv.def("__call__", nogil<conv_type, B const &, B &, &conv_type::op>);
+  conv.def("call_async", async<conv_type, B const &, B &, &conv_type::op>);
 
 }
 
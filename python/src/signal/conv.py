@@ -10,17 +10,33 @@ from vsip import import_module
 from vsip import vector, matrix
 
 class conv:
+    """Convolve input vectors with the vector `kernel`, whose dtype is
+    used for the input and output, too.
+    (This used to take a dtype in place of the kernel, but as the kernel
+    was then never passed to the convolution, such objects couldn't be
+    constructed.)"""
 
-    def __init__(self, dtype, symmetry, support, i, decimation, n, hint):
+    def __init__(self, kernel, symmetry, support, i, decimation, n, hint):
 
-        self.dtype = dtype
+        self.dtype = kernel.dtype
+        self.kernel = kernel
         self.symmetry = symmetry
         self.support = support
 
-        m = import_module('vsip.signal.conv', dtype)
-        self._impl = m.conv(symmetry, i, decimation, support, n, hint)
+        m = import_module('vsip.signal.conv', self.dtype)
+        self._impl = m.conv(kernel.block, symmetry, i, decimation, support, n, hint)
+
+        self.input_size = self._impl.input_size   #: the size of the input vector
+        self.output_size = self._impl.output_size #: the size of the output vector
 
     def __call__(self, input, output):
 
         self._impl(input.block, output.block)
 
+    def call_async(self, input, output):
+        """Like __call__, but compute in the background.
+        Returns a future; its `wait()` method blocks until the
+        computation has completed."""
+
+        return self._impl.call_async(input.block, output.block)
+
@@ -9,6 +9,7 @@
 #define signal_corr_hpp_
 
 #include <ovxx/python/block.hpp>
+#include <ovxx/python/gil.hpp>
 #include <vsip/signal.hpp>
 
 namespace pyvsip
@@ -75,6 +76,9 @@ template <typename T>
 void define_corr()
 {
   typedef corr_base<T> corr_type;
+  typedef ovxx::python::Block<1, T> B;
+  using ovxx::python::nogil;
+  using ovxx::python::async;
 
   bpl::class_<corr_type, std::unique_ptr<corr_type>, boost::noncopyable>
     corr("corr", bpl::no_init);
@@ -83,7 +87,10 @@ void define_corr()
   corr.add_property("support", &corr_type::support);
   corr.add_property("input_size", &corr_type::input_size);
   corr.add_property("output_size", &corr_type::output_size);
-  corr.def("__call__", &corr_type::op);
+  corr.def("__call__", nogil<corr_type, vsip::bias_type, B const &, B const &, B &,
+			    &corr_type::op>);
+  corr.def("call_async", async<corr_type, vsip::bias_type, B const &, B const &, B &,
+			       &corr_type::op>);
 
 }
 }
@@ -37,3 +37,10 @@ class corr:
 
         self._impl(bias, ref.block, input.block, output.block)
 
+    def call_async(self, bias, ref, input, output):
+        """Like __call__, but compute in the background.
+        Returns a future; its `wait()` method blocks until the
+        computation has completed."""
+
+        return self._impl.call_async(bias, ref.block, input.block, output.block)
+
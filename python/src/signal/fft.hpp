@@ -9,6 +9,7 @@
 #define signal_fft_hpp_
 
 #include <ovxx/python/block.hpp>
+#include <ovxx/python/gil.hpp>
 #include <vsip/signal.hpp>
 #include <ovxx/domain_utils.hpp>
 
@@ -191,6 +192,10 @@ void define_real_fft()
   typedef vsip::complex<T> C;
   typedef fft_base<T, C, vsip::fft_fwd> fft_type;
   typedef fft_base<C, T, vsip::fft_inv> ifft_type;
+  typedef ovxx::python::Block<1, T> RB;
+  typedef ovxx::python::Block<1, C> CB;
+  using ovxx::python::nogil;
+  using ovxx::python::async;
 
   bpl::class_<fft_type, std::unique_ptr<fft_type>, boost::noncopyable>
     fft("fft", bpl::no_init);
@@ -199,7 +204,8 @@ void define_real_fft()
   fft.add_property("output_size", &fft_type::output_size);
   fft.add_property("scale", &fft_type::scale);
   fft.add_property("forward", &fft_type::forward);
-  fft.def("__call__", &fft_type::op);
+  fft.def("__call__", nogil<fft_type, RB const &, CB &, &fft_type::op>);
+  fft.def("call_async", async<fft_type, RB const &, CB &, &fft_type::op>);
 
   bpl::class_<ifft_type, std::unique_ptr<ifft_type>, boost::noncopyable>
     ifft("ifft", bpl::no_init);
@@ -208,7 +214,8 @@ void define_real_fft()
   ifft.add_property("output_size", &ifft_type::output_size);
   ifft.add_property("scale", &ifft_type::scale);
   ifft.add_property("forward", &ifft_type::forward);
-  ifft.def("__call__", &ifft_type::op);
+  ifft.def("__call__", nogil<ifft_type, CB const &, RB &, &ifft_type::op>);
+  ifft.def("call_async", async<ifft_type, CB const &, RB &, &ifft_type::op>);
 }
 
 template <typename T>
@@ -217,6 +224,9 @@ void define_complex_fft()
   typedef vsip::complex<T> C;
   typedef fft_base<C, C, vsip::fft_fwd> fft_type;
   typedef fft_base<C, C, vsip::fft_inv> ifft_type;
+  typedef ovxx::python::Block<1, C> B;
+  using ovxx::python::nogil;
+  using ovxx::python::async;
 
   bpl::class_<fft_type, std::unique_ptr<fft_type>, boost::noncopyable>
     fft("fft", bpl::no_init);
@@ -225,8 +235,10 @@ void define_complex_fft()
   fft.add_property("output_size", &fft_type::output_size);
   fft.add_property("scale", &fft_type::scale);
   fft.add_property("forward", &fft_type::forward);
-  fft.def("__call__", &fft_type::op);
-  fft.def("__call__", &fft_type::ip);
+  fft.def("__call__", nogil<fft_type, B const &, B &, &fft_type::op>);
+  fft.def("__call__", nogil<fft_type, B &, &fft_type::ip>);
+  fft.def("call_async", async<fft_type, B const &, B &, &fft_type::op>);
+  fft.def("call_async", async<fft_type, B &, &fft_type::ip>);
 
   bpl::class_<ifft_type, std::unique_ptr<ifft_type>, boost::noncopyable>
     ifft("ifft", bpl::no_init);
@@ -235,8 +247,10 @@ void define_complex_fft()
   ifft.add_property("output_size", &ifft_type::output_size);
   ifft.add_property("scale", &ifft_type::scale);
   ifft.add_property("forward", &ifft_type::forward);
-  ifft.def("__call__", &ifft_type::op);
-  ifft.def("__call__", &ifft_type::ip);
+  ifft.def("__call__", nogil<ifft_type, B const &, B &, &ifft_type::op>);
+  ifft.def("__call__", nogil<ifft_type, B &, &ifft_type::ip>);
+  ifft.def("call_async", async<ifft_type, B const &, B &, &ifft_type::op>);
+  ifft.def("call_async", async<ifft_type, B &, &ifft_type::ip>);
 }
 
 }
@@ -49,3 +49,13 @@ class fft:
         else:
             self._impl(input.block)
 
+    def call_async(self, input, output=None):
+        """Like __call__, but compute in the background.
+        Returns a future; its `wait()` method blocks until the
+        computation has completed."""
+
+        if output:
+            return self._impl.call_async(input.block, output.block)
+        else:
+            return self._impl.call_async(input.block)
+
@@ -9,6 +9,7 @@
 #define signal_fftm_hpp_
 
 #include <ovxx/python/block.hpp>
+#include <ovxx/python/gil.hpp>
 #include <vsip/signal.hpp>
 #include <ovxx/domain_utils.hpp>
 
@@ -227,6 +228,10 @@ void define_real_fftm()
   typedef vsip::complex<T> C;
   typedef fftm_base<T, C, vsip::fft_fwd> fftm_type;
   typedef fftm_base<C, T, vsip::fft_inv> ifftm_type;
+  typedef ovxx::python::Block<2, T> RB;
+  typedef ovxx::python::Block<2, C> CB;
+  using ovxx::python::nogil;
+  using ovxx::python::async;
 
   bpl::class_<fftm_type, std::unique_ptr<fftm_type>, boost::noncopyable>
     fftm("fftm", bpl::no_init);
@@ -236,7 +241,8 @@ void define_real_fftm()
   fftm.add_property("scale", &fftm_type::scale);
   fftm.add_property("forward", &fftm_type::forward);
   fftm.add_property("axis", &fftm_type::axis);
-  fftm.def("__call__", &fftm_type::op);
+  fftm.def("__call__", nogil<fftm_type, RB const &, CB &, &fftm_type::op>);
+  fftm.def("call_async", async<fftm_type, RB const &, CB &, &fftm_type::op>);
 
   bpl::class_<ifftm_type, std::unique_ptr<ifftm_type>, boost::noncopyable>
     ifftm("ifftm", bpl::no_init);
@@ -246,7 +252,8 @@ void define_real_fftm()
   ifftm.add_property("scale", &ifftm_type::scale);
   ifftm.add_property("forward", &ifftm_type::forward);
   ifftm.add_property("axis", &ifftm_type::axis);
-  ifftm.def("__call__", &ifftm_type::op);
+  ifftm.def("__call__", nogil<ifftm_type, CB const &, RB &, &ifftm_type::op>);
+  ifftm.def("call_async", async<ifftm_type, CB const &, RB &, &ifftm_type::op>);
 }
 
 template <typename T>
@@ -255,6 +262,9 @@ void define_complex_fftm()
   typedef vsip::complex<T> C;
   typedef fftm_base<C, C, vsip::fft_fwd> fftm_type;
   typedef fftm_base<C, C, vsip::fft_inv> ifftm_type;
+  typedef ovxx::python::Block<2, C> B;
+  using ovxx::python::nogil;
+  using ovxx::python::async;
 
   bpl::class_<fftm_type, std::unique_ptr<fftm_type>, boost::noncopyable>
     fftm("fftm", bpl::no_init);
@@ -264,8 +274,10 @@ void define_complex_fftm()
   fftm.add_property("scale", &fftm_type::scale);
   fftm.add_property("forward", &fftm_type::forward);
   fftm.add_property("axis", &fftm_type::axis);
-  fftm.def("__call__", &fftm_type::op);
-  fftm.def("__call__", &fftm_type::ip);
+  fftm.def("__call__", nogil<fftm_type, B const &, B &, &fftm_type::op>);
+  fftm.def("__call__", nogil<fftm_type, B &, &fftm_type::ip>);
+  fftm.def("call_async", async<fftm_type, B const &, B &, &fftm_type::op>);
+  fftm.def("call_async", async<fftm_type, B &, &fftm_type::ip>);
 
   bpl::class_<ifftm_type, std::unique_ptr<ifftm_type>, boost::noncopyable>
     ifftm("ifftm", bpl::no_init);
@@ -275,8 +287,10 @@ void define_complex_fftm()
   ifftm.add_property("scale", &ifftm_type::scale);
   ifftm.add_property("forward", &ifftm_type::forward);
   ifftm.add_property("axis", &ifftm_type::axis);
-  ifftm.def("__call__", &ifftm_type::op);
-  ifftm.def("__call__", &ifftm_type::ip);
+  ifftm.def("__call__", nogil<ifftm_type, B const &, B &, &ifftm_type::op>);
+  ifftm.def("__call__", nogil<ifftm_type, B &, &ifftm_type::ip>);
+  ifftm.def("call_async", async<ifftm_type, B const &, B &, &ifftm_type::op>);
+  ifftm.def("call_async", async<ifftm_type, B &, &ifftm_type::ip>);
 }
 }
 
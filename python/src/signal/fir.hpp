@@ -9,6 +9,7 @@
 #define signal_fir_hpp_
 
 #include <ovxx/python/block.hpp>
+#include <ovxx/python/gil.hpp>
 #include <vsip/signal.hpp>
 #include <ovxx/domain_utils.hpp>
 
@@ -101,6 +102,9 @@ template <typename T>
 void define_fir()
 {
   typedef fir_base<T> fir_type;
+  typedef ovxx::python::Block<1, T> B;
+  using ovxx::python::nogil;
+  using ovxx::python::async;
 
   bpl::class_<fir_type, std::unique_ptr<fir_type>, boost::noncopyable>
     fir("fir", bpl::no_init);
@@ -112,7 +116,8 @@ void define_fir()
   fir.add_property("symmetry", &fir_type::symmetry);
   fir.add_property("state", &fir_type::state);
   fir.def("reset", &fir_type::reset);
-  fir.def("__call__", &fir_type::op);
+  fir.def("__call__", nogil<fir_type, B const &, B &, &fir_type::op>);
+  fir.def("call_async", async<fir_type, B const &, B &, &fir_type::op>);
 }
 
 }
@@ -9,6 +9,7 @@
 #define signal_corr_hpp_
 
 #include <ovxx/python/block.hpp>
+#include <ovxx/python/gil.hpp>
 #include <vsip/signal.hpp>
 
 namespace pyvsip
@@ -71,6 +72,9 @@ template <typename T>
 void define_iir()
 {
   typedef iir_base<T> iir_type;
+  typedef ovxx::python::Block<1, T> B;
+  using ovxx::python::nogil;
+  using ovxx::python::async;
 
   bpl::class_<iir_type, std::unique_ptr<iir_type>, boost::noncopyable>
     iir("iir", bpl::no_init);
@@ -79,7 +83,8 @@ void define_iir()
   iir.add_property("input_size", &iir_type::input_size);
   iir.add_property("state", &iir_type::state);
   iir.def("reset", &iir_type::reset);
-  iir.def("__call__", &iir_type::op);
+  iir.def("__call__", nogil<iir_type, B const &, B &, &iir_type::op>);
+  iir.def("call_async", async<iir_type, B const &, B &, &iir_type::op>);
 }
 }
 
@@ -42,6 +42,13 @@ class iir:
 
         self._impl(input.block, output.block)
 
+    def call_async(self, input, output):
+        """Like __call__, but compute in the background.
+        Returns a future; its `wait()` method blocks until the
+        computation has completed."""
+
+        return self._impl.call_async(input.block, output.block)
+
     def reset(self):
 
         self._impl.reset()
@@ -16,7 +16,12 @@
 #include <ovxx/parallel/assign_fwd.hpp>
 #include <ovxx/dda.hpp>
 #include <ovxx/assign/copy.hpp>
+#include <ovxx/assign/transpose.hpp>
 #include <ovxx/assign/loop_fusion.hpp>
+#include <ovxx/assign/simd.hpp>
+#if OVXX_ENABLE_THREADING
+# include <ovxx/assign/threaded.hpp>
+#endif
 #ifdef OVXX_PARALLEL
 # include <ovxx/parallel/map_traits.hpp>
 # include <ovxx/parallel/expr.hpp>
@@ -58,6 +58,18 @@ transpose(T1 *lhs, stride_type lhs_col_stride,
       lhs[r+c*lhs_col_stride] = rhs[r*rhs_row_stride+c];
 }
 
+template <typename T>
+void
+transpose(std::pair<T*, T*> const &lhs, stride_type lhs_col_stride,
+	  std::pair<T const*, T const*> const &rhs, stride_type rhs_row_stride,
+	  length_type lhs_rows, length_type lhs_cols)
+{
+  transpose(lhs.first, lhs_col_stride, rhs.first, rhs_row_stride,
+	    lhs_rows, lhs_cols);
+  transpose(lhs.second, lhs_col_stride, rhs.second, rhs_row_stride,
+	    lhs_rows, lhs_cols);
+}
+
 template <typename T>
 void
 copy(T *lhs, stride_type lhs_stride,
@@ -9,6 +9,7 @@
 #define ovxx_assign_loop_fusion_hpp_
 
 #include <ovxx/expr/evaluate.hpp>
+#include <ovxx/expr/host.hpp>
 
 namespace ovxx
 {
@@ -170,6 +171,45 @@ struct loop_fusion<LHS, RHS, 3, tuple<2,1,0> >
   }
 };
 
+/// True if LHS and all leaves of RHS can be accessed through
+/// expr::Host_blocks.
+template <typename LHS, typename RHS>
+struct is_host_accessible
+{
+  static bool const value =
+    expr::is_host_accessible<LHS>::value &&
+    dda::Data<LHS, dda::out>::ct_cost == 0 &&
+    expr::is_host_accessible<RHS>::value;
+};
+
+/// Run the loop `L` (parametrized by LHS and RHS block types) on the
+/// blocks themselves, or, if possible, on Host_block proxies. The
+/// latter synchronize host storage once per evaluation, rather than
+/// once per element, and access elements through raw pointers.
+template <template <typename, typename> class L,
+	  typename LHS, typename RHS,
+	  bool H = is_host_accessible<LHS, RHS>::value>
+struct host_resident
+{
+  static void exec(LHS &lhs, RHS const &rhs) { L<LHS, RHS>::exec(lhs, rhs);}
+};
+
+template <template <typename, typename> class L, typename LHS, typename RHS>
+struct host_resident<L, LHS, RHS, true>
+{
+  typedef typename expr::host_type<RHS>::type rhs_type;
+  typedef expr::Host_block<LHS> lhs_type;
+
+  static void exec(LHS &lhs, RHS const &rhs)
+  {
+    // Acquire the operands for reading before acquiring the result
+    // for writing, as they may share storage.
+    rhs_type host_rhs = expr::host<expr::Host_block>(rhs);
+    lhs_type host_lhs(lhs);
+    L<lhs_type, rhs_type>::exec(host_lhs, host_rhs);
+  }
+};
+
 } // namespace ovxx::assignment
 
 namespace dispatcher
@@ -177,11 +217,15 @@ namespace dispatcher
 template <dimension_type D, typename LHS, typename RHS>
 struct Evaluator<op::assign<D>, be::loop_fusion, void(LHS &, RHS const &)>
 {
+  typedef typename get_block_layout<LHS>::order_type order_type;
+  template <typename L, typename R>
+  struct loop : assignment::loop_fusion<L, R, D, order_type> {};
+
   static bool const ct_valid = true;
   static std::string name() { return OVXX_DISPATCH_EVAL_NAME;}
   static bool rt_valid(LHS &, RHS const &) { return true;}  
   static void exec(LHS &lhs, RHS const &rhs)
-  { assignment::loop_fusion<LHS, RHS, D>::exec(lhs, rhs);}
+  { assignment::host_resident<loop, LHS, RHS>::exec(lhs, rhs);}
 };
 
 } // namespace ovxx::dispatcher
@@ -0,0 +1,385 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_assign_simd_hpp_
+#define ovxx_assign_simd_hpp_
+
+#include <ovxx/assign_fwd.hpp>
+#include <ovxx/simd/simd.hpp>
+#include <ovxx/expr/operations.hpp>
+#include <ovxx/expr/unary.hpp>
+#include <ovxx/expr/binary.hpp>
+#include <ovxx/expr/ternary.hpp>
+#include <ovxx/expr/scalar.hpp>
+#include <ovxx/complex_traits.hpp>
+#include <vsip/dda.hpp>
+#if OVXX_ENABLE_THREADING
+# include <ovxx/assign/threaded.hpp>
+#endif
+
+namespace ovxx
+{
+namespace simd
+{
+
+/// True if B is a (non-expression) block whose data can be accessed
+/// directly as an array of T in storage format F.
+template <typename B, typename T, storage_format_type F,
+	  bool E = is_expr_block<B>::value>
+struct is_leaf : false_type {};
+
+template <typename B, typename T, storage_format_type F>
+struct is_leaf<B, T, F, false>
+{
+  static bool const value =
+    is_same<typename B::value_type, T>::value &&
+    get_block_layout<B>::storage_format == F &&
+    dda::Data<B, dda::in>::ct_cost == 0;
+};
+
+/// True if B is a scalar block of type T.
+template <typename B, typename T>
+struct is_scalar : false_type {};
+template <typename B, typename T>
+struct is_scalar<B const, T> : is_scalar<B, T> {};
+template <typename T>
+struct is_scalar<expr::Scalar<1, T>, T> : true_type {};
+
+/// Common properties of the simd assignment evaluators.
+template <typename LHS>
+struct assign_traits
+{
+  typedef typename LHS::value_type value_type;
+  static storage_format_type const format =
+    get_block_layout<LHS>::storage_format;
+  typedef ops<value_type, format> ops_type;
+
+  static bool const ct_valid =
+    is_supported<value_type, format>::value &&
+    dda::Data<LHS, dda::out>::ct_cost == 0;
+
+  template <typename B>
+  struct leaf : is_leaf<B, value_type, format> {};
+};
+
+/// Return true if the block's data is unit-stride and of the given size.
+template <typename B>
+inline bool
+is_dense(B const &block, length_type size)
+{
+  dda::Data<B, dda::in> data(block);
+  return data.stride(0) == 1 && data.size(0) == size;
+}
+
+template <typename B>
+inline bool
+is_dense(B &block)
+{
+  dda::Data<B, dda::out> data(block);
+  return data.stride(0) == 1;
+}
+
+/// Kernel invocations on sub-ranges [i, i + n) of their operands.
+template <typename O, typename I, typename R>
+struct unary_task
+{
+  typedef void (*function_type)(I, R, length_type);
+  function_type f;
+  I a;
+  R r;
+  void operator()(index_type i, length_type n) const
+  { f(O::offset(a, i), r + i, n);}
+};
+
+template <typename O>
+struct binary_task
+{
+  typedef typename O::in_type I;
+  typedef typename O::out_type R;
+  typedef void (*function_type)(I, I, R, length_type);
+  function_type f;
+  I a, b;
+  R r;
+  void operator()(index_type i, length_type n) const
+  { f(O::offset(a, i), O::offset(b, i), O::offset(r, i), n);}
+};
+
+template <typename O>
+struct ternary_task
+{
+  typedef typename O::in_type I;
+  typedef typename O::out_type R;
+  typedef void (*function_type)(I, I, I, R, length_type);
+  function_type f;
+  I a, b, c;
+  R r;
+  void operator()(index_type i, length_type n) const
+  { f(O::offset(a, i), O::offset(b, i), O::offset(c, i), O::offset(r, i), n);}
+};
+
+template <typename O>
+struct conj_task
+{
+  typename O::in_type a;
+  typename O::out_type r;
+  void operator()(index_type i, length_type n) const
+  { O::vconj(O::offset(a, i), O::offset(r, i), n);}
+};
+
+template <typename O, typename T>
+struct scalar_task
+{
+  T s;
+  typename O::in_type b;
+  typename O::out_type r;
+  void operator()(index_type i, length_type n) const
+  { O::svmul(s, O::offset(b, i), O::offset(r, i), n);}
+};
+
+#if OVXX_ENABLE_THREADING
+template <typename T, typename F>
+class chunked
+{
+public:
+  chunked(F const &f, length_type size, unsigned int threads)
+    : f_(f), size_(size),
+      chunk_(assignment::chunk_size<T>(size, threads))
+  {}
+  length_type chunks() const { return (size_ + chunk_ - 1) / chunk_;}
+  void operator()(index_type c)
+  {
+    index_type const begin = c * chunk_;
+    f_(begin, std::min(chunk_, size_ - begin));
+  }
+private:
+  F const &f_;
+  length_type size_;
+  length_type chunk_;
+};
+#endif
+
+/// Run task over [0, size), splitting it across the default thread pool
+/// if that is worthwhile. T is the value-type of the destination.
+template <typename T, typename F>
+void
+run(F const &task, length_type size)
+{
+#if OVXX_ENABLE_THREADING
+  thread_pool *pool = thread_pool::get_default();
+  if (pool->size() > 1 && size >= thread_pool::threshold())
+  {
+    chunked<T, F> c(task, size, pool->size());
+    pool->parallel_for(c.chunks(), c);
+    return;
+  }
+#endif
+  task(0, size);
+}
+
+} // namespace ovxx::simd
+
+namespace dispatcher
+{
+
+/// A * B, s * B, A * s
+template <typename LHS, typename B1, typename B2>
+struct Evaluator<op::assign<1>, be::simd,
+		 void(LHS &, expr::Binary<expr::op::Mult, B1, B2, true> const &)>
+{
+  typedef expr::Binary<expr::op::Mult, B1, B2, true> RHS;
+  typedef simd::assign_traits<LHS> traits;
+  typedef typename traits::value_type T;
+  typedef typename traits::ops_type O;
+
+  static bool const vv =
+    traits::template leaf<B1>::value && traits::template leaf<B2>::value;
+  static bool const sv =
+    simd::is_scalar<B1, T>::value && traits::template leaf<B2>::value;
+  static bool const vs =
+    traits::template leaf<B1>::value && simd::is_scalar<B2, T>::value;
+
+  static bool const ct_valid = traits::ct_valid && (vv || sv || vs);
+
+  static std::string name() { return OVXX_DISPATCH_EVAL_NAME;}
+  static bool rt_valid(LHS &lhs, RHS const &rhs)
+  {
+    length_type size = lhs.size(1, 0);
+    return simd::is_dense(lhs) &&
+      (sv || simd::is_dense(rhs.arg1(), size)) &&
+      (vs || simd::is_dense(rhs.arg2(), size));
+  }
+  static void exec(LHS &lhs, RHS const &rhs)
+  {
+    exec(lhs, rhs, integral_constant<bool, sv>(), integral_constant<bool, vs>());
+  }
+
+private:
+  static void exec(LHS &lhs, RHS const &rhs, false_type, false_type)
+  {
+    dda::Data<LHS, dda::out> data_r(lhs);
+    dda::Data<B1, dda::in> data_a(rhs.arg1());
+    dda::Data<B2, dda::in> data_b(rhs.arg2());
+    simd::binary_task<O> task = {O::vmul, data_a.ptr(), data_b.ptr(), data_r.ptr()};
+    simd::run<T>(task, lhs.size(1, 0));
+  }
+  static void exec(LHS &lhs, RHS const &rhs, true_type, false_type)
+  {
+    dda::Data<LHS, dda::out> data_r(lhs);
+    dda::Data<B2, dda::in> data_b(rhs.arg2());
+    simd::scalar_task<O, T> task = {rhs.arg1().value(), data_b.ptr(), data_r.ptr()};
+    simd::run<T>(task, lhs.size(1, 0));
+  }
+  static void exec(LHS &lhs, RHS const &rhs, false_type, true_type)
+  {
+    dda::Data<LHS, dda::out> data_r(lhs);
+    dda::Data<B1, dda::in> data_a(rhs.arg1());
+    simd::scalar_task<O, T> task = {rhs.arg2().value(), data_a.ptr(), data_r.ptr()};
+    simd::run<T>(task, lhs.size(1, 0));
+  }
+};
+
+/// A + B
+template <typename LHS, typename B1, typename B2>
+struct Evaluator<op::assign<1>, be::simd,
+		 void(LHS &, expr::Binary<expr::op::Add, B1, B2, true> const &)>
+{
+  typedef expr::Binary<expr::op::Add, B1, B2, true> RHS;
+  typedef simd::assign_traits<LHS> traits;
+  typedef typename traits::value_type T;
+  typedef typename traits::ops_type O;
+
+  static bool const ct_valid =
+    traits::ct_valid &&
+    traits::template leaf<B1>::value &&
+    traits::template leaf<B2>::value;
+
+  static std::string name() { return OVXX_DISPATCH_EVAL_NAME;}
+  static bool rt_valid(LHS &lhs, RHS const &rhs)
+  {
+    length_type size = lhs.size(1, 0);
+    return simd::is_dense(lhs) &&
+      simd::is_dense(rhs.arg1(), size) &&
+      simd::is_dense(rhs.arg2(), size);
+  }
+  static void exec(LHS &lhs, RHS const &rhs)
+  {
+    dda::Data<LHS, dda::out> data_r(lhs);
+    dda::Data<B1, dda::in> data_a(rhs.arg1());
+    dda::Data<B2, dda::in> data_b(rhs.arg2());
+    simd::binary_task<O> task = {O::vadd, data_a.ptr(), data_b.ptr(), data_r.ptr()};
+    simd::run<T>(task, lhs.size(1, 0));
+  }
+};
+
+/// A * B + C (ma), (A + B) * C (am)
+template <typename LHS,
+	  template <typename, typename, typename> class Op,
+	  typename B1, typename B2, typename B3>
+struct Evaluator<op::assign<1>, be::simd,
+		 void(LHS &, expr::Ternary<Op, B1, B2, B3, true> const &)>
+{
+  typedef expr::Ternary<Op, B1, B2, B3, true> RHS;
+  typedef simd::assign_traits<LHS> traits;
+  typedef typename traits::value_type T;
+  typedef typename traits::ops_type O;
+
+  static bool const is_ma = is_same<Op<T, T, T>, expr::op::Ma<T, T, T> >::value;
+  static bool const is_am = is_same<Op<T, T, T>, expr::op::Am<T, T, T> >::value;
+
+  static bool const ct_valid =
+    traits::ct_valid && (is_ma || is_am) &&
+    traits::template leaf<B1>::value &&
+    traits::template leaf<B2>::value &&
+    traits::template leaf<B3>::value;
+
+  static std::string name() { return OVXX_DISPATCH_EVAL_NAME;}
+  static bool rt_valid(LHS &lhs, RHS const &rhs)
+  {
+    length_type size = lhs.size(1, 0);
+    return simd::is_dense(lhs) &&
+      simd::is_dense(rhs.arg1(), size) &&
+      simd::is_dense(rhs.arg2(), size) &&
+      simd::is_dense(rhs.arg3(), size);
+  }
+  static void exec(LHS &lhs, RHS const &rhs)
+  {
+    dda::Data<LHS, dda::out> data_r(lhs);
+    dda::Data<B1, dda::in> data_a(rhs.arg1());
+    dda::Data<B2, dda::in> data_b(rhs.arg2());
+    dda::Data<B3, dda::in> data_c(rhs.arg3());
+    simd::ternary_task<O> task =
+      {is_ma ? O::vma : O::vam,
+       data_a.ptr(), data_b.ptr(), data_c.ptr(), data_r.ptr()};
+    simd::run<T>(task, lhs.size(1, 0));
+  }
+};
+
+/// magsq(A)
+template <typename LHS, typename B>
+struct Evaluator<op::assign<1>, be::simd,
+		 void(LHS &, expr::Unary<expr::op::Magsq, B, true> const &)>
+{
+  typedef expr::Unary<expr::op::Magsq, B, true> RHS;
+  typedef typename B::value_type T;
+  static storage_format_type const format = get_block_layout<B>::storage_format;
+  typedef simd::ops<T, format> O;
+
+  static bool const ct_valid =
+    simd::is_supported<T, format>::value &&
+    simd::is_leaf<B, T, format>::value &&
+    simd::is_supported<typename LHS::value_type,
+		       get_block_layout<LHS>::storage_format>::value &&
+    is_same<typename LHS::value_type, float>::value &&
+    dda::Data<LHS, dda::out>::ct_cost == 0;
+
+  static std::string name() { return OVXX_DISPATCH_EVAL_NAME;}
+  static bool rt_valid(LHS &lhs, RHS const &rhs)
+  {
+    return simd::is_dense(lhs) && simd::is_dense(rhs.arg(), lhs.size(1, 0));
+  }
+  static void exec(LHS &lhs, RHS const &rhs)
+  {
+    dda::Data<LHS, dda::out> data_r(lhs);
+    dda::Data<B, dda::in> data_a(rhs.arg());
+    simd::unary_task<O, typename O::in_type, float *> task =
+      {O::vmagsq, data_a.ptr(), data_r.ptr()};
+    simd::run<float>(task, lhs.size(1, 0));
+  }
+};
+
+/// conj(A)
+template <typename LHS, typename B>
+struct Evaluator<op::assign<1>, be::simd,
+		 void(LHS &, expr::Unary<expr::op::Conj, B, true> const &)>
+{
+  typedef expr::Unary<expr::op::Conj, B, true> RHS;
+  typedef simd::assign_traits<LHS> traits;
+  typedef typename traits::value_type T;
+  typedef typename traits::ops_type O;
+
+  static bool const ct_valid =
+    traits::ct_valid && is_complex<T>::value &&
+    traits::template leaf<B>::value;
+
+  static std::string name() { return OVXX_DISPATCH_EVAL_NAME;}
+  static bool rt_valid(LHS &lhs, RHS const &rhs)
+  {
+    return simd::is_dense(lhs) && simd::is_dense(rhs.arg(), lhs.size(1, 0));
+  }
+  static void exec(LHS &lhs, RHS const &rhs)
+  {
+    dda::Data<LHS, dda::out> data_r(lhs);
+    dda::Data<B, dda::in> data_a(rhs.arg());
+    simd::conj_task<O> task = {data_a.ptr(), data_r.ptr()};
+    simd::run<T>(task, lhs.size(1, 0));
+  }
+};
+
+} // namespace ovxx::dispatcher
+} // namespace ovxx
+
+#endif
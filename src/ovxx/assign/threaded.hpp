@@ -0,0 +1,272 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_assign_threaded_hpp_
+#define ovxx_assign_threaded_hpp_
+
+#include <ovxx/expr/evaluate.hpp>
+#include <ovxx/assign/loop_fusion.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <vsip/dda.hpp>
+#include <algorithm>
+
+namespace ovxx
+{
+namespace assignment
+{
+
+/// True if B is an elementwise expression block, i.e. one whose
+/// elements may be computed independently of each other.
+template <typename B>
+struct is_elementwise_expr : false_type {};
+
+template <typename B>
+struct is_elementwise_expr<B const> : is_elementwise_expr<B> {};
+
+template <template <typename> class O, typename B>
+struct is_elementwise_expr<expr::Unary<O, B, true> > : true_type {};
+
+template <template <typename, typename> class O, typename B1, typename B2>
+struct is_elementwise_expr<expr::Binary<O, B1, B2, true> > : true_type {};
+
+template <template <typename, typename, typename> class O,
+	  typename B1, typename B2, typename B3>
+struct is_elementwise_expr<expr::Ternary<O, B1, B2, B3, true> > : true_type {};
+
+/// Return the number of elements of type T each of `threads` threads
+/// should process out of `size`. The result is rounded up to a
+/// multiple of the cache-line size (or the page size, for large chunks),
+/// so threads don't compete for the same lines or pages.
+template <typename T>
+length_type
+chunk_size(length_type size, unsigned int threads)
+{
+  length_type const line = std::max<length_type>(64 / sizeof(T), 1);
+  length_type const page = std::max<length_type>(4096 / sizeof(T), 1);
+  length_type chunk = (size + threads - 1) / threads;
+  length_type const grain = chunk >= page ? page : line;
+  return (chunk + grain - 1) / grain * grain;
+}
+
+/// Evaluate an elementwise assignment in chunks. Multi-dimensional
+/// blocks are chunked like one-dimensional ones, by the offset of their
+/// elements in storage order. Chunks thus start on cache-line (or page)
+/// boundaries along the minor dimension, rather than on whole rows, so
+/// threads neither compete for the lines at chunk boundaries nor get
+/// unbalanced work if the major dimension is short.
+template <typename LHS, typename RHS,
+	  dimension_type D = LHS::dim,
+	  typename O = typename get_block_layout<LHS>::order_type>
+class threaded;
+
+template <typename LHS, typename RHS, typename O>
+class threaded<LHS, RHS, 1, O>
+{
+public:
+  threaded(LHS &lhs, RHS const &rhs, unsigned int threads)
+    : lhs_(lhs), rhs_(rhs), size_(lhs.size(1, 0)),
+      chunk_(chunk_size<typename LHS::value_type>(size_, threads))
+  {}
+
+  length_type chunks() const { return (size_ + chunk_ - 1) / chunk_;}
+
+  void operator()(index_type c)
+  {
+    index_type const begin = c * chunk_;
+    index_type const end = std::min(begin + chunk_, size_);
+    for (index_type i = begin; i < end; ++i)
+      lhs_.put(i, rhs_.get(i));
+  }
+
+private:
+  LHS &lhs_;
+  RHS const &rhs_;
+  length_type size_;
+  length_type chunk_;
+};
+
+template <typename LHS, typename RHS, typename O>
+class threaded<LHS, RHS, 2, O>
+{
+  static dimension_type const dim0 = O::impl_dim0;
+  static dimension_type const dim1 = O::impl_dim1;
+
+public:
+  threaded(LHS &lhs, RHS const &rhs, unsigned int threads)
+    : lhs_(lhs), rhs_(rhs),
+      size0_(lhs.size(2, dim0)), size1_(lhs.size(2, dim1)),
+      chunk_(chunk_size<typename LHS::value_type>(size0_ * size1_, threads))
+  {}
+
+  length_type chunks() const
+  { return (size0_ * size1_ + chunk_ - 1) / chunk_;}
+
+  void operator()(index_type c)
+  {
+    index_type const begin = c * chunk_;
+    index_type const end = std::min(begin + chunk_, size0_ * size1_);
+    index_type i[2];
+    i[dim0] = begin / size1_;
+    index_type first = begin % size1_;
+    for (index_type n = begin; n < end; ++i[dim0], first = 0)
+    {
+      index_type const last = std::min(size1_, first + (end - n));
+      for (i[dim1] = first; i[dim1] < last; ++i[dim1])
+	lhs_.put(i[0], i[1], rhs_.get(i[0], i[1]));
+      n += last - first;
+    }
+  }
+
+private:
+  LHS &lhs_;
+  RHS const &rhs_;
+  length_type size0_;
+  length_type size1_;
+  length_type chunk_;
+};
+
+template <typename LHS, typename RHS, typename O>
+class threaded<LHS, RHS, 3, O>
+{
+  static dimension_type const dim0 = O::impl_dim0;
+  static dimension_type const dim1 = O::impl_dim1;
+  static dimension_type const dim2 = O::impl_dim2;
+
+public:
+  threaded(LHS &lhs, RHS const &rhs, unsigned int threads)
+    : lhs_(lhs), rhs_(rhs),
+      size0_(lhs.size(3, dim0)),
+      size1_(lhs.size(3, dim1)),
+      size2_(lhs.size(3, dim2)),
+      chunk_(chunk_size<typename LHS::value_type>(size0_ * size1_ * size2_,
+						  threads))
+  {}
+
+  length_type chunks() const
+  { return (size0_ * size1_ * size2_ + chunk_ - 1) / chunk_;}
+
+  void operator()(index_type c)
+  {
+    index_type const begin = c * chunk_;
+    index_type const end = std::min(begin + chunk_, size0_ * size1_ * size2_);
+    index_type i[3];
+    index_type line = begin / size2_;
+    index_type first = begin % size2_;
+    for (index_type n = begin; n < end; ++line, first = 0)
+    {
+      i[dim0] = line / size1_;
+      i[dim1] = line % size1_;
+      index_type const last = std::min(size2_, first + (end - n));
+      for (i[dim2] = first; i[dim2] < last; ++i[dim2])
+	lhs_.put(i[0], i[1], i[2], rhs_.get(i[0], i[1], i[2]));
+      n += last - first;
+    }
+  }
+
+private:
+  LHS &lhs_;
+  RHS const &rhs_;
+  length_type size0_;
+  length_type size1_;
+  length_type size2_;
+  length_type chunk_;
+};
+
+/// Run the loop `D` on Dense_host_block proxies if LHS and all leaves
+/// of RHS are stored densely in dimension order O, and otherwise the
+/// loop `L` as host_resident does. Dense proxies access elements by
+/// their offset, and so may be traversed as a single one-dimensional
+/// array, whatever their dimension.
+template <template <typename, typename> class L,
+	  template <typename, typename> class D,
+	  typename O, typename LHS, typename RHS,
+	  bool H = is_host_accessible<LHS, RHS>::value>
+struct dense_resident
+{
+  static void exec(LHS &lhs, RHS const &rhs) { L<LHS, RHS>::exec(lhs, rhs);}
+};
+
+template <template <typename, typename> class L,
+	  template <typename, typename> class D,
+	  typename O, typename LHS, typename RHS>
+struct dense_resident<L, D, O, LHS, RHS, true>
+{
+  typedef typename expr::host_type<RHS, expr::Dense_host_block>::type rhs_type;
+  typedef expr::Dense_host_block<LHS> lhs_type;
+
+  static void exec(LHS &lhs, RHS const &rhs)
+  {
+    if (expr::is_dense<O>(lhs) && expr::is_dense<O>(rhs))
+    {
+      // See host_resident for the order of acquisition.
+      rhs_type dense_rhs = expr::host<expr::Dense_host_block>(rhs);
+      lhs_type dense_lhs(lhs);
+      D<lhs_type, rhs_type>::exec(dense_lhs, dense_rhs);
+    }
+    else
+      host_resident<L, LHS, RHS>::exec(lhs, rhs);
+  }
+};
+
+} // namespace ovxx::assignment
+
+namespace dispatcher
+{
+
+/// Split elementwise expression assignments across the default
+/// thread pool, if they are large enough to amortize the fork / join
+/// overhead (see thread_pool::threshold()).
+template <dimension_type D, typename LHS, typename RHS>
+struct Evaluator<op::assign<D>, be::threaded, void(LHS &, RHS const &)>
+{
+  typedef typename get_block_layout<LHS>::order_type order_type;
+  template <typename L, typename R, dimension_type Dim, typename O>
+  struct chunked_loop
+  {
+    static void exec(L &lhs, R const &rhs)
+    {
+      thread_pool *pool = thread_pool::get_default();
+      assignment::threaded<L, R, Dim, O> task(lhs, rhs, pool->size());
+      pool->parallel_for(task.chunks(), task);
+    }
+  };
+  template <typename L, typename R>
+  struct loop : chunked_loop<L, R, D, order_type> {};
+  template <typename L, typename R>
+  struct dense_loop : chunked_loop<L, R, 1, row1_type> {};
+
+#if OVXX_HAVE_OPENCL
+  // Element access may need to synchronize with device memory,
+  // which can't be done concurrently. Host_blocks synchronize
+  // up-front, in the calling thread.
+  static bool const ct_valid =
+    assignment::is_elementwise_expr<RHS>::value &&
+    assignment::is_host_accessible<LHS, RHS>::value;
+#else
+  static bool const ct_valid =
+    assignment::is_elementwise_expr<RHS>::value &&
+    dda::Data<LHS, dda::out>::ct_cost == 0;
+#endif
+
+  static std::string name() { return OVXX_DISPATCH_EVAL_NAME;}
+  static bool rt_valid(LHS &lhs, RHS const &)
+  {
+    return thread_pool::get_default()->size() > 1 &&
+      lhs.size() >= thread_pool::threshold();
+  }
+  static void exec(LHS &lhs, RHS const &rhs)
+  {
+    expr::evaluate(rhs);
+    assignment::dense_resident<loop, dense_loop, order_type, LHS, RHS>
+      ::exec(lhs, rhs);
+  }
+};
+
+} // namespace ovxx::dispatcher
+} // namespace ovxx
+
+#endif
@@ -0,0 +1,333 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_assign_transpose_hpp_
+#define ovxx_assign_transpose_hpp_
+
+#include <ovxx/assign_fwd.hpp>
+#include <ovxx/assign/copy.hpp>
+#include <ovxx/is_same_ptr.hpp>
+#include <ovxx/simd/simd.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <vsip/dda.hpp>
+#include <vector>
+#include <algorithm>
+
+namespace ovxx
+{
+namespace assignment
+{
+namespace detail
+{
+/// Transpose micro-kernels: b[c * ldb + r] = a[r * lda + c].
+/// Element types of 32 and 64 bits use the SIMD kernels, which
+/// transpose register-sized tiles.
+template <typename T>
+struct transpose_kernel
+{
+  static void exec(T const *a, stride_type lda, T *b, stride_type ldb,
+		   length_type rows, length_type cols)
+  {
+    for (index_type r = 0; r != rows; ++r)
+      for (index_type c = 0; c != cols; ++c)
+	b[c * ldb + r] = a[r * lda + c];
+  }
+};
+
+template <>
+struct transpose_kernel<float>
+{
+  static void exec(float const *a, stride_type lda, float *b, stride_type ldb,
+		   length_type rows, length_type cols)
+  { simd::get_kernels().transpose32(a, lda, b, ldb, rows, cols);}
+};
+
+template <>
+struct transpose_kernel<double>
+{
+  static void exec(double const *a, stride_type lda, double *b, stride_type ldb,
+		   length_type rows, length_type cols)
+  { simd::get_kernels().transpose64(a, lda, b, ldb, rows, cols);}
+};
+
+template <>
+struct transpose_kernel<complex<float> >
+{
+  static void exec(complex<float> const *a, stride_type lda,
+		   complex<float> *b, stride_type ldb,
+		   length_type rows, length_type cols)
+  {
+    simd::get_kernels().transpose64(reinterpret_cast<double const *>(a), lda,
+				    reinterpret_cast<double *>(b), ldb,
+				    rows, cols);
+  }
+};
+
+/// The side of the (square) tiles the transpose is blocked into, chosen
+/// so that a source and a destination tile fit into L1 cache.
+template <typename T>
+struct transpose_tile
+{
+  static length_type const value = sizeof(T) <= 8 ? 64 : 32;
+};
+
+// Transpose the band of tiles starting at row `band * tile` of a.
+template <typename T>
+struct transpose_task
+{
+  T const *a;
+  stride_type lda;
+  T *b;
+  stride_type ldb;
+  length_type rows;
+  length_type cols;
+
+  void operator()(index_type band) const
+  {
+    length_type const tile = transpose_tile<T>::value;
+    index_type const r = band * tile;
+    length_type const nr = std::min(tile, rows - r);
+    for (index_type c = 0; c < cols; c += tile)
+      transpose_kernel<T>::exec(a + r * lda + c, lda, b + c * ldb + r, ldb,
+				nr, std::min(tile, cols - c));
+  }
+};
+
+// Swap tile (band, j) with the transpose of tile (j, band), for all j >= band,
+// in a square matrix.
+template <typename T>
+struct swap_task
+{
+  T *a;
+  stride_type lda;
+  length_type size;
+
+  void operator()(index_type band) const
+  {
+    length_type const tile = transpose_tile<T>::value;
+    std::vector<T> upper(tile * tile), lower(tile * tile);
+    index_type const r = band * tile;
+    length_type const nr = std::min(tile, size - r);
+    for (index_type c = r; c < size; c += tile)
+    {
+      length_type const nc = std::min(tile, size - c);
+      // upper = (r, c)^T (nc x nr), lower = (c, r)^T (nr x nc)
+      transpose_kernel<T>::exec(a + r * lda + c, lda, &upper[0], nr, nr, nc);
+      if (c != r)
+      {
+	transpose_kernel<T>::exec(a + c * lda + r, lda, &lower[0], nc, nc, nr);
+	for (index_type i = 0; i != nr; ++i)
+	  std::copy(&lower[i * nc], &lower[i * nc] + nc, a + (r + i) * lda + c);
+      }
+      for (index_type i = 0; i != nc; ++i)
+	std::copy(&upper[i * nr], &upper[i * nr] + nr, a + (c + i) * lda + r);
+    }
+  }
+};
+
+// Interleaved-complex data is accessed through a pointer to the
+// scalar type, while strides count complex values.
+template <typename T, typename P>
+struct element_ptr
+{
+  typedef P type;
+  static type cast(P ptr) { return ptr;}
+};
+
+template <typename T>
+struct element_ptr<complex<T>, T *>
+{
+  typedef complex<T> *type;
+  static type cast(T *ptr) { return reinterpret_cast<type>(ptr);}
+};
+
+template <typename T>
+struct element_ptr<complex<T>, T const *>
+{
+  typedef complex<T> const *type;
+  static type cast(T const *ptr) { return reinterpret_cast<type>(ptr);}
+};
+
+template <typename T, typename F>
+void run_bands(F &task, length_type rows, length_type size)
+{
+  length_type const tile = transpose_tile<T>::value;
+  length_type const bands = (rows + tile - 1) / tile;
+  thread_pool *pool = thread_pool::get_default();
+  if (pool->size() > 1 && bands > 1 && size >= thread_pool::threshold())
+    pool->parallel_for(bands, task);
+  else
+    for (index_type b = 0; b != bands; ++b)
+      task(b);
+}
+
+} // namespace ovxx::assignment::detail
+
+/// Transpose the `rows` x `cols` matrix `a` (with unit column stride)
+/// into `b` (with unit row stride), i.e. b[c * ldb + r] = a[r * lda + c].
+///
+/// The matrix is blocked into tiles that fit into cache, each of which
+/// is transposed using SIMD micro-kernels. Bands of tiles are
+/// distributed across the default thread pool.
+template <typename T>
+void
+transpose_tiled(T const *a, stride_type lda, T *b, stride_type ldb,
+		length_type rows, length_type cols)
+{
+  detail::transpose_task<T> task = {a, lda, b, ldb, rows, cols};
+  detail::run_bands<T>(task, rows, rows * cols);
+}
+
+template <typename T>
+void
+transpose_tiled(std::pair<T const *, T const *> const &a, stride_type lda,
+		std::pair<T *, T *> const &b, stride_type ldb,
+		length_type rows, length_type cols)
+{
+  transpose_tiled(a.first, lda, b.first, ldb, rows, cols);
+  transpose_tiled(a.second, lda, b.second, ldb, rows, cols);
+}
+
+/// Transpose the square `size` x `size` matrix `a` in place.
+template <typename T>
+void
+transpose_square_in_place(T *a, stride_type lda, length_type size)
+{
+  detail::swap_task<T> task = {a, lda, size};
+  detail::run_bands<T>(task, size, size * size);
+}
+
+/// Transpose the dense, row-major `rows` x `cols` matrix `a` in place,
+/// so it becomes the row-major `cols` x `rows` matrix. Each cycle of
+/// the permutation is followed once, keeping track of the visited
+/// elements in a bitmap.
+template <typename T>
+void
+transpose_in_place(T *a, length_type rows, length_type cols)
+{
+  if (rows == cols)
+    return transpose_square_in_place(a, static_cast<stride_type>(cols), rows);
+
+  length_type const size = rows * cols;
+  std::vector<bool> visited(size);
+  // The first and last elements stay in place.
+  for (index_type start = 1; start + 1 < size; ++start)
+  {
+    if (visited[start]) continue;
+    T value = a[start];
+    index_type i = start;
+    do
+    {
+      // Element (r, c) = (i / cols, i % cols) moves to c * rows + r.
+      index_type next = (i % cols) * rows + i / cols;
+      std::swap(value, a[next]);
+      visited[next] = true;
+      i = next;
+    }
+    while (i != start);
+  }
+}
+
+template <typename T>
+void
+transpose_in_place(std::pair<T *, T *> const &a, length_type rows, length_type cols)
+{
+  transpose_in_place(a.first, rows, cols);
+  transpose_in_place(a.second, rows, cols);
+}
+
+template <typename T>
+void
+transpose_square_in_place(std::pair<T *, T *> const &a, stride_type lda,
+			  length_type size)
+{
+  transpose_square_in_place(a.first, lda, size);
+  transpose_square_in_place(a.second, lda, size);
+}
+
+} // namespace ovxx::assignment
+
+namespace dispatcher
+{
+
+/// 2D assignment between blocks of different dimension-ordering,
+/// i.e. a (possibly in-place) transpose.
+template <typename LHS, typename RHS>
+struct Evaluator<op::assign<2>, be::transpose, void(LHS &, RHS const &)>
+{
+  static std::string name() { return OVXX_DISPATCH_EVAL_NAME;}
+
+  typedef typename LHS::value_type lhs_value_type;
+  typedef typename RHS::value_type rhs_value_type;
+
+  typedef typename get_block_layout<LHS>::order_type lhs_order_type;
+  typedef typename get_block_layout<RHS>::order_type rhs_order_type;
+
+  static bool const ct_valid =
+    is_same<rhs_value_type, lhs_value_type>::value &&
+    !is_expr_block<RHS>::value &&
+    dda::Data<LHS, dda::out>::ct_cost == 0 &&
+    dda::Data<RHS, dda::in>::ct_cost == 0 &&
+    is_split_block<LHS>::value == is_split_block<RHS>::value &&
+    !is_same<lhs_order_type, rhs_order_type>::value;
+
+  static bool rt_valid(LHS &, RHS const &) { return true;}
+
+  static void exec(LHS &lhs, RHS const &rhs)
+  {
+    typedef dda::Data<LHS, dda::out> lhs_data_type;
+    typedef dda::Data<RHS, dda::in> rhs_data_type;
+    typedef assignment::detail::element_ptr<lhs_value_type,
+      typename lhs_data_type::ptr_type> lhs_ptr;
+    typedef assignment::detail::element_ptr<rhs_value_type,
+      typename rhs_data_type::ptr_type> rhs_ptr;
+
+    lhs_data_type lhs_data(lhs);
+    rhs_data_type rhs_data(rhs);
+    typename lhs_ptr::type b = lhs_ptr::cast(lhs_data.ptr());
+    typename rhs_ptr::type a = rhs_ptr::cast(rhs_data.ptr());
+
+    length_type const rows = lhs_data.size(0);
+    length_type const cols = lhs_data.size(1);
+    // The major (outer) and minor dimensions of each side.
+    dimension_type const lhs_minor = lhs_order_type::impl_dim1;
+    dimension_type const rhs_minor = rhs_order_type::impl_dim1;
+    // Express the assignment as b[j * ldb + i] = a[i * lda + j],
+    // with a (n x m) the source.
+    length_type const n = rhs_minor == 1 ? rows : cols;
+    length_type const m = rhs_minor == 1 ? cols : rows;
+    stride_type const lda = rhs_data.stride(1 - rhs_minor);
+    stride_type const ldb = lhs_data.stride(1 - lhs_minor);
+
+    if (is_same_ptr(b, a))
+    {
+      if (rows == cols)
+      {
+	OVXX_PRECONDITION(lda == ldb);
+	assignment::transpose_square_in_place(b, lda, rows);
+      }
+      else
+      {
+	// Only dense storage can be transposed in place.
+	OVXX_PRECONDITION(lda == static_cast<stride_type>(m) &&
+			  ldb == static_cast<stride_type>(n));
+	assignment::transpose_in_place(b, n, m);
+      }
+    }
+    else if (lhs_data.stride(lhs_minor) == 1 && rhs_data.stride(rhs_minor) == 1)
+      assignment::transpose_tiled(a, lda, b, ldb, n, m);
+    else
+      assignment::copy(b, lhs_data.stride(0), lhs_data.stride(1),
+		       a, rhs_data.stride(0), rhs_data.stride(1),
+		       rows, cols);
+  }
+};
+
+} // namespace ovxx::dispatcher
+} // namespace ovxx
+
+#endif
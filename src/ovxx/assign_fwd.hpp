@@ -52,9 +52,11 @@ struct List<op::assign<D> >
   typedef make_type_list<be::user,
 			 be::cuda,
 			 be::dense_expr,
+			 be::transpose,
 			 be::copy,
 			 be::op_expr,
 			 be::simd,
+			 be::threaded,
 			 be::fc_expr,
 			 be::rbo_expr,
 			 be::mdim_expr,
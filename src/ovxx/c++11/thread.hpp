@@ -27,10 +27,14 @@ public:
   }
   ~mutex() { pthread_mutex_destroy(&mutex_);}
   void lock() { pthread_mutex_lock(&mutex_);}
+  bool try_lock() { return pthread_mutex_trylock(&mutex_) == 0;}
   void unlock() { pthread_mutex_unlock(&mutex_);}
-
+  pthread_mutex_t *native_handle() { return &mutex_;}
 
 private:
+  mutex(mutex const &);
+  mutex &operator=(mutex const &);
+
   pthread_mutex_t mutex_;
 };
 
@@ -48,6 +52,45 @@ private:
   L &l_;
 };
 
+template <typename L>
+class unique_lock
+{
+public:
+  explicit unique_lock(L &l) : l_(l) { l_.lock();}
+  ~unique_lock() { l_.unlock();}
+  L *mutex() const { return &l_;}
+
+private:
+  unique_lock(unique_lock const &);
+  unique_lock& operator=(unique_lock const &);
+
+  L &l_;
+};
+
+class condition_variable
+{
+public:
+  condition_variable()
+  {
+    if (pthread_cond_init(&cond_, 0))
+      throw std::bad_alloc();
+  }
+  ~condition_variable() { pthread_cond_destroy(&cond_);}
+  void notify_one() { pthread_cond_signal(&cond_);}
+  void notify_all() { pthread_cond_broadcast(&cond_);}
+  void wait(unique_lock<mutex> &l)
+  { pthread_cond_wait(&cond_, l.mutex()->native_handle());}
+  template <typename P>
+  void wait(unique_lock<mutex> &l, P pred)
+  { while (!pred()) wait(l);}
+
+private:
+  condition_variable(condition_variable const &);
+  condition_variable &operator=(condition_variable const &);
+
+  pthread_cond_t cond_;
+};
+
 class thread
 {
   struct callable_base
@@ -55,10 +55,21 @@
 #define OVXX_UNUSED /* empty */
 #endif
 
-#ifdef OVXX_HAVE_MPI
+#if defined(OVXX_HAVE_MPI) || defined(OVXX_HAVE_SHM)
 # define OVXX_PARALLEL 1
 #endif
 
+// Set if there is an FFT backend (other than the no_fft dummy)
+// for single- and double-precision values, respectively.
+#if OVXX_DFT_FFT || OVXX_FFTW_HAVE_FLOAT || \
+    (OVXX_CVSIP_FFT && OVXX_CVSIP_HAVE_FLOAT)
+# define OVXX_FFT_HAVE_FLOAT 1
+#endif
+#if OVXX_DFT_FFT || OVXX_FFTW_HAVE_DOUBLE || \
+    (OVXX_CVSIP_FFT && OVXX_CVSIP_HAVE_DOUBLE)
+# define OVXX_FFT_HAVE_DOUBLE 1
+#endif
+
 #ifndef OVXX_TUNE_MODE
 /// Setting TUNE_MODE to 1 disables the tunable_thresholds.  This
 /// allows benchmarks to be run without thresholds to determine
@@ -115,11 +115,13 @@ OVXX_BE_NAME(blas)
 OVXX_BE_NAME(dense_expr)
 OVXX_BE_NAME(copy)
 OVXX_BE_NAME(op_expr)
+OVXX_BE_NAME(threaded)
 OVXX_BE_NAME(simd)
 OVXX_BE_NAME(fc_expr)
 OVXX_BE_NAME(rbo_expr)
 OVXX_BE_NAME(mdim_expr)
 OVXX_BE_NAME(loop_fusion)
+OVXX_BE_NAME(fft_based)
 OVXX_BE_NAME(cvsip)
 OVXX_BE_NAME(opt)
 OVXX_BE_NAME(generic)
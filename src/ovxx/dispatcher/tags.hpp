@@ -28,6 +28,8 @@ struct dense_expr;
 struct copy;
 /// Special expr handling (vmmul, etc)
 struct op_expr;
+/// Multi-threaded elementwise expression evaluation.
+struct threaded;
 /// SIMD.
 struct simd;
 /// Fused Fastconv RBO evaluator.
@@ -42,6 +44,8 @@ struct loop_fusion;
 struct fftw;
 /// Dummy FFT
 struct no_fft;
+/// FFT-based convolution and correlation.
+struct fft_based;
 
 /// BLAS implementation (ATLAS, MKL, etc)
 struct blas;
@@ -0,0 +1,324 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_expr_host_hpp_
+#define ovxx_expr_host_hpp_
+
+#include <ovxx/expr/unary.hpp>
+#include <ovxx/expr/binary.hpp>
+#include <ovxx/expr/ternary.hpp>
+#include <ovxx/expr/scalar.hpp>
+#include <ovxx/storage/traits.hpp>
+#include <ovxx/pointer.hpp>
+#include <vsip/dda.hpp>
+
+namespace ovxx
+{
+namespace expr
+{
+
+/// A proxy for a block with direct data access, reading (and,
+/// unless B is const, writing) the block's host storage through
+/// a raw pointer.
+///
+/// Constructing a Host_block synchronizes the block's host storage
+/// once, so element access doesn't need to. The proxy is thus only
+/// valid as long as the block's data isn't accessed in any other
+/// location, i.e. for the duration of a single evaluation.
+template <typename B>
+class Host_block
+{
+  typedef typename remove_const<B>::type block_type;
+  static storage_format_type const storage_format =
+    get_block_layout<block_type>::storage_format;
+  typedef storage_traits<typename block_type::value_type, storage_format> storage;
+
+public:
+  static dimension_type const dim = block_type::dim;
+  typedef typename block_type::value_type value_type;
+  typedef value_type &reference_type;
+  typedef value_type const &const_reference_type;
+  typedef typename block_type::map_type map_type;
+  typedef typename conditional<is_const<B>::value,
+			       typename storage::const_ptr_type,
+			       typename storage::ptr_type>::type ptr_type;
+
+  Host_block(B &block)
+    : block_(block),
+      ptr_(pointer_cast<ptr_type>(block.ptr()))
+  {
+    for (dimension_type d = 0; d != dim; ++d)
+    {
+      size_[d] = block.size(dim, d);
+      stride_[d] = block.stride(dim, d);
+    }
+  }
+
+  length_type size() const VSIP_NOTHROW { return block_.size();}
+  length_type size(dimension_type block_dim, dimension_type d) const VSIP_NOTHROW
+  {
+    if (block_dim == 1) return size();
+    else return size_[d];
+  }
+  void increment_count() const VSIP_NOTHROW {}
+  void decrement_count() const VSIP_NOTHROW {}
+  map_type const &map() const VSIP_NOTHROW { return block_.map();}
+
+  value_type get(index_type i) const
+  { return storage::get(ptr_, i * stride_[0]);}
+  value_type get(index_type i, index_type j) const
+  { return storage::get(ptr_, i * stride_[0] + j * stride_[1]);}
+  value_type get(index_type i, index_type j, index_type k) const
+  { return storage::get(ptr_, i * stride_[0] + j * stride_[1] + k * stride_[2]);}
+
+  void put(index_type i, value_type v)
+  { storage::put(ptr_, i * stride_[0], v);}
+  void put(index_type i, index_type j, value_type v)
+  { storage::put(ptr_, i * stride_[0] + j * stride_[1], v);}
+  void put(index_type i, index_type j, index_type k, value_type v)
+  { storage::put(ptr_, i * stride_[0] + j * stride_[1] + k * stride_[2], v);}
+
+private:
+  block_type const &block_;
+  ptr_type ptr_;
+  length_type size_[dim];
+  stride_type stride_[dim];
+};
+
+/// A one-dimensional proxy for a dense block with direct data
+/// access. Elements are addressed by their offset in storage order,
+/// so all dimensions are traversed in a single loop. Like Host_block,
+/// the proxy is only valid for the duration of a single evaluation.
+template <typename B>
+class Dense_host_block
+{
+  typedef typename remove_const<B>::type block_type;
+  static storage_format_type const storage_format =
+    get_block_layout<block_type>::storage_format;
+  typedef storage_traits<typename block_type::value_type, storage_format> storage;
+
+public:
+  static dimension_type const dim = block_type::dim;
+  typedef typename block_type::value_type value_type;
+  typedef value_type &reference_type;
+  typedef value_type const &const_reference_type;
+  typedef typename block_type::map_type map_type;
+  typedef typename conditional<is_const<B>::value,
+			       typename storage::const_ptr_type,
+			       typename storage::ptr_type>::type ptr_type;
+
+  Dense_host_block(B &block)
+    : block_(block),
+      ptr_(pointer_cast<ptr_type>(block.ptr()))
+  {}
+
+  length_type size() const VSIP_NOTHROW { return block_.size();}
+  length_type size(dimension_type block_dim, dimension_type d) const VSIP_NOTHROW
+  {
+    if (block_dim == 1) return size();
+    else return block_.size(block_dim, d);
+  }
+  void increment_count() const VSIP_NOTHROW {}
+  void decrement_count() const VSIP_NOTHROW {}
+  map_type const &map() const VSIP_NOTHROW { return block_.map();}
+
+  value_type get(index_type i) const { return storage::get(ptr_, i);}
+  void put(index_type i, value_type v) { storage::put(ptr_, i, v);}
+
+private:
+  block_type const &block_;
+  ptr_type ptr_;
+};
+
+namespace detail
+{
+template <typename B, bool E = is_expr_block<B>::value>
+struct is_host_accessible
+{
+  static bool const value =
+    get_block_layout<B>::storage_format != any_storage_format &&
+    dda::Data<B, dda::in>::ct_cost == 0;
+};
+
+template <typename B>
+struct is_host_accessible<B, true> : false_type {};
+} // namespace ovxx::expr::detail
+
+/// True if all leaves of B can be replaced by Host_blocks, i.e.
+/// B is a block with direct data access, a scalar, or an elementwise
+/// expression whose operands are host-accessible.
+template <typename B>
+struct is_host_accessible : detail::is_host_accessible<B> {};
+
+template <typename B>
+struct is_host_accessible<B const> : is_host_accessible<B> {};
+
+template <dimension_type D, typename T>
+struct is_host_accessible<Scalar<D, T> > : true_type {};
+
+template <template <typename> class O, typename B>
+struct is_host_accessible<Unary<O, B, true> > : is_host_accessible<B> {};
+
+template <template <typename, typename> class O, typename B1, typename B2>
+struct is_host_accessible<Binary<O, B1, B2, true> >
+{
+  static bool const value =
+    is_host_accessible<B1>::value && is_host_accessible<B2>::value;
+};
+
+template <template <typename, typename, typename> class O,
+	  typename B1, typename B2, typename B3>
+struct is_host_accessible<Ternary<O, B1, B2, B3, true> >
+{
+  static bool const value =
+    is_host_accessible<B1>::value && is_host_accessible<B2>::value &&
+    is_host_accessible<B3>::value;
+};
+
+/// The type of a (host-accessible) expression with its leaves
+/// replaced by read-only proxies P (Host_block or Dense_host_block).
+template <typename B, template <typename> class P = Host_block>
+struct host_type { typedef P<B const> type;};
+
+template <typename B, template <typename> class P>
+struct host_type<B const, P> : host_type<B, P> {};
+
+template <dimension_type D, typename T, template <typename> class P>
+struct host_type<Scalar<D, T>, P> { typedef Scalar<D, T> type;};
+
+template <template <typename> class O, typename B,
+	  template <typename> class P>
+struct host_type<Unary<O, B, true>, P>
+{
+  typedef Unary<O, typename host_type<B, P>::type const, true> type;
+};
+
+template <template <typename, typename> class O, typename B1, typename B2,
+	  template <typename> class P>
+struct host_type<Binary<O, B1, B2, true>, P>
+{
+  typedef Binary<O, typename host_type<B1, P>::type const,
+		 typename host_type<B2, P>::type const, true> type;
+};
+
+template <template <typename, typename, typename> class O,
+	  typename B1, typename B2, typename B3,
+	  template <typename> class P>
+struct host_type<Ternary<O, B1, B2, B3, true>, P>
+{
+  typedef Ternary<O, typename host_type<B1, P>::type const,
+		  typename host_type<B2, P>::type const,
+		  typename host_type<B3, P>::type const, true> type;
+};
+
+/// Return `block` with its leaves replaced by read-only proxies P.
+/// Unlike transform::combine this preserves the operation objects.
+template <template <typename> class P, typename B>
+inline typename host_type<B, P>::type
+host(B const &block)
+{ return typename host_type<B, P>::type(block);}
+
+template <template <typename> class P, dimension_type D, typename T>
+inline Scalar<D, T>
+host(Scalar<D, T> const &block)
+{ return block;}
+
+template <template <typename> class P, template <typename> class O, typename B>
+inline typename host_type<Unary<O, B, true>, P>::type
+host(Unary<O, B, true> const &block)
+{
+  typedef typename host_type<Unary<O, B, true>, P>::type type;
+  return type(block.operation(), host<P>(block.arg()));
+}
+
+template <template <typename> class P,
+	  template <typename, typename> class O, typename B1, typename B2>
+inline typename host_type<Binary<O, B1, B2, true>, P>::type
+host(Binary<O, B1, B2, true> const &block)
+{
+  typedef typename host_type<Binary<O, B1, B2, true>, P>::type type;
+  return type(block.operation(), host<P>(block.arg1()), host<P>(block.arg2()));
+}
+
+template <template <typename> class P,
+	  template <typename, typename, typename> class O,
+	  typename B1, typename B2, typename B3>
+inline typename host_type<Ternary<O, B1, B2, B3, true>, P>::type
+host(Ternary<O, B1, B2, B3, true> const &block)
+{
+  typedef typename host_type<Ternary<O, B1, B2, B3, true>, P>::type type;
+  return type(block.operation(),
+	      host<P>(block.arg1()), host<P>(block.arg2()), host<P>(block.arg3()));
+}
+
+/// Return true if `block` (a host-accessible block or expression)
+/// and all its leaves are stored densely in dimension order O, so
+/// they may be replaced by Dense_host_blocks.
+template <typename O, typename B>
+inline bool
+is_dense(B const &block)
+{
+  dimension_type const order[] = {O::impl_dim0, O::impl_dim1, O::impl_dim2};
+  dimension_type const dim = B::dim;
+  stride_type stride = 1;
+  for (dimension_type d = dim; d-- != 0;)
+  {
+    if (block.stride(dim, order[d]) != stride) return false;
+    stride *= block.size(dim, order[d]);
+  }
+  return true;
+}
+
+template <typename O, dimension_type D, typename T>
+inline bool
+is_dense(Scalar<D, T> const &) { return true;}
+
+template <typename O, template <typename> class Op, typename B>
+inline bool
+is_dense(Unary<Op, B, true> const &block)
+{ return is_dense<O>(block.arg());}
+
+template <typename O, template <typename, typename> class Op,
+	  typename B1, typename B2>
+inline bool
+is_dense(Binary<Op, B1, B2, true> const &block)
+{ return is_dense<O>(block.arg1()) && is_dense<O>(block.arg2());}
+
+template <typename O, template <typename, typename, typename> class Op,
+	  typename B1, typename B2, typename B3>
+inline bool
+is_dense(Ternary<Op, B1, B2, B3, true> const &block)
+{
+  return is_dense<O>(block.arg1()) && is_dense<O>(block.arg2()) &&
+    is_dense<O>(block.arg3());
+}
+
+} // namespace ovxx::expr
+
+template <typename B>
+struct block_traits<expr::Dense_host_block<B> >
+  : by_value_traits<expr::Dense_host_block<B> >
+{};
+
+template <typename B>
+struct block_traits<expr::Dense_host_block<B> const>
+  : by_value_traits<expr::Dense_host_block<B> const>
+{};
+
+template <typename B>
+struct block_traits<expr::Host_block<B> >
+  : by_value_traits<expr::Host_block<B> >
+{};
+
+template <typename B>
+struct block_traits<expr::Host_block<B> const>
+  : by_value_traits<expr::Host_block<B> const>
+{};
+
+} // namespace ovxx
+
+#endif
@@ -81,6 +81,15 @@ struct Div
 template <typename T1, typename T2, typename T3>
 struct Ma;
 
+template <typename T1, typename T2, typename T3>
+struct Am;
+
+template <typename T>
+struct Magsq;
+
+template <typename T>
+struct Conj;
+
 } // namespace ovxx::expr::op
 } // namespace ovxx::expr
 } // namespace ovxx
@@ -10,7 +10,10 @@
 #include <ovxx/layout.hpp>
 #include <ovxx/aligned_array.hpp>
 #include <vsip/dense.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <ovxx/fftw/plan_cache.hpp>
 #include <fftw3.h>
+#include <algorithm>
 
 namespace ovxx
 {
@@ -77,6 +80,55 @@ int make_flags(unsigned NoT, bool preserve_input = true)
   return flags;
 }
 
+// Split the rows [0, rows) of an FFTM into one chunk per thread.
+// F is called as f(begin, end) to compute the FFTs of rows [begin, end).
+template <typename F>
+class row_chunks
+{
+public:
+  row_chunks(F const &f, length_type rows, unsigned int threads)
+    : f_(f), rows_(rows), chunk_((rows + threads - 1) / threads) {}
+
+  length_type chunks() const { return (rows_ + chunk_ - 1) / chunk_;}
+  void operator()(index_type c)
+  {
+    index_type const begin = c * chunk_;
+    f_(begin, std::min(begin + chunk_, rows_));
+  }
+
+private:
+  F const &f_;
+  length_type rows_;
+  length_type chunk_;
+};
+
+// Compute the FFTs of 'rows' rows of 'size' elements each.
+// We can't let FFTW parallelize FFTMs itself, since that would require
+// knowing the true (local) dimensions at planning time. Instead, the
+// rows are split across the default thread pool, with each thread
+// using FFTW's new-array execute functions, which may be called
+// concurrently on the same plan.
+template <typename F>
+void for_each_row(F const &f, length_type rows, length_type size)
+{
+  thread_pool *pool = thread_pool::get_default();
+  if (rows > 1 && pool->size() > 1 && rows * size >= thread_pool::threshold())
+  {
+    row_chunks<F> task(f, rows, pool->size());
+    pool->parallel_for(task.chunks(), task);
+  }
+  else
+    f(0, rows);
+}
+
+// Cached plans are told apart by transform type and precision.
+enum transform_type { c2c, r2c, c2r};
+template <typename T>
+int plan_kind(transform_type t) { return 3 * sizeof(T) + t;}
+
+// The plans for a given transform, together with the buffers they
+// were made for. Instances are shared through the plan cache.
+template <dimension_type D, typename I, typename O> struct plans;
 template <dimension_type D, typename I, typename O> struct planner;
 template <dimension_type D, typename I, typename O, int S> class fft;
 template <typename I, typename O, int A, int D> class fftm;
@@ -37,9 +37,10 @@ Domain<D> FFTW(iosize)(Domain<D> const &dom)
 { return io_size<D, complex<SCALAR_TYPE>, SCALAR_TYPE, D-1>::size(dom);}
 
 template <dimension_type D>
-struct planner<D, complex<SCALAR_TYPE>, complex<SCALAR_TYPE> >
+struct plans<D, complex<SCALAR_TYPE>, complex<SCALAR_TYPE> >
+  : plan_cache::entry
 {
-  planner(Domain<D> const &dom, int exp, int flags, length_type mult = 1)
+  plans(Domain<D> const &dom, int exp, int flags, length_type mult = 1)
     : aligned_(!(flags & FFTW_UNALIGNED)),
       mult_(mult)
   {
@@ -101,7 +102,7 @@ struct planner<D, complex<SCALAR_TYPE>, complex<SCALAR_TYPE> >
       OVXX_DO_THROW(std::bad_alloc());
     }
   }
-  ~planner() VSIP_NOTHROW
+  ~plans() VSIP_NOTHROW
   {
     FFTW(destroy_plan)(plan_op_);
     FFTW(destroy_plan)(plan_ip_);
@@ -116,9 +117,67 @@ struct planner<D, complex<SCALAR_TYPE>, complex<SCALAR_TYPE> >
 };
 
 template <dimension_type D>
-struct planner<D, SCALAR_TYPE, complex<SCALAR_TYPE> >
+struct planner<D, complex<SCALAR_TYPE>, complex<SCALAR_TYPE> >
+{
+  typedef fftw::plans<D, complex<SCALAR_TYPE>, complex<SCALAR_TYPE> > plans_type;
+
+  planner(Domain<D> const &dom, int exp, int flags, length_type mult = 1)
+    : plans_(plan_cache::acquire<plans_type>
+	     (plan_cache::key(plan_kind<SCALAR_TYPE>(c2c), dom, exp, flags, mult),
+	      dom, exp, flags, mult)),
+#if OVXX_ENABLE_THREADING
+      borrowed_(plans_->borrow_buffers()),
+#endif
+      in_buffer_(plans_->in_buffer_.get()),
+      out_buffer_(plans_->out_buffer_.get()),
+      plan_ip_(plans_->plan_ip_),
+      plan_op_(plans_->plan_op_),
+      aligned_(!(flags & FFTW_UNALIGNED)),
+      mult_(mult)
+  {
+#if OVXX_ENABLE_THREADING
+    // Another object holds the cached buffers, and may use them
+    // concurrently, so this one needs its own.
+    if (!borrowed_)
+    {
+      own_in_ = aligned_array<complex<SCALAR_TYPE> >
+	(32, plans_->in_buffer_.size());
+      own_out_ = aligned_array<complex<SCALAR_TYPE> >
+	(32, plans_->out_buffer_.size());
+      in_buffer_ = own_in_.get();
+      out_buffer_ = own_out_.get();
+    }
+#endif
+  }
+  ~planner() VSIP_NOTHROW
+  {
+#if OVXX_ENABLE_THREADING
+    if (borrowed_) plans_->return_buffers();
+#endif
+    plan_cache::release(plans_);
+  }
+
+  plans_type *plans_;
+#if OVXX_ENABLE_THREADING
+  // Objects sharing plans may be used concurrently, so only one
+  // of them at a time borrows the cached buffers.
+  bool borrowed_;
+  aligned_array<complex<SCALAR_TYPE> > own_in_;
+  aligned_array<complex<SCALAR_TYPE> > own_out_;
+#endif
+  complex<SCALAR_TYPE> *in_buffer_;
+  complex<SCALAR_TYPE> *out_buffer_;
+  FFTW(plan) plan_ip_;
+  FFTW(plan) plan_op_;
+  bool aligned_;
+  length_type mult_;
+};
+
+template <dimension_type D>
+struct plans<D, SCALAR_TYPE, complex<SCALAR_TYPE> >
+  : plan_cache::entry
 {
-  planner(Domain<D> dom, int A, int flags, length_type mult = 1)
+  plans(Domain<D> dom, int A, int flags, length_type mult = 1)
     VSIP_THROW((std::bad_alloc))
   : aligned_(!(flags & FFTW_UNALIGNED)),
     mult_(mult)
@@ -188,7 +247,7 @@ struct planner<D, SCALAR_TYPE, complex<SCALAR_TYPE> >
     }
     if (!plan_) OVXX_DO_THROW(std::bad_alloc());
   }
-  ~planner() VSIP_NOTHROW { FFTW(destroy_plan)(plan_);}
+  ~plans() VSIP_NOTHROW { FFTW(destroy_plan)(plan_);}
 
   aligned_array<SCALAR_TYPE> in_buffer_;
   aligned_array<complex<SCALAR_TYPE> > out_buffer_;
@@ -197,10 +256,66 @@ struct planner<D, SCALAR_TYPE, complex<SCALAR_TYPE> >
   length_type mult_;
 };
 
+template <dimension_type D>
+struct planner<D, SCALAR_TYPE, complex<SCALAR_TYPE> >
+{
+  typedef fftw::plans<D, SCALAR_TYPE, complex<SCALAR_TYPE> > plans_type;
+
+  planner(Domain<D> const &dom, int A, int flags, length_type mult = 1)
+    VSIP_THROW((std::bad_alloc))
+    : plans_(plan_cache::acquire<plans_type>
+	     (plan_cache::key(plan_kind<SCALAR_TYPE>(r2c), dom, A, flags, mult),
+	      dom, A, flags, mult)),
+#if OVXX_ENABLE_THREADING
+      borrowed_(plans_->borrow_buffers()),
+#endif
+      in_buffer_(plans_->in_buffer_.get()),
+      out_buffer_(plans_->out_buffer_.get()),
+      plan_(plans_->plan_),
+      aligned_(!(flags & FFTW_UNALIGNED)),
+      mult_(mult)
+  {
+#if OVXX_ENABLE_THREADING
+    // Another object holds the cached buffers, and may use them
+    // concurrently, so this one needs its own.
+    if (!borrowed_)
+    {
+      own_in_ = aligned_array<SCALAR_TYPE>(32, plans_->in_buffer_.size());
+      own_out_ = aligned_array<complex<SCALAR_TYPE> >
+	(32, plans_->out_buffer_.size());
+      in_buffer_ = own_in_.get();
+      out_buffer_ = own_out_.get();
+    }
+#endif
+  }
+  ~planner() VSIP_NOTHROW
+  {
+#if OVXX_ENABLE_THREADING
+    if (borrowed_) plans_->return_buffers();
+#endif
+    plan_cache::release(plans_);
+  }
+
+  plans_type *plans_;
+#if OVXX_ENABLE_THREADING
+  // Objects sharing plans may be used concurrently, so only one
+  // of them at a time borrows the cached buffers.
+  bool borrowed_;
+  aligned_array<SCALAR_TYPE> own_in_;
+  aligned_array<complex<SCALAR_TYPE> > own_out_;
+#endif
+  SCALAR_TYPE *in_buffer_;
+  complex<SCALAR_TYPE> *out_buffer_;
+  FFTW(plan) plan_;
+  bool aligned_;
+  length_type mult_;
+};
+
 template <vsip::dimension_type D>
-struct planner<D, complex<SCALAR_TYPE>, SCALAR_TYPE>
+struct plans<D, complex<SCALAR_TYPE>, SCALAR_TYPE>
+  : plan_cache::entry
 {
-  planner(Domain<D> dom, int A, int flags, length_type mult = 1)
+  plans(Domain<D> dom, int A, int flags, length_type mult = 1)
     VSIP_THROW((std::bad_alloc))
   : aligned_(!(flags & FFTW_UNALIGNED)),
     mult_(mult)
@@ -270,7 +385,7 @@ struct planner<D, complex<SCALAR_TYPE>, SCALAR_TYPE>
     }
     if (!plan_) OVXX_DO_THROW(std::bad_alloc());
   }
-  ~planner() VSIP_NOTHROW { FFTW(destroy_plan)(plan_);}
+  ~plans() VSIP_NOTHROW { FFTW(destroy_plan)(plan_);}
 
   aligned_array<complex<SCALAR_TYPE> > in_buffer_;
   aligned_array<SCALAR_TYPE> out_buffer_;
@@ -279,6 +394,61 @@ struct planner<D, complex<SCALAR_TYPE>, SCALAR_TYPE>
   length_type mult_;
 };
 
+template <vsip::dimension_type D>
+struct planner<D, complex<SCALAR_TYPE>, SCALAR_TYPE>
+{
+  typedef fftw::plans<D, complex<SCALAR_TYPE>, SCALAR_TYPE> plans_type;
+
+  planner(Domain<D> const &dom, int A, int flags, length_type mult = 1)
+    VSIP_THROW((std::bad_alloc))
+    : plans_(plan_cache::acquire<plans_type>
+	     (plan_cache::key(plan_kind<SCALAR_TYPE>(c2r), dom, A, flags, mult),
+	      dom, A, flags, mult)),
+#if OVXX_ENABLE_THREADING
+      borrowed_(plans_->borrow_buffers()),
+#endif
+      in_buffer_(plans_->in_buffer_.get()),
+      out_buffer_(plans_->out_buffer_.get()),
+      plan_(plans_->plan_),
+      aligned_(!(flags & FFTW_UNALIGNED)),
+      mult_(mult)
+  {
+#if OVXX_ENABLE_THREADING
+    // Another object holds the cached buffers, and may use them
+    // concurrently, so this one needs its own.
+    if (!borrowed_)
+    {
+      own_in_ = aligned_array<complex<SCALAR_TYPE> >
+	(32, plans_->in_buffer_.size());
+      own_out_ = aligned_array<SCALAR_TYPE>(32, plans_->out_buffer_.size());
+      in_buffer_ = own_in_.get();
+      out_buffer_ = own_out_.get();
+    }
+#endif
+  }
+  ~planner() VSIP_NOTHROW
+  {
+#if OVXX_ENABLE_THREADING
+    if (borrowed_) plans_->return_buffers();
+#endif
+    plan_cache::release(plans_);
+  }
+
+  plans_type *plans_;
+#if OVXX_ENABLE_THREADING
+  // Objects sharing plans may be used concurrently, so only one
+  // of them at a time borrows the cached buffers.
+  bool borrowed_;
+  aligned_array<complex<SCALAR_TYPE> > own_in_;
+  aligned_array<SCALAR_TYPE> own_out_;
+#endif
+  complex<SCALAR_TYPE> *in_buffer_;
+  SCALAR_TYPE *out_buffer_;
+  FFTW(plan) plan_;
+  bool aligned_;
+  length_type mult_;
+};
+
 // 1D complex -> complex FFT
 
 template <int S>
@@ -307,8 +477,8 @@ public:
     query_layout(in);
     out = in;
   }
-  virtual ctype *input_buffer() { return in_buffer_.get();}
-  virtual ctype *output_buffer() { return out_buffer_.get();}
+  virtual ctype *input_buffer() { return in_buffer_;}
+  virtual ctype *output_buffer() { return out_buffer_;}
   virtual void in_place(ctype *inout, stride_type s, length_type l)
   {
     FFTW(execute_dft)(plan_ip_,
@@ -375,8 +545,8 @@ public:
     out = in;
     out.storage_format = complex_storage_format;
   }
-  virtual rtype *input_buffer() { return in_buffer_.get();}
-  virtual ctype *output_buffer() { return out_buffer_.get();}
+  virtual rtype *input_buffer() { return in_buffer_;}
+  virtual ctype *output_buffer() { return out_buffer_;}
   virtual void out_of_place(rtype *in, stride_type,
 			    ctype *out, stride_type,
 			    length_type)
@@ -417,8 +587,8 @@ public:
     out = in;
     out.storage_format = array;
   }
-  virtual ctype *input_buffer() { return in_buffer_.get();}
-  virtual rtype *output_buffer() { return out_buffer_.get();}
+  virtual ctype *input_buffer() { return in_buffer_;}
+  virtual rtype *output_buffer() { return out_buffer_;}
   virtual void out_of_place(ctype *in, stride_type,
 			    rtype *out, stride_type,
 			    length_type)
@@ -461,8 +631,8 @@ public:
     query_layout(in);
     out = in;
   }
-  virtual ctype *input_buffer() { return in_buffer_.get();}
-  virtual ctype *output_buffer() { return out_buffer_.get();}
+  virtual ctype *input_buffer() { return in_buffer_;}
+  virtual ctype *output_buffer() { return out_buffer_;}
   virtual void in_place(ctype *inout,
 			stride_type, stride_type,
 			length_type, length_type)
@@ -535,8 +705,8 @@ public:
     out = in;
     out.storage_format = complex_storage_format;
   }
-  virtual rtype *input_buffer() { return in_buffer_.get();}
-  virtual ctype *output_buffer() { return out_buffer_.get();}
+  virtual rtype *input_buffer() { return in_buffer_;}
+  virtual ctype *output_buffer() { return out_buffer_;}
   virtual void out_of_place(rtype *in,
 			    stride_type, stride_type,
 			    ctype *out,
@@ -580,8 +750,8 @@ public:
     out = in;
     out.storage_format = array;
   }
-  virtual ctype *input_buffer() { return in_buffer_.get();}
-  virtual rtype *output_buffer() { return out_buffer_.get();}
+  virtual ctype *input_buffer() { return in_buffer_;}
+  virtual rtype *output_buffer() { return out_buffer_;}
   // Multi-dimensional C2R FFTs overwrite the input buffer.
   virtual bool requires_copy(Rt_layout<2> &) { return true;}
   virtual void out_of_place(ctype *in, stride_type, stride_type,
@@ -626,8 +796,8 @@ public:
     query_layout(in);
     out = in;
   }
-  virtual ctype *input_buffer() { return in_buffer_.get();}
-  virtual ctype *output_buffer() { return out_buffer_.get();}
+  virtual ctype *input_buffer() { return in_buffer_;}
+  virtual ctype *output_buffer() { return out_buffer_;}
   virtual void in_place(ctype *inout,
 			stride_type, stride_type, stride_type,
 			length_type, length_type, length_type)
@@ -705,8 +875,8 @@ public:
     out = in;
     out.storage_format = complex_storage_format;
   }
-  virtual rtype *input_buffer() { return in_buffer_.get();}
-  virtual ctype *output_buffer() { return out_buffer_.get();}
+  virtual rtype *input_buffer() { return in_buffer_;}
+  virtual ctype *output_buffer() { return out_buffer_;}
   virtual void out_of_place(rtype *in, stride_type, stride_type, stride_type,
 			    ctype *out, stride_type, stride_type, stride_type,
 			    length_type, length_type, length_type)
@@ -752,8 +922,8 @@ public:
     out = in;
     out.storage_format = array;
   }
-  virtual ctype *input_buffer() { return in_buffer_.get();}
-  virtual rtype *output_buffer() { return out_buffer_.get();}
+  virtual ctype *input_buffer() { return in_buffer_;}
+  virtual rtype *output_buffer() { return out_buffer_;}
   // Multi-dimensional C2R FFTs overwrite the input buffer.
   virtual bool requires_copy(Rt_layout<3> &) { return true;}
   virtual void out_of_place(ctype *in, stride_type, stride_type, stride_type,
@@ -785,6 +955,39 @@ class fftm<SCALAR_TYPE, complex<SCALAR_TYPE>, A, fft_fwd>
 
   static int const axis = A == vsip::col ? 0 : 1;
 
+  // Compute the FFTs of rows [begin, end).
+  struct row_ffts
+  {
+    FFTW(plan) plan;
+    rtype *in;
+    stride_type in_stride;
+    ctype *out;
+    stride_type out_stride;
+
+    void operator()(index_type begin, index_type end) const
+    {
+      for (index_type i = begin; i != end; ++i)
+	FFTW(execute_dft_r2c)(plan, in + i * in_stride,
+			      reinterpret_cast<FFTW(complex)*>(out + i * out_stride));
+    }
+  };
+  struct split_row_ffts
+  {
+    FFTW(plan) plan;
+    rtype *in;
+    stride_type in_stride;
+    ztype out;
+    stride_type out_stride;
+
+    void operator()(index_type begin, index_type end) const
+    {
+      for (index_type i = begin; i != end; ++i)
+	FFTW(execute_split_dft_r2c)(plan, in + i * in_stride,
+				    out.first + i * out_stride,
+				    out.second + i * out_stride);
+    }
+  };
+
 public:
   fftm(Domain<2> const &dom, unsigned number)
     : planner<1, rtype, ctype>(dom[axis], 0, make_flags<rtype>(dom[axis], number, false),
@@ -801,8 +1004,8 @@ public:
     out = in;
     out.storage_format = complex_storage_format;
   }
-  virtual rtype *input_buffer() { return in_buffer_.get();}
-  virtual ctype *output_buffer() { return out_buffer_.get();}
+  virtual rtype *input_buffer() { return in_buffer_;}
+  virtual ctype *output_buffer() { return out_buffer_;}
   virtual void out_of_place(rtype *in, stride_type i_str_0, stride_type i_str_1,
 			    ctype *out, stride_type o_str_0, stride_type o_str_1,
 			    length_type rows, length_type cols)
@@ -810,13 +1013,12 @@ public:
     // To support distributed blocks we need to be ready to handle subsizes
     // of what we planned for. Thus, mult <= mult_.
     length_type const mult = axis == 1 ? rows : cols;
-    length_type const in_stride = axis == 1 ? i_str_0 : i_str_1;
-    length_type const out_stride = axis == 1 ? o_str_0 : o_str_1;
+    length_type const size = axis == 1 ? cols : rows;
+    stride_type const in_stride = axis == 1 ? i_str_0 : i_str_1;
+    stride_type const out_stride = axis == 1 ? o_str_0 : o_str_1;
 
-    // For the same reason, we can't have FFTW do the parallelization, since
-    // that would require knowing the true (local) dimensions at planning time.
-    for (index_type i = 0; i != mult; ++i, in += in_stride, out += out_stride)
-      FFTW(execute_dft_r2c)(plan_, in, reinterpret_cast<FFTW(complex)*>(out));
+    row_ffts task = {plan_, in, in_stride, out, out_stride};
+    for_each_row(task, mult, size);
   }
   virtual void out_of_place(rtype *in, stride_type i_str_0, stride_type i_str_1,
 			    ztype out, stride_type o_str_0, stride_type o_str_1,
@@ -825,17 +1027,12 @@ public:
     // To support distributed blocks we need to be ready to handle subsizes
     // of what we planned for. Thus, mult <= mult_.
     length_type const mult = axis == 1 ? rows : cols;
-    length_type const in_stride = axis == 1 ? i_str_0 : i_str_1;
-    length_type const out_stride = axis == 1 ? o_str_0 : o_str_1;
+    length_type const size = axis == 1 ? cols : rows;
+    stride_type const in_stride = axis == 1 ? i_str_0 : i_str_1;
+    stride_type const out_stride = axis == 1 ? o_str_0 : o_str_1;
 
-    rtype* out_r = out.first;
-    rtype* out_i = out.second;
-
-    // For the same reason, we can't have FFTW do the parallelization, since
-    // that would require knowing the true (local) dimensions at planning time.
-    for (index_type i = 0; i != mult; ++i,
-	   in += in_stride, out_r += out_stride, out_i += out_stride)
-      FFTW(execute_split_dft_r2c)(plan_, in, out_r, out_i);
+    split_row_ffts task = {plan_, in, in_stride, out, out_stride};
+    for_each_row(task, mult, size);
   }
 };
 
@@ -852,6 +1049,41 @@ class fftm<complex<SCALAR_TYPE>, SCALAR_TYPE, A, fft_inv>
 
   static int const axis = A == vsip::col ? 0 : 1;
 
+  // Compute the FFTs of rows [begin, end).
+  struct row_ffts
+  {
+    FFTW(plan) plan;
+    ctype *in;
+    stride_type in_stride;
+    rtype *out;
+    stride_type out_stride;
+
+    void operator()(index_type begin, index_type end) const
+    {
+      for (index_type i = begin; i != end; ++i)
+	FFTW(execute_dft_c2r)(plan,
+			      reinterpret_cast<FFTW(complex)*>(in + i * in_stride),
+			      out + i * out_stride);
+    }
+  };
+  struct split_row_ffts
+  {
+    FFTW(plan) plan;
+    ztype in;
+    stride_type in_stride;
+    rtype *out;
+    stride_type out_stride;
+
+    void operator()(index_type begin, index_type end) const
+    {
+      for (index_type i = begin; i != end; ++i)
+	FFTW(execute_split_dft_c2r)(plan,
+				    in.first + i * in_stride,
+				    in.second + i * in_stride,
+				    out + i * out_stride);
+    }
+  };
+
 public:
   fftm(Domain<2> const &dom, unsigned number)
     : planner<1, ctype, rtype>(dom[axis], 0, make_flags<rtype>(dom[axis], number), dom[1-axis].length())
@@ -867,35 +1099,31 @@ public:
     out = in;
     out.storage_format = array;
   }
-  virtual ctype *input_buffer() { return in_buffer_.get();}
-  virtual rtype *output_buffer() { return out_buffer_.get();}
+  virtual ctype *input_buffer() { return in_buffer_;}
+  virtual rtype *output_buffer() { return out_buffer_;}
   virtual void out_of_place(ctype *in, stride_type i_str_0, stride_type i_str_1,
 			    rtype *out, stride_type o_str_0, stride_type o_str_1,
 			    length_type rows, length_type cols)
   {
     length_type const mult = axis == 1 ? rows : cols;
-    length_type const in_stride = axis == 1 ? i_str_0 : i_str_1;
-    length_type const out_stride = axis == 1 ? o_str_0 : o_str_1;
+    length_type const size = axis == 1 ? cols : rows;
+    stride_type const in_stride = axis == 1 ? i_str_0 : i_str_1;
+    stride_type const out_stride = axis == 1 ? o_str_0 : o_str_1;
 
-    for (index_type i = 0; i != mult; ++i, in += in_stride, out += out_stride)
-    {
-      FFTW(execute_dft_c2r)(plan_,
-			    reinterpret_cast<FFTW(complex)*>(in), out);
-    }
+    row_ffts task = {plan_, in, in_stride, out, out_stride};
+    for_each_row(task, mult, size);
   }
   virtual void out_of_place(ztype in, stride_type i_str_0, stride_type i_str_1,
 			    rtype *out, stride_type o_str_0, stride_type o_str_1,
 			    length_type rows, length_type cols)
   {
     length_type const mult = axis == 1 ? rows : cols;
-    length_type const in_stride = axis == 1 ? i_str_0 : i_str_1;
-    length_type const out_stride = axis == 1 ? o_str_0 : o_str_1;
-
-    rtype *in_r = in.first;
-    rtype *in_i = in.second;
-    for (index_type i = 0; i != mult;
-	 ++i, in_r += in_stride, in_i += in_stride, out += out_stride)
-      FFTW(execute_split_dft_c2r)(plan_, in_r, in_i, out);
+    length_type const size = axis == 1 ? cols : rows;
+    stride_type const in_stride = axis == 1 ? i_str_0 : i_str_1;
+    stride_type const out_stride = axis == 1 ? o_str_0 : o_str_1;
+
+    split_row_ffts task = {plan_, in, in_stride, out, out_stride};
+    for_each_row(task, mult, size);
   }
 };
 
@@ -912,6 +1140,48 @@ class fftm<complex<SCALAR_TYPE>, complex<SCALAR_TYPE>, A, D>
 
   static int const axis = A == vsip::col ? 0 : 1;
 
+  // Compute the FFTs of rows [begin, end). For in-place
+  // transforms, 'in' and 'out' are the same.
+  struct row_ffts
+  {
+    FFTW(plan) plan;
+    ctype *in;
+    stride_type in_stride;
+    ctype *out;
+    stride_type out_stride;
+
+    void operator()(index_type begin, index_type end) const
+    {
+      for (index_type i = begin; i != end; ++i)
+	FFTW(execute_dft)(plan,
+			  reinterpret_cast<FFTW(complex)*>(in + i * in_stride),
+			  reinterpret_cast<FFTW(complex)*>(out + i * out_stride));
+    }
+  };
+  struct split_row_ffts
+  {
+    FFTW(plan) plan;
+    ztype in;
+    stride_type in_stride;
+    ztype out;
+    stride_type out_stride;
+
+    void operator()(index_type begin, index_type end) const
+    {
+      for (index_type i = begin; i != end; ++i)
+      {
+	rtype *in_real = in.first + i * in_stride;
+	rtype *in_imag = in.second + i * in_stride;
+	rtype *out_real = out.first + i * out_stride;
+	rtype *out_imag = out.second + i * out_stride;
+	if (D == fft_fwd)
+	  FFTW(execute_split_dft)(plan, in_real, in_imag, out_real, out_imag);
+	else
+	  FFTW(execute_split_dft)(plan, in_imag, in_real, out_imag, out_real);
+      }
+    }
+  };
+
 public:
   fftm(Domain<2> const &dom, int number)
     : planner<1, ctype, ctype>
@@ -930,74 +1200,51 @@ public:
     query_layout(in);
     out = in;
   }
-  virtual ctype *input_buffer() { return in_buffer_.get();}
-  virtual ctype *output_buffer() { return out_buffer_.get();}
+  virtual ctype *input_buffer() { return in_buffer_;}
+  virtual ctype *output_buffer() { return out_buffer_;}
   virtual void in_place(ctype *inout, stride_type str_0, stride_type str_1,
 			length_type rows, length_type cols)
   {
     length_type const mult = axis == 1 ? rows : cols;
+    length_type const size = axis == 1 ? cols : rows;
     stride_type const stride  = axis == 1 ? str_0 : str_1;
 
-    for (index_type i = 0; i != mult; ++i, inout += stride)
-      FFTW(execute_dft)(this->plan_ip_,
- 			reinterpret_cast<FFTW(complex)*>(inout),
- 			reinterpret_cast<FFTW(complex)*>(inout));
+    row_ffts task = {this->plan_ip_, inout, stride, inout, stride};
+    for_each_row(task, mult, size);
   }
   virtual void in_place(ztype inout, stride_type str_0, stride_type str_1,
 			length_type rows, length_type cols)
   {
     length_type const mult = axis == 1 ? rows : cols;
+    length_type const size = axis == 1 ? cols : rows;
     stride_type const stride = axis == 1 ? str_0 : str_1;
 
-    rtype* real_ptr = inout.first;
-    rtype* imag_ptr = inout.second;
-
-    for (index_type i = 0; i != mult; ++i, real_ptr += stride, imag_ptr += stride)
-      if (D == fft_fwd)
-	FFTW(execute_split_dft)(this->plan_ip_,
-				real_ptr, imag_ptr,
-				real_ptr, imag_ptr);
-      else
-	FFTW(execute_split_dft)(this->plan_ip_,
-				imag_ptr, real_ptr,
-				imag_ptr, real_ptr);
+    split_row_ffts task = {this->plan_ip_, inout, stride, inout, stride};
+    for_each_row(task, mult, size);
   }
   virtual void out_of_place(ctype *in, stride_type i_str_0, stride_type i_str_1,
 			    ctype *out, stride_type o_str_0, stride_type o_str_1,
 			    length_type rows, length_type cols)
   {
     length_type const mult = axis == 1 ? rows : cols;
-    length_type const in_stride = axis == 1 ? i_str_0 : i_str_1;
-    length_type const out_stride = axis == 1 ? o_str_0 : o_str_1;
+    length_type const size = axis == 1 ? cols : rows;
+    stride_type const in_stride = axis == 1 ? i_str_0 : i_str_1;
+    stride_type const out_stride = axis == 1 ? o_str_0 : o_str_1;
 
-    for (index_type i = 0; i != mult; ++i, in += in_stride, out += out_stride)
-      FFTW(execute_dft)(plan_op_,
-			reinterpret_cast<FFTW(complex)*>(in),
-			reinterpret_cast<FFTW(complex)*>(out));
+    row_ffts task = {plan_op_, in, in_stride, out, out_stride};
+    for_each_row(task, mult, size);
   }
   virtual void out_of_place(ztype in, stride_type i_str_0, stride_type i_str_1,
 			    ztype out, stride_type o_str_0, stride_type o_str_1,
 			    length_type rows, length_type cols)
   {
     length_type const mult = axis == 1 ? rows : cols;
-    length_type const in_stride  = axis == 1 ? i_str_0 : i_str_1;
-    length_type const out_stride = axis == 1 ? o_str_0 : o_str_1;
-
-    rtype *in_real  = in.first;
-    rtype *in_imag  = in.second;
-    rtype *out_real = out.first;
-    rtype *out_imag = out.second;
-
-    for (index_type i = 0; i != mult;
-	 ++i,
-	   in_real += in_stride, in_imag += in_stride,
-	   out_real += out_stride, out_imag += out_stride)
-      if (D == fft_fwd)
-	FFTW(execute_split_dft)(plan_op_,
-				in_real, in_imag, out_real, out_imag);
-      else
-	FFTW(execute_split_dft)(plan_op_,
-				in_imag, in_real, out_imag, out_real);
+    length_type const size = axis == 1 ? cols : rows;
+    stride_type const in_stride  = axis == 1 ? i_str_0 : i_str_1;
+    stride_type const out_stride = axis == 1 ? o_str_0 : o_str_1;
+
+    split_row_ffts task = {plan_op_, in, in_stride, out, out_stride};
+    for_each_row(task, mult, size);
   }
 };
 
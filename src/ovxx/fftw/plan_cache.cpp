@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#include <ovxx/fftw/plan_cache.hpp>
+#include <ovxx/c++11.hpp>
+#if OVXX_ENABLE_THREADING
+# include <ovxx/c++11/thread.hpp>
+#endif
+#include <map>
+
+namespace ovxx
+{
+namespace fftw
+{
+namespace
+{
+typedef std::map<plan_cache::key, plan_cache::entry *> map_type;
+
+map_type entries;
+// Unreferenced entries, most recently used first.
+std::list<plan_cache::entry *> idle;
+length_type max_idle = 32;
+#if OVXX_ENABLE_THREADING
+mutex cache_mutex;
+#endif
+} // namespace ovxx::fftw::<unnamed>
+
+bool plan_cache::key::operator<(key const &other) const
+{
+  if (kind != other.kind) return kind < other.kind;
+  if (dim != other.dim) return dim < other.dim;
+  for (dimension_type d = 0; d != 3; ++d)
+    if (size[d] != other.size[d]) return size[d] < other.size[d];
+  if (param != other.param) return param < other.param;
+  if (flags != other.flags) return flags < other.flags;
+  return mult < other.mult;
+}
+
+#if OVXX_ENABLE_THREADING
+plan_cache::guard::guard() { cache_mutex.lock();}
+plan_cache::guard::~guard() { cache_mutex.unlock();}
+#else
+plan_cache::guard::guard() {}
+plan_cache::guard::~guard() {}
+#endif
+
+plan_cache::entry *plan_cache::find(key const &k)
+{
+  map_type::iterator i = entries.find(k);
+  if (i == entries.end()) return 0;
+  entry *e = i->second;
+  if (e->refs_++ == 0)
+    idle.erase(e->idle_);
+  return e;
+}
+
+plan_cache::entry *plan_cache::insert(key const &k, entry *e)
+{
+  e->refs_ = 1;
+  e->key_ = &entries.insert(std::make_pair(k, e)).first->first;
+  return e;
+}
+
+void plan_cache::release(entry *e)
+{
+  guard g;
+  if (--e->refs_) return;
+  e->idle_ = idle.insert(idle.begin(), e);
+  trim(max_idle);
+}
+
+// Destroy the least recently used idle entries, leaving at most 'max'.
+void plan_cache::trim(length_type max)
+{
+  while (idle.size() > max)
+  {
+    entry *e = idle.back();
+    idle.pop_back();
+    key k = *e->key_;
+    entries.erase(k);
+    delete e;
+  }
+}
+
+length_type plan_cache::capacity()
+{
+  guard g;
+  return max_idle;
+}
+
+void plan_cache::set_capacity(length_type c)
+{
+  guard g;
+  max_idle = c;
+  trim(max_idle);
+}
+
+length_type plan_cache::size()
+{
+  guard g;
+  return entries.size();
+}
+
+void plan_cache::clear()
+{
+  guard g;
+  trim(0);
+}
+
+} // namespace ovxx::fftw
+} // namespace ovxx
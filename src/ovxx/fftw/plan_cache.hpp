@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_fftw_plan_cache_hpp_
+#define ovxx_fftw_plan_cache_hpp_
+
+#include <ovxx/support.hpp>
+#include <ovxx/detail/noncopyable.hpp>
+#include <vsip/domain.hpp>
+#include <list>
+
+namespace ovxx
+{
+namespace fftw
+{
+
+/// A process-wide, reference-counted cache of FFTW plans.
+///
+/// Constructing an Fft or Fftm object with the same parameters as an
+/// existing one reuses its plans instead of planning again. Plans that
+/// are no longer referenced are kept around (up to `capacity()` of them,
+/// least recently used first out), so short-lived objects can be
+/// recreated cheaply.
+///
+/// All planning happens with the cache locked, as the FFTW planner
+/// itself isn't thread-safe.
+class plan_cache
+{
+public:
+  /// All parameters that determine the outcome of planning.
+  struct key
+  {
+    template <dimension_type D>
+    key(int k, Domain<D> const &dom, int p, int f, length_type m)
+      : kind(k), dim(D), param(p), flags(f), mult(m)
+    {
+      for (dimension_type d = 0; d != 3; ++d)
+	size[d] = d < D ? dom[d].size() : 0;
+    }
+    bool operator<(key const &other) const;
+
+    int kind;
+    dimension_type dim;
+    length_type size[3];
+    int param;
+    int flags;
+    length_type mult;
+  };
+
+  /// Base class for cached plans, and the buffers they were
+  /// planned with.
+  class entry : ovxx::detail::noncopyable
+  {
+    friend class plan_cache;
+  public:
+    entry() : refs_(0), key_(0), lent_(0) {}
+    virtual ~entry() {}
+    /// Claim the entry's buffers for exclusive use, until they are
+    /// returned with `return_buffers()`. Return false if another
+    /// user holds them already.
+    bool borrow_buffers() { return __sync_bool_compare_and_swap(&lent_, 0, 1);}
+    void return_buffers() { __sync_lock_release(&lent_);}
+  private:
+    unsigned int refs_;
+    // The entry's key in the cache.
+    key const *key_;
+    // The entry's position in the idle list, while unreferenced.
+    std::list<entry *>::iterator idle_;
+    int lent_;
+  };
+
+  /// Return the plans of type E for `k`, constructing them from
+  /// `args` if they aren't cached yet. Each call needs to be matched
+  /// by a call to `release()`.
+  template <typename E, typename... A>
+  static E *acquire(key const &k, A const &... args)
+  {
+    guard g;
+    entry *e = find(k);
+    if (!e) e = insert(k, new E(args...));
+    return static_cast<E *>(e);
+  }
+  /// Release plans obtained from `acquire()`.
+  static void release(entry *);
+
+  /// The maximum number of unreferenced plans kept in the cache.
+  static length_type capacity();
+  static void set_capacity(length_type);
+  /// The number of cached plans, referenced or not.
+  static length_type size();
+  /// Destroy all unreferenced plans.
+  static void clear();
+
+private:
+  struct guard : ovxx::detail::noncopyable
+  {
+    guard();
+    ~guard();
+  };
+  static entry *find(key const &);
+  static entry *insert(key const &, entry *);
+  static void trim(length_type);
+};
+
+} // namespace ovxx::fftw
+} // namespace ovxx
+
+#endif
@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#include <ovxx/fftw/wisdom.hpp>
+#include <ovxx/fftw/plan_cache.hpp>
+#include <ovxx/options.hpp>
+#include <ovxx/support.hpp>
+#include <fftw3.h>
+#include <cstdio>
+#include <sstream>
+#if HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+
+namespace ovxx
+{
+namespace fftw
+{
+namespace
+{
+// The wisdom path given at initialization, if any.
+std::string wisdom_path;
+
+// Write to a temporary file first, then move it into place, so
+// concurrent processes never see a partially written file.
+template <typename F>
+bool save_file(std::string const &filename, F export_to_filename)
+{
+  std::ostringstream tmp;
+  tmp << filename << ".tmp";
+#if HAVE_UNISTD_H
+  tmp << '.' << getpid();
+#endif
+  if (!export_to_filename(tmp.str().c_str()))
+  {
+    std::remove(tmp.str().c_str());
+    return false;
+  }
+  return std::rename(tmp.str().c_str(), filename.c_str()) == 0;
+}
+} // namespace ovxx::fftw::<unnamed>
+
+bool load_wisdom(std::string const &path)
+{
+  bool status = true;
+#ifdef OVXX_FFTW_HAVE_FLOAT
+  status &= fftwf_import_wisdom_from_filename((path + ".float").c_str()) != 0;
+#endif
+#ifdef OVXX_FFTW_HAVE_DOUBLE
+  status &= fftw_import_wisdom_from_filename((path + ".double").c_str()) != 0;
+#endif
+  return status;
+}
+
+bool save_wisdom(std::string const &path)
+{
+  bool status = true;
+#ifdef OVXX_FFTW_HAVE_FLOAT
+  status &= save_file(path + ".float", fftwf_export_wisdom_to_filename);
+#endif
+#ifdef OVXX_FFTW_HAVE_DOUBLE
+  status &= save_file(path + ".double", fftw_export_wisdom_to_filename);
+#endif
+  return status;
+}
+
+#ifdef OVXX_FFTW_HAVE_FLOAT
+template <>
+std::string export_wisdom<float>()
+{
+  char *w = fftwf_export_wisdom_to_string();
+  if (!w) return std::string();
+  std::string wisdom(w);
+  fftwf_free(w);
+  return wisdom;
+}
+
+template <>
+bool import_wisdom<float>(std::string const &wisdom)
+{
+  return fftwf_import_wisdom_from_string(wisdom.c_str()) != 0;
+}
+#endif
+
+#ifdef OVXX_FFTW_HAVE_DOUBLE
+template <>
+std::string export_wisdom<double>()
+{
+  char *w = fftw_export_wisdom_to_string();
+  if (!w) return std::string();
+  std::string wisdom(w);
+  fftw_free(w);
+  return wisdom;
+}
+
+template <>
+bool import_wisdom<double>(std::string const &wisdom)
+{
+  return fftw_import_wisdom_from_string(wisdom.c_str()) != 0;
+}
+#endif
+
+void forget_wisdom()
+{
+#ifdef OVXX_FFTW_HAVE_FLOAT
+  fftwf_forget_wisdom();
+#endif
+#ifdef OVXX_FFTW_HAVE_DOUBLE
+  fftw_forget_wisdom();
+#endif
+}
+
+void initialize(int &argc, char **&argv)
+{
+  wisdom_path = options::get(argc, argv, "ovxx-fftw-wisdom", "OVXX_FFTW_WISDOM");
+  // A missing file isn't an error: it will be created during finalization.
+  if (!wisdom_path.empty())
+    load_wisdom(wisdom_path);
+}
+
+void finalize()
+{
+  if (!wisdom_path.empty() && !save_wisdom(wisdom_path))
+    std::cerr << "WARNING: unable to save FFTW wisdom to "
+	      << wisdom_path << std::endl;
+  wisdom_path.clear();
+  plan_cache::clear();
+}
+
+} // namespace ovxx::fftw
+} // namespace ovxx
@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_fftw_wisdom_hpp_
+#define ovxx_fftw_wisdom_hpp_
+
+#include <string>
+
+namespace ovxx
+{
+namespace fftw
+{
+
+// FFTW accumulates "wisdom" about the fastest plans for all transforms
+// created with a number-of-times hint large enough to request
+// measurement (see rigor()). Saving that wisdom and loading it into the
+// next process makes creating the same Fft and Fftm objects again cheap.
+//
+// Single- and double-precision wisdom are kept separately; for a given
+// path, they are stored in `<path>.float` and `<path>.double`.
+//
+// If a wisdom path is given with the `--ovxx-fftw-wisdom=<path>` option
+// or the OVXX_FFTW_WISDOM environment variable, wisdom is loaded from it
+// during library initialization and saved back during finalization.
+
+/// Load wisdom from the files at `path`. Return false if there was
+/// nothing to load, or the files couldn't be parsed.
+bool load_wisdom(std::string const &path);
+
+/// Save all accumulated wisdom to the files at `path`.
+/// Return false if that failed.
+bool save_wisdom(std::string const &path);
+
+/// Return the accumulated wisdom for precision T (float or double).
+template <typename T>
+std::string export_wisdom();
+
+/// Add the wisdom in `wisdom` for precision T (float or double).
+/// Return false if it couldn't be parsed.
+template <typename T>
+bool import_wisdom(std::string const &wisdom);
+
+/// Discard all accumulated wisdom.
+void forget_wisdom();
+
+/// Load wisdom from the configured path, if any.
+void initialize(int &argc, char **&argv);
+
+/// Save wisdom to the configured path, if any, and release
+/// unused cached plans.
+void finalize();
+
+} // namespace ovxx::fftw
+} // namespace ovxx
+
+#endif
@@ -0,0 +1,473 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_gemm_hpp_
+#define ovxx_gemm_hpp_
+
+#include <ovxx/support.hpp>
+#include <ovxx/simd/simd.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <vsip/dda.hpp>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+namespace ovxx
+{
+namespace gemm
+{
+/// Cache blocking parameters: `a` is packed in blocks of mc x kc
+/// (for L2), `b` in blocks of kc x nc, of which the micro-kernels
+/// stream panels of kc x nr (for L1).
+length_type const kc = 256;
+length_type const mc = 20 * simd::gemm_mr;
+length_type const nc = 4096;
+/// The widest micro-kernel tile supported.
+length_type const max_nr = 32;
+
+/// The smallest problem (m * n * k) worth packing for. Smaller products
+/// are left to the generic evaluators.
+length_type const threshold = 512;
+
+template <typename S> struct micro_kernel;
+
+template <>
+struct micro_kernel<float>
+{
+  static length_type nr() { return simd::get_kernels().sgemm_nr;}
+  static void exec(length_type k, float const *a, float const *b, float *c)
+  { simd::get_kernels().sgemm(k, a, b, c);}
+};
+
+template <>
+struct micro_kernel<double>
+{
+  static length_type nr() { return simd::get_kernels().dgemm_nr;}
+  static void exec(length_type k, double const *a, double const *b, double *c)
+  { simd::get_kernels().dgemm(k, a, b, c);}
+};
+
+/// Operands are accessed in terms of their real scalar type S. Complex
+/// products are computed as real products of twice the size, with
+/// each complex value a + ib of the left operand expanded into the 2x2
+/// block [a -b; b a], and each complex value of the right operand and
+/// the result into the 2x1 block [a; b].
+template <typename S>
+struct real_matrix
+{
+  real_matrix(S const *p, stride_type r, stride_type c, bool = false)
+    : data(p), row(r), col(c) {}
+  S get(index_type i, index_type j) const { return data[i * row + j * col];}
+  bool row_major() const { return std::labs(col) <= std::labs(row);}
+  /// Return the first column, if it is stored densely, or 0.
+  S const *dense_column() const { return row == 1 ? data : 0;}
+
+  S const *data;
+  stride_type row;
+  stride_type col;
+};
+
+template <typename S>
+struct complex_matrix
+{
+  complex_matrix(complex<S> const *p, stride_type r, stride_type c)
+    : re(reinterpret_cast<S const *>(p)), im(re + 1), row(2 * r), col(2 * c) {}
+  complex_matrix(std::pair<S const *, S const *> const &p, stride_type r, stride_type c)
+    : re(p.first), im(p.second), row(r), col(c) {}
+  bool row_major() const { return std::labs(col) <= std::labs(row);}
+
+  S const *re;
+  S const *im;
+  stride_type row;
+  stride_type col;
+};
+
+template <typename S>
+struct complex_lhs : complex_matrix<S>
+{
+  template <typename P>
+  complex_lhs(P const &p, stride_type r, stride_type c, bool = false)
+    : complex_matrix<S>(p, r, c) {}
+  S get(index_type i, index_type j) const
+  {
+    stride_type const o = (i / 2) * this->row + (j / 2) * this->col;
+    if (((i ^ j) & 1) == 0) return this->re[o];
+    return i & 1 ? this->im[o] : -this->im[o];
+  }
+};
+
+template <typename S>
+struct complex_rhs : complex_matrix<S>
+{
+  template <typename P>
+  complex_rhs(P const &p, stride_type r, stride_type c, bool conj = false)
+    : complex_matrix<S>(p, r, c), sign(conj ? -1 : 1) {}
+  S get(index_type i, index_type j) const
+  {
+    stride_type const o = (i / 2) * this->row + j * this->col;
+    return i & 1 ? sign * this->im[o] : this->re[o];
+  }
+  /// Return the first (expanded) column, if it is stored densely, or 0.
+  /// That is the case for a unit-stride, interleaved, unconjugated
+  /// column.
+  S const *dense_column() const
+  {
+    return this->row == 2 && this->im == this->re + 1 && sign == 1 ?
+      this->re : 0;
+  }
+
+  S sign;
+};
+
+template <typename S>
+struct real_result
+{
+  real_result(S *p, stride_type r, stride_type c) : data(p), row(r), col(c) {}
+  S &ref(index_type i, index_type j) const { return data[i * row + j * col];}
+
+  S *data;
+  stride_type row;
+  stride_type col;
+};
+
+template <typename S>
+struct complex_result
+{
+  complex_result(complex<S> *p, stride_type r, stride_type c)
+    : re(reinterpret_cast<S *>(p)), im(re + 1), row(2 * r), col(2 * c) {}
+  complex_result(std::pair<S *, S *> const &p, stride_type r, stride_type c)
+    : re(p.first), im(p.second), row(r), col(c) {}
+  S &ref(index_type i, index_type j) const
+  { return (i & 1 ? im : re)[(i / 2) * row + j * col];}
+
+  S *re;
+  S *im;
+  stride_type row;
+  stride_type col;
+};
+
+/// The accessors and sizes used to compute products of values of type T.
+template <typename T>
+struct expansion
+{
+  typedef T scalar_type;
+  typedef real_matrix<T> lhs_type;
+  typedef real_matrix<T> rhs_type;
+  typedef real_result<T> result_type;
+  static length_type const factor = 1;
+};
+
+template <typename T>
+struct expansion<complex<T> >
+{
+  typedef T scalar_type;
+  typedef complex_lhs<T> lhs_type;
+  typedef complex_rhs<T> rhs_type;
+  typedef complex_result<T> result_type;
+  static length_type const factor = 2;
+};
+
+/// True if products of values of type T are supported.
+template <typename T>
+struct is_supported
+{
+  typedef typename scalar_of<T>::type scalar_type;
+  static bool const value =
+    is_same<scalar_type, float>::value || is_same<scalar_type, double>::value;
+};
+
+namespace detail
+{
+inline length_type round_up(length_type n, length_type m)
+{ return (n + m - 1) / m * m;}
+
+// Pack the m x k block of `a` at (i0, p0) into panels of gemm_mr rows,
+// each stored column by column, padding the last one with zeros.
+template <typename S, typename A>
+void pack_lhs(A const &a, index_type i0, length_type m,
+	      index_type p0, length_type k, S *buffer)
+{
+  length_type const mr = simd::gemm_mr;
+  for (index_type i = 0; i < m; i += mr, buffer += k * mr)
+  {
+    length_type const rows = std::min(mr, m - i);
+    for (index_type p = 0; p != k; ++p)
+    {
+      S *column = buffer + p * mr;
+      for (index_type r = 0; r != rows; ++r)
+	column[r] = a.get(i0 + i + r, p0 + p);
+      std::fill(column + rows, column + mr, S(0));
+    }
+  }
+}
+
+// Pack the k x n block of `b` at (p0, j0) into panels of nr columns,
+// each stored row by row, padding the last one with zeros.
+template <typename S, typename B>
+void pack_rhs(B const &b, index_type p0, length_type k,
+	      index_type j0, length_type n, length_type nr, S *buffer)
+{
+  for (index_type j = 0; j < n; j += nr, buffer += k * nr)
+  {
+    length_type const cols = std::min(nr, n - j);
+    for (index_type p = 0; p != k; ++p)
+    {
+      S *row = buffer + p * nr;
+      for (index_type c = 0; c != cols; ++c)
+	row[c] = b.get(p0 + p, j0 + j + c);
+      std::fill(row + cols, row + nr, S(0));
+    }
+  }
+}
+
+// Multiply block `c / slices` of mc rows of `a` with slice `c % slices`
+// of the packed block of `b`, adding the result to `r` if `accumulate`
+// is set. Task `c` packs its block of `a` into the `c`th slab of
+// `a_packed`, so concurrent tasks don't share buffers.
+template <typename S, typename A, typename R>
+struct gemm_task
+{
+  A const *a;
+  R const *r;
+  S const *b;
+  S *a_packed;
+  length_type slab;
+  length_type m;
+  index_type j0;
+  length_type n;
+  index_type p0;
+  length_type k;
+  length_type nr;
+  length_type slices;
+  length_type slice;
+  bool accumulate;
+
+  void operator()(index_type c)
+  {
+    length_type const mr = simd::gemm_mr;
+    index_type const i0 = (c / slices) * mc;
+    length_type const rows = std::min(mc, m - i0);
+    index_type const begin = (c % slices) * slice;
+    if (begin >= n) return;
+    index_type const end = std::min(n, begin + slice);
+
+    S *packed = a_packed + c * slab;
+    pack_lhs(*a, i0, rows, p0, k, packed);
+    S tile[simd::gemm_mr * max_nr];
+    for (index_type j = begin; j < end; j += nr)
+    {
+      length_type const cols = std::min(nr, end - j);
+      for (index_type i = 0; i < rows; i += mr)
+      {
+	micro_kernel<S>::exec(k, packed + i * k, b + j * k, tile);
+	length_type const tile_rows = std::min(mr, rows - i);
+	for (index_type ti = 0; ti != tile_rows; ++ti)
+	  for (index_type tj = 0; tj != cols; ++tj)
+	  {
+	    S &x = r->ref(i0 + i + ti, j0 + j + tj);
+	    x = accumulate ? x + tile[ti * nr + tj] : tile[ti * nr + tj];
+	  }
+      }
+    }
+  }
+};
+
+// Compute rows [begin, end) of the matrix-vector product r = a * x,
+// for a dense x.
+template <typename S, typename A, typename R>
+struct gemv_task
+{
+  A const *a;
+  S const *x;
+  R const *r;
+  length_type m;
+  length_type k;
+  length_type chunk;
+
+  void operator()(index_type c)
+  {
+    index_type const begin = c * chunk;
+    if (begin >= m) return;
+    index_type const end = std::min(m, begin + chunk);
+    if (a->row_major())
+    {
+      // Walk the rows of a, four at a time.
+      index_type i = begin;
+      for (; i + 4 <= end; i += 4)
+      {
+	S s0 = S(), s1 = S(), s2 = S(), s3 = S();
+	for (index_type p = 0; p != k; ++p)
+	{
+	  s0 += a->get(i, p) * x[p];
+	  s1 += a->get(i + 1, p) * x[p];
+	  s2 += a->get(i + 2, p) * x[p];
+	  s3 += a->get(i + 3, p) * x[p];
+	}
+	r->ref(i, 0) = s0;
+	r->ref(i + 1, 0) = s1;
+	r->ref(i + 2, 0) = s2;
+	r->ref(i + 3, 0) = s3;
+      }
+      for (; i < end; ++i)
+      {
+	S s = S();
+	for (index_type p = 0; p != k; ++p)
+	  s += a->get(i, p) * x[p];
+	r->ref(i, 0) = s;
+      }
+    }
+    else
+    {
+      // Walk the columns of a, accumulating into a cache-sized block
+      // of results.
+      length_type const block = 1024;
+      S sum[block];
+      for (index_type i0 = begin; i0 < end; i0 += block)
+      {
+	length_type const rows = std::min(block, end - i0);
+	std::fill(sum, sum + rows, S());
+	for (index_type p = 0; p != k; ++p)
+	  for (index_type i = 0; i != rows; ++i)
+	    sum[i] += a->get(i0 + i, p) * x[p];
+	for (index_type i = 0; i != rows; ++i)
+	  r->ref(i0 + i, 0) = sum[i];
+      }
+    }
+  }
+};
+
+} // namespace ovxx::gemm::detail
+
+/// Compute the matrix-vector product r = a * x, with `a` m x k,
+/// splitting the rows across the default thread pool. `x` is copied
+/// into a dense buffer unless it already is dense.
+template <typename S, typename A, typename X, typename R>
+void
+gemv(length_type m, length_type k, A const &a, X const &x, R const &r)
+{
+  S const *dense = x.dense_column();
+  std::vector<S> packed;
+  if (!dense && k)
+  {
+    packed.resize(k);
+    for (index_type p = 0; p != k; ++p)
+      packed[p] = x.get(p, 0);
+    dense = &packed[0];
+  }
+
+  thread_pool *pool = thread_pool::get_default();
+  length_type chunks = 1;
+  if (pool->size() > 1 && m * k >= thread_pool::threshold())
+    chunks = std::min<length_type>(pool->size(), (m + 3) / 4);
+  detail::gemv_task<S, A, R> task =
+    {&a, dense, &r, m, k, detail::round_up((m + chunks - 1) / chunks, 4)};
+  if (chunks > 1)
+    pool->parallel_for(chunks, task);
+  else
+    task(0);
+}
+
+/// Compute the matrix product r = a * b, with `a` m x k and `b` k x n.
+///
+/// This follows the usual approach of packing blocks of `a` and `b`
+/// into contiguous panels that stay in cache, which are then combined
+/// by a SIMD micro-kernel computing a small tile of `r` in registers.
+/// Blocks of rows (and if needed, of columns) are distributed across
+/// the default thread pool.
+template <typename S, typename A, typename B, typename R>
+void
+gemm(length_type m, length_type n, length_type k,
+     A const &a, B const &b, R const &r)
+{
+  if (n == 1)
+    return gemv<S>(m, k, a, b, r);
+  if (k == 0)
+  {
+    for (index_type i = 0; i != m; ++i)
+      for (index_type j = 0; j != n; ++j)
+	r.ref(i, j) = S();
+    return;
+  }
+
+  length_type const nr = micro_kernel<S>::nr();
+  OVXX_PRECONDITION(nr <= max_nr);
+  thread_pool *pool = thread_pool::get_default();
+  bool const threaded = pool->size() > 1 && m * n * k >= thread_pool::threshold();
+  length_type const blocks = (m + mc - 1) / mc;
+  // The size of a packed block of `a`.
+  length_type const slab = detail::round_up(std::min(mc, m), simd::gemm_mr) *
+    std::min(kc, k);
+
+  std::vector<S> b_packed;
+  std::vector<S> a_packed;
+  for (index_type j0 = 0; j0 < n; j0 += nc)
+  {
+    length_type const cols = std::min(nc, n - j0);
+    // If there aren't enough blocks of rows to keep all threads busy,
+    // also split the columns.
+    length_type slices = 1;
+    if (threaded && blocks < pool->size())
+      slices = std::min((pool->size() + blocks - 1) / blocks, (cols + nr - 1) / nr);
+    length_type const slice = detail::round_up((cols + slices - 1) / slices, nr);
+    for (index_type p0 = 0; p0 < k; p0 += kc)
+    {
+      length_type const depth = std::min(kc, k - p0);
+      length_type const tasks = blocks * slices;
+      b_packed.resize(detail::round_up(cols, nr) * depth);
+      a_packed.resize(tasks * slab);
+      detail::pack_rhs(b, p0, depth, j0, cols, nr, &b_packed[0]);
+      detail::gemm_task<S, A, R> task =
+	{&a, &r, &b_packed[0], &a_packed[0], slab,
+	 m, j0, cols, p0, depth, nr, slices, slice, p0 != 0};
+      if (threaded && tasks > 1)
+	pool->parallel_for(tasks, task);
+      else
+	for (index_type t = 0; t != tasks; ++t)
+	  task(t);
+    }
+  }
+}
+
+/// Compute r = a * b (or a * conj(b) if `conj` is set), with `a` an
+/// m x k and `b` a k x n matrix of values of type T, given as pointers
+/// and (row, column) strides. Pointers to complex values may be split.
+template <typename T, typename PA, typename PB, typename PR>
+void
+prod(length_type m, length_type n, length_type k,
+     PA a, stride_type a_row, stride_type a_col,
+     PB b, stride_type b_row, stride_type b_col, bool conj,
+     PR r, stride_type r_row, stride_type r_col)
+{
+  typedef expansion<T> e;
+  typename e::lhs_type lhs(a, a_row, a_col);
+  typename e::rhs_type rhs(b, b_row, b_col, conj);
+  typename e::result_type result(r, r_row, r_col);
+  gemm<typename e::scalar_type>(e::factor * m, n, e::factor * k, lhs, rhs, result);
+}
+
+/// Access to the data of a block as needed by `prod()`: directly if
+/// possible, otherwise through a copy.
+template <typename B, dda::sync_policy S>
+struct operand
+{
+  typedef typename get_block_layout<B>::order_type order_type;
+  static storage_format_type const format =
+    get_block_layout<B>::storage_format == split_complex ? split_complex : array;
+  static bool const direct =
+    !is_expr_block<B>::value &&
+    get_block_layout<B>::storage_format == format &&
+    dda::Data<B, S>::ct_cost == 0;
+  typedef typename conditional<direct,
+    typename get_block_layout<B>::type,
+    Layout<B::dim, order_type, dense, format> >::type layout_type;
+  typedef dda::Data<B, S, layout_type> type;
+};
+
+} // namespace ovxx::gemm
+} // namespace ovxx
+
+#endif
@@ -8,6 +8,8 @@
 
 #include <ovxx/library.hpp>
 #include <ovxx/allocator.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <ovxx/simd/simd.hpp>
 #include <ovxx/c++11/chrono.hpp>
 #if defined(OVXX_ENABLE_THREADING)
 # include <ovxx/c++11/thread.hpp>
@@ -17,6 +19,8 @@
 #endif
 #if OVXX_HAVE_MPI
 # include <ovxx/mpi/service.hpp>
+#elif OVXX_HAVE_SHM
+# include <ovxx/shm/service.hpp>
 #endif
 #if defined(OVXX_ENABLE_OMP)
 # include <omp.h>
@@ -29,6 +33,9 @@ extern "C" {
 #if defined(OVXX_FFTW_THREADS)
 # include <fftw3.h>
 #endif
+#if defined(OVXX_FFTW)
+# include <ovxx/fftw/wisdom.hpp>
+#endif
 
 using namespace ovxx;
 
@@ -50,6 +57,25 @@ thread_local library *omp_library = 0;
 unsigned int thread_local_count = 0;
 #endif
 
+#if defined(OVXX_FFTW_HAVE_THREADS_CALLBACK)
+// FFTW runs its parallel loops on the library's thread pool,
+// rather than on threads of its own.
+struct fftw_jobs
+{
+  void *(*work)(char *);
+  char *data;
+  size_t size;
+  void operator()(index_type i) { work(data + i * size);}
+};
+
+void fftw_parallel_for(void *(*work)(char *), char *data, size_t size,
+		       int jobs, void *)
+{
+  fftw_jobs f = {work, data, size};
+  thread_pool::get_default()->parallel_for(jobs, f);
+}
+#endif
+
 void initialize(int &argc, char **&argv)
 {
   {
@@ -65,6 +91,8 @@ void initialize(int &argc, char **&argv)
 #ifndef OVXX_TIMER_SYSTEM
     cxx11::chrono::high_resolution_clock::init();
 #endif
+    thread_pool::initialize(argc, argv);
+    simd::initialize();
 #if defined(OVXX_HAVE_OPENCL)
     ovxx::opencl::initialize();
 #endif
@@ -72,32 +100,46 @@ void initialize(int &argc, char **&argv)
     vsip_init(0);
 #endif
 #if defined(OVXX_FFTW_THREADS)
+    // FFTW uses as many threads as the library's pool.
+    int const threads = thread_pool::get_default()->size();
     int status = 0;
 # ifdef OVXX_FFTW_HAVE_FLOAT
     status = fftwf_init_threads();
     if (!status)
       OVXX_DO_THROW(std::runtime_error("Error during FFTW initialization"));
-    fftwf_plan_with_nthreads(4);
+    fftwf_plan_with_nthreads(threads);
+#  ifdef OVXX_FFTW_HAVE_THREADS_CALLBACK
+    fftwf_threads_set_callback(fftw_parallel_for, 0);
+#  endif
 # endif
 # ifdef OVXX_FFTW_HAVE_DOUBLE
     status = fftw_init_threads();
     if (!status)
       OVXX_DO_THROW(std::runtime_error("Error during FFTW initialization"));
-    fftw_plan_with_nthreads(4);
+    fftw_plan_with_nthreads(threads);
+#  ifdef OVXX_FFTW_HAVE_THREADS_CALLBACK
+    fftw_threads_set_callback(fftw_parallel_for, 0);
+#  endif
 # endif
 #endif // OVXX_FFTW_THREADS
+#if defined(OVXX_FFTW)
+    fftw::initialize(argc, argv);
+#endif
   }
   if (thread_local_count == 1)
   {
     allocator::initialize(argc, argv);
 #if OVXX_HAVE_MPI
     mpi::initialize(argc, argv);
+#elif OVXX_HAVE_SHM
+    shm::initialize(argc, argv);
 #endif
   }
 #ifdef OVXX_ENABLE_OMP
   if (global_count == 1)
   {
-    // Initialize OpenMP threads
+    // Initialize OpenMP threads, using as many as the library's pool.
+    omp_set_num_threads(thread_pool::get_default()->size());
 #pragma omp parallel
     // thread 0 is the main thread, which is already
     // initialized.
@@ -134,6 +176,9 @@ void finalize()
 #if OVXX_HAVE_MPI
     mpi::finalize(global_count == 0);
     allocator::finalize();
+#elif OVXX_HAVE_SHM
+    shm::finalize(global_count == 0);
+    allocator::finalize();
 #endif
   }
   if (!global_count)
@@ -144,6 +189,10 @@ void finalize()
 #if defined(OVXX_HAVE_OPENCL)
     ovxx::opencl::finalize();
 #endif
+#if defined(OVXX_FFTW)
+    fftw::finalize();
+#endif
+    thread_pool::finalize();
   }
 }
 } // namespace <unnamed>
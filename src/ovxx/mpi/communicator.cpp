@@ -7,11 +7,150 @@
 // license contained in the accompanying LICENSE.BSD file.
 
 #include <ovxx/mpi/communicator.hpp>
+#include <algorithm>
+#include <cstring>
 
 namespace ovxx
 {
 namespace mpi
 {
+namespace
+{
+length_type node_size = 0;
+}
+
+void set_node_size(length_type size) { node_size = size;}
+
+/// The processors of a communicator, grouped into nodes.
+/// This is set up the first time a collective operation needs it,
+/// as that requires communication.
+struct Communicator::Nodes
+{
+  Nodes()
+    : initialized(false), hierarchical(false),
+      node(MPI_COMM_NULL), leaders(MPI_COMM_NULL),
+      window(MPI_WIN_NULL), buffer(0), capacity(0), phase(0)
+  {}
+  ~Nodes()
+  {
+    int finalized;
+    OVXX_MPI_CHECK_RESULT(MPI_Finalized, (&finalized));
+    if (finalized) return;
+    free_window();
+    if (leaders != MPI_COMM_NULL) MPI_Comm_free(&leaders);
+    if (node != MPI_COMM_NULL) MPI_Comm_free(&node);
+  }
+
+  void initialize(MPI_Comm comm);
+  void reserve(size_t bytes);
+  void free_window();
+
+  bool initialized;
+  /// Whether collectives go through the node leaders. That only
+  /// pays off if there are several nodes, one of which has
+  /// several processors.
+  bool hierarchical;
+  /// The processors on this node.
+  MPI_Comm node;
+  /// The node leaders (rank 0 of each node), or MPI_COMM_NULL
+  /// if this processor isn't one.
+  MPI_Comm leaders;
+  /// The node of each processor (i.e., the rank of its leader in
+  /// `leaders`), and its rank within that node.
+  std::vector<int> node_of;
+  std::vector<int> node_rank;
+  /// The rank of each processor's leader.
+  std::vector<int> leader;
+  /// A shared-memory window owned by the leader, holding two
+  /// buffers of `capacity / 2` bytes each, used in turn.
+  MPI_Win window;
+  char *buffer;
+  size_t capacity;
+  int phase;
+};
+
+void Communicator::Nodes::initialize(MPI_Comm comm)
+{
+  initialized = true;
+  int rank, size;
+  OVXX_MPI_CHECK_RESULT(MPI_Comm_rank, (comm, &rank));
+  OVXX_MPI_CHECK_RESULT(MPI_Comm_size, (comm, &size));
+
+  MPI_Comm shared;
+  OVXX_MPI_CHECK_RESULT(MPI_Comm_split_type,
+    (comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &shared));
+  int shared_rank;
+  OVXX_MPI_CHECK_RESULT(MPI_Comm_rank, (shared, &shared_rank));
+  if (node_size)
+  {
+    // Split the processors sharing memory into nodes of at most
+    // `node_size` processors each.
+    OVXX_MPI_CHECK_RESULT(MPI_Comm_split,
+      (shared, shared_rank / node_size, rank, &node));
+    MPI_Comm_free(&shared);
+  }
+  else node = shared;
+
+  int local_rank;
+  OVXX_MPI_CHECK_RESULT(MPI_Comm_rank, (node, &local_rank));
+  OVXX_MPI_CHECK_RESULT(MPI_Comm_split,
+    (comm, local_rank == 0 ? 0 : MPI_UNDEFINED, rank, &leaders));
+  int mine[2] = { 0, local_rank};
+  if (leaders != MPI_COMM_NULL)
+    OVXX_MPI_CHECK_RESULT(MPI_Comm_rank, (leaders, &mine[0]));
+  OVXX_MPI_CHECK_RESULT(MPI_Bcast, (&mine[0], 1, MPI_INT, 0, node));
+
+  std::vector<int> all(2 * size);
+  OVXX_MPI_CHECK_RESULT(MPI_Allgather,
+    (mine, 2, MPI_INT, &all[0], 2, MPI_INT, comm));
+  node_of.resize(size);
+  node_rank.resize(size);
+  int num_nodes = 0;
+  for (int p = 0; p != size; ++p)
+  {
+    node_of[p] = all[2 * p];
+    node_rank[p] = all[2 * p + 1];
+    num_nodes = std::max(num_nodes, node_of[p] + 1);
+  }
+  hierarchical = num_nodes > 1 && num_nodes < size;
+  std::vector<int> leader_of(num_nodes);
+  for (int p = 0; p != size; ++p)
+    if (node_rank[p] == 0) leader_of[node_of[p]] = p;
+  leader.resize(size);
+  for (int p = 0; p != size; ++p)
+    leader[p] = leader_of[node_of[p]];
+}
+
+/// Make sure each of the window's buffers holds at least `bytes`.
+/// All processors on the node call this with the same size.
+void Communicator::Nodes::reserve(size_t bytes)
+{
+  if (2 * bytes <= capacity) return;
+  free_window();
+  capacity = std::max(2 * bytes, 2 * capacity);
+  int local_rank;
+  OVXX_MPI_CHECK_RESULT(MPI_Comm_rank, (node, &local_rank));
+  OVXX_MPI_CHECK_RESULT(MPI_Win_allocate_shared,
+    (local_rank == 0 ? capacity : 0, 1, MPI_INFO_NULL, node,
+     &buffer, &window));
+  MPI_Aint size;
+  int disp_unit;
+  OVXX_MPI_CHECK_RESULT(MPI_Win_shared_query,
+    (window, 0, &size, &disp_unit, &buffer));
+  OVXX_MPI_CHECK_RESULT(MPI_Win_lock_all, (MPI_MODE_NOCHECK, window));
+  phase = 0;
+}
+
+void Communicator::Nodes::free_window()
+{
+  if (window == MPI_WIN_NULL) return;
+  // Make sure nobody is still reading from the window.
+  MPI_Barrier(node);
+  MPI_Win_unlock_all(window);
+  MPI_Win_free(&window);
+  buffer = 0;
+  capacity = 0;
+}
 
 struct comm_free
 {
@@ -28,9 +167,11 @@ struct comm_free
 Communicator::Communicator()
 {
   impl_.reset(new MPI_Comm(MPI_COMM_WORLD));
+  nodes_.reset(new Nodes);
 }
 
 Communicator::Communicator(MPI_Comm const & comm, comm_create_kind kind)
+  : nodes_(new Nodes)
 {
   if (comm == MPI_COMM_NULL)
     /* MPI_COMM_NULL indicates that the communicator is not usable. */
@@ -61,6 +202,7 @@ Communicator::Communicator(MPI_Comm const & comm, comm_create_kind kind)
 }
 
 Communicator::Communicator(Communicator const &comm, Group const &subgroup)
+  : nodes_(new Nodes)
 {
   MPI_Comm newcomm;
   OVXX_MPI_CHECK_RESULT(MPI_Comm_create, (comm, subgroup, &newcomm));
@@ -76,5 +218,98 @@ Communicator::Communicator(Communicator const &comm, Group const &subgroup)
   }
 }
 
+Communicator::Nodes &Communicator::nodes() const
+{
+  if (!nodes_->initialized) nodes_->initialize(*this);
+  return *nodes_;
+}
+
+processor_type Communicator::node_leader(processor_type proc) const
+{
+  Nodes &n = nodes();
+  return n.hierarchical ? n.leader[proc] : proc;
+}
+
+// Send the root's data to its node's leader, broadcast it among
+// the leaders, and replicate it within each node.
+void Communicator::broadcast(processor_type root_proc, void *data, int count,
+			     MPI_Datatype type, size_t bytes)
+{
+  Nodes &n = nodes();
+  if (!n.hierarchical)
+  {
+    OVXX_MPI_CHECK_RESULT(MPI_Bcast, (data, count, type, root_proc, *this));
+    return;
+  }
+  processor_type const self = rank();
+  int const root_node = n.node_of[root_proc];
+  int const root_rank = n.node_rank[root_proc];
+  if (root_rank != 0 && n.node_of[self] == root_node)
+  {
+    if (self == root_proc)
+    {
+      OVXX_MPI_CHECK_RESULT(MPI_Send, (data, count, type, 0, 0, n.node));
+    }
+    else if (n.node_rank[self] == 0)
+    {
+      OVXX_MPI_CHECK_RESULT(MPI_Recv,
+        (data, count, type, root_rank, 0, n.node, MPI_STATUS_IGNORE));
+    }
+  }
+  if (n.leaders != MPI_COMM_NULL)
+    OVXX_MPI_CHECK_RESULT(MPI_Bcast, (data, count, type, root_node, n.leaders));
+  replicate(n, data, bytes);
+}
+
+// Reduce within each node, then among the leaders, and
+// replicate the result within each node.
+void Communicator::allreduce(void const *value, void *result,
+			     MPI_Datatype type, MPI_Op op, size_t bytes)
+{
+  Nodes &n = nodes();
+  if (!n.hierarchical)
+  {
+    OVXX_MPI_CHECK_RESULT(MPI_Allreduce,
+      (const_cast<void*>(value), result, 1, type, op, *this));
+    return;
+  }
+  OVXX_MPI_CHECK_RESULT(MPI_Reduce,
+    (const_cast<void*>(value), result, 1, type, op, 0, n.node));
+  if (n.leaders != MPI_COMM_NULL)
+    OVXX_MPI_CHECK_RESULT(MPI_Allreduce,
+      (MPI_IN_PLACE, result, 1, type, op, n.leaders));
+  replicate(n, result, bytes);
+}
+
+// Copy the node leader's data to the other processors on its node.
+// The leader alternates between the window's two buffers, so the
+// others are done reading a buffer by the time the leader writes
+// into it again (after the next call's barrier).
+void Communicator::replicate(Nodes &n, void *data, size_t bytes)
+{
+  if (!bytes) return;
+  n.reserve(bytes);
+  char *buffer = n.buffer + n.phase * (n.capacity / 2);
+  n.phase = 1 - n.phase;
+  bool const leader = n.leaders != MPI_COMM_NULL;
+  if (leader)
+  {
+    std::memcpy(buffer, data, bytes);
+    MPI_Win_sync(n.window);
+  }
+  OVXX_MPI_CHECK_RESULT(MPI_Barrier, (n.node));
+  if (!leader)
+  {
+    MPI_Win_sync(n.window);
+    std::memcpy(data, buffer, bytes);
+  }
+}
+
+void Communicator::replicate_bytes(void *data, size_t bytes)
+{
+  Nodes &n = nodes();
+  if (n.hierarchical) replicate(n, data, bytes);
+}
+
 } // namespace ovxx::mpi
 } // namespace ovxx
@@ -22,6 +22,11 @@ namespace ovxx
 namespace mpi
 {
 
+/// Set the maximum number of processors node-aware collectives
+/// group into a node. By default (0) all processors sharing memory
+/// form one node.
+void set_node_size(length_type size);
+
 /// A communicator permits communication and
 /// synchronization among a set of processes.
 class Communicator
@@ -96,12 +101,51 @@ public:
 
   void wait(request_type& req);
 
+  /// Create persistent requests, which are started with `start()`
+  /// and released with `free()`.
+  template <typename T>
+  void send_init(processor_type dest_proc, T* data, length_type size,
+		 request_type& req);
+
+  void send_init(processor_type dest_proc, chain_type& chain,
+		 request_type& req);
+
+  template <typename T>
+  void recv_init(processor_type src_proc, T* data, length_type size,
+		 request_type& req);
+
+  void recv_init(processor_type src_proc, chain_type& chain,
+		 request_type& req);
+
+  void start(std::vector<request_type>& reqs);
+
+  void wait(std::vector<request_type>& reqs);
+
+  void free(request_type& req);
+
+  /// Collective operations are node-aware: if the communicator
+  /// spans several nodes, with several processors on some of them,
+  /// only one processor per node (its leader) takes part in the
+  /// inter-node communication, and the result is replicated
+  /// within each node through shared memory.
   template <typename T>
   void broadcast(processor_type root_proc, T* data, length_type size);
 
   template <typename T>
   T allreduce(reduction_type rdx, T value);
 
+  /// Return the leader of processor `proc`'s node, if collectives
+  /// are node-aware, and `proc` itself otherwise. This is a
+  /// collective operation the first time it is called.
+  processor_type node_leader(processor_type proc) const;
+
+  /// Copy `size` elements at `data` from each node's leader to the
+  /// other processors on its node, if collectives are node-aware.
+  /// All processors call this with the same size.
+  template <typename T>
+  void replicate(T* data, length_type size)
+  { replicate_bytes(data, size * sizeof(T));}
+
   int impl_ll_pset() const VSIP_NOTHROW { return 0;}
   // { return ll_pset_type(); }
 
@@ -109,8 +153,20 @@ public:
   friend bool operator==(Communicator const&, Communicator const&);
 
 private:
+  struct Nodes;
+
+  Nodes &nodes() const;
+  void broadcast(processor_type root_proc, void *data, int count,
+		 MPI_Datatype type, size_t bytes);
+  void allreduce(void const *value, void *result, MPI_Datatype type,
+		 MPI_Op op, size_t bytes);
+  void replicate(Nodes &nodes, void *data, size_t bytes);
+  void replicate_bytes(void *data, size_t bytes);
+
   ovxx::shared_ptr<MPI_Comm> impl_;
   pvec_type pvec_;
+  /// The node layout, shared by all copies of this communicator.
+  ovxx::shared_ptr<Nodes> nodes_;
 };
 
 inline bool
@@ -178,13 +234,78 @@ Communicator::wait(request_type& req)
   MPI_Wait(&req, &status);
 }
 
+template <typename T>
+inline void
+Communicator::send_init(processor_type dest_proc,
+			T *data,
+			length_type size,
+			request_type &req)
+{
+  OVXX_MPI_CHECK_RESULT(MPI_Send_init,
+    (data, size, Datatype<T>::value(), dest_proc, 0, *this, &req));
+}
+
+inline void
+Communicator::send_init(processor_type dest_proc, chain_type &chain,
+			request_type &req)
+{
+  OVXX_MPI_CHECK_RESULT(MPI_Send_init,
+    (MPI_BOTTOM, 1, chain, dest_proc, 0, *this, &req));
+}
+
+template <typename T>
+inline void
+Communicator::recv_init(processor_type src_proc,
+			T *data,
+			length_type size,
+			request_type &req)
+{
+  OVXX_MPI_CHECK_RESULT(MPI_Recv_init,
+    (data, size, Datatype<T>::value(), src_proc, 0, *this, &req));
+}
+
+inline void
+Communicator::recv_init(processor_type src_proc, chain_type &chain,
+			request_type &req)
+{
+  OVXX_MPI_CHECK_RESULT(MPI_Recv_init,
+    (MPI_BOTTOM, 1, chain, src_proc, 0, *this, &req));
+}
+
+/// Start a list of persistent requests.
+/// The requests are started in order (unlike with `MPI_Startall`),
+/// so messages between the same pair of processors are matched in
+/// the order they appear in the list.
+inline void
+Communicator::start(std::vector<request_type> &reqs)
+{
+  for (std::vector<request_type>::iterator i = reqs.begin(); i != reqs.end(); ++i)
+    OVXX_MPI_CHECK_RESULT(MPI_Start, (&*i));
+}
+
+/// Wait for a list of communications to complete.
+/// Persistent requests remain valid, and may be started again.
+inline void
+Communicator::wait(std::vector<request_type> &reqs)
+{
+  if (reqs.empty()) return;
+  OVXX_MPI_CHECK_RESULT(MPI_Waitall,
+    (static_cast<int>(reqs.size()), &reqs[0], MPI_STATUSES_IGNORE));
+}
+
+/// Release a persistent request.
+inline void
+Communicator::free(request_type &req)
+{
+  MPI_Request_free(&req);
+}
+
 /// Broadcast a value from root processor to other processors.
 template <typename T>
 inline void
 Communicator::broadcast(processor_type root_proc, T* data, length_type size)
 {
-  OVXX_MPI_CHECK_RESULT(MPI_Bcast,
-    (data, size, Datatype<T>::value(), root_proc, *this));
+  broadcast(root_proc, data, size, Datatype<T>::value(), size * sizeof(T));
 }
 
 /// Reduce a value from all processors to all processors.
@@ -208,8 +329,7 @@ Communicator::allreduce(reduction_type rtype, T value)
   default: OVXX_UNREACHABLE("invalid reduction type");
   }
 
-  OVXX_MPI_CHECK_RESULT(MPI_Allreduce, 
-    (&value, &result, 1, Datatype<T>::value(), op, *this));
+  allreduce(&value, &result, Datatype<T>::value(), op, sizeof(T));
   return result;
 }
 
@@ -7,7 +7,9 @@
 // license contained in the accompanying LICENSE.BSD file.
 
 #include "service.hpp"
+#include <ovxx/options.hpp>
 #include <cstring>
+#include <cstdlib>
 #include <iostream>
 
 namespace
@@ -48,6 +50,10 @@ void initialize(int &argc, char **&argv)
     // Initialize complex datatypes.
     Datatype<complex<float> >::value();
     Datatype<complex<double> >::value();
+    std::string const node_size =
+      options::get(argc, argv, "ovxx-node-size", "OVXX_NODE_SIZE");
+    if (!node_size.empty())
+      set_node_size(std::strtoul(node_size.c_str(), 0, 10));
   }
   communicator = new Communicator(MPI_COMM_WORLD, Communicator::comm_attach);
 }
@@ -101,6 +107,7 @@ index_type local_processor_index() VSIP_NOTHROW
   processor_type proc = local_processor();
   for (index_type i = 0; i != pvec.size(); ++i)
     if (pvec[i] == proc) return i;
-  assert(0); // Invalid local processor
+  OVXX_UNREACHABLE("invalid local processor");
+  return 0;
 }
 }
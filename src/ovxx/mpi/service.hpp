@@ -27,6 +27,15 @@ namespace ovxx
 namespace mpi
 {
 
+/// Initialize the MPI library (unless the application already did),
+/// as well as the calling thread's default communicator.
+/// Node-aware collectives, and assignments to views replicated on
+/// all processors, can be tuned with the following
+/// command-line option, or the corresponding environment variable:
+///
+///   :--ovxx-node-size (OVXX_NODE_SIZE):
+///     the maximum number of processors per node. Defaults to all
+///     processors sharing memory.
 void initialize(int &, char **&);
 void finalize(bool);
 
@@ -42,6 +51,11 @@ using mpi::free_chain;
 typedef int ll_pbuf_type;
 typedef int ll_pset_type;
 
+/// Run `program` on this processor. (The processors themselves are
+/// started by `mpirun`.)
+inline int run(int (*program)(int, char **), int argc, char **argv)
+{ return program(argc, argv);}
+
 /// Set new default communicator, and return the old one.
 Communicator set_default_communicator(Communicator c);
 Communicator &default_communicator();
@@ -63,6 +77,8 @@ template <> struct reduction_supported<reduce_sum, int>
 { static bool const value = true;};
 template <> struct reduction_supported<reduce_sum, float>
 { static bool const value = true;};
+template <> struct reduction_supported<reduce_sum, double>
+{ static bool const value = true;};
 template <> struct reduction_supported<reduce_all_true, int>
 { static bool const value = true;};
 template <> struct reduction_supported<reduce_all_true_bool, bool>
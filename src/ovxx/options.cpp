@@ -0,0 +1,61 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#include <ovxx/options.hpp>
+#include <ovxx/support.hpp>
+#include <cstdlib>
+#include <cstring>
+
+namespace ovxx
+{
+namespace options
+{
+
+bool extract(int &argc, char **&argv, char const *name, std::string &value)
+{
+  std::size_t const length = std::strlen(name);
+  for (int i = 1; i < argc; ++i)
+  {
+    char const *arg = argv[i];
+    if (std::strncmp(arg, "--", 2) || std::strncmp(arg + 2, name, length))
+      continue;
+    arg += 2 + length;
+    int consumed;
+    if (*arg == '=')
+    {
+      value = arg + 1;
+      consumed = 1;
+    }
+    else if (*arg == '\0' && i + 1 < argc)
+    {
+      value = argv[i + 1];
+      consumed = 2;
+    }
+    else continue;
+    // Shift the remaining arguments (including the terminating null
+    // pointer) down.
+    for (int j = i; j + consumed <= argc; ++j)
+      argv[j] = argv[j + consumed];
+    argc -= consumed;
+    return true;
+  }
+  return false;
+}
+
+std::string get(int &argc, char **&argv, char const *name, char const *env,
+		std::string const &fallback)
+{
+  std::string value;
+  if (extract(argc, argv, name, value)) return value;
+#if HAVE_GETENV
+  if (char const *e = std::getenv(env)) return e;
+#endif
+  return fallback;
+}
+
+} // namespace ovxx::options
+} // namespace ovxx
@@ -0,0 +1,32 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_options_hpp_
+#define ovxx_options_hpp_
+
+#include <string>
+
+namespace ovxx
+{
+namespace options
+{
+
+/// Look for the option `--<name>=<value>` or `--<name> <value>` on the
+/// command line. If found, store its value in `value`, remove the option
+/// from argv, and return true.
+bool extract(int &argc, char **&argv, char const *name, std::string &value);
+
+/// Return the value of the command-line option `name` if given,
+/// otherwise that of the environment variable `env`, if set.
+/// Otherwise return `fallback`.
+std::string get(int &argc, char **&argv, char const *name, char const *env,
+		std::string const &fallback = std::string());
+
+} // namespace ovxx::options
+} // namespace ovxx
+
+#endif
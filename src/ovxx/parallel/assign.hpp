@@ -128,6 +128,49 @@ struct Dispatcher<D, LHS, RHS, par_expr_noreorg>
   }
 };
 } // namespace ovxx::assignment
+
+namespace parallel
+{
+/// A reusable plan for the redistribution of the distributed view `rhs`
+/// into the distributed view `lhs`, i.e. for `lhs = rhs`.
+///
+/// `lhs = rhs` computes the messages and MPI datatypes describing the
+/// transfer anew on each assignment. A Redistribution does that once,
+/// setting up persistent requests, so each call only starts and waits
+/// for them. This pays off for assignments that are repeated many
+/// times, such as corner turns.
+///
+/// The views need to stay valid, and their storage in place, for the
+/// lifetime of the plan.
+template <typename LHS, typename RHS>
+class Redistribution
+{
+  static dimension_type const dim = LHS::dim;
+  typedef typename LHS::block_type lhs_block_type;
+  typedef typename RHS::block_type rhs_block_type;
+  typedef typename
+  choose_par_assign_impl<dim, lhs_block_type, rhs_block_type, false>::type
+  impl_tag;
+
+public:
+  Redistribution(LHS lhs, RHS rhs) : assign_(lhs, rhs) {}
+
+  void operator()() { assign_();}
+
+  /// Start the redistribution, to be completed by `wait()`.
+  /// Other data can be computed on while this data is in
+  /// transit. Until `wait()` returns, `rhs` must not be
+  /// modified, and `lhs` neither read nor modified.
+  void start() { assign_.start();}
+  /// Wait for the completion of the redistribution.
+  /// A redistribution destroyed while still in transit is completed
+  /// by its destructor, which can't report communication errors.
+  void wait() { assign_.wait();}
+
+private:
+  Assignment<dim, lhs_block_type, rhs_block_type, impl_tag> assign_;
+};
+} // namespace ovxx::parallel
 } // namespace ovxx
 
 #endif
@@ -149,8 +149,10 @@ public:
       send_list (),
       recv_list (),
       copy_list (),
-      req_list  (),
+      send_reqs (),
+      recv_reqs (),
       msg_count (0),
+      pending_  (false),
       src_dda_  (src_.local().block(), dda::in),
       dst_dda_  (dst_.local().block(), dda::out)
   {
@@ -160,27 +162,69 @@ public:
     if (!disable_copy)
       build_copy_list();
     build_recv_list();
+
+    init_send_list();
+    init_recv_list();
   }
 
   ~Assignment()
   {
-    // At destruction, the list of outstanding sends should be empty.
-    // This would be non-empty if:
-    //  - Par_assign did not to clear the lists after
-    //    processing it (library design error), or
-    //  - User executed send() without a corresponding wait().
-    OVXX_PRECONDITION(req_list.size() == 0);
+    // Complete an assignment that was started but not waited for.
+    // Errors can't be reported from here, and throwing during stack
+    // unwinding would terminate the program, so they are dropped.
+    // Callers that need to see them must call wait() themselves.
+    if (pending_)
+    {
+#if VSIP_HAS_EXCEPTIONS
+      try { wait();}
+      catch (...) { pending_ = false;}
+#else
+      wait();
+#endif
+    }
+
+    for (index_type i = 0; i != send_reqs.size(); ++i)
+      comm_.free(send_reqs[i]);
+    for (index_type i = 0; i != recv_reqs.size(); ++i)
+      comm_.free(recv_reqs[i]);
   }
 
+  /// Perform the assignment.
+  /// All messages are set up as persistent requests when the
+  /// assignment is constructed, so repeated executions only need
+  /// to start them and wait for their completion.
   void operator()()
   {
+    start();
+    wait();
+  }
+
+  /// Start the assignment, without waiting for it to complete.
+  /// Until `wait()` returns, the source must not be modified, and
+  /// the destination must be neither read nor modified.
+  void start()
+  {
+    OVXX_PRECONDITION(!pending_);
+    if (recv_list.size() > 0) start_recv_list();
     if (send_list.size() > 0) exec_send_list();
-    if (copy_list.size() > 0) exec_copy_list();
+    // Local copies overlap with the communication, unless the
+    // received data needs to be copied out of a temporary buffer
+    // later on, which would overwrite them.
+    if (copy_list.size() > 0 && dst_dda_type::ct_cost == 0) exec_copy_list();
+    pending_ = true;
+  }
+
+  /// Wait for the completion of an assignment started with `start()`.
+  void wait()
+  {
+    if (!pending_) return;
     if (recv_list.size() > 0) exec_recv_list();
+    if (copy_list.size() > 0 && dst_dda_type::ct_cost != 0) exec_copy_list();
 
-    if (req_list.size() > 0)  wait_send_list();
+    if (send_list.size() > 0) wait_send_list();
 
     cleanup();
+    pending_ = false;
   }
 
 private:
@@ -191,6 +235,10 @@ private:
   void build_recv_list();
   void build_copy_list();
 
+  void init_send_list();
+  void init_recv_list();
+
+  void start_recv_list();
   void exec_send_list();
   void exec_recv_list();
   void exec_copy_list();
@@ -208,27 +256,29 @@ private:
   std::vector<Msg_record>    recv_list;
   std::vector<Copy_record>   copy_list;
 
-  std::vector<request_type> req_list;
+  std::vector<request_type> send_reqs;
+  std::vector<request_type> recv_reqs;
 
   int                       msg_count;
+  bool                      pending_;
 
   src_dda_type              src_dda_;
   dst_dda_type              dst_dda_;
 };
 
-// Overload set for send, abstracts handling of interleaved- and
+// Overload set for send_init, abstracts handling of interleaved- and
 // split- complex.
 
 template <typename T>
 void
-send(Communicator&                            comm,
-     processor_type                           proc,
-     T*                                       data,
-     length_type                              size,
-     std::vector<Communicator::request_type>& req_list)
+send_init(Communicator&                            comm,
+	  processor_type                           proc,
+	  T*                                       data,
+	  length_type                              size,
+	  std::vector<Communicator::request_type>& req_list)
 {
   Communicator::request_type   req;
-  comm.send(proc, data, size, req);
+  comm.send_init(proc, data, size, req);
   req_list.push_back(req);
 }
 
@@ -236,43 +286,51 @@ send(Communicator&                            comm,
 
 template <typename T>
 void
-send(Communicator&                            comm,
-     processor_type                           proc,
-     std::pair<T*, T*> const&                 data,
-     length_type                              size,
-     std::vector<Communicator::request_type>& req_list)
+send_init(Communicator&                            comm,
+	  processor_type                           proc,
+	  std::pair<T*, T*> const&                 data,
+	  length_type                              size,
+	  std::vector<Communicator::request_type>& req_list)
 {
   Communicator::request_type   req1;
   Communicator::request_type   req2;
-  comm.send(proc, data.first,  size, req1);
-  comm.send(proc, data.second, size, req2);
+  comm.send_init(proc, data.first,  size, req1);
+  comm.send_init(proc, data.second, size, req2);
   req_list.push_back(req1);
   req_list.push_back(req2);
 }
 
-// Overload set for recv, abstracts handling of interleaved- and
+// Overload set for recv_init, abstracts handling of interleaved- and
 // split- complex.
 template <typename T>
 inline void
-recv(Communicator &comm,
-     processor_type proc,
-     T*             data,
-     length_type    size)
+recv_init(Communicator&                            comm,
+	  processor_type                           proc,
+	  T*                                       data,
+	  length_type                              size,
+	  std::vector<Communicator::request_type>& req_list)
 {
-  comm.recv(proc, data, size);
+  Communicator::request_type   req;
+  comm.recv_init(proc, data, size, req);
+  req_list.push_back(req);
 }
 
 
 
 template <typename T>
 inline void
-recv(Communicator&      comm,
-     processor_type           proc,
-     std::pair<T*, T*> const& data,
-     length_type              size)
+recv_init(Communicator&                            comm,
+	  processor_type                           proc,
+	  std::pair<T*, T*> const&                 data,
+	  length_type                              size,
+	  std::vector<Communicator::request_type>& req_list)
 {
-  comm.recv(proc, data.first, size);
-  comm.recv(proc, data.second, size);
+  Communicator::request_type   req1;
+  Communicator::request_type   req2;
+  comm.recv_init(proc, data.first,  size, req1);
+  comm.recv_init(proc, data.second, size, req2);
+  req_list.push_back(req1);
+  req_list.push_back(req2);
 }
 
 
@@ -509,18 +567,12 @@ Assignment<D, LHS, RHS, Blkvec_assign>::build_copy_list()
 }
 
 
-// Execute the send_list.
+// Create persistent requests for the send_list.
 
 template <dimension_type D, typename LHS, typename RHS>
 void
-Assignment<D, LHS, RHS, Blkvec_assign>::exec_send_list()
+Assignment<D, LHS, RHS, Blkvec_assign>::init_send_list()
 {
-#if OVXX_ABV_VERBOSE >= 1
-  processor_type rank = local_processor();
-  std::cout << "(" << rank << ") "
-	    << "exec_send_list(size: " << send_list.size()
-	    << ") -------------------------------------\n";
-#endif
   typedef typename std::vector<Msg_record>::iterator sl_iterator;
   typedef storage_traits<typename RHS::value_type, src_lp::storage_format> storage;
 
@@ -528,47 +580,78 @@ Assignment<D, LHS, RHS, Blkvec_assign>::exec_send_list()
   sl_iterator sl_end = send_list.end();
   for (; sl_cur != sl_end; ++sl_cur)
   {
-    processor_type proc = (*sl_cur).proc_;
+    send_init(comm_, (*sl_cur).proc_,
+	      storage::offset(src_dda_.ptr(), (*sl_cur).offset_),
+	      (*sl_cur).size_, send_reqs);
+  }
+}
 
-    src_dda_.sync_in();
-    send(comm_, proc,
-	 storage::offset(src_dda_.ptr(), (*sl_cur).offset_),
-	 (*sl_cur).size_, req_list);
-    src_dda_.sync_out();
+
+
+// Create persistent requests for the recv_list.
+
+template <dimension_type D, typename LHS, typename RHS>
+void
+Assignment<D, LHS, RHS, Blkvec_assign>::init_recv_list()
+{
+  typedef typename std::vector<Msg_record>::iterator rl_iterator;
+  typedef storage_traits<typename LHS::value_type, dst_lp::storage_format> storage;
+
+  rl_iterator rl_cur = recv_list.begin();
+  rl_iterator rl_end = recv_list.end();
+  for (; rl_cur != rl_end; ++rl_cur)
+  {
+    recv_init(comm_, (*rl_cur).proc_,
+	      storage::offset(dst_dda_.ptr(), (*rl_cur).offset_),
+	      (*rl_cur).size_, recv_reqs);
   }
 }
 
 
 
-// Execute the recv_list.
+// Start the receives of the recv_list, ahead of the matching sends.
 
 template <dimension_type D, typename LHS, typename RHS>
 void
-Assignment<D, LHS, RHS, Blkvec_assign>::exec_recv_list()
+Assignment<D, LHS, RHS, Blkvec_assign>::start_recv_list()
+{
+  comm_.start(recv_reqs);
+}
+
+
+
+// Execute the send_list.
+
+template <dimension_type D, typename LHS, typename RHS>
+void
+Assignment<D, LHS, RHS, Blkvec_assign>::exec_send_list()
 {
 #if OVXX_ABV_VERBOSE >= 1
   processor_type rank = local_processor();
   std::cout << "(" << rank << ") "
-	    << "exec_recv_list(size: " << recv_list.size()
+	    << "exec_send_list(size: " << send_list.size()
 	    << ") -------------------------------------\n";
 #endif
+  src_dda_.sync_in();
+  comm_.start(send_reqs);
+}
 
-  typedef typename std::vector<Msg_record>::iterator rl_iterator;
-  typedef storage_traits<typename LHS::value_type, dst_lp::storage_format> storage;
 
-  rl_iterator rl_cur = recv_list.begin();
-  rl_iterator rl_end = recv_list.end();
-    
-  for (; rl_cur != rl_end; ++rl_cur)
-  {
-    processor_type proc = (*rl_cur).proc_;
 
-    dst_dda_.sync_in();
-    recv(comm_, proc,
-	 storage::offset(dst_dda_.ptr(), (*rl_cur).offset_),
-	 (*rl_cur).size_);
-    dst_dda_.sync_out();
-  }
+// Wait for the recv_list to be completed.
+
+template <dimension_type D, typename LHS, typename RHS>
+void
+Assignment<D, LHS, RHS, Blkvec_assign>::exec_recv_list()
+{
+#if OVXX_ABV_VERBOSE >= 1
+  processor_type rank = local_processor();
+  std::cout << "(" << rank << ") "
+	    << "exec_recv_list(size: " << recv_list.size()
+	    << ") -------------------------------------\n";
+#endif
+  comm_.wait(recv_reqs);
+  dst_dda_.sync_out();
 }
 
 
@@ -618,14 +701,7 @@ template <dimension_type D, typename LHS, typename RHS>
 void
 Assignment<D, LHS, RHS, Blkvec_assign>::wait_send_list()
 {
-  typename std::vector<request_type>::iterator
-		cur = req_list.begin(),
-		end = req_list.end();
-  for(; cur != end; ++cur)
-  {
-    comm_.wait(*cur);
-  }
-  req_list.clear();
+  comm_.wait(send_reqs);
 }
 
 } // namespace ovxx::parallel
@@ -178,6 +178,16 @@ class Assignment<D, LHS, RHS, Chained_assign>
   typedef Communicator::request_type request_type;
   typedef Communicator::chain_type   chain_type;
 
+  // A destination replicated on all processors may be sent only to
+  // one processor per node (its leader), which then replicates it
+  // within the node through shared memory. That requires direct,
+  // dense access to the local subblock.
+  static bool const by_node_capable =
+    is_same<lhs_appmap_t, Replicated_map<D> >::value &&
+    !is_split_block<LHS>::value &&
+    lhs_dda_type::ct_cost == 0 &&
+    lhs_dda_type::layout_type::packing == dense;
+
   /// A Msg_record holds a piece of a data transfer that together
   /// describe a complete communication.
   ///
@@ -187,6 +197,8 @@ class Assignment<D, LHS, RHS, Chained_assign>
   ///   DATA_ is the raw data pointer of the local subblock,
   ///   CHAIN_ is the DMA chain representing the data from subblock_
   ///      to send.
+  ///   DATA_CHAIN_ is CHAIN_ stitched to the subblock's data, as used
+  ///      by the persistent request.
   ///
   /// Notes:
   ///   [1] CHAIN_ completely describes the data to send/receive,
@@ -201,13 +213,15 @@ class Assignment<D, LHS, RHS, Chained_assign>
     Msg_record(processor_type proc, index_type sb, chain_type chain)
       : proc_    (proc),
         subblock_(sb),
-	chain_   (chain)
+	chain_   (chain),
+	data_chain_()
       {}
 
   public:
     processor_type proc_;    // destination processor
     index_type     subblock_;
     chain_type     chain_;
+    chain_type     data_chain_;
   };
 
 
@@ -253,8 +267,12 @@ public:
       send_list (),
       recv_list (),
       copy_list (),
-      req_list  (),
+      send_reqs (),
+      recv_reqs (),
       msg_count (0),
+      pending_  (false),
+      by_node_  (by_node_capable &&
+		 lhs_am_.num_processors() == comm_.size()),
       rhs_dda_ (new rhs_dda_type*[rhs_.block().map().num_subblocks()]),
       lhs_dda_ (new lhs_dda_type*[lhs_.block().map().num_subblocks()])
   {
@@ -263,28 +281,46 @@ public:
     chain_assign::build_dda_array<D, RHS>(rhs_, rhs_am_, rhs_dda_, dda::in);
     chain_assign::build_dda_array<D, LHS>(lhs_, lhs_am_, lhs_dda_, dda::out);
 
+    // All processors hold the destination, so they all take part in
+    // looking up the node leaders (which is collective).
+    if (by_node_)
+      for (processor_type p = 0; p != comm_.size(); ++p)
+	leaders_.push_back(comm_.node_leader(p));
+
     build_send_list();
     if (!disable_copy)
       build_copy_list();
     build_recv_list();
+
+    init_send_list();
+    init_recv_list();
   }
 
   ~Assignment()
   {
-    // At destruction, the list of outstanding sends should be empty.
-    // This would be non-empty if:
-    //  - Par_assign did not to clear the lists after
-    //    processing it (library design error), or
-    //  - User executed send() without a corresponding wait().
-    OVXX_PRECONDITION(req_list.size() == 0);
+    // Complete an assignment that was started but not waited for.
+    // Errors can't be reported from here, and throwing during stack
+    // unwinding would terminate the program, so they are dropped.
+    // Callers that need to see them must call wait() themselves.
+    if (pending_)
+    {
+#if VSIP_HAS_EXCEPTIONS
+      try { wait();}
+      catch (...) { pending_ = false;}
+#else
+      wait();
+#endif
+    }
 
     if (send_list.size() > 0)
     {
       typedef typename std::vector<Msg_record>::iterator sl_iterator;
       sl_iterator sl_cur = send_list.begin();
       sl_iterator sl_end = send_list.end();
-      for (; sl_cur != sl_end; ++sl_cur)
+      for (index_type i = 0; sl_cur != sl_end; ++sl_cur, ++i)
       {
+	comm_.free(send_reqs[i]);
+	free_chain((*sl_cur).data_chain_);
 	free_chain((*sl_cur).chain_);
       }
     }
@@ -294,8 +330,10 @@ public:
       typedef typename std::vector<Msg_record>::iterator rl_iterator;
       rl_iterator rl_cur = recv_list.begin();
       rl_iterator rl_end = recv_list.end();
-      for (; rl_cur != rl_end; ++rl_cur)
+      for (index_type i = 0; rl_cur != rl_end; ++rl_cur, ++i)
       {
+	comm_.free(recv_reqs[i]);
+	free_chain((*rl_cur).data_chain_);
 	free_chain((*rl_cur).chain_);
       }
     }
@@ -307,15 +345,43 @@ public:
     delete[] rhs_dda_;
   }
 
+  /// Perform the assignment.
+  /// All messages are set up as persistent requests when the
+  /// assignment is constructed, so repeated executions only need
+  /// to start them and wait for their completion.
   void operator()()
   {
+    start();
+    wait();
+  }
+
+  /// Start the assignment, without waiting for it to complete.
+  /// Until `wait()` returns, the source must not be modified, and
+  /// the destination must be neither read nor modified.
+  void start()
+  {
+    OVXX_PRECONDITION(!pending_);
+    if (recv_list.size() > 0) start_recv_list();
     if (send_list.size() > 0) exec_send_list();
-    if (copy_list.size() > 0) exec_copy_list();
+    // Local copies overlap with the communication, unless the
+    // received data needs to be copied out of a temporary buffer
+    // later on, which would overwrite them.
+    if (copy_list.size() > 0 && lhs_dda_type::ct_cost == 0) exec_copy_list();
+    pending_ = true;
+  }
+
+  /// Wait for the completion of an assignment started with `start()`.
+  void wait()
+  {
+    if (!pending_) return;
     if (recv_list.size() > 0) exec_recv_list();
+    if (copy_list.size() > 0 && lhs_dda_type::ct_cost != 0) exec_copy_list();
+    if (by_node_) exec_replicate();
 
-    if (req_list.size() > 0)  wait_send_list();
+    if (send_list.size() > 0) wait_send_list();
 
     cleanup();
+    pending_ = false;
   }
 
 private:
@@ -326,12 +392,22 @@ private:
   void build_recv_list();
   void build_copy_list();
 
+  void init_send_list();
+  void init_recv_list();
+
+  void start_recv_list();
   void exec_send_list();
   void exec_recv_list();
   void exec_copy_list();
+  void exec_replicate();
 
   void wait_send_list();
 
+  // Whether `proc` receives its data from its node's leader,
+  // rather than from the processors holding the source.
+  bool served_by_node(processor_type proc) const
+  { return by_node_ && leaders_[proc] != proc;}
+
   void cleanup() {}	// Cleanup send_list buffers.
 
   lhs_appmap_t const& lhs_am_;
@@ -342,9 +418,13 @@ private:
   std::vector<Msg_record>    recv_list;
   std::vector<Copy_record>   copy_list;
 
-  std::vector<request_type> req_list;
+  std::vector<request_type> send_reqs;
+  std::vector<request_type> recv_reqs;
 
   int                       msg_count;
+  bool                      pending_;
+  bool                      by_node_;
+  std::vector<processor_type> leaders_;
 
   rhs_dda_type**            rhs_dda_;
   lhs_dda_type**            lhs_dda_;
@@ -403,7 +483,7 @@ Assignment<D, LHS, RHS, Chained_assign>::build_send_list()
 
       index_type lhs_sb = lhs_am_.subblock(proc);
 
-      if (lhs_sb != no_subblock)
+      if (lhs_sb != no_subblock && !served_by_node(proc))
       {
 	// Check to see if destination processor already has block
 	if (!disable_copy && processor_has_block(rhs_am_, proc, rhs_sb))
@@ -477,7 +557,7 @@ Assignment<D, LHS, RHS, Chained_assign>::build_recv_list()
 
   index_type lhs_sb = lhs_am_.subblock(rank);
 
-  if (lhs_sb != no_subblock)
+  if (lhs_sb != no_subblock && !served_by_node(rank))
   {
     lhs_dda_type* dda = lhs_dda_[lhs_sb];
     dda->sync_in();
@@ -563,7 +643,7 @@ Assignment<D, LHS, RHS, Chained_assign>::build_copy_list()
 #endif
 
   index_type lhs_sb = lhs_am_.subblock(rank);
-  if (lhs_sb != no_subblock)
+  if (lhs_sb != no_subblock && !served_by_node(rank))
   {
     index_type rhs_sb = rhs_am_.subblock(rank);
     if (rhs_sb != no_subblock)
@@ -622,6 +702,66 @@ Assignment<D, LHS, RHS, Chained_assign>::build_copy_list()
 
 
 
+// Create persistent requests for the send_list.
+
+template <dimension_type D, typename LHS, typename RHS>
+void
+Assignment<D, LHS, RHS, Chained_assign>::init_send_list()
+{
+  typedef typename std::vector<Msg_record>::iterator sl_iterator;
+  sl_iterator sl_cur = send_list.begin();
+  sl_iterator sl_end = send_list.end();
+  for (; sl_cur != sl_end; ++sl_cur)
+  {
+    Chain_builder builder;
+    rhs_dda_type* dda = rhs_dda_[(*sl_cur).subblock_];
+    // FIXME: Does this have to be non-const ?
+    builder.stitch(dda->non_const_ptr(), (*sl_cur).chain_);
+    (*sl_cur).data_chain_ = builder.get_chain();
+
+    request_type req;
+    comm_.send_init((*sl_cur).proc_, (*sl_cur).data_chain_, req);
+    send_reqs.push_back(req);
+  }
+}
+
+
+
+// Create persistent requests for the recv_list.
+
+template <dimension_type D, typename LHS, typename RHS>
+void
+Assignment<D, LHS, RHS, Chained_assign>::init_recv_list()
+{
+  typedef typename std::vector<Msg_record>::iterator rl_iterator;
+  rl_iterator rl_cur = recv_list.begin();
+  rl_iterator rl_end = recv_list.end();
+  for (; rl_cur != rl_end; ++rl_cur)
+  {
+    Chain_builder builder;
+    lhs_dda_type* dda = lhs_dda_[(*rl_cur).subblock_];
+    builder.stitch(dda->ptr(), (*rl_cur).chain_);
+    (*rl_cur).data_chain_ = builder.get_chain();
+
+    request_type req;
+    comm_.recv_init((*rl_cur).proc_, (*rl_cur).data_chain_, req);
+    recv_reqs.push_back(req);
+  }
+}
+
+
+
+// Start the receives of the recv_list, ahead of the matching sends.
+
+template <dimension_type D, typename LHS, typename RHS>
+void
+Assignment<D, LHS, RHS, Chained_assign>::start_recv_list()
+{
+  comm_.start(recv_reqs);
+}
+
+
+
 // Execute the send_list.
 
 template <dimension_type D, typename LHS, typename RHS>
@@ -634,34 +774,15 @@ Assignment<D, LHS, RHS, Chained_assign>::exec_send_list()
 	    << "exec_send_list(size: " << send_list.size()
 	    << ") -------------------------------------\n";
 #endif
-  typedef typename std::vector<Msg_record>::iterator sl_iterator;
-
-  {
-    sl_iterator sl_cur = send_list.begin();
-    sl_iterator sl_end = send_list.end();
-    for (; sl_cur != sl_end; ++sl_cur)
-    {
-      Chain_builder builder;
-      processor_type proc = (*sl_cur).proc_;
-
-      rhs_dda_type* dda = rhs_dda_[(*sl_cur).subblock_];
-      dda->sync_in();
-      // FIXME: Does this have to be non-const ?
-      builder.stitch(dda->non_const_ptr(), (*sl_cur).chain_);
-      dda->sync_out();
-      
-      chain_type chain = builder.get_chain();
-      request_type   req;
-      comm_.send(proc, chain, req);
-      free_chain(chain);
-      req_list.push_back(req);
-    }
-  }
+  // All messages are sent from the same local subblock.
+  rhs_dda_type* dda = rhs_dda_[send_list.front().subblock_];
+  dda->sync_in();
+  comm_.start(send_reqs);
 }
 
 
 
-// Execute the recv_list.
+// Wait for the recv_list to be completed.
 
 template <dimension_type D, typename LHS, typename RHS>
 void
@@ -674,24 +795,10 @@ Assignment<D, LHS, RHS, Chained_assign>::exec_recv_list()
 	    << ") -------------------------------------\n";
 #endif
 
-  typedef typename std::vector<Msg_record>::iterator rl_iterator;
-  rl_iterator rl_cur = recv_list.begin();
-  rl_iterator rl_end = recv_list.end();
-    
-  for (; rl_cur != rl_end; ++rl_cur)
-  {
-    Chain_builder builder;
-    processor_type proc = (*rl_cur).proc_;
-
-    lhs_dda_type* dda = lhs_dda_[(*rl_cur).subblock_];
-    dda->sync_in();
-    builder.stitch(dda->ptr(), (*rl_cur).chain_);
-    dda->sync_out();
-
-    chain_type chain = builder.get_chain();
-    comm_.recv(proc, chain);
-    free_chain(chain);
-  }
+  comm_.wait(recv_reqs);
+  // All messages are received into the same local subblock.
+  lhs_dda_type* dda = lhs_dda_[recv_list.front().subblock_];
+  dda->sync_out();
 }
 
 
@@ -735,20 +842,26 @@ Assignment<D, LHS, RHS, Chained_assign>::exec_copy_list()
 
 
 
+// Replicate the node leader's subblock, which is complete by now,
+// to the other processors on its node.
+
+template <dimension_type D, typename LHS, typename RHS>
+void
+Assignment<D, LHS, RHS, Chained_assign>::exec_replicate()
+{
+  lhs_dda_type* dda = lhs_dda_[lhs_am_.subblock(local_processor())];
+  comm_.replicate(dda->ptr(), dda->size());
+}
+
+
+
 // Wait for the send_list instructions to be completed.
 
 template <dimension_type D, typename LHS, typename RHS>
 void
 Assignment<D, LHS, RHS, Chained_assign>::wait_send_list()
 {
-  typename std::vector<request_type>::iterator
-		cur = req_list.begin(),
-		end = req_list.end();
-  for(; cur != end; ++cur)
-  {
-    comm_.wait(*cur);
-  }
-  req_list.clear();
+  comm_.wait(send_reqs);
 }
 
 } // namespace ovxx::parallel
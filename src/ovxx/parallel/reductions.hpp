@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_parallel_reductions_hpp_
+#define ovxx_parallel_reductions_hpp_
+
+#include <ovxx/support.hpp>
+#include <ovxx/block_traits.hpp>
+#include <ovxx/reductions/functors.hpp>
+#include <ovxx/parallel/service.hpp>
+#include <ovxx/dispatch.hpp>
+#include <vsip/impl/map_fwd.hpp>
+
+namespace ovxx
+{
+namespace parallel
+{
+
+/// Traits class to determine whether each element of a distributed
+/// block is held by exactly one subblock.
+template <typename M>
+struct has_disjoint_subblocks { static bool const value = false;};
+
+template <typename D0, typename D1, typename D2>
+struct has_disjoint_subblocks<Map<D0, D1, D2> >
+{ static bool const value = true;};
+
+/// Traits class to determine whether partial results of reduction R
+/// can be combined (using its `rtype`) into the result over the whole.
+template <template <typename> class R>
+struct is_combinable_reduction { static bool const value = false;};
+
+template <>
+struct is_combinable_reduction<Sum_value> { static bool const value = true;};
+template <>
+struct is_combinable_reduction<Sum_sq_value> { static bool const value = true;};
+template <>
+struct is_combinable_reduction<Sum_magsq_value> { static bool const value = true;};
+template <>
+struct is_combinable_reduction<All_true> { static bool const value = true;};
+template <>
+struct is_combinable_reduction<Any_true> { static bool const value = true;};
+
+} // namespace ovxx::parallel
+
+namespace dispatcher
+{
+
+/// Reduce each processor's subblock of a distributed block locally,
+/// then combine the partial results with a single
+/// `Communicator::allreduce()`, rather than broadcasting each
+/// element in turn.
+template <template <typename> class R,
+	  typename T, typename B, typename O, dimension_type D>
+struct Evaluator<op::reduce<R>, be::parallel,
+  void(T&, B const&, O, integral_constant<dimension_type, D>)>
+{
+  typedef typename B::value_type value_type;
+  typedef typename B::map_type map_type;
+
+  static char const* name() { return "parallel";}
+
+  static bool const ct_valid =
+    is_simple_distributed_block<B>::value &&
+    parallel::has_disjoint_subblocks<map_type>::value &&
+    parallel::is_combinable_reduction<R>::value &&
+    parallel::reduction_supported<R<value_type>::rtype, T>::value;
+  static bool rt_valid(T&, B const&, O, integral_constant<dimension_type, D>)
+  { return true;}
+
+  static void exec(T& r, B const& a, O, integral_constant<dimension_type, D>)
+  {
+    typedef typename distributed_local_block<B>::type local_block_type;
+    typedef typename get_block_layout<local_block_type>::order_type
+      local_order_type;
+    typedef integral_constant<dimension_type, D> dim_type;
+
+    // Processors without a subblock contribute the empty reduction.
+    T local = R<value_type>::value(R<value_type>::initial(), 0);
+    if (a.subblock() != no_subblock)
+      Dispatcher<op::reduce<R>,
+	void(T&, local_block_type const&, local_order_type, dim_type)>::
+	dispatch(local, get_local_block(a), local_order_type(), dim_type());
+    r = a.map().impl_comm().allreduce(R<value_type>::rtype, local);
+  }
+};
+
+} // namespace ovxx::dispatcher
+} // namespace ovxx
+
+#endif
@@ -44,6 +44,9 @@ create_ll_pset(std::vector<vsip::processor_type> const&, ll_pset_type&) {}
 inline void
 destroy_ll_pset(ll_pset_type&) {}
 
+inline int run(int (*program)(int, char **), int argc, char **argv)
+{ return program(argc, argv);}
+
 inline Communicator &default_communicator()
 {
   static Communicator communicator;
@@ -10,8 +10,10 @@
 #define ovxx_parallel_service_hpp_
 
 #include <ovxx/config.hpp>
-#ifdef OVXX_PARALLEL
+#if defined(OVXX_HAVE_MPI)
 # include <ovxx/mpi/service.hpp>
+#elif defined(OVXX_HAVE_SHM)
+# include <ovxx/shm/service.hpp>
 #else
 # include <ovxx/parallel/serial.hpp>
 #endif
@@ -43,20 +43,38 @@ namespace python
 namespace bpl = boost::python;
 using boost::shared_ptr;
 
-// Send all traces from OVXX_TRACE to the Python logger
+// Send all traces from OVXX_TRACE to the Python logger.
+// As traces may be emitted by code running without the GIL
+// (see gil.hpp), acquire it first.
 inline void trace(char const *format, ...)
 {
-  bpl::object logging = bpl::import("logging");
-  bpl::object info = logging.attr("info");
   va_list args;
   char msg[128];
   va_start(args, format);
   vsnprintf(msg, sizeof(msg), format, args);
   va_end(args);
-  info(msg);
+  PyGILState_STATE state = PyGILState_Ensure();
+  try
+  {
+    bpl::object logging = bpl::import("logging");
+    bpl::object info = logging.attr("info");
+    info(msg);
+  }
+  // Blocks released while Python shuts down trace their deallocation
+  // when the logging module can't be imported any more. Drop these
+  // traces, rather than throwing out of the blocks' destructors.
+  catch (bpl::error_already_set const &) { PyErr_Clear();}
+  PyGILState_Release(state);
 }
 
-inline void initialize() { import_array();}
+inline void initialize()
+{
+  // Since Python 3.7 the GIL is created by Py_Initialize().
+#if PY_VERSION_HEX < 0x03070000
+  PyEval_InitThreads();
+#endif
+  import_array();
+}
 
 #define PYVSIP_THROW(TYPE, REASON)	 \
 {                                        \
@@ -136,6 +154,10 @@ public:
   sm_proxy(allocator *a, length_type s, bool f)
     : parent_(new storage_manager<T>(a, s, f))
   {}
+  // the user-storage constructor
+  sm_proxy(allocator *a, length_type s, T *data)
+    : parent_(new storage_manager<T>(a, s, data))
+  {}
   // the subblock constructor
   sm_proxy(smanager_ptr sm) : parent_(sm) {}
   // the real/imag component constructor
@@ -159,6 +181,11 @@ public:
     else if (real_) return cparent_->at(i).real();
     else return cparent_->at(i).imag();
   }
+  void admit(bool update)
+  {
+    OVXX_PRECONDITION(parent_);
+    parent_->admit(update);
+  }
   
   ptr_type ptr()
   {
@@ -197,9 +224,11 @@ struct storage_traits<T, true>
 
 template <dimension_type D, typename T, typename M = Local_map> class Block;
 
-// This block is modeled after stored_block, but without support for user-storage.
+// This block is modeled after stored_block. Instead of user-storage it may
+// adopt the data of a NumPy array, which it then keeps alive.
 // In addition, this block-type uses a runtime layout, as it is also used for
-// subblocks, to avoid having to export many different block types to Python.
+// subblocks and adopted (strided or Fortran-ordered) arrays, to avoid having
+// to export many different block types to Python.
 template <dimension_type D, typename T>
 class Block<D, T, Local_map>
 {
@@ -247,6 +276,22 @@ public:
       smanager_->put(i, value);
   }
 
+  /// Create a block operating on existing data, owned by `base`.
+  /// `dom` holds physical coordinates (see below), and `extent`
+  /// is the number of elements spanned by `dom`.
+  Block(Domain<dim> const &dom, T *data, length_type extent, bpl::object base,
+	map_type const &map = map_type())
+    : offset_(0),
+      layout_(dom),
+      smanager_(new smanager_type(map.impl_allocator(), extent, data)),
+      map_(map),
+      base_(base),
+      array_refcount_(0)
+  {
+    // The storage is compatible, so this doesn't copy.
+    smanager_->admit(true);
+  }
+
   // constructor used internally to form a subblock of parent.
   // dom holds physical coordinates, i.e. strides express distance in elements,
   // not rows / columns.
@@ -255,6 +300,7 @@ public:
     : offset_(0),
       layout_(dom),
       smanager_(parent.smanager_),
+      base_(parent.base_),
       array_refcount_(0)
   {
     for (index_type i = 0; i != dim; ++i) offset_ += dom[i].first();
@@ -265,6 +311,7 @@ public:
     : offset_(parent.offset_),
       layout_(parent.layout_),
       smanager_(new smanager_type(parent.smanager_, real)),
+      base_(parent.base_),
       array_refcount_(0)
   {}
 
@@ -409,6 +456,8 @@ private:
   applied_layout_type layout_;
   shared_ptr<smanager_type> smanager_;
   map_type map_;
+  // The owner of adopted data, if any.
+  bpl::object base_;
   unsigned array_refcount_;
 };
 
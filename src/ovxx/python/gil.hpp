@@ -0,0 +1,257 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_python_gil_hpp_
+#define ovxx_python_gil_hpp_
+
+#include <ovxx/python/block.hpp>
+#include <ovxx/allocator.hpp>
+#include <ovxx/detail/noncopyable.hpp>
+#if OVXX_ENABLE_THREADING
+# include <ovxx/c++11/thread.hpp>
+#endif
+#include <string>
+
+namespace ovxx
+{
+namespace python
+{
+
+/// Release the GIL for the lifetime of this object, so other Python
+/// threads can run while we compute.
+/// Code executed without the GIL must not touch any Python objects,
+/// not even their reference counts. The caller's arguments are kept
+/// alive by the caller, so blocks passed in remain valid.
+class gil_release : ovxx::detail::noncopyable
+{
+public:
+  gil_release() : state_(PyEval_SaveThread()) {}
+  ~gil_release() { PyEval_RestoreThread(state_);}
+
+private:
+  PyThreadState *state_;
+};
+
+/// The result of an asynchronous call, which runs in its own thread
+/// without the GIL. The future holds references to the call's arguments,
+/// so they remain valid until the call has completed.
+/// The call allocates temporaries with the caller's default allocator.
+/// Without threading support the call is executed right away.
+class future : ovxx::detail::noncopyable
+{
+  template <typename F>
+  struct task
+  {
+    task(F f, future *s)
+      : function(f), self(s), alloc(allocator::get_default()) {}
+    void operator()()
+    {
+      allocator::set_default(alloc);
+      self->run(function);
+      allocator::set_default(0);
+    }
+    F function;
+    future *self;
+    allocator *alloc;
+  };
+
+public:
+  /// Run `f()` asynchronously. `args` holds the Python objects `f`
+  /// refers to, and `result` the object returned by `wait()`.
+  template <typename F>
+  future(F f, bpl::object args, bpl::object result = bpl::object())
+    : args_(args),
+      result_(result),
+      done_(false)
+#if OVXX_ENABLE_THREADING
+    , thread_(0)
+#endif
+  {
+#if OVXX_ENABLE_THREADING
+    thread_ = new cxx11::thread(task<F>(f, this));
+#else
+    gil_release unlocked;
+    run(f);
+#endif
+  }
+  ~future()
+  {
+    gil_release unlocked;
+    join();
+  }
+
+  /// Return true if the call has completed.
+  bool done()
+  {
+#if OVXX_ENABLE_THREADING
+    cxx11::lock_guard<cxx11::mutex> lock(mutex_);
+#endif
+    return done_;
+  }
+  /// Wait for the call to complete, and return its result.
+  /// If the call failed, raise a RuntimeError.
+  bpl::object wait()
+  {
+    {
+      gil_release unlocked;
+      join();
+    }
+    args_ = bpl::object();
+    if (!error_.empty())
+      PYVSIP_THROW(RuntimeError, error_.c_str());
+    return result_;
+  }
+
+private:
+  template <typename F>
+  void run(F &f)
+  {
+    try { f();}
+    catch (std::exception const &e) { error_ = e.what();}
+    catch (...) { error_ = "unknown error";}
+#if OVXX_ENABLE_THREADING
+    cxx11::lock_guard<cxx11::mutex> lock(mutex_);
+#endif
+    done_ = true;
+  }
+  void join()
+  {
+#if OVXX_ENABLE_THREADING
+    if (!thread_) return;
+    thread_->join();
+    delete thread_;
+    thread_ = 0;
+#endif
+  }
+
+  bpl::object args_;
+  bpl::object result_;
+  std::string error_;
+  bool done_;
+#if OVXX_ENABLE_THREADING
+  cxx11::mutex mutex_;
+  cxx11::thread *thread_;
+#endif
+};
+
+/// An argument of a call executed without the GIL: values are copied,
+/// references refer to the wrapped C++ object held by the Python object.
+template <typename A>
+struct argument
+{
+  argument(bpl::object o) : value(bpl::extract<A>(o)) {}
+  A get() const { return value;}
+  A value;
+};
+
+template <typename A>
+struct argument<A &>
+{
+  typedef typename remove_const<A>::type type;
+  argument(bpl::object o) : ptr(&bpl::extract<type &>(o)()) {}
+  A &get() const { return *ptr;}
+  type *ptr;
+};
+
+/// Wrappers calling `(self.*F)(...)` without the GIL.
+template <typename C, typename A1, void (C::*F)(A1)>
+void nogil(C &self, A1 a1)
+{
+  gil_release unlocked;
+  (self.*F)(a1);
+}
+
+template <typename C, typename A1, typename A2, void (C::*F)(A1, A2)>
+void nogil(C &self, A1 a1, A2 a2)
+{
+  gil_release unlocked;
+  (self.*F)(a1, a2);
+}
+
+template <typename C, typename A1, typename A2, typename A3, typename A4,
+	  void (C::*F)(A1, A2, A3, A4)>
+void nogil(C &self, A1 a1, A2 a2, A3 a3, A4 a4)
+{
+  gil_release unlocked;
+  (self.*F)(a1, a2, a3, a4);
+}
+
+/// The deferred call of `(self.*F)(...)`, as run by a future.
+template <typename C, typename A1, void (C::*F)(A1)>
+struct call1
+{
+  call1(bpl::object s, bpl::object a1)
+    : self(&bpl::extract<C &>(s)()), arg1(a1) {}
+  void operator()() { (self->*F)(arg1.get());}
+  C *self;
+  argument<A1> arg1;
+};
+
+template <typename C, typename A1, typename A2, void (C::*F)(A1, A2)>
+struct call2
+{
+  call2(bpl::object s, bpl::object a1, bpl::object a2)
+    : self(&bpl::extract<C &>(s)()), arg1(a1), arg2(a2) {}
+  void operator()() { (self->*F)(arg1.get(), arg2.get());}
+  C *self;
+  argument<A1> arg1;
+  argument<A2> arg2;
+};
+
+template <typename C, typename A1, typename A2, typename A3, typename A4,
+	  void (C::*F)(A1, A2, A3, A4)>
+struct call4
+{
+  call4(bpl::object s, bpl::object a1, bpl::object a2, bpl::object a3, bpl::object a4)
+    : self(&bpl::extract<C &>(s)()), arg1(a1), arg2(a2), arg3(a3), arg4(a4) {}
+  void operator()() { (self->*F)(arg1.get(), arg2.get(), arg3.get(), arg4.get());}
+  C *self;
+  argument<A1> arg1;
+  argument<A2> arg2;
+  argument<A3> arg3;
+  argument<A4> arg4;
+};
+
+/// Wrappers calling `(self.*F)(...)` asynchronously.
+template <typename C, typename A1, void (C::*F)(A1)>
+shared_ptr<future> async(bpl::object self, bpl::object a1)
+{
+  call1<C, A1, F> call(self, a1);
+  return shared_ptr<future>(new future(call, bpl::make_tuple(self, a1)));
+}
+
+template <typename C, typename A1, typename A2, void (C::*F)(A1, A2)>
+shared_ptr<future> async(bpl::object self, bpl::object a1, bpl::object a2)
+{
+  call2<C, A1, A2, F> call(self, a1, a2);
+  return shared_ptr<future>(new future(call, bpl::make_tuple(self, a1, a2)));
+}
+
+template <typename C, typename A1, typename A2, typename A3, typename A4,
+	  void (C::*F)(A1, A2, A3, A4)>
+shared_ptr<future> async(bpl::object self, bpl::object a1, bpl::object a2,
+			 bpl::object a3, bpl::object a4)
+{
+  call4<C, A1, A2, A3, A4, F> call(self, a1, a2, a3, a4);
+  return shared_ptr<future>
+    (new future(call, bpl::make_tuple(self, a1, a2, a3, a4)));
+}
+
+/// Define the `future` type. This needs to be done once, by the
+/// `library` module.
+inline void define_future()
+{
+  bpl::class_<future, shared_ptr<future>, boost::noncopyable>
+    f("future", bpl::no_init);
+  f.def("done", &future::done);
+  f.def("wait", &future::wait);
+}
+
+} // namespace ovxx::python
+} // namespace ovxx
+
+#endif
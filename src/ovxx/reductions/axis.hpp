@@ -0,0 +1,339 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_reductions_axis_hpp_
+#define ovxx_reductions_axis_hpp_
+
+#include <vsip/support.hpp>
+#include <vsip/vector.hpp>
+#include <vsip/matrix.hpp>
+#include <vsip/tensor.hpp>
+#include <vsip/dda.hpp>
+#include <ovxx/reductions/functors.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <ovxx/dispatch.hpp>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+namespace ovxx
+{
+namespace dispatcher
+{
+namespace op
+{
+// Evaluator OpTag for reductions along one axis.
+template <template <typename> class R> struct reduce_axis;
+} // namespace ovxx::dispatcher::op
+} // namespace ovxx::dispatcher
+
+namespace reduction
+{
+/// True if R selects a value (such as `Max_value`), rather than
+/// accumulating one (such as `Sum_value`).
+template <template <typename> class R>
+struct is_selection { static bool const value = false;};
+
+template <> struct is_selection<Max_value> { static bool const value = true;};
+template <> struct is_selection<Min_value> { static bool const value = true;};
+template <> struct is_selection<Max_mag_value> { static bool const value = true;};
+template <> struct is_selection<Min_mag_value> { static bool const value = true;};
+template <> struct is_selection<Max_magsq_value> { static bool const value = true;};
+template <> struct is_selection<Min_magsq_value> { static bool const value = true;};
+
+/// A uniform interface to accumulating and selecting reductions.
+/// The state is initialized from the first value, and then
+/// updated with all values (including the first).
+template <template <typename> class R, typename T,
+	  bool S = is_selection<R>::value>
+struct axis_traits
+{
+  typedef typename R<T>::accum_type accum_type;
+  typedef typename R<T>::result_type result_type;
+
+  static accum_type initial(T) { return R<T>::initial();}
+  static void update(accum_type &state, T value)
+  { state = R<T>::update(state, value);}
+  static result_type value(accum_type const &state, length_type size)
+  { return R<T>::value(state, size);}
+};
+
+template <template <typename> class R, typename T>
+struct axis_traits<R, T, true>
+{
+  typedef R<T> accum_type;
+  typedef typename R<T>::result_type result_type;
+
+  static accum_type initial(T value) { return accum_type(value);}
+  static void update(accum_type &state, T value) { state.next_value(value);}
+  static result_type value(accum_type state, length_type) { return state.value();}
+};
+
+/// The view type holding the result of reducing one axis of a
+/// D-dimensional view.
+template <dimension_type D, typename T> struct axis_result;
+template <typename T>
+struct axis_result<2, T>
+{
+  typedef Vector<T> type;
+  static type create(length_type const *size) { return type(size[0]);}
+};
+template <typename T>
+struct axis_result<3, T>
+{
+  typedef Matrix<T> type;
+  static type create(length_type const *size) { return type(size[0], size[1]);}
+};
+
+/// Access to the values of a block as an array: directly if possible,
+/// otherwise through a dense copy.
+template <typename B>
+struct axis_data
+{
+  typedef typename get_block_layout<B>::order_type order_type;
+  static bool const direct =
+    !is_expr_block<B>::value &&
+    dda::Data<B, dda::in>::ct_cost == 0 &&
+    get_block_layout<B>::storage_format == array;
+  typedef typename conditional<direct,
+    typename get_block_layout<B>::type,
+    Layout<B::dim, order_type, dense, array> >::type layout_type;
+  typedef dda::Data<B, dda::in, layout_type> type;
+};
+
+namespace detail
+{
+/// The number of results accumulated at a time when the reduced axis
+/// isn't the innermost one, so the partial results stay in cache.
+length_type const axis_block = 1024;
+
+/// Reduce the `axis` values `axis_stride` apart, for `inner` results
+/// `inner_stride` apart, for each of `outer` slices `outer_stride` apart.
+/// Task `c` handles slice `c / chunks`, and the `c % chunks`th chunk of
+/// its results, which it stores into `result`.
+template <typename A, typename P, typename T>
+struct axis_task
+{
+  typedef typename A::accum_type accum_type;
+  typedef T result_type;
+
+  P data;
+  length_type outer;
+  stride_type outer_stride;
+  length_type axis;
+  stride_type axis_stride;
+  length_type inner;
+  stride_type inner_stride;
+  length_type chunks;
+  length_type chunk;
+  result_type *result;
+  stride_type result_outer_stride;
+  stride_type result_inner_stride;
+
+  void put(index_type p, index_type q, result_type value)
+  {
+    result[static_cast<stride_type>(p) * result_outer_stride +
+	   static_cast<stride_type>(q) * result_inner_stride] = value;
+  }
+
+  void operator()(index_type c)
+  {
+    index_type const p = c / chunks;
+    index_type const begin = (c % chunks) * chunk;
+    if (begin >= inner) return;
+    length_type const size = std::min(chunk, inner - begin);
+    P const base = data + static_cast<stride_type>(p) * outer_stride
+      + static_cast<stride_type>(begin) * inner_stride;
+
+    if (std::labs(axis_stride) <= std::labs(inner_stride))
+    {
+      // The reduced axis is the inner one: reduce one run at a time.
+      P row = base;
+      for (index_type q = 0; q != size; ++q, row += inner_stride)
+      {
+	accum_type state = A::initial(*row);
+	P x = row;
+	for (index_type k = 0; k != axis; ++k, x += axis_stride)
+	  A::update(state, *x);
+	put(p, begin + q, A::value(state, axis));
+      }
+    }
+    else
+    {
+      // The reduced axis is the outer one: accumulate a block of
+      // results while walking each run.
+      std::vector<accum_type> state;
+      state.reserve(std::min(size, axis_block));
+      for (index_type b = 0; b < size; b += axis_block)
+      {
+	length_type const n = std::min(axis_block, size - b);
+	P const first = base + static_cast<stride_type>(b) * inner_stride;
+	state.clear();
+	P x = first;
+	for (index_type q = 0; q != n; ++q, x += inner_stride)
+	  state.push_back(A::initial(*x));
+	P row = first;
+	for (index_type k = 0; k != axis; ++k, row += axis_stride)
+	{
+	  x = row;
+	  for (index_type q = 0; q != n; ++q, x += inner_stride)
+	    A::update(state[q], *x);
+	}
+	for (index_type q = 0; q != n; ++q)
+	  put(p, begin + b + q, A::value(state[q], axis));
+      }
+    }
+  }
+};
+} // namespace ovxx::reduction::detail
+} // namespace ovxx::reduction
+
+namespace dispatcher
+{
+
+template<template <typename> class R>
+struct List<op::reduce_axis<R> >
+{
+  typedef make_type_list<be::user, be::generic>::type type;
+};
+
+/// Reduce axis `axis` of block `a` into block `r`. The data is
+/// traversed in storage order, and the work is split across the
+/// default thread pool along the non-reduced dimensions.
+template <template <typename> class R, typename RB, typename B>
+struct Evaluator<op::reduce_axis<R>, be::generic,
+  void(RB &, B const &, dimension_type)>
+{
+  typedef typename B::value_type value_type;
+  typedef reduction::axis_traits<R, value_type> traits;
+  typedef typename reduction::axis_data<B>::type data_type;
+  typedef typename data_type::ptr_type ptr_type;
+  typedef Layout<RB::dim, typename get_block_layout<RB>::order_type,
+		 any_packing, array> result_layout_type;
+  typedef dda::Data<RB, dda::out, result_layout_type> result_data_type;
+
+  static char const* name() { return "generic";}
+
+  static bool const ct_valid = RB::dim + 1 == B::dim;
+  static bool rt_valid(RB &, B const &, dimension_type) { return true;}
+
+  static void exec(RB &r, B const &a, dimension_type axis)
+  {
+    dimension_type const D = B::dim;
+    data_type data(a);
+    // Workers store their results through a pointer, as element-wise
+    // put()s could synchronize the result block concurrently.
+    result_data_type result(r);
+
+    // The non-reduced dimensions, outermost first.
+    dimension_type dims[2];
+    dimension_type n = 0;
+    for (dimension_type d = 0; d != D; ++d)
+      if (d != axis) dims[n++] = d;
+    if (D == 3 && std::labs(data.stride(dims[0])) < std::labs(data.stride(dims[1])))
+      std::swap(dims[0], dims[1]);
+    dimension_type const inner_dim = dims[D - 2];
+
+    reduction::detail::axis_task<traits, ptr_type, typename RB::value_type> task;
+    task.data = data.ptr();
+    task.outer = D == 3 ? data.size(dims[0]) : 1;
+    task.outer_stride = D == 3 ? data.stride(dims[0]) : 0;
+    task.axis = data.size(axis);
+    task.axis_stride = data.stride(axis);
+    task.inner = data.size(inner_dim);
+    task.inner_stride = data.stride(inner_dim);
+    task.result = result.ptr();
+    // Indices of the result block skip the reduced axis.
+    task.result_outer_stride =
+      D == 3 ? result.stride(dims[0] - (dims[0] > axis ? 1 : 0)) : 0;
+    task.result_inner_stride =
+      result.stride(inner_dim - (inner_dim > axis ? 1 : 0));
+
+    thread_pool *pool = thread_pool::get_default();
+    bool const threaded = pool->size() > 1 && a.size() >= thread_pool::threshold();
+    task.chunks = 1;
+    if (threaded && task.outer < pool->size())
+      task.chunks = std::min<length_type>(task.inner,
+	(pool->size() + task.outer - 1) / task.outer);
+    task.chunk = (task.inner + task.chunks - 1) / task.chunks;
+
+    length_type const tasks = task.outer * task.chunks;
+    if (threaded && tasks > 1)
+      pool->parallel_for(tasks, task);
+    else
+      for (index_type c = 0; c != tasks; ++c)
+	task(c);
+  }
+};
+
+} // namespace ovxx::dispatcher
+
+/// Reduce axis `axis` of the (non-empty, local) matrix or tensor
+/// `view` with reduction R, yielding a vector or matrix of the
+/// remaining dimensions. For example, `reduce<Sum_value>(m, 1)`
+/// returns the sums of the rows of `m`.
+template <template <typename> class R, typename V>
+typename reduction::axis_result<V::dim,
+  typename reduction::axis_traits<R, typename V::value_type>::result_type>::type
+reduce(V view, dimension_type axis)
+{
+  using namespace dispatcher;
+  typedef typename V::value_type T;
+  typedef typename reduction::axis_traits<R, T>::result_type result_type;
+  typedef reduction::axis_result<V::dim, result_type> result_traits;
+  typedef typename result_traits::type result_view_type;
+  typedef typename result_view_type::block_type result_block_type;
+  typedef typename V::block_type block_type;
+
+  OVXX_PRECONDITION(axis < V::dim && view.size() > 0);
+  length_type size[V::dim - 1];
+  for (dimension_type d = 0, i = 0; d != V::dim; ++d)
+    if (d != axis) size[i++] = view.size(d);
+  result_view_type result = result_traits::create(size);
+  dispatch<op::reduce_axis<R>, void,
+    result_block_type &, block_type const &, dimension_type>
+    (result.block(), view.block(), axis);
+  return result;
+}
+
+/// Axis-wise versions of the standard reductions. Each reduces
+/// axis `axis` of a matrix or tensor view.
+template <typename V>
+typename reduction::axis_result<V::dim, typename Sum_value<typename V::value_type>::result_type>::type
+sumval(V view, dimension_type axis) { return reduce<Sum_value>(view, axis);}
+
+template <typename V>
+typename reduction::axis_result<V::dim, typename Sum_sq_value<typename V::value_type>::result_type>::type
+sumsqval(V view, dimension_type axis) { return reduce<Sum_sq_value>(view, axis);}
+
+template <typename V>
+typename reduction::axis_result<V::dim, typename Mean_value<typename V::value_type>::result_type>::type
+meanval(V view, dimension_type axis) { return reduce<Mean_value>(view, axis);}
+
+template <typename V>
+typename reduction::axis_result<V::dim, typename Mean_magsq_value<typename V::value_type>::result_type>::type
+meansqval(V view, dimension_type axis) { return reduce<Mean_magsq_value>(view, axis);}
+
+template <typename V>
+typename reduction::axis_result<V::dim, typename Max_value<typename V::value_type>::result_type>::type
+maxval(V view, dimension_type axis) { return reduce<Max_value>(view, axis);}
+
+template <typename V>
+typename reduction::axis_result<V::dim, typename Min_value<typename V::value_type>::result_type>::type
+minval(V view, dimension_type axis) { return reduce<Min_value>(view, axis);}
+
+template <typename V>
+typename reduction::axis_result<V::dim, typename Max_mag_value<typename V::value_type>::result_type>::type
+maxmgval(V view, dimension_type axis) { return reduce<Max_mag_value>(view, axis);}
+
+template <typename V>
+typename reduction::axis_result<V::dim, typename Max_magsq_value<typename V::value_type>::result_type>::type
+maxmgsqval(V view, dimension_type axis) { return reduce<Max_magsq_value>(view, axis);}
+
+} // namespace ovxx
+
+#endif
@@ -15,18 +15,16 @@
 #include <vsip/tensor.hpp>
 #include <vsip/dda.hpp>
 #include <ovxx/reductions/functors.hpp>
+#include <ovxx/reductions/summary.hpp>
 #include <ovxx/parallel/service.hpp>
 #include <ovxx/dispatch.hpp>
 #include <ovxx/length.hpp>
 #if OVXX_HAVE_CVSIP
 # include <ovxx/cvsip/reductions.hpp>
 #endif
-
-// This value is a tradeoff based on the fact that floating point 
-// values only have 24 bits of precision.  Adding lots of small
-// values can affect the accuracy of the result and this limit (4 K)
-// helps prevent these losses for very large reductions.
-#define OVXX_MAX_SUMMATION_LENGTH  (1 << 12)
+#ifdef OVXX_PARALLEL
+# include <ovxx/parallel/reductions.hpp>
+#endif
 
 namespace ovxx
 {
@@ -58,6 +56,7 @@ struct dispatcher
     typedef make_type_list<
       be::parallel,
       be::cuda,
+      be::opt,
       be::cvsip,
       be::generic>::type list_type;
 
@@ -122,74 +121,60 @@ struct dispatcher<R, V, true>
 };
 #endif
 
-// Is this reduction a summation?
-template <template <typename> class R>
-struct is_summation { static bool const value = false;};
-
-template<> struct is_summation<Sum_value> { static bool const value = true;};
-template<> struct is_summation<Sum_sq_value> { static bool const value = true;};
-template<> struct is_summation<Mean_value> { static bool const value = true;};
-template<> struct is_summation<Mean_magsq_value> { static bool const value = true;};
-
-// Are intermediate values squared before summing?
-template <template <typename> class R>
-struct is_sum_squared_based { static bool const value = false;};
-
-template<> struct is_sum_squared_based<Sum_sq_value> { static bool const value = true;};
-template<> struct is_sum_squared_based<Mean_magsq_value> { static bool const value = true;};
-
-// Is the result averaged after summing?
-template <template <typename> class R>
-struct is_mean_based { static bool const value = false;};
-
-template<> struct is_mean_based<Mean_value> { static bool const value = true;};
-template<> struct is_mean_based<Mean_magsq_value> { static bool const value = true;};
+/// Express reduction R over values of type T in terms of a summary.
+template <template <typename> class R, typename T>
+struct summary_reduction
+{
+  static bool const ct_valid = false;
+};
 
-// Get either only the real part, or both real and imaginary parts, depending
-// on the destination value type.
-template <typename T1, typename T2>
-struct extract
+template <typename T>
+struct summary_reduction<Sum_value, T>
 {
-  static void apply(T1 const& src, T2& dst) { dst = src;}
+  static bool const ct_valid = is_summarizable<T>::value;
+  static unsigned const what = sum_flag;
+  static T value(summary<T> const &s, length_type) { return T(s.sum);}
 };
 
-template <typename T1, typename T2>
-struct extract<complex<T1>, T2>
+template <typename T>
+struct summary_reduction<Mean_value, T>
 {
-  static void apply(complex<T1> const& src, T2& dst) { dst = src.real();}
+  static bool const ct_valid = is_summarizable<T>::value;
+  static unsigned const what = sum_flag;
+  static T value(summary<T> const &s, length_type size)
+  {
+    typedef typename summary<T>::accum_scalar_type scalar_type;
+    return T(s.sum / static_cast<scalar_type>(size));
+  }
 };
 
-template <template <typename> class R, typename T>
-T partial_sum(T const *data, std::ptrdiff_t offset, length_type len)
+template <typename T>
+struct summary_reduction<Sum_sq_value, T>
 {
-  T result = T();
-  data += offset;
-  if (is_sum_squared_based<R>::value)
-    for (index_type i = 0; i < len; ++i)
-      result += data[i]*data[i];
-  else
-    for (index_type i = 0; i < len; ++i)
-      result += data[i];
-  return result;
-}
+  static bool const ct_valid = is_summarizable<T>::value && !is_complex<T>::value;
+  static unsigned const what = sumsq_flag;
+  static T value(summary<T> const &s, length_type) { return T(s.sumsq);}
+};
 
-template <template <typename> class R, typename T>
-complex<T> partial_sum(std::pair<T const*, T const*> const &data, std::ptrdiff_t offset, length_type len)
+template <typename T>
+struct summary_reduction<Sum_magsq_value, T>
 {
-  complex<T> result = complex<T>();
-  if (is_sum_squared_based<R>::value)
-    for (index_type i = 0; i < len; ++i)
-    {
-      complex<T> val = 
-        complex<T>(data.first[i + offset], data.second[i + offset]);
-      result += val*val;
-    }
-  else
-    for (index_type i = 0; i < len; ++i)
-      result += complex<T>(data.first[i + offset], data.second[i + offset]);
+  typedef typename scalar_of<T>::type result_type;
+  static bool const ct_valid = is_summarizable<T>::value;
+  static unsigned const what = sumsq_flag;
+  static result_type value(summary<T> const &s, length_type)
+  { return result_type(s.sumsq);}
+};
 
-  return result;
-}
+template <typename T>
+struct summary_reduction<Mean_magsq_value, T>
+{
+  typedef typename scalar_of<T>::type result_type;
+  static bool const ct_valid = is_summarizable<T>::value;
+  static unsigned const what = sumsq_flag;
+  static result_type value(summary<T> const &s, length_type size)
+  { return result_type(s.sumsq / size);}
+};
 
 } // namespace ovxx::reduction
 
@@ -230,10 +215,35 @@ struct List<op::reduce<R> >
 {
   typedef make_type_list<be::user,
 			 be::cuda,
+			 be::opt,
 			 be::cvsip,
 			 be::generic>::type type;
 };
 
+/// Summations over floating-point data, computed with several
+/// independent (and vectorized) partial sums, split across the
+/// default thread pool for large enough problems.
+template <template <typename> class R,
+	  typename T, typename B, typename O, dimension_type D>
+struct Evaluator<op::reduce<R>, be::opt,
+  void(T&, B const&, O, integral_constant<dimension_type, D>)>
+{
+  typedef typename B::value_type value_type;
+  typedef reduction::summary_reduction<R, value_type> traits;
+
+  static char const* name() { return "opt";}
+
+  static bool const ct_valid = traits::ct_valid;
+  static bool rt_valid(T&, B const& a, O, integral_constant<dimension_type, D>)
+  { return reduction::use_summary(a);}
+
+  static void exec(T& r, B const& a, O, integral_constant<dimension_type, D>)
+  {
+    using namespace reduction;
+    r = traits::value(summarize_block<value_type>(a, traits::what), a.size());
+  }
+};
+
 template <template <typename> class R,
 	  typename T, typename B>
 struct Evaluator<op::reduce<R>, be::generic, 
@@ -247,58 +257,17 @@ struct Evaluator<op::reduce<R>, be::generic,
 
   static void exec(T& r, B const& a, row1_type, integral_constant<dimension_type, 1>)
   {
-    using namespace reduction;
+    typedef typename B::value_type V;
+    typename R<V>::accum_type state = R<V>::initial();
     length_type length = a.size(1, 0);
-    length_type const max_length = OVXX_MAX_SUMMATION_LENGTH;
-
-    // Anything under the maximum length, not a summation (min/max)
-    // or not dealing with single-precision floating point is 
-    // handled in the usual way.
-    if (!is_summation<R>::value ||
-        !is_same<typename scalar_of<T>::type, float>::value ||
-        (length < max_length))
-    {
-      typedef typename B::value_type V;
-      typename R<V>::accum_type state = R<V>::initial();
 
-      PRAGMA_IVDEP
-        for (index_type i=0; i<length; ++i)
-        {
-          state = R<V>::update(state, a.get(i));
-          if (R<V>::done(state)) break;
-        }
-      r = R<V>::value(state, length);
-    }
-    else
+    PRAGMA_IVDEP
+    for (index_type i=0; i<length; ++i)
     {
-      // Special handling is provided for very large summations by breaking
-      // them into smaller blocks and saving intermediate results.  This avoids
-      // accuracy issues related to round-off error when single-precision
-      // is used.
-      length_type const subblocks = length % max_length ?
-        length / max_length + 1 : length / max_length;
-      length_type const last_subblock_size = length % max_length ?
-        length % max_length : max_length;
-
-      vsip::dda::Data<B, vsip::dda::in> data(a);
-
-      typename B::value_type result = 0;
-      index_type sb = 0;
-      for (; sb < subblocks - 1; ++sb)
-      {
-        result += partial_sum<R>(data.ptr(), sb * max_length, max_length);
-      }
-      result += partial_sum<R>(data.ptr(), sb * max_length, last_subblock_size);
-
-      // Partial sums are accumlated in the view's natural type, even
-      // for magnitude-of-squared values where the imaginary part is zero.
-      // The result type is real in those cases, so we extract the desired
-      // part depending on the type being returned.
-      extract<typename B::value_type, T>::apply(result, r);
-
-      if (is_mean_based<R>::value)
-        r /= length;
+      state = R<V>::update(state, a.get(i));
+      if (R<V>::done(state)) break;
     }
+    r = R<V>::value(state, length);
   }
 };
 
@@ -14,6 +14,7 @@
 #include <vsip/matrix.hpp>
 #include <vsip/tensor.hpp>
 #include <ovxx/reductions/functors.hpp>
+#include <ovxx/reductions/summary.hpp>
 #include <ovxx/dispatch.hpp>
 #if OVXX_HAVE_CVSIP
 # include <ovxx/cvsip/reductions_idx.hpp>
@@ -21,13 +22,101 @@
 
 namespace ovxx
 {
+namespace reduction
+{
+/// Express index reduction R over values of type T in terms of a
+/// summary. Extrema of real values are found by value, those of
+/// complex values by magnitude.
+template <template <typename> class R, typename T>
+struct summary_reduction_idx
+{
+  static bool const ct_valid = false;
+};
+
+template <typename T>
+struct summary_reduction_idx<Max_value, T>
+{
+  static bool const ct_valid = is_summarizable<T>::value && !is_complex<T>::value;
+  static T value(summary<T> const &s) { return s.max;}
+  static index_type index(summary<T> const &s) { return s.max_idx;}
+};
+
+template <typename T>
+struct summary_reduction_idx<Min_value, T>
+{
+  static bool const ct_valid = is_summarizable<T>::value && !is_complex<T>::value;
+  static T value(summary<T> const &s) { return s.min;}
+  static index_type index(summary<T> const &s) { return s.min_idx;}
+};
+
+template <typename T>
+struct summary_reduction_idx<Max_magsq_value, T>
+{
+  typedef typename scalar_of<T>::type result_type;
+  static bool const ct_valid = is_summarizable<T>::value && is_complex<T>::value;
+  static result_type value(summary<T> const &s) { return s.max;}
+  static index_type index(summary<T> const &s) { return s.max_idx;}
+};
+
+template <typename T>
+struct summary_reduction_idx<Min_magsq_value, T>
+{
+  typedef typename scalar_of<T>::type result_type;
+  static bool const ct_valid = is_summarizable<T>::value && is_complex<T>::value;
+  static result_type value(summary<T> const &s) { return s.min;}
+  static index_type index(summary<T> const &s) { return s.min_idx;}
+};
+
+template <typename T>
+struct summary_reduction_idx<Max_mag_value, T>
+{
+  typedef typename scalar_of<T>::type result_type;
+  static bool const ct_valid = is_summarizable<T>::value && is_complex<T>::value;
+  static result_type value(summary<T> const &s) { return std::sqrt(s.max);}
+  static index_type index(summary<T> const &s) { return s.max_idx;}
+};
+
+template <typename T>
+struct summary_reduction_idx<Min_mag_value, T>
+{
+  typedef typename scalar_of<T>::type result_type;
+  static bool const ct_valid = is_summarizable<T>::value && is_complex<T>::value;
+  static result_type value(summary<T> const &s) { return std::sqrt(s.min);}
+  static index_type index(summary<T> const &s) { return s.min_idx;}
+};
+
+} // namespace ovxx::reduction
+
 namespace dispatcher
 {
 
 template<template <typename> class R>
 struct List<op::reduce_idx<R> >
 {
-  typedef make_type_list<be::parallel, be::cvsip, be::cuda, be::generic>::type type;
+  typedef make_type_list<be::parallel, be::opt, be::cvsip, be::cuda, be::generic>::type type;
+};
+
+/// Extrema of floating-point data, found with vectorized kernels and
+/// split across the default thread pool for large enough problems.
+template <template <typename> class R,
+          typename T, typename Block, dimension_type D, typename O>
+struct Evaluator<op::reduce_idx<R>, be::opt,
+                 void(T&, Block const&, Index<D>&, O)>
+{
+  typedef typename Block::value_type value_type;
+  typedef reduction::summary_reduction_idx<R, value_type> traits;
+
+  static bool const ct_valid = traits::ct_valid;
+  static bool rt_valid(T&, Block const& a, Index<D>&, O)
+  { return reduction::use_summary(a);}
+
+  static void exec(T& r, Block const& a, Index<D>& idx, O)
+  {
+    using namespace reduction;
+    summary<value_type> s = summarize_block<value_type>(a, minmax_flag);
+    idx = unravel<O>(traits::index(s), extent<D>(a));
+    r = traits::value(s);
+  }
 };
 
 /// Generic evaluator for vector reductions.
@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_reductions_stats_hpp_
+#define ovxx_reductions_stats_hpp_
+
+#include <ovxx/reductions/summary.hpp>
+#include <vsip/support.hpp>
+#include <vsip/domain.hpp>
+
+namespace ovxx
+{
+
+/// The result of `stats()`.
+template <typename T, dimension_type D>
+struct Statistics
+{
+  typedef typename scalar_of<T>::type scalar_type;
+
+  /// The sum and the mean of the values.
+  T sum;
+  T mean;
+  /// The sum and the mean of the magnitudes squared.
+  scalar_type sumsq;
+  scalar_type meansq;
+  /// The smallest and largest values (for complex values, the
+  /// smallest and largest magnitudes squared), and the indices of
+  /// their first occurrences.
+  scalar_type min;
+  scalar_type max;
+  Index<D> min_idx;
+  Index<D> max_idx;
+};
+
+/// Compute the statistics of a (non-empty, local) view in a single
+/// pass over its data. For real values this is equivalent to calling
+/// `sumval()`, `meanval()`, `sumsqval()`, `meansqval()`, `minval()`
+/// and `maxval()`, but reads the data only once.
+///
+/// For complex values, `sumsq` and `meansq` are the (real) sum and
+/// mean of the magnitudes squared, sum(|z|^2). `meansq` thus matches
+/// `meansqval()`, but `sumsq` does not match `sumsqval()`, which
+/// computes the complex sum(z^2). `min` and `max` match `minmgsqval()`
+/// and `maxmgsqval()`.
+template <template <typename, typename> class V, typename T, typename B>
+Statistics<T, V<T, B>::dim>
+stats(V<T, B> view)
+{
+  using namespace reduction;
+  dimension_type const dim = V<T, B>::dim;
+  typedef typename get_block_layout<B>::order_type order_type;
+  typedef typename summary<T>::accum_scalar_type accum_scalar_type;
+
+  length_type const size = view.size();
+  OVXX_PRECONDITION(size > 0);
+  summary<T> s = summarize_block<T>(view.block(),
+				    sum_flag | sumsq_flag | minmax_flag);
+
+  Statistics<T, dim> r;
+  r.sum = T(s.sum);
+  r.mean = T(s.sum / static_cast<accum_scalar_type>(size));
+  r.sumsq = s.sumsq;
+  r.meansq = s.sumsq / static_cast<accum_scalar_type>(size);
+  r.min = s.min;
+  r.max = s.max;
+  Length<dim> length = extent<dim>(view.block());
+  r.min_idx = unravel<order_type>(s.min_idx, length);
+  r.max_idx = unravel<order_type>(s.max_idx, length);
+  return r;
+}
+
+} // namespace ovxx
+
+#endif
@@ -0,0 +1,535 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_reductions_summary_hpp_
+#define ovxx_reductions_summary_hpp_
+
+#include <ovxx/support.hpp>
+#include <ovxx/complex_traits.hpp>
+#include <ovxx/simd/simd.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <ovxx/block_traits.hpp>
+#include <ovxx/length.hpp>
+#include <ovxx/expr/evaluate.hpp>
+#include <vsip/domain.hpp>
+#include <vsip/dda.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace ovxx
+{
+namespace reduction
+{
+
+/// The length of the blocks single-precision values are summed in
+/// before the partial sums are accumulated in double precision.
+length_type const block_length = 1024;
+
+/// The length of the chunks a summary is split into. The chunks
+/// don't depend on the number of threads, so neither does the result.
+length_type const chunk_length = 16 * block_length;
+
+/// The quantities a summary may be asked for.
+enum summary_flags
+{
+  sum_flag = 1,
+  sumsq_flag = 2,
+  minmax_flag = 4
+};
+
+/// Statistics of a range of values of type T, gathered in a single
+/// pass by `summarize()`.
+///
+/// `sumsq` is the sum of the magnitudes squared. `min` and `max` are
+/// the extreme values for real T, and the extreme magnitudes squared
+/// for complex T. Single-precision sums are accumulated in double
+/// precision.
+template <typename T>
+struct summary
+{
+  typedef typename scalar_of<T>::type scalar_type;
+  typedef typename conditional<is_same<scalar_type, float>::value,
+			       double, scalar_type>::type accum_scalar_type;
+  typedef typename conditional<is_complex<T>::value,
+			       complex<accum_scalar_type>,
+			       accum_scalar_type>::type accum_type;
+
+  summary()
+    : sum(), sumsq(), min(), max(), min_idx(0), max_idx(0) {}
+
+  /// Merge in the summary `s` of the values following the ones
+  /// summarized here. Ties are resolved in favor of the earlier index.
+  void merge(summary const &s)
+  {
+    sum += s.sum;
+    sumsq += s.sumsq;
+    if (s.min < min) { min = s.min; min_idx = s.min_idx;}
+    if (s.max > max) { max = s.max; max_idx = s.max_idx;}
+  }
+
+  accum_type sum;
+  accum_scalar_type sumsq;
+  scalar_type min;
+  scalar_type max;
+  index_type min_idx;
+  index_type max_idx;
+};
+
+namespace detail
+{
+// The key extrema are selected by.
+template <typename T>
+inline T key(T value) { return value;}
+template <typename T>
+inline T key(complex<T> const &value)
+{ return value.real() * value.real() + value.imag() * value.imag();}
+
+// The magnitude squared.
+template <typename T>
+inline T sq(T value) { return value * value;}
+template <typename T>
+inline T sq(complex<T> const &value) { return key(value);}
+
+template <typename T>
+inline T const *offset(T const *p, index_type i) { return p + i;}
+template <typename T>
+inline std::pair<T const *, T const *>
+offset(std::pair<T const *, T const *> const &p, index_type i)
+{ return std::make_pair(p.first + i, p.second + i);}
+
+inline void assign(summary<float> &s, simd::stats const &st)
+{
+  s.sum = st.sum;
+  s.sumsq = st.sumsq;
+  s.min = st.min;
+  s.max = st.max;
+  s.min_idx = st.min_idx;
+  s.max_idx = st.max_idx;
+}
+
+// Summarize values whose magnitudes squared are computed by
+// `magsq(i, n, buffer)` in cache-sized blocks.
+template <typename F>
+void summarize_magsq(F const &magsq, length_type n, summary<complex<float> > &s)
+{
+  float buffer[block_length];
+  for (index_type b = 0; b < n; b += block_length)
+  {
+    length_type const size = std::min(block_length, n - b);
+    magsq(b, size, buffer);
+    simd::stats st;
+    simd::get_kernels().vstats(buffer, size, &st);
+    summary<complex<float> > p;
+    p.sumsq = st.sum;
+    p.min = st.min;
+    p.max = st.max;
+    p.min_idx = b + st.min_idx;
+    p.max_idx = b + st.max_idx;
+    if (b == 0)
+      s = p;
+    else
+      s.merge(p);
+  }
+}
+
+struct interleaved_magsq
+{
+  float const *a;
+  void operator()(index_type i, length_type n, float *r) const
+  { simd::get_kernels().cvmagsq(a + 2 * i, r, n);}
+};
+
+struct split_magsq
+{
+  float const *re;
+  float const *im;
+  void operator()(index_type i, length_type n, float *r) const
+  { simd::get_kernels().zvmagsq(re + i, im + i, r, n);}
+};
+
+template <typename P, typename T>
+void summarize_halves(P const &a, length_type n, unsigned what, summary<T> &s);
+
+} // namespace ovxx::reduction::detail
+
+/// Summarize the `n` (> 0) values of `a`. Only the quantities
+/// requested in `what` are guaranteed to be computed.
+template <typename T>
+void
+summarize(T const *a, length_type n, unsigned what, summary<T> &s)
+{
+  if (n > block_length)
+  {
+    detail::summarize_halves(a, n, what, s);
+    return;
+  }
+  typedef typename summary<T>::accum_type A;
+  typedef typename summary<T>::accum_scalar_type Q;
+  // Four independent accumulators break the dependency chain.
+  A sum[4] = {A(), A(), A(), A()};
+  Q sumsq[4] = {Q(), Q(), Q(), Q()};
+  index_type i = 0;
+  if (what == sum_flag)
+  {
+    for (; i + 4 <= n; i += 4)
+      for (index_type j = 0; j != 4; ++j)
+	sum[j] += A(a[i + j]);
+    for (; i < n; ++i)
+      sum[0] += A(a[i]);
+  }
+  else if (what == sumsq_flag)
+  {
+    for (; i + 4 <= n; i += 4)
+      for (index_type j = 0; j != 4; ++j)
+	sumsq[j] += Q(detail::sq(a[i + j]));
+    for (; i < n; ++i)
+      sumsq[0] += Q(detail::sq(a[i]));
+  }
+  else
+  {
+    s.min = s.max = detail::key(a[0]);
+    s.min_idx = s.max_idx = 0;
+    for (; i < n; ++i)
+    {
+      typename summary<T>::scalar_type k = detail::key(a[i]);
+      sum[i % 4] += A(a[i]);
+      sumsq[i % 4] += Q(detail::sq(a[i]));
+      if (k < s.min) { s.min = k; s.min_idx = i;}
+      if (k > s.max) { s.max = k; s.max_idx = i;}
+    }
+  }
+  s.sum = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+  s.sumsq = (sumsq[0] + sumsq[1]) + (sumsq[2] + sumsq[3]);
+}
+
+template <typename T>
+void
+summarize(std::pair<T const *, T const *> const &a, length_type n,
+	  unsigned what, summary<complex<T> > &s)
+{
+  typedef typename summary<complex<T> >::accum_scalar_type Q;
+  if (n > block_length)
+  {
+    detail::summarize_halves(a, n, what, s);
+    return;
+  }
+  if (what == sum_flag)
+  {
+    summary<T> re, im;
+    summarize(a.first, n, sum_flag, re);
+    summarize(a.second, n, sum_flag, im);
+    s.sum = complex<Q>(re.sum, im.sum);
+    return;
+  }
+  Q sum_re = Q(), sum_im = Q(), sumsq = Q();
+  s.min = s.max = a.first[0] * a.first[0] + a.second[0] * a.second[0];
+  s.min_idx = s.max_idx = 0;
+  for (index_type i = 0; i != n; ++i)
+  {
+    T k = a.first[i] * a.first[i] + a.second[i] * a.second[i];
+    sum_re += a.first[i];
+    sum_im += a.second[i];
+    sumsq += k;
+    if (k < s.min) { s.min = k; s.min_idx = i;}
+    if (k > s.max) { s.max = k; s.max_idx = i;}
+  }
+  s.sum = complex<Q>(sum_re, sum_im);
+  s.sumsq = sumsq;
+}
+
+inline void
+summarize(float const *a, length_type n, unsigned what, summary<float> &s)
+{
+  simd::kernels const &k = simd::get_kernels();
+  if (what == sum_flag)
+    s.sum = k.vsum(a, n);
+  else if (what == sumsq_flag)
+    s.sumsq = k.vsumsq(a, n);
+  else
+  {
+    simd::stats st;
+    k.vstats(a, n, &st);
+    detail::assign(s, st);
+  }
+}
+
+inline void
+summarize(complex<float> const *a, length_type n, unsigned what,
+	  summary<complex<float> > &s)
+{
+  simd::kernels const &k = simd::get_kernels();
+  float const *f = reinterpret_cast<float const *>(a);
+  if (what & minmax_flag)
+  {
+    detail::interleaved_magsq magsq = {f};
+    detail::summarize_magsq(magsq, n, s);
+  }
+  else if (what & sumsq_flag)
+    s.sumsq = k.vsumsq(f, 2 * n);
+  if (what & (sum_flag | minmax_flag))
+  {
+    double re, im;
+    k.cvsum(f, n, &re, &im);
+    s.sum = complex<double>(re, im);
+  }
+}
+
+inline void
+summarize(std::pair<float const *, float const *> const &a, length_type n,
+	  unsigned what, summary<complex<float> > &s)
+{
+  simd::kernels const &k = simd::get_kernels();
+  if (what & minmax_flag)
+  {
+    detail::split_magsq magsq = {a.first, a.second};
+    detail::summarize_magsq(magsq, n, s);
+  }
+  else if (what & sumsq_flag)
+    s.sumsq = k.vsumsq(a.first, n) + k.vsumsq(a.second, n);
+  if (what & (sum_flag | minmax_flag))
+    s.sum = complex<double>(k.vsum(a.first, n), k.vsum(a.second, n));
+}
+
+namespace detail
+{
+// Summarize the two halves of `a` separately, and merge the results.
+// Summing pairwise like this lets round-off errors grow with log(n),
+// rather than with n.
+template <typename P, typename T>
+void summarize_halves(P const &a, length_type n, unsigned what, summary<T> &s)
+{
+  length_type const half = n / 2;
+  summary<T> upper;
+  summarize(a, half, what, s);
+  summarize(offset(a, half), n - half, what, upper);
+  upper.min_idx += half;
+  upper.max_idx += half;
+  s.merge(upper);
+}
+
+template <typename T, typename P>
+struct summarize_task
+{
+  P data;
+  length_type size;
+  unsigned what;
+  summary<T> *partials;
+
+  void operator()(index_type c)
+  {
+    index_type const begin = c * chunk_length;
+    summarize(offset(data, begin), std::min(chunk_length, size - begin), what,
+	      partials[c]);
+    partials[c].min_idx += begin;
+    partials[c].max_idx += begin;
+  }
+};
+
+// Run `task` for each chunk of `n` values, splitting the work across
+// the default thread pool for large enough problems, and merge the
+// partial results pairwise.
+template <typename T, typename F>
+summary<T>
+summarize_chunks(F &task, length_type n)
+{
+  OVXX_PRECONDITION(n > 0);
+  length_type const chunks = (n + chunk_length - 1) / chunk_length;
+  std::vector<summary<T> > partials(chunks);
+  task.partials = &partials[0];
+  if (n >= thread_pool::threshold())
+    thread_pool::get_default()->parallel_for(chunks, task);
+  else
+    for (index_type c = 0; c != chunks; ++c)
+      task(c);
+  for (length_type step = 1; step < chunks; step *= 2)
+    for (index_type c = 0; c + step < chunks; c += 2 * step)
+      partials[c].merge(partials[c + step]);
+  return partials[0];
+}
+} // namespace ovxx::reduction::detail
+
+/// Summarize the `n` (> 0) values of `a`, in chunks of `chunk_length`
+/// values, which are split across the default thread pool for large
+/// enough problems.
+template <typename T, typename P>
+summary<T>
+summarize(P const &a, length_type n, unsigned what)
+{
+  detail::summarize_task<T, P> task = {a, n, what, 0};
+  return detail::summarize_chunks<T>(task, n);
+}
+
+/// True if values of type T can be summarized.
+template <typename T>
+struct is_summarizable
+{
+  typedef typename scalar_of<T>::type scalar_type;
+  static bool const value =
+    is_same<scalar_type, float>::value || is_same<scalar_type, double>::value;
+};
+
+template <typename T>
+inline T const *const_ptr(T const *p) { return p;}
+template <typename T>
+inline std::pair<T const *, T const *>
+const_ptr(std::pair<T *, T *> const &p) { return std::make_pair(p.first, p.second);}
+template <typename T>
+inline std::pair<T const *, T const *>
+const_ptr(std::pair<T const *, T const *> const &p) { return p;}
+
+namespace detail
+{
+template <typename B>
+bool is_dense(B const &b, true_type)
+{
+  typedef typename get_block_layout<B>::order_type order_type;
+  dimension_type const order[] =
+    {order_type::impl_dim0, order_type::impl_dim1, order_type::impl_dim2};
+  dda::Data<B, dda::in> data(b);
+  stride_type stride = 1;
+  for (dimension_type d = B::dim; d-- > 0;)
+  {
+    if (data.stride(order[d]) != stride) return false;
+    stride *= data.size(order[d]);
+  }
+  return true;
+}
+
+template <typename B>
+bool is_dense(B const &, false_type) { return false;}
+
+template <typename B>
+struct is_direct
+  : integral_constant<bool, !is_expr_block<B>::value &&
+		      dda::Data<B, dda::in>::ct_cost == 0>
+{};
+} // namespace ovxx::reduction::detail
+
+/// Return true if `b` is best reduced through a summary. That is the
+/// case if it isn't empty, and its data is dense, or it is long enough
+/// for the blocked summation to pay off against the generic loop,
+/// after reading it in tiles.
+template <typename B>
+bool
+use_summary(B const &b)
+{
+  return b.size() != 0 &&
+    (detail::is_dense(b, detail::is_direct<B>()) || b.size() >= block_length);
+}
+
+/// Convert a linear index into a dense array in dimension order O
+/// into a D-dimensional index.
+template <typename O, dimension_type D>
+Index<D>
+unravel(index_type i, Length<D> const &length)
+{
+  dimension_type const order[] = {O::impl_dim0, O::impl_dim1, O::impl_dim2};
+  Index<D> idx;
+  for (dimension_type d = D; d-- > 0;)
+  {
+    idx[order[d]] = i % length[order[d]];
+    i /= length[order[d]];
+  }
+  return idx;
+}
+
+namespace detail
+{
+// Summarize the values of a block that isn't dense (or has no data
+// of its own), reading each chunk in tiles of `block_length` values,
+// so no temporary of the block's size is needed.
+template <typename T, typename B>
+struct summarize_tiles_task
+{
+  typedef typename get_block_layout<B>::order_type order_type;
+  static dimension_type const dim = B::dim;
+
+  B const &block;
+  Length<dim> length;
+  length_type size;
+  unsigned what;
+  summary<T> *partials;
+
+  void operator()(index_type c)
+  {
+    index_type const begin = c * chunk_length;
+    length_type const n = std::min(chunk_length, size - begin);
+    std::vector<T> tile(std::min(block_length, n));
+    for (index_type t = 0; t < n; t += block_length)
+    {
+      length_type const m = std::min(block_length, n - t);
+      read(begin + t, m, &tile[0]);
+      summary<T> p;
+      summarize(static_cast<T const *>(&tile[0]), m, what, p);
+      p.min_idx += begin + t;
+      p.max_idx += begin + t;
+      if (t == 0)
+	partials[c] = p;
+      else
+	partials[c].merge(p);
+    }
+  }
+
+  // Read the `n` values starting at linear index `begin`
+  // (in dimension order) into `tile`.
+  void read(index_type begin, length_type n, T *tile) const
+  {
+    dimension_type const order[] =
+      {order_type::impl_dim0, order_type::impl_dim1, order_type::impl_dim2};
+    Index<dim> idx = unravel<order_type>(begin, length);
+    for (index_type k = 0; k != n; ++k)
+    {
+      tile[k] = get(block, idx);
+      for (dimension_type d = dim; d-- > 0;)
+      {
+	if (++idx[order[d]] != length[order[d]]) break;
+	idx[order[d]] = 0;
+      }
+    }
+  }
+};
+
+template <typename T, typename B>
+summary<T>
+summarize_block(B const &b, unsigned what, false_type)
+{
+  // Non-elementwise operands compute their values on the first
+  // element access, which isn't thread-safe, so do that here,
+  // before the tiles are read concurrently.
+  expr::evaluate(b);
+  summarize_tiles_task<T, B> task =
+    {b, extent<B::dim>(b), b.size(), what, 0};
+  return summarize_chunks<T>(task, b.size());
+}
+
+template <typename T, typename B>
+summary<T>
+summarize_block(B const &b, unsigned what, true_type)
+{
+  if (!is_dense(b, true_type()))
+    return summarize_block<T>(b, what, false_type());
+  dda::Data<B, dda::in> data(b);
+  return summarize<T>(const_ptr(data.ptr()), b.size(), what);
+}
+} // namespace ovxx::reduction::detail
+
+/// Summarize the (> 0) values of `b`, in the dimension order of its
+/// layout. Dense data is read in place, and all other blocks
+/// (including expressions) are read in tiles, so the summary never
+/// needs a temporary of the block's size.
+template <typename T, typename B>
+summary<T>
+summarize_block(B const &b, unsigned what)
+{
+  return detail::summarize_block<T>(b, what, detail::is_direct<B>());
+}
+
+} // namespace ovxx::reduction
+} // namespace ovxx
+
+#endif
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_shm_chain_builder_hpp_
+#define ovxx_shm_chain_builder_hpp_
+
+#include <ovxx/support.hpp>
+#include <ovxx/parallel/copy_chain.hpp>
+#include <utility>
+
+namespace ovxx
+{
+namespace shm
+{
+
+/// Build copy chains describing the data of a message.
+/// Chains are built relative to a zero base address, and
+/// stitched to the address of the actual data when
+/// the message is set up.
+class Chain_builder
+{
+public:
+  template <typename T>
+  void add(std::ptrdiff_t offset, int stride, unsigned length)
+  {
+    chain_.add(address(offset), sizeof(T), stride, length);
+  }
+
+  template <typename T>
+  void add(std::ptrdiff_t offset,
+	   int stride0, unsigned length0,
+	   int stride1, unsigned length1)
+  {
+    // Dense rows are copied as a single record.
+    if (stride1 == 1 && stride0 == static_cast<int>(length1))
+      chain_.add(address(offset), sizeof(T), 1, length0 * length1);
+    else
+      for (unsigned i = 0; i < length0; ++i)
+	chain_.add(address(offset + sizeof(T)*i*stride0),
+		   sizeof(T), stride1, length1);
+  }
+
+  void* base() { return 0;}
+
+  parallel::Copy_chain get_chain() { return chain_;}
+
+  void stitch(void* base, parallel::Copy_chain const &chain)
+  {
+    chain_.append_offset(base, chain);
+  }
+
+  void stitch(std::pair<void*,void*> base, parallel::Copy_chain const &chain)
+  {
+    stitch(base.first, chain);
+    stitch(base.second, chain);
+  }
+
+  bool is_empty() const { return chain_.size() == 0;}
+
+private:
+  static void *address(std::ptrdiff_t offset)
+  { return reinterpret_cast<void*>(offset);}
+
+  parallel::Copy_chain chain_;
+};
+
+inline void
+free_chain(parallel::Copy_chain &chain)
+{
+  chain = parallel::Copy_chain();
+}
+
+} // namespace ovxx::shm
+} // namespace ovxx
+
+#endif
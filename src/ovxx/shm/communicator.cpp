@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#include <ovxx/shm/communicator.hpp>
+#include <ovxx/shm/world.hpp>
+#include <cstring>
+
+namespace ovxx
+{
+namespace shm
+{
+
+World::World(length_type size)
+  : size_(size),
+    sends_(size),
+    recvs_(size),
+    arrived_(0),
+    generation_(0),
+    slots_(size)
+{}
+
+void World::post(Request *req)
+{
+  Request *match = 0;
+  {
+    cxx11::lock_guard<cxx11::mutex> lock(mutex_);
+    OVXX_PRECONDITION(req->done && "request already started");
+    OVXX_PRECONDITION(req->src < size_ && req->dst < size_);
+    req->done = false;
+    queue_type &pending = req->is_send ? recvs_[req->dst] : sends_[req->dst];
+    for (queue_type::iterator i = pending.begin(); i != pending.end(); ++i)
+      if ((*i)->src == req->src)
+      {
+	match = *i;
+	pending.erase(i);
+	break;
+      }
+    if (!match)
+    {
+      (req->is_send ? sends_ : recvs_)[req->dst].push_back(req);
+      return;
+    }
+  }
+  // Neither request is visible to other processors any more,
+  // so the data can be copied without holding the lock.
+  Request *send = req->is_send ? req : match;
+  Request *recv = req->is_send ? match : req;
+  OVXX_PRECONDITION(send->chain.data_size() == recv->chain.data_size());
+  if (send->chain.data_size())
+    send->chain.copy_into(recv->chain);
+
+  cxx11::lock_guard<cxx11::mutex> lock(mutex_);
+  complete(send);
+  complete(recv);
+  done_.notify_all();
+}
+
+void World::wait(Request *req)
+{
+  cxx11::unique_lock<cxx11::mutex> lock(mutex_);
+  while (!req->done) done_.wait(lock);
+}
+
+void World::barrier()
+{
+  cxx11::unique_lock<cxx11::mutex> lock(barrier_mutex_);
+  unsigned int const generation = generation_;
+  if (++arrived_ == size_)
+  {
+    arrived_ = 0;
+    ++generation_;
+    barrier_.notify_all();
+  }
+  else
+    while (generation == generation_) barrier_.wait(lock);
+}
+
+void const *const *World::publish(processor_type rank, void const *value)
+{
+  slots_[rank] = value;
+  barrier();
+  return &slots_[0];
+}
+
+void World::complete(Request *req)
+{
+  if (req->detached) delete req;
+  else req->done = true;
+}
+
+Communicator::Communicator(shared_ptr<World> world, processor_type rank)
+  : world_(world),
+    rank_(rank),
+    pvec_(world->size())
+{
+  for (index_type i = 0; i != pvec_.size(); ++i)
+    pvec_[i] = static_cast<processor_type>(i);
+}
+
+Communicator Communicator::split(int color, int key) const
+{
+  OVXX_PRECONDITION(color >= 0);
+  struct member
+  {
+    int color;
+    int key;
+    shared_ptr<World> world;
+  } self = { color, key, shared_ptr<World>()};
+
+  void const *const *members = publish(&self);
+  // The lowest-ranked member of each subset creates its world.
+  processor_type leader = rank_;
+  processor_type rank = 0;
+  length_type size = 0;
+  for (processor_type r = 0; r != pvec_.size(); ++r)
+  {
+    member const &m = *static_cast<member const *>(members[r]);
+    if (m.color != color) continue;
+    ++size;
+    if (r < leader) leader = r;
+    if (m.key < key || (m.key == key && r < rank_)) ++rank;
+  }
+  member const &lead = *static_cast<member const *>(members[leader]);
+  if (leader == rank_)
+    self.world.reset(new World(size));
+  barrier();
+  shared_ptr<World> world = lead.world;
+  // Keep `self` alive until all members have got their world.
+  barrier();
+  return Communicator(world, rank);
+}
+
+void Communicator::barrier() const
+{
+  world_->barrier();
+}
+
+/// Wait for a previous communication (send or receive) to complete.
+void Communicator::wait(request_type &req)
+{
+  world_->wait(req);
+  if (!req->persistent)
+  {
+    delete req;
+    req = 0;
+  }
+}
+
+/// Release a persistent request.
+void Communicator::free(request_type &req)
+{
+  OVXX_PRECONDITION(req->done && "request still pending");
+  delete req;
+  req = 0;
+}
+
+Communicator::request_type
+Communicator::make_request(bool is_send, processor_type proc,
+			   chain_type const &chain, bool persistent) const
+{
+  if (is_send) return new Request(true, rank_, proc, chain, persistent);
+  else return new Request(false, proc, rank_, chain, persistent);
+}
+
+void Communicator::post(request_type req) const
+{
+  world_->post(req);
+}
+
+// The data is copied into the request, so the caller may reuse
+// its buffer right away.
+void Communicator::buf_send(processor_type dest_proc, void const *data,
+			    size_t elem_size, length_type size)
+{
+  request_type req = make_request(true, dest_proc, chain_type(), false);
+  req->detached = true;
+  char const *begin = static_cast<char const*>(data);
+  req->buffer.assign(begin, begin + elem_size * size);
+  if (size)
+    req->chain.add(&req->buffer[0], elem_size, 1, size);
+  world_->post(req);
+}
+
+void Communicator::broadcast_bytes(processor_type root_proc,
+				   void *data, size_t size)
+{
+  void const *const *values = publish(data);
+  if (rank_ != root_proc)
+    std::memcpy(data, values[root_proc], size);
+  barrier();
+}
+
+void const *const *Communicator::publish(void const *value) const
+{
+  return world_->publish(rank_, value);
+}
+
+} // namespace ovxx::shm
+} // namespace ovxx
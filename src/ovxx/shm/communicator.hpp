@@ -0,0 +1,298 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_shm_communicator_hpp_
+#define ovxx_shm_communicator_hpp_
+
+#include <ovxx/support.hpp>
+#include <ovxx/reductions/types.hpp>
+#include <ovxx/parallel/copy_chain.hpp>
+#include <ovxx/c++11.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace ovxx
+{
+namespace shm
+{
+
+class World;
+struct Request;
+
+/// A communicator permits communication and synchronization
+/// among a set of processors, which are threads of the same process.
+///
+/// Messages are matched in the order they are posted, as with MPI.
+/// Their data is copied directly from the sender's into the receiver's
+/// memory, by whichever of the two posts its request last.
+class Communicator
+{
+public:
+  typedef Request *request_type;
+  typedef parallel::Copy_chain chain_type;
+  typedef std::vector<processor_type> pvec_type;
+
+public:
+  Communicator() : rank_(0) {}
+
+  /// Build the communicator through which processor `rank`
+  /// takes part in `world`.
+  Communicator(shared_ptr<World> world, processor_type rank);
+
+  operator bool() const { return world_.get();}
+
+  /// Determine the rank of the executing processor in a
+  /// communicator.
+  processor_type rank() const { return rank_;}
+  /// Determine the number of processors in a communicator.
+  length_type size() const { return pvec_.size();}
+  pvec_type const& pvec() const { return pvec_;}
+
+  /// Split the communicator into disjoint subsets of processors,
+  /// one per (non-negative) `color`, ranked by `key`, with ties
+  /// broken by rank, as `MPI_Comm_split` does. This is a collective
+  /// operation, and the only way to build a communicator for a subset
+  /// of processors: unlike MPI, the shared-memory service has no
+  /// `Group` type.
+  Communicator split(int color, int key) const;
+  Communicator split(int color) const { return split(color, rank());}
+
+  void barrier() const;
+
+  template <typename T>
+  void buf_send(processor_type dest_proc, T* data, length_type size);
+
+  template <typename T>
+  void send(processor_type dest_proc, T* data, length_type size,
+	    request_type& req);
+
+  void send(processor_type dest_proc, chain_type& chain, request_type& req);
+
+  template <typename T>
+  void recv(processor_type src_proc, T* data, length_type size);
+
+  void recv(processor_type src_proc, chain_type& chain);
+
+  void wait(request_type& req);
+
+  /// Create persistent requests, which are started with `start()`
+  /// and released with `free()`.
+  template <typename T>
+  void send_init(processor_type dest_proc, T* data, length_type size,
+		 request_type& req);
+
+  void send_init(processor_type dest_proc, chain_type& chain,
+		 request_type& req);
+
+  template <typename T>
+  void recv_init(processor_type src_proc, T* data, length_type size,
+		 request_type& req);
+
+  void recv_init(processor_type src_proc, chain_type& chain,
+		 request_type& req);
+
+  void start(std::vector<request_type>& reqs);
+
+  void wait(std::vector<request_type>& reqs);
+
+  void free(request_type& req);
+
+  template <typename T>
+  void broadcast(processor_type root_proc, T* data, length_type size);
+
+  template <typename T>
+  T allreduce(reduction_type rdx, T value);
+
+  /// Processors share all their memory, so data needs no routing
+  /// through node leaders: each processor is its own.
+  processor_type node_leader(processor_type proc) const { return proc;}
+  template <typename T>
+  void replicate(T*, length_type) {}
+
+  int impl_ll_pset() const VSIP_NOTHROW { return 0;}
+
+  friend bool operator==(Communicator const&, Communicator const&);
+
+private:
+  template <typename T>
+  static chain_type make_chain(T *data, length_type size)
+  {
+    chain_type chain;
+    chain.add(const_cast<void*>(static_cast<void const*>(data)),
+	      sizeof(T), 1, size);
+    return chain;
+  }
+
+  request_type make_request(bool is_send, processor_type proc,
+			    chain_type const &chain, bool persistent) const;
+  void post(request_type req) const;
+  void buf_send(processor_type dest_proc, void const *data,
+		size_t elem_size, length_type size);
+  void broadcast_bytes(processor_type root_proc, void *data, size_t size);
+  /// Make `value` visible to all processors, and return the values
+  /// published by all of them, indexed by rank. The values remain
+  /// valid until `barrier()` is called.
+  void const *const *publish(void const *value) const;
+
+  shared_ptr<World> world_;
+  processor_type rank_;
+  pvec_type pvec_;
+};
+
+inline bool
+operator==(Communicator const &comm1, Communicator const &comm2)
+{
+  return comm1.world_ == comm2.world_;
+}
+
+inline bool
+operator!=(Communicator const &comm1, Communicator const &comm2)
+{
+  return !operator==(comm1, comm2);
+}
+
+template <typename T>
+inline void
+Communicator::buf_send(processor_type dest_proc, T *data, length_type size)
+{
+  buf_send(dest_proc, static_cast<void const*>(data), sizeof(T), size);
+}
+
+template <typename T>
+inline void
+Communicator::send(processor_type dest_proc,
+		   T *data,
+		   length_type size,
+		   request_type &req)
+{
+  req = make_request(true, dest_proc, make_chain(data, size), false);
+  post(req);
+}
+
+inline void
+Communicator::send(processor_type dest_proc, chain_type &chain, request_type &req)
+{
+  req = make_request(true, dest_proc, chain, false);
+  post(req);
+}
+
+template <typename T>
+inline void
+Communicator::recv(processor_type src_proc, T *data, length_type size)
+{
+  chain_type chain = make_chain(data, size);
+  recv(src_proc, chain);
+}
+
+inline void
+Communicator::recv(processor_type src_proc, chain_type &chain)
+{
+  request_type req = make_request(false, src_proc, chain, false);
+  post(req);
+  wait(req);
+}
+
+template <typename T>
+inline void
+Communicator::send_init(processor_type dest_proc,
+			T *data,
+			length_type size,
+			request_type &req)
+{
+  req = make_request(true, dest_proc, make_chain(data, size), true);
+}
+
+inline void
+Communicator::send_init(processor_type dest_proc, chain_type &chain,
+			request_type &req)
+{
+  req = make_request(true, dest_proc, chain, true);
+}
+
+template <typename T>
+inline void
+Communicator::recv_init(processor_type src_proc,
+			T *data,
+			length_type size,
+			request_type &req)
+{
+  req = make_request(false, src_proc, make_chain(data, size), true);
+}
+
+inline void
+Communicator::recv_init(processor_type src_proc, chain_type &chain,
+			request_type &req)
+{
+  req = make_request(false, src_proc, chain, true);
+}
+
+/// Start a list of persistent requests.
+/// The requests are started in order, so messages between the same
+/// pair of processors are matched in the order they appear in the list.
+inline void
+Communicator::start(std::vector<request_type> &reqs)
+{
+  for (std::vector<request_type>::iterator i = reqs.begin(); i != reqs.end(); ++i)
+    post(*i);
+}
+
+/// Wait for a list of communications to complete.
+/// Persistent requests remain valid, and may be started again.
+inline void
+Communicator::wait(std::vector<request_type> &reqs)
+{
+  for (std::vector<request_type>::iterator i = reqs.begin(); i != reqs.end(); ++i)
+    wait(*i);
+}
+
+/// Broadcast a value from root processor to other processors.
+template <typename T>
+inline void
+Communicator::broadcast(processor_type root_proc, T* data, length_type size)
+{
+  broadcast_bytes(root_proc, data, size * sizeof(T));
+}
+
+namespace detail
+{
+template <typename T>
+inline T
+reduce(reduction_type rtype, T a, T b)
+{
+  switch (rtype)
+  {
+  case reduce_all_true:
+  case reduce_all_true_bool:	return a && b;
+  case reduce_any_true:
+  case reduce_any_true_bool:	return a || b;
+  case reduce_sum:		return a + b;
+  case reduce_min:		return std::min(a, b);
+  case reduce_max:		return std::max(a, b);
+  default: OVXX_UNREACHABLE("invalid reduction type");
+  }
+}
+} // namespace ovxx::shm::detail
+
+/// Reduce a value from all processors to all processors.
+/// All processors combine the values in rank order, so they
+/// obtain identical results.
+template <typename T>
+inline T
+Communicator::allreduce(reduction_type rtype, T value)
+{
+  void const *const *values = publish(&value);
+  T result = *static_cast<T const*>(values[0]);
+  for (index_type i = 1; i != size(); ++i)
+    result = detail::reduce(rtype, result, *static_cast<T const*>(values[i]));
+  barrier();
+  return result;
+}
+
+} // namespace ovxx::shm
+} // namespace ovxx
+
+#endif
@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#include "service.hpp"
+#include <ovxx/shm/world.hpp>
+#include <ovxx/library.hpp>
+#include <ovxx/options.hpp>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+using ovxx::shm::World;
+using ovxx::processor_type;
+typedef ovxx::shared_ptr<World> world_ptr;
+
+thread_local ovxx::shm::Communicator *communicator;
+// The world and rank of the calling thread, if it was started
+// by `run()`.
+thread_local world_ptr *processor_world = 0;
+thread_local processor_type processor_rank = 0;
+// The number of calls to `run()` in progress.
+int active_runs = 0;
+// Set once the user has been warned about running on a single processor.
+int warned = 0;
+
+struct active_run
+{
+  active_run() { __sync_fetch_and_add(&active_runs, 1);}
+  ~active_run() { __sync_fetch_and_sub(&active_runs, 1);}
+};
+
+struct processor
+{
+  processor(int (*p)(int, char **), int argc, char **argv,
+	    world_ptr *w, processor_type r, int *s)
+    : program(p), args(argv, argv + argc), world(w), rank(r), status(s)
+  {
+    args.push_back(0);
+  }
+
+  void operator()()
+  {
+    processor_world = world;
+    processor_rank = rank;
+    *status = program(args.size() - 1, &args[0]);
+    processor_world = 0;
+  }
+
+  int (*program)(int, char **);
+  // Options are removed from argv as they are parsed,
+  // so each processor needs its own copy.
+  std::vector<char *> args;
+  world_ptr *world;
+  processor_type rank;
+  int *status;
+};
+}
+
+namespace ovxx
+{
+namespace shm
+{
+
+int run(length_type size, int (*program)(int, char **), int argc, char **argv)
+{
+  OVXX_PRECONDITION(size > 0);
+  active_run active;
+  // Keep the library initialized on the calling thread, so its
+  // process-global parts are set up once, before any processor
+  // starts, and torn down only after all of them are done.
+  // It parses a copy of the arguments, leaving all of them
+  // to the processors.
+  std::vector<char *> args(argv, argv + argc);
+  args.push_back(0);
+  int lib_argc = argc;
+  char **lib_argv = &args[0];
+  library lib(lib_argc, lib_argv);
+  world_ptr world(new World(size));
+  std::vector<int> status(size, 0);
+  std::vector<cxx11::thread *> processors;
+  for (processor_type r = 0; r != size; ++r)
+    processors.push_back(new cxx11::thread
+      (processor(program, argc, argv, &world, r, &status[r])));
+  for (processor_type r = 0; r != size; ++r)
+  {
+    processors[r]->join();
+    delete processors[r];
+  }
+  for (processor_type r = 0; r != size; ++r)
+    if (status[r]) return status[r];
+  return 0;
+}
+
+// This function is guaranteed to be called exactly once per thread.
+void initialize(int &argc, char **&argv)
+{
+  if (processor_world)
+  {
+    communicator = new Communicator(*processor_world, processor_rank);
+    return;
+  }
+  // More than one processor was requested, but the program wasn't
+  // started through `run()`, and thus only has one.
+  std::string const procs =
+    options::get(argc, argv, "ovxx-num-processors", "OVXX_NUM_PROCESSORS");
+  if (!procs.empty() && std::atoi(procs.c_str()) > 1 &&
+      !__sync_fetch_and_add(&active_runs, 0) &&
+      !__sync_fetch_and_or(&warned, 1))
+    std::cerr << "WARNING: " << procs << " processors requested, "
+	      << "but the program runs on 1, as it wasn't started "
+	      << "through ovxx::parallel::run()" << std::endl;
+  communicator = new Communicator(shared_ptr<World>(new World(1)), 0);
+}
+
+// This function is guaranteed to be called exactly once per thread.
+void finalize(bool)
+{
+  delete communicator;
+  communicator = 0;
+}
+
+} // namespace ovxx::shm
+
+namespace parallel
+{
+int run(int (*program)(int, char **), int argc, char **argv)
+{
+  std::string const procs =
+    options::get(argc, argv, "ovxx-num-processors", "OVXX_NUM_PROCESSORS");
+  length_type size = 1;
+  if (!procs.empty() && std::atoi(procs.c_str()) > 1)
+    size = std::atoi(procs.c_str());
+  return shm::run(size, program, argc, argv);
+}
+
+Communicator &default_communicator()
+{
+  return *communicator;
+}
+Communicator set_default_communicator(Communicator c)
+{
+  Communicator old = *communicator;
+  *communicator = c;
+  return old;
+}
+} // namespace ovxx::parallel
+} // namespace ovxx
+
+namespace vsip
+{
+length_type num_processors() VSIP_NOTHROW
+{
+  return ovxx::parallel::default_communicator().size();
+}
+
+processor_type local_processor() VSIP_NOTHROW
+{
+  return ovxx::parallel::default_communicator().rank();
+}
+
+index_type local_processor_index() VSIP_NOTHROW
+{
+  ovxx::shm::Communicator::pvec_type const &pvec =
+    ovxx::parallel::default_communicator().pvec();
+  processor_type proc = local_processor();
+  for (index_type i = 0; i != pvec.size(); ++i)
+    if (pvec[i] == proc) return i;
+  OVXX_UNREACHABLE("invalid local processor");
+  return 0;
+}
+}
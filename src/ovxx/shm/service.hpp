@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_shm_service_hpp_
+#define ovxx_shm_service_hpp_
+
+#include <ovxx/support.hpp>
+#include <ovxx/reductions/types.hpp>
+#include <ovxx/parallel/assign_fwd.hpp>
+#include <ovxx/shm/communicator.hpp>
+#include <ovxx/shm/chain_builder.hpp>
+#include <vector>
+
+namespace vsip
+{
+length_type num_processors() VSIP_NOTHROW;
+processor_type local_processor() VSIP_NOTHROW;
+index_type local_processor_index() VSIP_NOTHROW;
+}
+
+namespace ovxx
+{
+namespace shm
+{
+
+/// Run `program` on `size` processors, each a thread of its own
+/// that calls `program` with its own copy of `argc` and `argv`,
+/// and initializes the library (through a `vsipl` object), like
+/// the processes started by `mpirun` do.
+/// Unlike processes, processors share the program's global and
+/// static variables, so `program` must not rely on those to hold
+/// state of its own.
+///
+/// Return once all processors are done, with the first non-zero
+/// status any of them returned, or 0.
+int run(length_type size, int (*program)(int, char **), int argc, char **argv);
+
+/// Initialize the calling thread's default communicator.
+/// Threads started by `run()` are processors of its world, all
+/// other threads form worlds of their own. If more than one processor
+/// is requested (see `parallel::run()`) while no `run()` is in progress,
+/// a warning is printed, as the program then runs on a single processor.
+void initialize(int &, char **&);
+void finalize(bool);
+
+} // namespace shm
+
+namespace parallel
+{
+using shm::Communicator;
+using shm::Chain_builder;
+using shm::free_chain;
+
+typedef int ll_pbuf_type;
+typedef int ll_pset_type;
+
+/// Run `program` on the number of processors given by the following
+/// command-line option, or the corresponding environment variable
+/// (as set by `ovxx-run`):
+///
+///   :--ovxx-num-processors (OVXX_NUM_PROCESSORS):
+///     the number of processors. Defaults to 1.
+int run(int (*program)(int, char **), int argc, char **argv);
+
+/// Set new default communicator, and return the old one.
+Communicator set_default_communicator(Communicator c);
+Communicator &default_communicator();
+
+inline void
+create_ll_pset(std::vector<processor_type> const&, ll_pset_type&) {}
+
+inline void
+destroy_ll_pset(ll_pset_type&) {}
+
+
+// supported reductions
+
+template <reduction_type rtype, typename T>
+struct reduction_supported
+{ static bool const value = false;};
+
+template <> struct reduction_supported<reduce_sum, int>
+{ static bool const value = true;};
+template <> struct reduction_supported<reduce_sum, float>
+{ static bool const value = true;};
+template <> struct reduction_supported<reduce_sum, double>
+{ static bool const value = true;};
+template <> struct reduction_supported<reduce_all_true, int>
+{ static bool const value = true;};
+template <> struct reduction_supported<reduce_all_true_bool, bool>
+{ static bool const value = true;};
+template <> struct reduction_supported<reduce_any_true, int>
+{ static bool const value = true;};
+template <> struct reduction_supported<reduce_any_true_bool, bool>
+{ static bool const value = true;};
+} // namespace ovxx::parallel
+} // namespace ovxx
+
+#endif
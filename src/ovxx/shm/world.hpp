@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_shm_world_hpp_
+#define ovxx_shm_world_hpp_
+
+#include <ovxx/support.hpp>
+#include <ovxx/detail/noncopyable.hpp>
+#include <ovxx/parallel/copy_chain.hpp>
+#include <ovxx/c++11/thread.hpp>
+#include <deque>
+#include <vector>
+
+namespace ovxx
+{
+namespace shm
+{
+
+/// A (send or receive) request, describing the data of a message
+/// sent from processor `src` to processor `dst`.
+struct Request : ovxx::detail::noncopyable
+{
+  Request(bool s, processor_type from, processor_type to,
+	  parallel::Copy_chain const &c, bool p)
+    : is_send(s), src(from), dst(to), chain(c),
+      persistent(p), detached(false), done(true)
+  {}
+
+  bool is_send;
+  processor_type src;
+  processor_type dst;
+  parallel::Copy_chain chain;
+  /// Persistent requests may be started any number of times, and
+  /// are only released by `Communicator::free()`.
+  bool persistent;
+  /// Detached requests are never waited for, and are released
+  /// as soon as they complete.
+  bool detached;
+  bool done;
+  /// The data of buffered sends.
+  std::vector<char> buffer;
+};
+
+/// The state shared by a set of processors: the queues of pending
+/// requests, and the means to synchronize in collective operations.
+class World : ovxx::detail::noncopyable
+{
+public:
+  explicit World(length_type size);
+
+  length_type size() const { return size_;}
+
+  /// Post a request. If a matching request has already been posted,
+  /// transfer the message, and complete both requests.
+  void post(Request *req);
+  /// Wait for a request to complete.
+  void wait(Request *req);
+  /// Wait for all processors to arrive.
+  void barrier();
+  /// Store `value` as processor `rank`'s slot, and wait for all
+  /// processors to do the same. Return the slots, indexed by rank.
+  void const *const *publish(processor_type rank, void const *value);
+
+private:
+  typedef std::deque<Request*> queue_type;
+
+  void complete(Request *req);
+
+  length_type const size_;
+  cxx11::mutex mutex_;
+  cxx11::condition_variable done_;
+  /// Pending sends and receives, indexed by destination.
+  std::vector<queue_type> sends_;
+  std::vector<queue_type> recvs_;
+
+  cxx11::mutex barrier_mutex_;
+  cxx11::condition_variable barrier_;
+  length_type arrived_;
+  unsigned int generation_;
+  std::vector<void const *> slots_;
+};
+
+} // namespace ovxx::shm
+} // namespace ovxx
+
+#endif
@@ -0,0 +1,379 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_signal_conv_fft_hpp_
+#define ovxx_signal_conv_fft_hpp_
+
+#include <ovxx/signal/conv.hpp>
+#include <ovxx/complex_traits.hpp>
+#include <vsip/impl/signal/fft.hpp>
+#include <ovxx/parallel/map_traits.hpp>
+#include <memory>
+#include <algorithm>
+
+namespace ovxx
+{
+namespace signal
+{
+
+/// Return the minimum number of kernel coefficients (per output
+/// sample) for which convolutions and correlations are computed
+/// using FFTs, rather than by direct summation.
+/// With `alg_time` the FFT path is taken as soon as it pays off.
+/// With `alg_noise` it is only taken for much larger kernels, as
+/// direct summation accumulates less round-off error.
+/// With `alg_space` it is never taken, as the transforms need extra
+/// memory; the FFT-based evaluators check for this hint themselves.
+inline length_type fft_crossover(alg_hint_type hint)
+{
+  return hint == alg_time ? 32 : 512;
+}
+
+namespace detail
+{
+inline length_type next_power_of_2(length_type n)
+{
+  length_type p = 1;
+  while (p < n) p *= 2;
+  return p;
+}
+
+inline length_type power(length_type n, dimension_type d)
+{
+  length_type p = 1;
+  for (; d; --d) p *= n;
+  return p;
+}
+
+/// True if there are FFT backends suitable for fast convolution
+/// of T. The no_fft dummy backend doesn't count.
+template <typename T>
+struct is_fft_conv_type
+{
+  typedef typename scalar_of<T>::type scalar_type;
+  static bool const value =
+#if OVXX_FFT_HAVE_FLOAT
+    is_same<scalar_type, float>::value ||
+#endif
+#if OVXX_FFT_HAVE_DOUBLE
+    is_same<scalar_type, double>::value ||
+#endif
+    false;
+};
+
+/// True if the blocks B1, B2 and B3 are local. The FFT-based
+/// evaluators leave distributed data to the direct implementations,
+/// which work on a complete local copy of it on each processor.
+template <typename B1, typename B2, typename B3 = B1>
+struct is_local_data
+{
+  static bool const value =
+    parallel::is_local_only<typename B1::map_type>::value &&
+    parallel::is_local_only<typename B2::map_type>::value &&
+    parallel::is_local_only<typename B3::map_type>::value;
+};
+
+/// The 1D transforms used to compute fast convolutions of T.
+/// Real data is transformed with real-to-complex FFTs, so only half
+/// the spectrum needs to be computed.
+template <typename T, unsigned N>
+struct conv_fft
+{
+  typedef complex<T> spectrum_type;
+  typedef vsip::Fft<const_Vector, T, complex<T>, 0, by_reference, N> fwd_type;
+  typedef vsip::Fft<const_Vector, complex<T>, T, 0, by_reference, N> inv_type;
+  static length_type spectrum_size(length_type size) { return size / 2 + 1;}
+};
+
+template <typename T, unsigned N>
+struct conv_fft<complex<T>, N>
+{
+  typedef complex<T> spectrum_type;
+  typedef vsip::Fft<const_Vector, complex<T>, complex<T>, fft_fwd, by_reference, N>
+    fwd_type;
+  typedef vsip::Fft<const_Vector, complex<T>, complex<T>, fft_inv, by_reference, N>
+    inv_type;
+  static length_type spectrum_size(length_type size) { return size;}
+};
+
+/// Store the result of a (complex) fast convolution into `out`.
+template <typename T, typename B1, typename B2>
+void store_result(const_Matrix<complex<T>, B1> result, Matrix<T, B2> out)
+{ out = real(result);}
+
+template <typename T, typename B1, typename B2>
+void store_result(const_Matrix<complex<T>, B1> result,
+		  Matrix<complex<T>, B2> out)
+{ out = result;}
+
+} // namespace ovxx::signal::detail
+
+/// Fast convolution.
+///
+/// For kernels above the `fft_crossover()` size, the convolution is
+/// computed in the frequency domain: 1D convolutions use the
+/// overlap-save method, 2D convolutions a single, zero-padded
+/// transform. Smaller kernels are handled by the direct
+/// implementation this derives from.
+template <template <typename, typename> class V,
+	  symmetry_type                       S,
+	  support_region_type                 R,
+	  typename                            T,
+	  unsigned                            N,
+          alg_hint_type                       H>
+class Fft_convolution;
+
+template <symmetry_type       S,
+	  support_region_type R,
+	  typename            T,
+	  unsigned            N,
+          alg_hint_type       H>
+class Fft_convolution<const_Vector, S, R, T, N, H>
+  : public Convolution<const_Vector, S, R, T, N, H>
+{
+  typedef Convolution<const_Vector, S, R, T, N, H> base_type;
+  typedef detail::conv_fft<T, N> fft_traits;
+  typedef typename fft_traits::spectrum_type ctype;
+  typedef typename scalar_of<T>::type scalar_type;
+
+  // The frequency-domain state, only allocated if it is used.
+  struct workspace
+  {
+    workspace(const_Vector<T> kernel, length_type size)
+      : fwd(Domain<1>(size), scalar_type(1)),
+	inv(Domain<1>(size), scalar_type(1)),
+	kernel_spectrum(fft_traits::spectrum_size(size)),
+	spectrum(fft_traits::spectrum_size(size)),
+	in(size, T()),
+	out(size)
+    {
+      // Fold the inverse transform's scaling into the kernel.
+      in(Domain<1>(kernel.size())) = kernel;
+      fwd(in, kernel_spectrum);
+      kernel_spectrum *= scalar_type(1) / size;
+    }
+
+    typename fft_traits::fwd_type fwd;
+    typename fft_traits::inv_type inv;
+    Vector<ctype> kernel_spectrum;
+    Vector<ctype> spectrum;
+    Vector<T> in;
+    Vector<T> out;
+  };
+
+public:
+  template <typename B>
+  Fft_convolution(const_Vector<T, B> filter_coeffs,
+		  Domain<1> const &input_size,
+		  length_type decimation)
+    VSIP_THROW((std::bad_alloc))
+  : base_type(filter_coeffs, input_size, decimation)
+  {
+    length_type const M = this->kernel_size().size();
+    length_type const P = this->output_size().size();
+    if (P == 0 || M < fft_crossover(H) * decimation) return;
+
+    shift_ = R == support_full ? 0 : R == support_same ? M / 2 : M - 1;
+    // The number of (undecimated) output samples that need to be computed.
+    length_type const span = (P - 1) * decimation + 1;
+    length_type const size =
+      std::min(detail::next_power_of_2(4 * M),
+	       detail::next_power_of_2(span + M - 1));
+    step_ = size - M + 1;
+    workspace_.reset
+      (new workspace(conv_kernel<Vector<T> >(S, filter_coeffs), size));
+  }
+
+  /// Return true if convolutions are computed using FFTs.
+  bool uses_fft() const VSIP_NOTHROW { return workspace_.get();}
+
+protected:
+  template <typename B1, typename B2>
+  void convolve(const_Vector<T, B1> in, Vector<T, B2> out) VSIP_NOTHROW
+  {
+    if (workspace_.get())
+      fft_convolve(in, out, integral_constant<bool,
+		   detail::is_local_data<B1, B2>::value>());
+    else
+      base_type::convolve(in, out);
+  }
+
+private:
+  template <typename B1, typename B2>
+  void fft_convolve(const_Vector<T, B1> in, Vector<T, B2> out, false_type)
+  { base_type::convolve(in, out);}
+
+  template <typename B1, typename B2>
+  void fft_convolve(const_Vector<T, B1> in, Vector<T, B2> out, true_type)
+  {
+    workspace &ws = *workspace_;
+    length_type const M = this->kernel_size().size();
+    length_type const N_in = this->input_size().size();
+    length_type const P = this->output_size().size();
+    length_type const D = this->decimation();
+    length_type const size = ws.in.size();
+    index_type const last = shift_ + (P - 1) * D;
+
+    // Each block computes the (undecimated) outputs [m0, m0 + step_)
+    // from the inputs [m0 - M + 1, m0 + step_).
+    for (index_type m0 = shift_; m0 <= last; m0 += step_)
+    {
+      stride_type const begin = stride_type(m0) - stride_type(M - 1);
+      index_type const lo = std::max<stride_type>(begin, 0);
+      index_type const hi = std::min<stride_type>(begin + size, N_in);
+      if (lo != index_type(begin) || hi != index_type(begin + size))
+	ws.in = T();
+      if (hi > lo)
+	ws.in(Domain<1>(lo - begin, 1, hi - lo)) = in(Domain<1>(lo, 1, hi - lo));
+
+      ws.fwd(ws.in, ws.spectrum);
+      ws.spectrum *= ws.kernel_spectrum;
+      ws.inv(ws.spectrum, ws.out);
+
+      // The outputs n with shift_ + n * D in [m0, m0 + step_).
+      index_type const n0 = (m0 - shift_ + D - 1) / D;
+      index_type const n1 = std::min(P, (m0 + step_ - shift_ + D - 1) / D);
+      if (n1 > n0)
+	out(Domain<1>(n0, 1, n1 - n0)) =
+	  ws.out(Domain<1>(M - 1 + shift_ + n0 * D - m0, D, n1 - n0));
+    }
+  }
+
+  index_type shift_;
+  length_type step_;
+  std::unique_ptr<workspace> workspace_;
+};
+
+template <symmetry_type       S,
+	  support_region_type R,
+	  typename            T,
+	  unsigned            N,
+          alg_hint_type       H>
+class Fft_convolution<const_Matrix, S, R, T, N, H>
+  : public Convolution<const_Matrix, S, R, T, N, H>
+{
+  typedef Convolution<const_Matrix, S, R, T, N, H> base_type;
+  typedef typename scalar_of<T>::type scalar_type;
+  typedef complex<scalar_type> ctype;
+  typedef vsip::Fft<const_Matrix, ctype, ctype, fft_fwd, by_reference, N>
+    fwd_type;
+  typedef vsip::Fft<const_Matrix, ctype, ctype, fft_inv, by_reference, N>
+    inv_type;
+
+  struct workspace
+  {
+    workspace(const_Matrix<T> kernel, Domain<2> const &size)
+      : fwd(size, scalar_type(1)),
+	inv(size, scalar_type(1)),
+	kernel_spectrum(size[0].size(), size[1].size(), ctype()),
+	buffer(size[0].size(), size[1].size())
+    {
+      kernel_spectrum(Domain<2>(kernel.size(0), kernel.size(1))) = kernel;
+      fwd(kernel_spectrum);
+      kernel_spectrum *= scalar_type(1) / size.size();
+    }
+
+    fwd_type fwd;
+    inv_type inv;
+    Matrix<ctype> kernel_spectrum;
+    Matrix<ctype> buffer;
+  };
+
+public:
+  template <typename B>
+  Fft_convolution(const_Matrix<T, B> filter_coeffs,
+		  Domain<2> const &input_size,
+		  length_type decimation)
+    VSIP_THROW((std::bad_alloc))
+  : base_type(filter_coeffs, input_size, decimation)
+  {
+    Domain<2> const &kernel = this->kernel_size();
+    if (this->output_size().size() == 0 ||
+	kernel.size() < fft_crossover(H) * detail::power(decimation, 2))
+      return;
+    Domain<2> size(detail::next_power_of_2(input_size[0].size() + kernel[0].size() - 1),
+		   detail::next_power_of_2(input_size[1].size() + kernel[1].size() - 1));
+    workspace_.reset
+      (new workspace(conv_kernel<Matrix<T> >(S, filter_coeffs), size));
+  }
+
+  /// Return true if convolutions are computed using FFTs.
+  bool uses_fft() const VSIP_NOTHROW { return workspace_.get();}
+
+protected:
+  template <typename B1, typename B2>
+  void convolve(const_Matrix<T, B1> in, Matrix<T, B2> out) VSIP_NOTHROW
+  {
+    if (workspace_.get())
+      fft_convolve(in, out, integral_constant<bool,
+		   detail::is_local_data<B1, B2>::value>());
+    else
+      base_type::convolve(in, out);
+  }
+
+private:
+  template <typename B1, typename B2>
+  void fft_convolve(const_Matrix<T, B1> in, Matrix<T, B2> out, false_type)
+  { base_type::convolve(in, out);}
+
+  template <typename B1, typename B2>
+  void fft_convolve(const_Matrix<T, B1> in, Matrix<T, B2> out, true_type)
+  {
+    workspace &ws = *workspace_;
+    Domain<2> const &kernel = this->kernel_size();
+    Domain<2> const &output = this->output_size();
+    length_type const D = this->decimation();
+    index_type shift[2];
+    for (dimension_type d = 0; d != 2; ++d)
+      shift[d] = R == support_full ? 0 :
+	R == support_same ? kernel[d].size() / 2 : kernel[d].size() - 1;
+
+    ws.buffer = ctype();
+    ws.buffer(Domain<2>(in.size(0), in.size(1))) = in;
+    ws.fwd(ws.buffer);
+    ws.buffer *= ws.kernel_spectrum;
+    ws.inv(ws.buffer);
+    detail::store_result
+      (ws.buffer(Domain<2>(Domain<1>(shift[0], D, output[0].size()),
+			   Domain<1>(shift[1], D, output[1].size()))),
+       out);
+  }
+
+  std::unique_ptr<workspace> workspace_;
+};
+
+} // namespace ovxx::signal
+
+namespace dispatcher
+{
+// Not used with alg_space (see signal::fft_crossover()).
+template <symmetry_type       S,
+	  support_region_type R,
+          typename            T,
+	  unsigned            N,
+          alg_hint_type       H>
+struct Evaluator<op::conv<1, S, R, T, N, H>, be::fft_based>
+{
+  static bool const ct_valid =
+    H != alg_space && signal::detail::is_fft_conv_type<T>::value;
+  typedef signal::Fft_convolution<const_Vector, S, R, T, N, H> backend_type;
+};
+template <symmetry_type       S,
+	  support_region_type R,
+          typename            T,
+	  unsigned            N,
+          alg_hint_type       H>
+struct Evaluator<op::conv<2, S, R, T, N, H>, be::fft_based>
+{
+  static bool const ct_valid =
+    H != alg_space && signal::detail::is_fft_conv_type<T>::value;
+  typedef signal::Fft_convolution<const_Matrix, S, R, T, N, H> backend_type;
+};
+} // namespace ovxx::dispatcher
+} // namespace ovxx
+
+#endif
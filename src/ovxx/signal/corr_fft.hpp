@@ -0,0 +1,352 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_signal_corr_fft_hpp_
+#define ovxx_signal_corr_fft_hpp_
+
+#include <ovxx/signal/corr.hpp>
+#include <ovxx/signal/conv_fft.hpp>
+
+namespace ovxx
+{
+namespace signal
+{
+namespace detail
+{
+/// The number of terms summed up for output `n` of a correlation
+/// along one dimension, used for unbiased scaling. This matches
+/// the direct implementation.
+inline length_type corr_terms(support_region_type R, dimension_type D,
+			      index_type n, length_type M, length_type N)
+{
+  length_type shift = R == support_full ? M - 1 : R == support_same ? M / 2 : 0;
+  length_type edge = R == support_same ? M / 2 : 0;
+  if (n < shift)
+    return n + M - shift;
+  else if (n >= N - edge)
+  {
+#if !VSIP_IMPL_CORR_CORRECT_SAME_SUPPORT_SCALING
+    // Definition in C-VSIPL (only used for 1D).
+    if (R == support_same && D == 1)
+      return N - 1 + (M + 1) / 2 - n;
+#endif
+    return N + shift - n;
+  }
+  else
+    return M;
+}
+
+/// Store the conjugate of a (circular) cross-correlation, which is
+/// the correlation as defined by VSIPL++.
+template <typename T, typename B1, typename B2>
+void store_conj(const_Vector<T, B1> result, Vector<T, B2> out)
+{ out = result;}
+
+template <typename T, typename B1, typename B2>
+void store_conj(const_Vector<complex<T>, B1> result,
+		Vector<complex<T>, B2> out)
+{ out = conj(result);}
+
+template <typename T, typename B1, typename B2>
+void store_conj(const_Matrix<complex<T>, B1> result, Matrix<T, B2> out)
+{ out = real(result);}
+
+template <typename T, typename B1, typename B2>
+void store_conj(const_Matrix<complex<T>, B1> result,
+		Matrix<complex<T>, B2> out)
+{ out = conj(result);}
+
+} // namespace ovxx::signal::detail
+
+/// Fast correlation.
+///
+/// For references above the `fft_crossover()` size, the correlation
+/// is computed with a single, zero-padded transform of the input.
+/// The conjugated spectrum of the reference is kept, and reused for as
+/// long as the reference passed in doesn't change. Smaller references
+/// are handled by the direct implementation this derives from.
+template <dimension_type      D,
+	  support_region_type R,
+	  typename            T,
+	  unsigned            N,
+          alg_hint_type       H>
+class Fft_correlation;
+
+template <support_region_type R,
+	  typename            T,
+	  unsigned            N,
+          alg_hint_type       H>
+class Fft_correlation<1, R, T, N, H> : public Correlation<1, R, T, N, H>
+{
+  typedef Correlation<1, R, T, N, H> base_type;
+  typedef detail::conv_fft<T, N> fft_traits;
+  typedef typename fft_traits::spectrum_type ctype;
+  typedef typename scalar_of<T>::type scalar_type;
+
+  struct workspace
+  {
+    workspace(length_type ref_size, length_type output_size, length_type size)
+      : fwd(Domain<1>(size), scalar_type(1)),
+	inv(Domain<1>(size), scalar_type(1)),
+	ref(ref_size),
+	ref_spectrum(fft_traits::spectrum_size(size)),
+	spectrum(fft_traits::spectrum_size(size)),
+	in(size, T()),
+	out(size),
+	scale(output_size),
+	valid(false)
+    {}
+
+    typename fft_traits::fwd_type fwd;
+    typename fft_traits::inv_type inv;
+    Vector<T> ref;
+    Vector<ctype> ref_spectrum;
+    Vector<ctype> spectrum;
+    Vector<T> in;
+    Vector<T> out;
+    Vector<scalar_type> scale;
+    bool valid;
+  };
+
+public:
+  Fft_correlation(Domain<1> const &ref_size, Domain<1> const &input_size)
+    VSIP_THROW((std::bad_alloc))
+  : base_type(ref_size, input_size)
+  {
+    length_type const M = this->reference_size().size();
+    length_type const N_in = this->input_size().size();
+    length_type const P = this->output_size().size();
+    if (P == 0 || M < fft_crossover(H)) return;
+
+    // Large enough for the transform to not wrap around into
+    // any of the outputs.
+    length_type size =
+      detail::next_power_of_2(R == support_min ? N_in : N_in + M - 1);
+    workspace_.reset(new workspace(M, P, size));
+    for (index_type n = 0; n != P; ++n)
+      workspace_->scale.put
+	(n, scalar_type(1) / detail::corr_terms(R, 1, n, M, N_in));
+  }
+
+  /// Return true if correlations are computed using FFTs.
+  bool uses_fft() const VSIP_NOTHROW { return workspace_.get();}
+
+  template <typename B1, typename B2, typename B3>
+  void
+  correlate(bias_type bias, const_Vector<T, B1> ref,
+	    const_Vector<T, B2> in, Vector<T, B3> out)
+    VSIP_NOTHROW
+  {
+    if (workspace_.get())
+      fft_correlate(bias, ref, in, out, integral_constant<bool,
+		    detail::is_local_data<B1, B2, B3>::value>());
+    else
+      base_type::correlate(bias, ref, in, out);
+  }
+
+private:
+  template <typename B1, typename B2, typename B3>
+  void
+  fft_correlate(bias_type bias, const_Vector<T, B1> ref,
+		const_Vector<T, B2> in, Vector<T, B3> out, false_type)
+  { base_type::correlate(bias, ref, in, out);}
+
+  template <typename B1, typename B2, typename B3>
+  void
+  fft_correlate(bias_type bias, const_Vector<T, B1> ref,
+		const_Vector<T, B2> in, Vector<T, B3> out, true_type)
+  {
+    workspace &ws = *workspace_;
+    length_type const M = this->reference_size().size();
+    length_type const N_in = this->input_size().size();
+    length_type const P = this->output_size().size();
+    length_type const shift =
+      R == support_full ? M - 1 : R == support_same ? M / 2 : 0;
+
+    if (!ws.valid || !equal_to(ws.ref, ref))
+    {
+      ws.ref = ref;
+      ws.in = T();
+      ws.in(Domain<1>(M)) = ref;
+      ws.fwd(ws.in, ws.ref_spectrum);
+      // Fold the inverse transform's scaling into the reference.
+      ws.ref_spectrum = conj(ws.ref_spectrum);
+      ws.ref_spectrum *= scalar_type(1) / ws.in.size();
+      ws.valid = true;
+    }
+    ws.in = T();
+    ws.in(Domain<1>(shift, 1, N_in)) = in;
+    ws.fwd(ws.in, ws.spectrum);
+    ws.spectrum *= ws.ref_spectrum;
+    ws.inv(ws.spectrum, ws.out);
+    detail::store_conj(ws.out(Domain<1>(P)), out);
+    if (bias == unbiased)
+      out *= ws.scale;
+  }
+
+  template <typename B>
+  static bool equal_to(Vector<T> cached, const_Vector<T, B> ref)
+  {
+    for (index_type i = 0; i != cached.size(); ++i)
+      if (cached.get(i) != ref.get(i)) return false;
+    return true;
+  }
+
+  std::unique_ptr<workspace> workspace_;
+};
+
+template <support_region_type R,
+	  typename            T,
+	  unsigned            N,
+          alg_hint_type       H>
+class Fft_correlation<2, R, T, N, H> : public Correlation<2, R, T, N, H>
+{
+  typedef Correlation<2, R, T, N, H> base_type;
+  typedef typename scalar_of<T>::type scalar_type;
+  typedef complex<scalar_type> ctype;
+  typedef vsip::Fft<const_Matrix, ctype, ctype, fft_fwd, by_reference, N>
+    fwd_type;
+  typedef vsip::Fft<const_Matrix, ctype, ctype, fft_inv, by_reference, N>
+    inv_type;
+
+  struct workspace
+  {
+    workspace(Domain<2> const &ref_size, Domain<2> const &output_size,
+	      Domain<2> const &size)
+      : fwd(size, scalar_type(1)),
+	inv(size, scalar_type(1)),
+	ref(ref_size[0].size(), ref_size[1].size()),
+	ref_spectrum(size[0].size(), size[1].size()),
+	buffer(size[0].size(), size[1].size()),
+	scale(output_size[0].size(), output_size[1].size()),
+	valid(false)
+    {}
+
+    fwd_type fwd;
+    inv_type inv;
+    Matrix<T> ref;
+    Matrix<ctype> ref_spectrum;
+    Matrix<ctype> buffer;
+    Matrix<scalar_type> scale;
+    bool valid;
+  };
+
+public:
+  Fft_correlation(Domain<2> const &ref_size, Domain<2> const &input_size)
+    VSIP_THROW((std::bad_alloc))
+  : base_type(ref_size, input_size)
+  {
+    Domain<2> const &ref = this->reference_size();
+    Domain<2> const &in = this->input_size();
+    Domain<2> const &out = this->output_size();
+    if (out.size() == 0 || ref.size() < fft_crossover(H)) return;
+
+    length_type size[2];
+    for (dimension_type d = 0; d != 2; ++d)
+      size[d] = detail::next_power_of_2(R == support_min ? in[d].size() :
+					in[d].size() + ref[d].size() - 1);
+    workspace_.reset(new workspace(ref, out, Domain<2>(size[0], size[1])));
+    for (index_type r = 0; r != out[0].size(); ++r)
+      for (index_type c = 0; c != out[1].size(); ++c)
+	workspace_->scale.put
+	  (r, c, scalar_type(1) /
+	   (detail::corr_terms(R, 2, r, ref[0].size(), in[0].size()) *
+	    detail::corr_terms(R, 2, c, ref[1].size(), in[1].size())));
+  }
+
+  /// Return true if correlations are computed using FFTs.
+  bool uses_fft() const VSIP_NOTHROW { return workspace_.get();}
+
+  template <typename B1, typename B2, typename B3>
+  void
+  correlate(bias_type bias, const_Matrix<T, B1> ref,
+	    const_Matrix<T, B2> in, Matrix<T, B3> out)
+    VSIP_NOTHROW
+  {
+    if (workspace_.get())
+      fft_correlate(bias, ref, in, out, integral_constant<bool,
+		    detail::is_local_data<B1, B2, B3>::value>());
+    else
+      base_type::correlate(bias, ref, in, out);
+  }
+
+private:
+  template <typename B1, typename B2, typename B3>
+  void
+  fft_correlate(bias_type bias, const_Matrix<T, B1> ref,
+		const_Matrix<T, B2> in, Matrix<T, B3> out, false_type)
+  { base_type::correlate(bias, ref, in, out);}
+
+  template <typename B1, typename B2, typename B3>
+  void
+  fft_correlate(bias_type bias, const_Matrix<T, B1> ref,
+		const_Matrix<T, B2> in, Matrix<T, B3> out, true_type)
+  {
+    workspace &ws = *workspace_;
+    Domain<2> const &ref_size = this->reference_size();
+    Domain<2> const &out_size = this->output_size();
+    index_type shift[2];
+    for (dimension_type d = 0; d != 2; ++d)
+    {
+      length_type M = ref_size[d].size();
+      shift[d] = R == support_full ? M - 1 : R == support_same ? M / 2 : 0;
+    }
+
+    if (!ws.valid || !equal_to(ws.ref, ref))
+    {
+      ws.ref = ref;
+      ws.ref_spectrum = ctype();
+      ws.ref_spectrum(Domain<2>(ref.size(0), ref.size(1))) = ref;
+      ws.fwd(ws.ref_spectrum);
+      ws.ref_spectrum = conj(ws.ref_spectrum);
+      ws.ref_spectrum *= scalar_type(1) / ws.buffer.size();
+      ws.valid = true;
+    }
+    ws.buffer = ctype();
+    ws.buffer(Domain<2>(Domain<1>(shift[0], 1, in.size(0)),
+			Domain<1>(shift[1], 1, in.size(1)))) = in;
+    ws.fwd(ws.buffer);
+    ws.buffer *= ws.ref_spectrum;
+    ws.inv(ws.buffer);
+    detail::store_conj(ws.buffer(Domain<2>(out_size[0].size(),
+					   out_size[1].size())), out);
+    if (bias == unbiased)
+      out *= ws.scale;
+  }
+
+  template <typename B>
+  static bool equal_to(Matrix<T> cached, const_Matrix<T, B> ref)
+  {
+    for (index_type r = 0; r != cached.size(0); ++r)
+      for (index_type c = 0; c != cached.size(1); ++c)
+	if (cached.get(r, c) != ref.get(r, c)) return false;
+    return true;
+  }
+
+  std::unique_ptr<workspace> workspace_;
+};
+
+} // namespace ovxx::signal
+
+namespace dispatcher
+{
+template <dimension_type      D,
+          support_region_type R,
+          typename            T,
+	  unsigned            N,
+          alg_hint_type       H>
+struct Evaluator<op::corr<D, R, T, N, H>, be::fft_based>
+{
+  // Not used with alg_space (see signal::fft_crossover()).
+  static bool const ct_valid =
+    H != alg_space && signal::detail::is_fft_conv_type<T>::value;
+  typedef signal::Fft_correlation<D, R, T, N, H> backend_type;
+};
+} // namespace ovxx::dispatcher
+} // namespace ovxx
+
+#endif
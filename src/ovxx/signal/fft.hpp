@@ -438,4 +438,6 @@ private:
 } // namespace ovxx::signal
 } // namespace ovxx
 
+#include <ovxx/signal/fft/fastconv.hpp>
+
 #endif
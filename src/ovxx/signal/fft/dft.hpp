@@ -13,6 +13,7 @@
 #include <vsip/domain.hpp>
 #include <ovxx/dispatch.hpp>
 #include <ovxx/signal/fft/util.hpp>
+#include <ovxx/signal/fft/native.hpp>
 #include <ovxx/aligned_array.hpp>
 
 namespace ovxx
@@ -23,13 +24,6 @@ namespace fft
 {
 namespace
 {
-template <typename T>
-inline complex<T>
-sin_cos(double phi)
-{
-  return complex<T>(cos(phi), sin(phi));
-}
-
 template <typename T>
 std::pair<T*,T*> offset(std::pair<T*,T*> data, int o)
 {
@@ -47,7 +41,6 @@ class dft<1, complex<T>, complex<T>, S>
   typedef T rtype;
   typedef complex<rtype> ctype;
   typedef std::pair<rtype*, rtype*> ztype;
-  typedef double atype;
 
   static int const exponent = S == fft_fwd ? -1 : 1;
 
@@ -58,67 +51,30 @@ public:
   { rtl_in.storage_format = rtl_out.storage_format;}
   virtual void in_place(ctype *inout, stride_type s, length_type l)
   {
-    aligned_array<ctype> tmp(l);
-    atype const phi = exponent * 2.0 * OVXX_PI/l;
-
-    for (index_type w = 0; w < l; ++w)
-    {
-      complex<atype> sum;
-      for (index_type k = 0; k < l; ++k)
-	sum += complex<atype>(inout[k * s]) * sin_cos<atype>(phi * k * w);
-      tmp[w] = sum;
-    }
-    for (index_type w = 0; w < l; ++w) inout[w * s] = tmp[w];
+    rtype *data = reinterpret_cast<rtype*>(inout);
+    plans_(l)(data, data + 1, 2 * s, data, data + 1, 2 * s);
   }
   virtual void in_place(ztype inout, stride_type s, length_type l)
   {
-    aligned_array<ctype> tmp(l);
-    atype const phi = exponent * 2.0 * OVXX_PI/l;
-
-    for (index_type w = 0; w < l; ++w)
-    {
-      complex<atype> sum;
-      for (index_type k = 0; k < l; ++k)
-	sum += complex<atype>(inout.first[k * s], inout.second[k * s])
-	  * sin_cos<atype>(phi * k * w);
-      tmp[w] = sum;
-    }
-    for (index_type w = 0; w < l; ++w)
-    {
-      inout.first[w * s] = tmp[w].real();
-      inout.second[w * s] = tmp[w].imag();
-    }
+    plans_(l)(inout.first, inout.second, s, inout.first, inout.second, s);
   }
   virtual void out_of_place(ctype *in, stride_type in_s,
 			    ctype *out, stride_type out_s,
 			    length_type l)
   {
-    atype const phi = exponent * 2.0 * OVXX_PI/l;
-
-    for (index_type w = 0; w < l; ++w)
-    {
-      complex<atype> sum;
-      for (index_type k = 0; k < l; ++k)
-	sum += complex<atype>(in[k * in_s]) * sin_cos<atype>(phi * k * w);
-      out[w * out_s] = ctype(sum);
-    }
+    rtype *i = reinterpret_cast<rtype*>(in);
+    rtype *o = reinterpret_cast<rtype*>(out);
+    plans_(l)(i, i + 1, 2 * in_s, o, o + 1, 2 * out_s);
   }
   virtual void out_of_place(ztype in, stride_type in_s,
 			    ztype out, stride_type out_s,
 			    length_type l)
   {
-    atype const phi = exponent * 2.0 * OVXX_PI/l;
-
-    for (index_type w = 0; w < l; ++w)
-    {
-      complex<atype> sum;
-      for (index_type k = 0; k < l; ++k)
-	sum += complex<atype>(in.first[k * in_s], in.second[k * in_s])
-	  * sin_cos<atype>(phi * k * w);
-      out.first[w * out_s] = sum.real();
-      out.second[w * out_s] = sum.imag();
-    }
+    plans_(l)(in.first, in.second, in_s, out.first, out.second, out_s);
   }
+
+private:
+  native::plan_cache<native::plan<T>, exponent> plans_;
 };
 
 // 1D real -> complex DFT
@@ -128,7 +84,6 @@ class dft<1, T, complex<T>, 0> : public fft_backend<1, T, complex<T>, 0>
   typedef T rtype;
   typedef complex<rtype> ctype;
   typedef std::pair<rtype*, rtype*> ztype;
-  typedef double atype;
 
 public:
   virtual char const* name() { return "dft<1,real,complex>";}
@@ -138,31 +93,18 @@ public:
 			    ctype *out, stride_type out_s,
 			    length_type l)
   {
-    atype const phi = - 2.0 * OVXX_PI/l;
-
-    for (index_type w = 0; w < l/2 + 1; ++w)
-    {
-      complex<atype> sum;
-      for (index_type k = 0; k < l; ++k)
-	sum += complex<atype>(in[k * in_s]) * sin_cos<atype>(phi * k * w);
-      out[w * out_s] = sum;
-    }
+    rtype *o = reinterpret_cast<rtype*>(out);
+    plans_(l)(in, in_s, o, o + 1, 2 * out_s);
   }
   virtual void out_of_place(rtype *in, stride_type in_s,
 			    ztype out, stride_type out_s,
 			    length_type l)
   {
-    atype const phi = - 2.0 * OVXX_PI/l;
-
-    for (index_type w = 0; w < l/2 + 1; ++w)
-    {
-      complex<atype> sum;
-      for (index_type k = 0; k < l; ++k)
-	sum += complex<atype>(in[k * in_s]) * sin_cos<atype>(phi * k * w);
-      out.first[w * out_s] = sum.real();
-      out.second[w * out_s] = sum.imag();
-    }
+    plans_(l)(in, in_s, out.first, out.second, out_s);
   }
+
+private:
+  native::plan_cache<native::real_plan<T>, -1> plans_;
 };
 
 // 1D complex -> real DFT
@@ -172,7 +114,6 @@ class dft<1, complex<T>, T, 0> : public fft_backend<1, complex<T>, T, 0>
   typedef T rtype;
   typedef std::complex<rtype> ctype;
   typedef std::pair<rtype*, rtype*> ztype;
-  typedef double atype;
 
 public:
   virtual char const* name() { return "dft<1,complex,real>";}
@@ -182,36 +123,18 @@ public:
 			    rtype *out, stride_type out_s,
 			    length_type l)
   {
-    atype const phi = 2.0 * OVXX_PI/l;
-
-    for (index_type w = 0; w < l; ++w)
-    {
-      complex<atype> sum;
-      for (index_type k = 0; k < l/2 + 1; ++k)
-	sum += complex<atype>(in[k * in_s]) * sin_cos<atype>(phi * k * w);
-      for (index_type k = l/2 + 1; k < l; ++k)
-	sum += conj(complex<atype>(in[(l - k) * in_s])) * sin_cos<atype>(phi * k * w);
-      out[w * out_s] = sum.real();
-    }
+    rtype *i = reinterpret_cast<rtype*>(in);
+    plans_(l)(i, i + 1, 2 * in_s, out, out_s);
   }
   virtual void out_of_place(ztype in, stride_type in_s,
 			    rtype *out, stride_type out_s,
 			    length_type l)
   {
-    atype const phi = 2.0 * OVXX_PI/l;
-
-    for (index_type w = 0; w < l; ++w)
-    {
-      complex<atype> sum;
-      for (index_type k = 0; k < l/2 + 1; ++k)
-	sum += complex<atype>(in.first[k * in_s], in.second[k * in_s])
-	  * sin_cos<atype>(phi * k * w);
-      for (index_type k = l/2 + 1; k < l; ++k)
-	sum += complex<atype>(in.first[(l - k) * in_s], -in.second[(l - k) * in_s])
-	  * sin_cos<atype>(phi * k * w);
-      out[w * out_s] = sum.real();
-    }
+    plans_(l)(in.first, in.second, in_s, out, out_s);
   }
+
+private:
+  native::plan_cache<native::real_plan<T>, 1> plans_;
 };
 
 // 2D complex -> complex DFT
@@ -222,7 +145,6 @@ class dft<2, complex<T>, complex<T>, S>
   typedef T rtype;
   typedef complex<rtype> ctype;
   typedef std::pair<rtype*, rtype*> ztype;
-  typedef double atype;
   static int const exponent = S == fft_fwd ? -1 : 1;
 
 public:
@@ -234,7 +156,6 @@ public:
 			stride_type r_stride, stride_type c_stride,
 			length_type rows, length_type cols)
   {
-    dft<1, ctype, ctype, S> dft_1d;
     for (length_type r = 0; r != rows; ++r)
       dft_1d.in_place(inout + r * r_stride, c_stride, cols);
     for (length_type c = 0; c != cols; ++c)
@@ -244,7 +165,6 @@ public:
 			stride_type r_stride, stride_type c_stride,
 			length_type rows, length_type cols)
   {
-    dft<1, ctype, ctype, S> dft_1d;
     for (length_type r = 0; r != rows; ++r)
     {
       ztype line = std::make_pair(inout.first + r * r_stride,
@@ -264,7 +184,6 @@ public:
 			    stride_type out_r_stride, stride_type out_c_stride,
 			    length_type rows, length_type cols)
   {
-    dft<1, ctype, ctype, S> dft_1d;
     for (length_type r = 0; r != rows; ++r)
       dft_1d.out_of_place(in + r * in_r_stride, in_c_stride,
 			  out + r * out_r_stride, out_c_stride, cols);
@@ -277,7 +196,6 @@ public:
 			    stride_type out_r_stride, stride_type out_c_stride,
 			    length_type rows, length_type cols)
   {
-    dft<1, ctype, ctype, S> dft_1d;
     for (length_type r = 0; r != rows; ++r)
     {
       ztype in_line = std::make_pair(in.first + r * in_r_stride,
@@ -294,6 +212,9 @@ public:
       dft_1d.in_place(line, out_r_stride, rows);
     }
   }
+
+private:
+  dft<1, ctype, ctype, S> dft_1d;
 };
 
 // 2D real -> complex DFT
@@ -315,8 +236,6 @@ public:
 			    stride_type out_r_stride, stride_type out_c_stride,
 			    length_type rows, length_type cols)
   {
-    dft<1, rtype, ctype, 0> rdft_1d;
-    dft<1, ctype, ctype, fft_fwd> dft_1d;
     if (axis == 0)
     {
       for (length_type c = 0; c != cols; ++c)
@@ -340,8 +259,6 @@ public:
 			    stride_type out_r_stride, stride_type out_c_stride,
 			    length_type rows, length_type cols)
   {
-    dft<1, rtype, ctype, 0> rdft_1d;
-    dft<1, ctype, ctype, fft_fwd> dft_1d;
     if (axis == 0)
     {
       for (length_type c = 0; c != cols; ++c)
@@ -376,6 +293,10 @@ public:
     }
   }
 
+
+private:
+  dft<1, rtype, ctype, 0> rdft_1d;
+  dft<1, ctype, ctype, fft_fwd> dft_1d;
 };
 
 // 2D complex -> real DFT
@@ -398,8 +319,6 @@ public:
 			    stride_type out_r_stride, stride_type out_c_stride,
 			    length_type rows, length_type cols)
   {
-    dft<1, ctype, ctype, fft_inv> dft_1d;
-    dft<1, ctype, rtype, 0> rdft_1d;
     if (axis == 0)
     {
       length_type rows2 = rows/2 + 1;
@@ -429,8 +348,6 @@ public:
 			    stride_type out_r_stride, stride_type out_c_stride,
 			    length_type rows, length_type cols)
   {
-    dft<1, ctype, ctype, fft_inv> dft_1d;
-    dft<1, ctype, rtype, 0> rdft_1d;
     if (axis == 0)
     {
       length_type rows2 = rows/2 + 1;
@@ -473,6 +390,10 @@ public:
     }
   }
 
+
+private:
+  dft<1, ctype, ctype, fft_inv> dft_1d;
+  dft<1, ctype, rtype, 0> rdft_1d;
 };
 
 // 3D complex -> complex DFT
@@ -497,8 +418,6 @@ public:
 			length_type y_length,
 			length_type z_length)
   {
-    dft<2, ctype, ctype, S> dft_2d;
-    dft<1, ctype, ctype, S> dft_1d;
     for (index_type x = 0; x != x_length; ++x)
       dft_2d.in_place(inout + x * x_stride,
 		      y_stride, z_stride, y_length, z_length);
@@ -515,8 +434,6 @@ public:
 			length_type y_length,
 			length_type z_length)
   {
-    dft<2, ctype, ctype, S> dft_2d;
-    dft<1, ctype, ctype, S> dft_1d;
     for (index_type x = 0; x != x_length; ++x)
       dft_2d.in_place(offset(inout, x * x_stride),
 		      y_stride, z_stride, y_length, z_length);
@@ -537,8 +454,6 @@ public:
 			    length_type y_length,
 			    length_type z_length)
   {
-    dft<2, ctype, ctype, S> dft_2d;
-    dft<1, ctype, ctype, S> dft_1d;
     for (index_type x = 0; x != x_length; ++x)
       dft_2d.out_of_place(in + x * in_x_stride,
 			  in_y_stride, in_z_stride,
@@ -562,8 +477,6 @@ public:
 			    length_type y_length,
 			    length_type z_length)
   {
-    dft<2, ctype, ctype, S> dft_2d;
-    dft<1, ctype, ctype, S> dft_1d;
     for (index_type x = 0; x != x_length; ++x)
       dft_2d.out_of_place(offset(in, x * in_x_stride),
 			  in_y_stride, in_z_stride,
@@ -575,6 +488,10 @@ public:
 	dft_1d.in_place(offset(out, y * out_y_stride + z * out_z_stride),
 			out_x_stride, x_length);
   }
+
+private:
+  dft<2, ctype, ctype, S> dft_2d;
+  dft<1, ctype, ctype, S> dft_1d;
 };
 
 // 3D real -> complex DFT
@@ -603,8 +520,6 @@ public:
 			    length_type y_length,
 			    length_type z_length)
   {
-    dft<1, rtype, ctype, 0> rdft_1d;
-    dft<2, ctype, ctype, fft_fwd> dft_2d;
     if (axis == 0)
     {
       for (length_type y = 0; y != y_length; ++y)
@@ -657,8 +572,6 @@ public:
 			    length_type y_length,
 			    length_type z_length)
   {
-    dft<1, rtype, ctype, 0> rdft_1d;
-    dft<2, ctype, ctype, fft_fwd> dft_2d;
     if (axis == 0)
     {
       for (length_type y = 0; y != y_length; ++y)
@@ -700,6 +613,10 @@ public:
     }
   }
 
+
+private:
+  dft<1, rtype, ctype, 0> rdft_1d;
+  dft<2, ctype, ctype, fft_fwd> dft_2d;
 };
 
 // 3D complex -> real DFT
@@ -728,8 +645,6 @@ public:
 			    length_type y_length,
 			    length_type z_length)
   {
-    dft<2, ctype, ctype, fft_inv> dft_2d;
-    dft<1, ctype, rtype, 0> rdft_1d;
     if (axis == 0)
     {
       length_type x2 = x_length/2 + 1;
@@ -794,8 +709,6 @@ public:
 			    length_type y_length,
 			    length_type z_length)
   {
-    dft<2, ctype, ctype, fft_inv> dft_2d;
-    dft<1, ctype, rtype, 0> rdft_1d;
     if (axis == 0)
     {
       length_type x2 = x_length/2 + 1;
@@ -876,6 +789,10 @@ public:
     }
   }
 
+
+private:
+  dft<2, ctype, ctype, fft_inv> dft_2d;
+  dft<1, ctype, rtype, 0> rdft_1d;
 };
 
 template <typename I, typename O, int A, int D> class dftm;
@@ -899,7 +816,6 @@ public:
 			    stride_type out_r_stride, stride_type out_c_stride,
 			    length_type rows, length_type cols)
   {
-    dft<1, rtype, ctype, 0> rdft;
     if (A == vsip::col)
       for (length_type c = 0; c != cols; ++c)
 	rdft.out_of_place(in + c * in_c_stride, in_r_stride,
@@ -915,7 +831,6 @@ public:
 			    stride_type out_r_stride, stride_type out_c_stride,
 			    length_type rows, length_type cols)
   {
-    dft<1, rtype, ctype, 0> rdft;
     if (A == vsip::col)
       for (length_type c = 0; c != cols; ++c)
 	rdft.out_of_place(in + c * in_c_stride, in_r_stride,
@@ -925,6 +840,9 @@ public:
 	rdft.out_of_place(in + r * in_r_stride, in_c_stride,
 			  offset(out, r * out_r_stride), out_c_stride, cols);
   }
+
+private:
+  dft<1, rtype, ctype, 0> rdft;
 };
 
 // complex -> real DFTM
@@ -946,7 +864,6 @@ public:
 			    stride_type out_r_stride, stride_type out_c_stride,
 			    length_type rows, length_type cols)
   {
-    dft<1, ctype, rtype, 0> rdft;
     if (A == vsip::col)
     {
       for (length_type c = 0; c != cols; ++c)
@@ -966,7 +883,6 @@ public:
 			    stride_type out_r_stride, stride_type out_c_stride,
 			    length_type rows, length_type cols)
   {
-    dft<1, ctype, rtype, 0> rdft;
     if (A == vsip::col)
     {
       for (length_type c = 0; c != cols; ++c)
@@ -988,6 +904,9 @@ public:
       }
     }
   }
+
+private:
+  dft<1, ctype, rtype, 0> rdft;
 };
 
 // complex -> complex DFTM
@@ -1008,7 +927,6 @@ public:
 			stride_type r_stride, stride_type c_stride,
 			length_type rows, length_type cols)
   {
-    dft<1, ctype, ctype, D> dft_1d;
     if (A == vsip::col)
       for (length_type c = 0; c != cols; ++c)
 	dft_1d.in_place(inout + c * c_stride, r_stride, rows);
@@ -1021,7 +939,6 @@ public:
 			stride_type r_stride, stride_type c_stride,
 			length_type rows, length_type cols)
   {
-    dft<1, ctype, ctype, D> dft_1d;
     if (A == vsip::col)
       for (length_type c = 0; c != cols; ++c)
       {
@@ -1044,7 +961,6 @@ public:
 			    stride_type out_r_stride, stride_type out_c_stride,
 			    length_type rows, length_type cols)
   {
-    dft<1, ctype, ctype, D> dft_1d;
     if (A == vsip::col)
       for (length_type c = 0; c != cols; ++c)
 	dft_1d.out_of_place(in + c * in_c_stride, in_r_stride,
@@ -1060,7 +976,6 @@ public:
 			    stride_type out_r_stride, stride_type out_c_stride,
 			    length_type rows, length_type cols)
   {
-    dft<1, ctype, ctype, D> dft_1d;
     if (A == vsip::col)
       for (length_type c = 0; c != cols; ++c)
       {
@@ -1082,6 +997,9 @@ public:
 			    out_line, out_c_stride, cols);
       }
   }
+
+private:
+  dft<1, ctype, ctype, D> dft_1d;
 };
 } // namespace ovxx::signal::fft
 } // namespace ovxx::signal
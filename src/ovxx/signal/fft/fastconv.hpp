@@ -0,0 +1,261 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_signal_fft_fastconv_hpp_
+#define ovxx_signal_fft_fastconv_hpp_
+
+#include <ovxx/assign_fwd.hpp>
+#include <ovxx/signal/fft/backend.hpp>
+#include <ovxx/signal/fft/functor.hpp>
+#include <ovxx/expr/unary.hpp>
+#include <ovxx/expr/vmmul.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <vsip/impl/vmmul.hpp>
+#include <vsip/dense.hpp>
+#include <vsip/matrix.hpp>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+namespace ovxx
+{
+namespace signal
+{
+namespace fft
+{
+namespace detail
+{
+
+/// Recover the template arguments of an Fftm backend.
+template <typename BE> struct fftm_traits;
+
+template <typename I, typename O, int A, int D>
+struct fftm_traits<fftm_backend<I, O, A, D> >
+{
+  typedef I input_type;
+  typedef O output_type;
+  static int const axis = A;
+  static int const direction = D;
+  typedef dispatcher::Dispatcher<
+    dispatcher::op::fftm<I, O, A, D, by_value, 0>,
+    std::unique_ptr<fftm_backend<I, O, A, D> >
+      (Domain<2> const &, typename scalar_of<O>::type)>
+    dispatcher_type;
+};
+
+/// The domain of lines `[begin, begin + size)` of a matrix whose
+/// lines (rows for A == row, columns otherwise) have length `length`.
+template <int A>
+inline Domain<2>
+lines(index_type begin, length_type size, length_type length)
+{
+  if (A == row) return Domain<2>(Domain<1>(begin, 1, size), length);
+  else return Domain<2>(length, Domain<1>(begin, 1, size));
+}
+
+/// Run the fast-convolution pipeline over one range of lines,
+/// `chunk` lines at a time. The spectrum of a chunk lives in a
+/// small temporary only, so it is still cache-resident when it
+/// is weighted and transformed back.
+template <typename LHS, typename FwdF, typename InvF, typename VB, int A>
+struct fastconv_task
+{
+  typedef typename FwdF::backend_type fwd_backend_type;
+  typedef typename InvF::backend_type inv_backend_type;
+  typedef typename FwdF::block_type in_block_type;
+  typedef typename fwd_backend_type::input_value_type in_value_type;
+  typedef typename fwd_backend_type::output_value_type value_type;
+  typedef typename VB::value_type weight_type;
+  typedef typename LHS::value_type lhs_value_type;
+  typedef typename conditional<A == row, row2_type, col2_type>::type order_type;
+  typedef Dense<2, value_type, order_type> tmp_block_type;
+
+  fastconv_task(LHS &l, FwdF const &f, InvF const &i, VB const &w,
+		length_type n, length_type c)
+    : lhs(l), fwd(f), inv(i), weights(w), size(n), chunk(c) {}
+
+  /// Process lines `[begin, end)` with the given backends.
+  void run(fwd_backend_type &fwd_backend, inv_backend_type &inv_backend,
+	   index_type begin, index_type end)
+  {
+    in_block_type const &in_block = fwd.arg();
+    length_type const in_length = in_block.size(2, 1 - A);
+    length_type const length = weights.size(1, 0);
+    length_type const out_length = lhs.size(2, 1 - A);
+    const_Matrix<in_value_type, in_block_type>
+      in(const_cast<in_block_type &>(in_block));
+    const_Vector<weight_type, VB> w(const_cast<VB &>(weights));
+    Matrix<lhs_value_type, LHS> out(lhs);
+
+    length_type const max = std::min(chunk, end - begin);
+    Matrix<value_type, tmp_block_type>
+      tmp(A == row ? max : length, A == row ? length : max);
+    for (index_type b = begin; b < end; b += chunk)
+    {
+      length_type const n = std::min(chunk, end - b);
+      typename Matrix<value_type, tmp_block_type>::subview_type spectrum =
+	tmp(detail::lines<A>(0, n, length));
+      typename Matrix<lhs_value_type, LHS>::subview_type result =
+	out(detail::lines<A>(b, n, out_length));
+      fwd.workspace().out_of_place(fwd_backend,
+				   in(detail::lines<A>(b, n, in_length)).block(),
+				   spectrum.block());
+      spectrum = vsip::vmmul<A>(w, spectrum);
+      inv.workspace().out_of_place(inv_backend, spectrum.block(),
+				   result.block());
+    }
+  }
+
+  /// Thread `i` of `threads`: the calling thread (i == 0) uses the
+  /// backends of the expression, all others their own copies, as
+  /// backends are not reentrant.
+  void operator()(index_type i)
+  {
+    index_type begin = i * size / threads;
+    index_type end = (i + 1) * size / threads;
+    if (i == 0)
+      run(fwd.backend(), inv.backend(), begin, end);
+    else
+      run(*fwd_backends[i - 1], *inv_backends[i - 1], begin, end);
+  }
+
+  LHS &lhs;
+  FwdF const &fwd;
+  InvF const &inv;
+  VB const &weights;
+  length_type size;
+  length_type chunk;
+  length_type threads;
+  std::vector<std::unique_ptr<fwd_backend_type> > fwd_backends;
+  std::vector<std::unique_ptr<inv_backend_type> > inv_backends;
+};
+
+} // namespace ovxx::signal::fft::detail
+} // namespace ovxx::signal::fft
+} // namespace ovxx::signal
+
+namespace dispatcher
+{
+
+/// Fused fast convolution: `inv_fftm(vmmul(weights, fwd_fftm(data)))`,
+/// with both Fftms and the vmmul operating along the same axis.
+/// Instead of materializing the forward spectrum and the weighted
+/// spectrum as two full-size temporaries, the lines are processed
+/// in cache-sized chunks (forward FFT, weighting, inverse FFT),
+/// and ranges of lines are spread across the thread pool.
+template <typename LHS,
+	  template <typename> class InvF,
+	  dimension_type VD, typename VB,
+	  template <typename> class FwdF, typename DB>
+struct Evaluator<op::assign<2>, be::fc_expr,
+		 void(LHS &,
+		      expr::Unary<InvF,
+		        expr::Vmmul<VD, VB,
+		          expr::Unary<FwdF, DB> const> const> const &)>
+{
+  static char const *name() { return "fastconv";}
+
+  typedef expr::Unary<FwdF, DB> fwd_block_type;
+  typedef expr::Vmmul<VD, VB, fwd_block_type const> vmmul_block_type;
+  typedef expr::Unary<InvF, vmmul_block_type const> RHS;
+  typedef FwdF<DB> fwd_functor_type;
+  typedef InvF<vmmul_block_type const> inv_functor_type;
+
+  /// Thread-local spectra are kept below this size (in bytes).
+  static length_type const chunk_size = 64 * 1024;
+
+  template <typename F, bool V = expr::is_fftm_functor<F>::value>
+  struct fftm_axis { static int const value = -1;};
+  template <typename F>
+  struct fftm_axis<F, true>
+  {
+    typedef signal::fft::detail::fftm_traits<typename F::backend_type> traits;
+    static int const value = traits::axis;
+    static int const direction = traits::direction;
+    static bool const complex_input = is_complex<typename traits::input_type>::value;
+    static bool const complex_output = is_complex<typename traits::output_type>::value;
+  };
+
+  typedef fftm_axis<fwd_functor_type> fwd_axis;
+  typedef fftm_axis<inv_functor_type> inv_axis;
+  static int const axis = fwd_axis::value;
+
+  // Both Fftms must run along the vmmul's axis. The forward Fftm may
+  // have a real input, and the inverse Fftm a real output.
+  template <bool V, typename Dummy = void>
+  struct valid { static bool const value = false;};
+  template <typename Dummy>
+  struct valid<true, Dummy>
+  {
+    static bool const value =
+      fwd_axis::direction == fft_fwd &&
+      inv_axis::direction == fft_inv &&
+      fwd_axis::complex_output &&
+      inv_axis::complex_input &&
+      is_same<typename LHS::value_type,
+	      typename inv_functor_type::result_type>::value;
+  };
+
+  static bool const ct_valid =
+    fwd_axis::value >= 0 &&
+    fwd_axis::value == inv_axis::value &&
+    fwd_axis::value == static_cast<int>(VD) &&
+    valid<fwd_axis::value >= 0 && inv_axis::value >= 0>::value;
+
+  static bool rt_valid(LHS &, RHS const &) { return true;}
+
+  static void exec(LHS &lhs, RHS const &rhs)
+  {
+    typedef signal::fft::detail::fastconv_task<
+      LHS, fwd_functor_type, inv_functor_type, VB, axis> task_type;
+    typedef typename fwd_functor_type::backend_type fwd_backend_type;
+    typedef typename inv_functor_type::backend_type inv_backend_type;
+    typedef signal::fft::detail::fftm_traits<fwd_backend_type> fwd_traits;
+    typedef signal::fft::detail::fftm_traits<inv_backend_type> inv_traits;
+
+    inv_functor_type const &inv = rhs.operation();
+    vmmul_block_type const &vmmul = inv.arg();
+    fwd_functor_type const &fwd = vmmul.get_mblk().operation();
+
+    length_type const lines = lhs.size(2, axis);
+    length_type const length = vmmul.size(2, 1 - axis);
+    length_type const in_length = fwd.arg().size(2, 1 - axis);
+    length_type const out_length = lhs.size(2, 1 - axis);
+    if (!lines) return;
+
+    thread_pool *pool = thread_pool::get_default();
+    length_type threads = 1;
+    if (pool->size() > 1 && lhs.size() >= thread_pool::threshold())
+      threads = std::min<length_type>(pool->size(), lines);
+    length_type chunk =
+      std::max<length_type>(1, chunk_size / (length * sizeof(typename task_type::value_type)));
+    chunk = std::min(chunk, (lines + threads - 1) / threads);
+
+    task_type task(lhs, fwd, inv, vmmul.get_vblk(), lines, chunk);
+    task.threads = threads;
+    // Backends accept fewer lines than they were planned for, so
+    // the extra ones only need to cover a single chunk.
+    for (index_type i = 1; i < threads; ++i)
+    {
+      task.fwd_backends.push_back(fwd_traits::dispatcher_type::dispatch
+	(signal::fft::detail::lines<axis>(0, chunk, in_length),
+	 fwd.workspace().scale()));
+      task.inv_backends.push_back(inv_traits::dispatcher_type::dispatch
+	(signal::fft::detail::lines<axis>(0, chunk, out_length),
+	 inv.workspace().scale()));
+    }
+    if (threads > 1)
+      pool->parallel_for(threads, task);
+    else
+      task(0);
+  }
+};
+
+} // namespace ovxx::dispatcher
+} // namespace ovxx
+
+#endif
@@ -97,7 +97,7 @@ struct fft
 
     map_type const &map() const { return arg_.map();}
     block_type const &arg() const { return arg_;}
-    backend_type const &backend() const { return backend_;}
+    backend_type &backend() const { return backend_;}
     workspace_type &workspace() const { return workspace_;}
 
     template <typename R>
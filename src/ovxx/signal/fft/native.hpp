@@ -0,0 +1,435 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_signal_fft_native_hpp_
+#define ovxx_signal_fft_native_hpp_
+
+#include <vsip/support.hpp>
+#include <ovxx/aligned_array.hpp>
+#include <ovxx/simd/simd.hpp>
+#include <ovxx/detail/noncopyable.hpp>
+#include <vector>
+#include <memory>
+#include <cmath>
+
+namespace ovxx
+{
+namespace signal
+{
+namespace fft
+{
+/// A built-in FFT engine, used by the `dft` backend.
+///
+/// Sizes that factor into 2, 3, 4, 5, and other small primes are
+/// transformed by a mixed-radix Stockham algorithm with precomputed
+/// twiddle factors. All other sizes use Bluestein's algorithm, which
+/// expresses the transform as a convolution evaluated with power-of-two
+/// transforms. Data are processed in split format, so the radix 2 to 5
+/// butterflies of float and double transforms can use the SIMD kernels.
+///
+/// Plans own the scratch buffers they transform in, so a plan (and
+/// thus a plan_cache, or a `dft` backend holding one) must not be used
+/// by more than one thread at a time. Code that runs transforms
+/// concurrently uses one backend per thread.
+namespace native
+{
+/// The largest prime factor handled directly by mixed-radix stages.
+length_type const max_radix = 13;
+
+/// exp(e * 2pi i * k / n)
+template <typename T>
+inline void root(int e, index_type k, length_type n, T &re, T &im)
+{
+  long double const phi = e * 2 * 3.141592653589793238462643383279503L
+    * static_cast<long double>(k % n) / n;
+  re = static_cast<T>(std::cos(phi));
+  im = static_cast<T>(std::sin(phi));
+}
+
+/// Apply one column of radix-r butterflies (see simd::kernels::sfft).
+/// `roots` holds the r-th roots of unity as (re, im) pairs.
+template <typename T>
+void generic_column(length_type r, T const *xr, T const *xi, T *yr, T *yi,
+		    length_type m, stride_type os, T const *w, T const *roots)
+{
+  T ar[max_radix], ai[max_radix];
+  for (index_type t = 0; t != m; ++t)
+  {
+    ar[0] = xr[t];
+    ai[0] = xi[t];
+    for (index_type q = 1; q != r; ++q)
+    {
+      T re = xr[q * m + t], im = xi[q * m + t];
+      T wr = w[2 * q - 2], wi = w[2 * q - 1];
+      ar[q] = re * wr - im * wi;
+      ai[q] = re * wi + im * wr;
+    }
+    for (index_type s = 0; s != r; ++s)
+    {
+      T sr = ar[0], si = ai[0];
+      for (index_type q = 1, k = s; q != r; ++q, k = (k + s) % r)
+      {
+	sr += ar[q] * roots[2 * k] - ai[q] * roots[2 * k + 1];
+	si += ar[q] * roots[2 * k + 1] + ai[q] * roots[2 * k];
+      }
+      yr[static_cast<stride_type>(s) * os + t] = sr;
+      yi[static_cast<stride_type>(s) * os + t] = si;
+    }
+  }
+}
+
+template <typename T>
+inline void column(length_type r, T const *xr, T const *xi, T *yr, T *yi,
+		   length_type m, stride_type os, T const *w, T const *roots,
+		   int)
+{ generic_column(r, xr, xi, yr, yi, m, os, w, roots);}
+
+inline void column(length_type r, float const *xr, float const *xi,
+		   float *yr, float *yi, length_type m, stride_type os,
+		   float const *w, float const *roots, int e)
+{
+  if (r <= 5) simd::get_kernels().sfft(r, xr, xi, yr, yi, m, os, w, e);
+  else generic_column(r, xr, xi, yr, yi, m, os, w, roots);
+}
+
+inline void column(length_type r, double const *xr, double const *xi,
+		   double *yr, double *yi, length_type m, stride_type os,
+		   double const *w, double const *roots, int e)
+{
+  if (r <= 5) simd::get_kernels().dfft(r, xr, xi, yr, yi, m, os, w, e);
+  else generic_column(r, xr, xi, yr, yi, m, os, w, roots);
+}
+
+/// A complex-to-complex transform of a fixed size and direction.
+/// Its input and work buffers are members, so transforms don't allocate
+/// but a plan is not reentrant.
+template <typename T>
+class plan : ovxx::detail::noncopyable
+{
+  struct stage
+  {
+    length_type radix;
+    length_type l;        // the size of the sub-transforms to combine
+    length_type m;        // the number of sub-transforms produced
+    index_type twiddles;  // offset into twiddles_
+    index_type roots;     // offset into roots_
+  };
+
+public:
+  plan(length_type n, int exponent)
+    : size_(n), exponent_(exponent), re_(n), im_(n)
+  {
+    if (n < 2) return;
+    length_type rest = n;
+    std::vector<length_type> radices;
+    while (rest % 4 == 0) { radices.push_back(4); rest /= 4;}
+    if (rest % 2 == 0) { radices.push_back(2); rest /= 2;}
+    for (length_type p = 3; p <= max_radix; p += 2)
+      while (rest % p == 0) { radices.push_back(p); rest /= p;}
+    if (rest != 1) init_bluestein();
+    else init_stages(radices);
+  }
+
+  length_type size() const { return size_;}
+
+  /// Transform the `size()` values in (in_r, in_i) with stride `is`,
+  /// storing the result in (out_r, out_i) with stride `os`. Interleaved
+  /// complex data are passed as (p, p + 1) with twice their stride.
+  /// Input and output may be the same.
+  void operator()(T const *in_r, T const *in_i, stride_type is,
+		  T *out_r, T *out_i, stride_type os)
+  {
+    for (index_type k = 0; k != size_; ++k)
+    {
+      re_[k] = in_r[static_cast<stride_type>(k) * is];
+      im_[k] = in_i[static_cast<stride_type>(k) * is];
+    }
+    std::pair<T*, T*> r = execute();
+    for (index_type k = 0; k != size_; ++k)
+    {
+      out_r[static_cast<stride_type>(k) * os] = r.first[k];
+      out_i[static_cast<stride_type>(k) * os] = r.second[k];
+    }
+  }
+
+  /// Transform the values in `input()`, returning the location of the
+  /// result.
+  std::pair<T*, T*> input() { return std::make_pair(re_.get(), im_.get());}
+  std::pair<T*, T*> execute()
+  {
+    if (inner_) return bluestein();
+    T *xr = re_.get(), *xi = im_.get();
+    T *yr = work_re_.get(), *yi = work_im_.get();
+    for (index_type i = 0; i != stages_.size(); ++i)
+    {
+      stage const &s = stages_[i];
+      T const *w = &twiddles_[s.twiddles];
+      T const *roots = roots_.data() + s.roots;
+      for (index_type j = 0; j != s.l; ++j, w += 2 * (s.radix - 1))
+	column(s.radix, xr + j * s.radix * s.m, xi + j * s.radix * s.m,
+	       yr + j * s.m, yi + j * s.m, s.m, s.l * s.m, w, roots, exponent_);
+      std::swap(xr, yr);
+      std::swap(xi, yi);
+    }
+    return std::make_pair(xr, xi);
+  }
+
+private:
+  void init_stages(std::vector<length_type> const &radices)
+  {
+    if (radices.empty()) return;
+    aligned_array<T> wr(size_), wi(size_);
+    work_re_ = wr;
+    work_im_ = wi;
+    length_type l = 1;
+    for (index_type i = 0; i != radices.size(); ++i)
+    {
+      length_type const r = radices[i];
+      stage s = { r, l, size_ / (l * r), twiddles_.size(), roots_.size()};
+      // w_q for column j is exp(e * 2pi i * q * j / (l * r)).
+      for (index_type j = 0; j != l; ++j)
+	for (index_type q = 1; q != r; ++q)
+	{
+	  T re, im;
+	  root(exponent_, q * j, l * r, re, im);
+	  twiddles_.push_back(re);
+	  twiddles_.push_back(im);
+	}
+      for (index_type k = 0; k != r; ++k)
+      {
+	T re, im;
+	root(exponent_, k, r, re, im);
+	roots_.push_back(re);
+	roots_.push_back(im);
+      }
+      stages_.push_back(s);
+      l *= r;
+    }
+  }
+
+  // Bluestein: with c_k = exp(e * pi i * k^2 / n),
+  // X_s = c_s * sum_k (x_k * c_k) * conj(c_{s-k}),
+  // a convolution that is evaluated with transforms of size m >= 2n - 1.
+  void init_bluestein()
+  {
+    length_type m = 1;
+    while (m < 2 * size_ - 1) m *= 2;
+    inner_.reset(new plan(m, -1));
+    chirp_.resize(2 * size_);
+    for (index_type k = 0; k != size_; ++k)
+      // k^2 mod 2n, to keep the argument small
+      root(exponent_, (k * k) % (2 * size_), 2 * size_,
+	   chirp_[2 * k], chirp_[2 * k + 1]);
+    std::pair<T*, T*> b = inner_->input();
+    for (index_type k = 0; k != m; ++k) b.first[k] = b.second[k] = T(0);
+    for (index_type k = 0; k != size_; ++k)
+    {
+      b.first[k] = chirp_[2 * k] / m;
+      b.second[k] = -chirp_[2 * k + 1] / m;
+      if (k)
+      {
+	b.first[m - k] = b.first[k];
+	b.second[m - k] = b.second[k];
+      }
+    }
+    b = inner_->execute();
+    kernel_.assign(2 * m, T(0));
+    for (index_type k = 0; k != m; ++k)
+    {
+      kernel_[2 * k] = b.first[k];
+      kernel_[2 * k + 1] = b.second[k];
+    }
+  }
+
+  std::pair<T*, T*> bluestein()
+  {
+    length_type const m = inner_->size();
+    std::pair<T*, T*> a = inner_->input();
+    for (index_type k = 0; k != size_; ++k)
+    {
+      T cr = chirp_[2 * k], ci = chirp_[2 * k + 1];
+      a.first[k] = re_[k] * cr - im_[k] * ci;
+      a.second[k] = re_[k] * ci + im_[k] * cr;
+    }
+    for (index_type k = size_; k != m; ++k) a.first[k] = a.second[k] = T(0);
+    std::pair<T*, T*> r = inner_->execute();
+    // The inverse transform of the product is computed as
+    // conj(fft(conj(A * B))).
+    for (index_type k = 0; k != m; ++k)
+    {
+      T br = kernel_[2 * k], bi = kernel_[2 * k + 1];
+      T pr = r.first[k] * br - r.second[k] * bi;
+      T pi = r.first[k] * bi + r.second[k] * br;
+      a.first[k] = pr;
+      a.second[k] = -pi;
+    }
+    r = inner_->execute();
+    for (index_type k = 0; k != size_; ++k)
+    {
+      T cr = chirp_[2 * k], ci = chirp_[2 * k + 1];
+      T vr = r.first[k], vi = -r.second[k];
+      re_[k] = vr * cr - vi * ci;
+      im_[k] = vr * ci + vi * cr;
+    }
+    return std::make_pair(re_.get(), im_.get());
+  }
+
+  length_type size_;
+  int exponent_;
+  aligned_array<T> re_, im_;
+  aligned_array<T> work_re_, work_im_;
+  std::vector<stage> stages_;
+  std::vector<T> twiddles_;
+  std::vector<T> roots_;
+  std::unique_ptr<plan> inner_;
+  std::vector<T> chirp_;
+  std::vector<T> kernel_;
+};
+
+/// A real-to-complex (exponent -1) or complex-to-real (exponent 1)
+/// transform of a fixed size. Even sizes are computed with a complex
+/// transform of half the size, odd sizes with one of the full size.
+template <typename T>
+class real_plan : ovxx::detail::noncopyable
+{
+public:
+  real_plan(length_type n, int exponent)
+    : size_(n), plan_(n % 2 ? n : n / 2, exponent)
+  {
+    if (n % 2) return;
+    length_type const h = n / 2;
+    twiddles_.resize(2 * h);
+    for (index_type s = 0; s != h; ++s)
+      root(-1, s, n, twiddles_[2 * s], twiddles_[2 * s + 1]);
+  }
+
+  length_type size() const { return size_;}
+
+  /// Compute the size() / 2 + 1 non-redundant values of the
+  /// transform of the real values in `in`.
+  void operator()(T const *in, stride_type is,
+		  T *out_r, T *out_i, stride_type os)
+  {
+    std::pair<T*, T*> z = plan_.input();
+    if (size_ % 2)
+    {
+      for (index_type k = 0; k != size_; ++k)
+      {
+	z.first[k] = in[static_cast<stride_type>(k) * is];
+	z.second[k] = T(0);
+      }
+      z = plan_.execute();
+      for (index_type s = 0; s != size_ / 2 + 1; ++s)
+      {
+	out_r[static_cast<stride_type>(s) * os] = z.first[s];
+	out_i[static_cast<stride_type>(s) * os] = z.second[s];
+      }
+      return;
+    }
+    length_type const h = size_ / 2;
+    for (index_type k = 0; k != h; ++k)
+    {
+      z.first[k] = in[static_cast<stride_type>(2 * k) * is];
+      z.second[k] = in[static_cast<stride_type>(2 * k + 1) * is];
+    }
+    z = plan_.execute();
+    // X_s = E_s + w^s O_s, with
+    // E_s = (Z_s + conj(Z_{h-s})) / 2 and O_s = -i (Z_s - conj(Z_{h-s})) / 2
+    T const half(0.5);
+    for (index_type s = 0; s != h; ++s)
+    {
+      index_type const t = s ? h - s : 0;
+      T zr = z.first[s], zi = z.second[s];
+      T cr = z.first[t], ci = -z.second[t];
+      T er = half * (zr + cr), ei = half * (zi + ci);
+      T odr = half * (zi - ci), odi = -half * (zr - cr);
+      T wr = twiddles_[2 * s], wi = twiddles_[2 * s + 1];
+      out_r[static_cast<stride_type>(s) * os] = er + wr * odr - wi * odi;
+      out_i[static_cast<stride_type>(s) * os] = ei + wr * odi + wi * odr;
+    }
+    out_r[static_cast<stride_type>(h) * os] = z.first[0] - z.second[0];
+    out_i[static_cast<stride_type>(h) * os] = T(0);
+  }
+
+  /// Compute the real transform of the size() / 2 + 1 values in (in_r, in_i),
+  /// extended by Hermitian symmetry.
+  void operator()(T const *in_r, T const *in_i, stride_type is,
+		  T *out, stride_type os)
+  {
+    std::pair<T*, T*> z = plan_.input();
+    length_type const h = size_ / 2;
+    if (size_ % 2)
+    {
+      for (index_type k = 0; k <= h; ++k)
+      {
+	z.first[k] = in_r[static_cast<stride_type>(k) * is];
+	z.second[k] = in_i[static_cast<stride_type>(k) * is];
+      }
+      for (index_type k = h + 1; k != size_; ++k)
+      {
+	z.first[k] = in_r[static_cast<stride_type>(size_ - k) * is];
+	z.second[k] = -in_i[static_cast<stride_type>(size_ - k) * is];
+      }
+      z.second[0] = T(0);
+      z = plan_.execute();
+      for (index_type k = 0; k != size_; ++k)
+	out[static_cast<stride_type>(k) * os] = z.first[k];
+      return;
+    }
+    // Z_s = E_s + i O_s, with
+    // E_s = X_s + conj(X_{h-s}) and O_s = (X_s - conj(X_{h-s})) w^{-s}
+    for (index_type s = 0; s != h; ++s)
+    {
+      stride_type const o = static_cast<stride_type>(s) * is;
+      stride_type const co = static_cast<stride_type>(h - s) * is;
+      T xr = in_r[o], xi = s ? in_i[o] : T(0);
+      T cr = in_r[co], ci = s ? -in_i[co] : T(0);
+      T er = xr + cr, ei = xi + ci;
+      T dr = xr - cr, di = xi - ci;
+      T wr = twiddles_[2 * s], wi = -twiddles_[2 * s + 1];
+      T odr = dr * wr - di * wi, odi = dr * wi + di * wr;
+      z.first[s] = er - odi;
+      z.second[s] = ei + odr;
+    }
+    z = plan_.execute();
+    for (index_type k = 0; k != h; ++k)
+    {
+      out[static_cast<stride_type>(2 * k) * os] = z.first[k];
+      out[static_cast<stride_type>(2 * k + 1) * os] = z.second[k];
+    }
+  }
+
+private:
+  length_type size_;
+  plan<T> plan_;
+  std::vector<T> twiddles_;
+};
+
+/// Plans of a given type and direction, created on first use for
+/// each size.
+template <typename P, int E>
+class plan_cache
+{
+public:
+  P &operator()(length_type n)
+  {
+    for (index_type i = 0; i != plans_.size(); ++i)
+      if (plans_[i]->size() == n) return *plans_[i];
+    plans_.push_back(std::unique_ptr<P>(new P(n, E)));
+    return *plans_.back();
+  }
+
+private:
+  std::vector<std::unique_ptr<P> > plans_;
+};
+
+} // namespace ovxx::signal::fft::native
+} // namespace ovxx::signal::fft
+} // namespace ovxx::signal
+} // namespace ovxx
+
+#endif
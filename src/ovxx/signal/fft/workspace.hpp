@@ -458,6 +458,8 @@ public:
     : scale_(scale)
   {
   }
+
+  scalar_type scale() const { return scale_;}
   
   template <typename BE, typename B1, typename B2>
   void out_of_place(BE &backend, B1 const &in, B2 &out)
@@ -14,6 +14,8 @@
 #include <vsip/vector.hpp>
 #include <vsip/domain.hpp>
 #include <ovxx/dispatch.hpp>
+#include <vector>
+#include <algorithm>
 
 namespace ovxx
 {
@@ -172,6 +174,126 @@ private:
   length_type state_saved_;
 };
 
+namespace detail
+{
+/// Unpack the k coefficients in `c` into the full kernel `h`,
+/// according to the symmetry S.
+template <typename T, symmetry_type S>
+void unpack_fir_kernel(T const *c, length_type k, length_type order, T *h)
+{
+  for (index_type j = 0; j != k; ++j)
+  {
+    h[j] = c[j];
+    if (S != nonsym) h[order - j] = c[j];
+  }
+}
+} // namespace ovxx::signal::detail
+
+/// Polyphase FIR.
+///
+/// The kernel is split into `decimation` sub-filters, each of which
+/// is applied to the matching phase of the input, so only the outputs
+/// that are kept get computed. The sub-filters are applied tap by tap
+/// across all outputs, which gives the compiler contiguous loops to
+/// vectorize. The last `order` input samples are kept across calls
+/// for `state_save`.
+template <typename T, symmetry_type S, obj_state C> 
+class Fir_polyphase : public Fir_backend<T, S, C>
+{
+  typedef Fir_backend<T, S, C> base;
+public:
+  Fir_polyphase(aligned_array<T> kernel, length_type k, length_type i, length_type d)
+    : base(i, k, d),
+      phase_(0),
+      ext_(this->order_ + this->input_size_, T(0)),
+      acc_(this->output_size_)
+  {
+    OVXX_PRECONDITION(k > (S == nonsym));
+    length_type const m = this->order_;
+    length_type const dec = this->decimation_;
+    std::vector<T> h(m + 1);
+    detail::unpack_fir_kernel<T, S>(kernel.get(), k, m, &h[0]);
+    // Sub-filter p holds the taps h[j * dec + p].
+    for (index_type p = 0; p != dec; ++p)
+    {
+      offsets_.push_back(taps_.size());
+      for (index_type t = p; t <= m; t += dec)
+	taps_.push_back(h[t]);
+    }
+    offsets_.push_back(taps_.size());
+    if (dec > 1)
+      phases_.resize(dec * phase_length());
+  }
+  virtual Fir_polyphase *clone() { return new Fir_polyphase(*this);}
+
+  length_type apply(T const *in, stride_type in_stride, length_type in_length,
+                    T *out, stride_type out_stride, length_type)
+  {
+    length_type const m = this->order_;
+    length_type const n = in_length;
+    length_type const dec = this->decimation_;
+    T *ext = &ext_[0];
+    for (index_type i = 0; i != n; ++i)
+      ext[m + i] = in[i * in_stride];
+
+    length_type const count = phase_ < n ? (n - phase_ + dec - 1) / dec : 0;
+    T *acc = &acc_[0];
+    std::fill(acc, acc + count, T(0));
+
+    // With x = ext, output o is sum_t h[t] * x[m + phase_ + o*dec - t].
+    // Splitting t = j*dec + p, the samples x[... - p - j*dec] are
+    // contiguous in phase r of the de-interleaved input.
+    length_type const stride = phase_length();
+    if (dec > 1)
+      for (index_type t = 0; t != m + n; ++t)
+	phases_[(t % dec) * stride + t / dec] = ext[t];
+    // Only phases p <= m have taps, which also keeps start non-negative.
+    for (index_type p = 0; p != dec && p <= m; ++p)
+    {
+      index_type const start = m + phase_ - p;
+      T const *x = dec > 1 ? &phases_[(start % dec) * stride] : ext;
+      x += start / dec;
+      T const *h = &taps_[offsets_[p]];
+      length_type const taps = offsets_[p + 1] - offsets_[p];
+      for (index_type j = 0; j != taps; ++j)
+      {
+	T const c = h[j];
+	T const *xj = x - j;
+	for (index_type o = 0; o != count; ++o)
+	  acc[o] += c * xj[o];
+      }
+    }
+    for (index_type o = 0; o != count; ++o)
+      out[o * out_stride] = acc[o];
+
+    if (C == state_save)
+    {
+      std::copy(ext + n, ext + n + m, ext);
+      phase_ = phase_ + count * dec - n;
+    }
+    return count;
+  }
+
+  virtual void reset() VSIP_NOTHROW
+  {
+    phase_ = 0;
+    std::fill(ext_.begin(), ext_.end(), T(0));
+  }
+
+private:
+  length_type phase_length() const
+  { return (this->order_ + this->input_size_ + this->decimation_ - 1) / this->decimation_;}
+
+  // The offset of the first output relative to the next input.
+  length_type phase_;
+  std::vector<T> taps_;
+  std::vector<length_type> offsets_;
+  // The saved state, followed by the current input.
+  std::vector<T> ext_;
+  std::vector<T> phases_;
+  std::vector<T> acc_;
+};
+
 } // namespace ovxx::signal
 
 namespace dispatcher
@@ -199,6 +321,30 @@ struct Evaluator<op::fir, be::generic,
   }
 };
 
+template <typename T, symmetry_type S, obj_state C> 
+struct Evaluator<op::fir, be::opt,
+                 shared_ptr<signal::Fir_backend<T, S, C> >
+                 (aligned_array<T>,
+                  length_type, length_type, length_type,
+                  unsigned, alg_hint_type)>
+{
+  static bool const ct_valid = true;
+  typedef ovxx::shared_ptr<signal::Fir_backend<T, S, C> > return_type;
+  // Fir_polyphase is faster than Fir for all decimations, but keeps
+  // copies of the input (and for decimation > 1 its de-interleaved
+  // phases), so leave alg_space requests to the generic backend.
+  static bool rt_valid(aligned_array<T> const &,
+                       length_type, length_type, length_type,
+                       unsigned, alg_hint_type h)
+  { return h != alg_space;}
+  static return_type exec(aligned_array<T> k, length_type ks,
+                          length_type is, length_type d,
+                          unsigned, alg_hint_type)
+  {
+    return return_type(new signal::Fir_polyphase<T, S, C>(k, ks, is, d));
+  }
+};
+
 } // namespace ovxx::dispatcher
 } // namespace ovxx
 
@@ -0,0 +1,207 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_signal_fir_bank_hpp_
+#define ovxx_signal_fir_bank_hpp_
+
+#include <vsip/support.hpp>
+#include <vsip/impl/signal/types.hpp>
+#include <vsip/vector.hpp>
+#include <vsip/matrix.hpp>
+#include <vsip/dda.hpp>
+#include <ovxx/signal/fir.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <vector>
+#include <algorithm>
+
+namespace ovxx
+{
+namespace signal
+{
+
+/// A bank of FIR filters sharing one kernel.
+///
+/// Each row of the input matrix is an independent channel, filtered
+/// with the same semantics as `vsip::Fir`. The state of all channels
+/// is kept in a single block, with the channels interleaved, so the
+/// inner loop of the filter runs across channels and can be
+/// vectorized. For large enough problems, the channels are split
+/// across the default thread pool.
+template <typename T = VSIP_DEFAULT_VALUE_TYPE,
+          symmetry_type S = nonsym,
+          obj_state C = state_save>
+class Fir_bank
+{
+  // Channels are assigned to threads in multiples of this.
+  static length_type const channel_block = 16;
+
+  struct arguments
+  {
+    T const *in;
+    stride_type in_row, in_col;
+    T *out;
+    stride_type out_row, out_col;
+    length_type count;
+  };
+
+  // Filter channels [c * width, (c + 1) * width).
+  struct task
+  {
+    Fir_bank *bank;
+    arguments const *args;
+    length_type width;
+
+    void operator()(index_type c)
+    {
+      index_type const begin = c * width;
+      bank->apply(*args, begin, std::min(begin + width, bank->channels_));
+    }
+  };
+
+public:
+  static symmetry_type const symmetry = S;
+  static obj_state const continuous_filter = C;
+
+  template <typename B>
+  Fir_bank(const_Vector<T, B> kernel,
+           length_type channels,
+           length_type input_size,
+           length_type decimation = 1)
+    VSIP_THROW((std::bad_alloc))
+    : channels_(channels),
+      input_size_(input_size),
+      order_(Fir_backend<T, S, C>::order(kernel.size()) - 1),
+      decimation_(decimation),
+      phase_(0),
+      kernel_(order_ + 1),
+      state_((order_ + input_size_) * channels_, T(0)),
+      acc_(channels_)
+  {
+    OVXX_PRECONDITION(channels_ > 0);
+    OVXX_PRECONDITION(input_size_ > 0);
+    OVXX_PRECONDITION(decimation_ > 0);
+    OVXX_PRECONDITION(kernel.size() > (S == nonsym));
+    OVXX_PRECONDITION(order_ + 1 > decimation_); // M >= decimation
+    OVXX_PRECONDITION(input_size_ >= order_);    // input_size >= M - 1
+    output_size_ = (input_size_ + decimation_ - 1) / decimation_;
+    std::vector<T> coeffs(kernel.size());
+    for (index_type i = 0; i != coeffs.size(); ++i)
+      coeffs[i] = kernel.get(i);
+    detail::unpack_fir_kernel<T, S>(&coeffs[0], coeffs.size(), order_, &kernel_[0]);
+  }
+
+  length_type kernel_size() const VSIP_NOTHROW { return order_ + 1;}
+  length_type filter_order() const VSIP_NOTHROW { return order_ + 1;}
+  length_type channels() const VSIP_NOTHROW { return channels_;}
+  length_type input_size() const VSIP_NOTHROW { return input_size_;}
+  length_type output_size() const VSIP_NOTHROW { return output_size_;}
+  length_type decimation() const VSIP_NOTHROW { return decimation_;}
+  obj_state continuous_filtering() const VSIP_NOTHROW { return C;}
+
+  /// Filter each row of `in` into the same row of `out`, and return
+  /// the number of outputs computed per channel.
+  template <typename Block0, typename Block1>
+  length_type
+  operator()(const_Matrix<T, Block0> in, Matrix<T, Block1> out) VSIP_NOTHROW
+  {
+    OVXX_PRECONDITION(in.size(0) == channels_ && in.size(1) == input_size_);
+    OVXX_PRECONDITION(out.size(0) == channels_ && out.size(1) == output_size_);
+
+    typedef typename get_block_layout<Block0>::type LP0;
+    typedef typename get_block_layout<Block1>::type LP1;
+    typedef typename adjust_layout_storage_format<array, LP0>::type use_LP0;
+    typedef typename adjust_layout_storage_format<array, LP1>::type use_LP1;
+
+    dda::Data<Block0, dda::in, use_LP0> data_in(in.block());
+    dda::Data<Block1, dda::out, use_LP1> data_out(out.block());
+
+    arguments args =
+    {
+      data_in.ptr(), data_in.stride(0), data_in.stride(1),
+      data_out.ptr(), data_out.stride(0), data_out.stride(1),
+      phase_ < input_size_ ? (input_size_ - phase_ + decimation_ - 1) / decimation_ : 0
+    };
+    thread_pool *pool = thread_pool::get_default();
+    if (pool->size() > 1 && channels_ > channel_block &&
+        channels_ * input_size_ * (order_ + 1) >= thread_pool::threshold())
+    {
+      length_type width = (channels_ + pool->size() - 1) / pool->size();
+      width = (width + channel_block - 1) / channel_block * channel_block;
+      task t = {this, &args, width};
+      pool->parallel_for((channels_ + width - 1) / width, t);
+    }
+    else
+      apply(args, 0, channels_);
+
+    if (C == state_save)
+      phase_ = phase_ + args.count * decimation_ - input_size_;
+    return args.count;
+  }
+
+  void reset() VSIP_NOTHROW
+  {
+    phase_ = 0;
+    std::fill(state_.begin(), state_.end(), T(0));
+  }
+
+private:
+  // Filter channels [begin, end). The state holds the last `order_`
+  // samples of each channel, followed by the new input, with sample t
+  // of channel c stored at state_[t * channels_ + c].
+  void apply(arguments const &args, index_type begin, index_type end)
+  {
+    length_type const m = order_;
+    length_type const n = input_size_;
+    length_type const w = channels_;
+    T *state = &state_[0];
+    T *acc = &acc_[0];
+
+    for (index_type c = begin; c != end; ++c)
+    {
+      T const *in = args.in + c * args.in_row;
+      for (index_type i = 0; i != n; ++i)
+        state[(m + i) * w + c] = in[i * args.in_col];
+    }
+
+    // Output o is sum_t h[t] * x[m + phase_ + o * dec - t].
+    for (index_type o = 0; o != args.count; ++o)
+    {
+      index_type const t0 = m + phase_ + o * decimation_;
+      std::fill(acc + begin, acc + end, T(0));
+      for (index_type t = 0; t <= m; ++t)
+      {
+        T const h = kernel_[t];
+        T const *x = state + (t0 - t) * w;
+        for (index_type c = begin; c != end; ++c)
+          acc[c] += h * x[c];
+      }
+      for (index_type c = begin; c != end; ++c)
+        args.out[c * args.out_row + o * args.out_col] = acc[c];
+    }
+
+    if (C == state_save)
+      for (index_type t = 0; t != m; ++t)
+        std::copy(state + (t + n) * w + begin, state + (t + n) * w + end,
+                  state + t * w + begin);
+  }
+
+  length_type channels_;
+  length_type input_size_;
+  length_type output_size_;
+  length_type order_;
+  length_type decimation_;
+  // The offset of the first output relative to the next input.
+  length_type phase_;
+  std::vector<T> kernel_;
+  std::vector<T> state_;
+  std::vector<T> acc_;
+};
+
+} // namespace ovxx::signal
+} // namespace ovxx
+
+#endif
@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_signal_fir_fft_hpp_
+#define ovxx_signal_fir_fft_hpp_
+
+#include <ovxx/signal/fir.hpp>
+#include <ovxx/signal/conv_fft.hpp>
+#include <vsip/dda.hpp>
+
+namespace ovxx
+{
+namespace signal
+{
+
+/// Overlap-save FIR, for long kernels.
+///
+/// The saved state and the current input are filtered in blocks of
+/// four times the kernel length (rounded up to a power of two), of
+/// which only the kept outputs are extracted.
+template <typename T, symmetry_type S, obj_state C>
+class Fir_fft : public Fir_backend<T, S, C>
+{
+  typedef Fir_backend<T, S, C> base;
+  typedef detail::conv_fft<T, 0> fft_traits;
+  typedef typename fft_traits::spectrum_type ctype;
+  typedef typename scalar_of<T>::type scalar_type;
+
+  struct workspace
+  {
+    workspace(std::vector<T> const &kernel, length_type size)
+      : fwd(Domain<1>(size), scalar_type(1)),
+	inv(Domain<1>(size), scalar_type(1)),
+	kernel_spectrum(fft_traits::spectrum_size(size)),
+	spectrum(fft_traits::spectrum_size(size)),
+	in(size, T()),
+	out(size)
+    {
+      for (index_type i = 0; i != kernel.size(); ++i)
+	in.put(i, kernel[i]);
+      fwd(in, kernel_spectrum);
+      kernel_spectrum *= scalar_type(1) / size;
+    }
+
+    typename fft_traits::fwd_type fwd;
+    typename fft_traits::inv_type inv;
+    Vector<ctype> kernel_spectrum;
+    Vector<ctype> spectrum;
+    Vector<T> in;
+    Vector<T> out;
+  };
+
+public:
+  Fir_fft(aligned_array<T> kernel, length_type k, length_type i, length_type d)
+    : base(i, k, d),
+      phase_(0),
+      kernel_(this->order_ + 1),
+      ext_(this->order_ + this->input_size_, T(0))
+  {
+    OVXX_PRECONDITION(k > (S == nonsym));
+    detail::unpack_fir_kernel<T, S>(kernel.get(), k, this->order_, &kernel_[0]);
+    initialize();
+  }
+  Fir_fft(Fir_fft const &fir)
+    : base(fir),
+      phase_(fir.phase_),
+      kernel_(fir.kernel_),
+      ext_(fir.ext_)
+  {
+    initialize();
+  }
+  virtual Fir_fft *clone() { return new Fir_fft(*this);}
+
+  length_type apply(T const *in, stride_type in_stride, length_type in_length,
+                    T *out, stride_type out_stride, length_type)
+  {
+    workspace &ws = *workspace_;
+    length_type const m = this->order_;
+    length_type const n = in_length;
+    length_type const dec = this->decimation_;
+    length_type const size = ws.in.size();
+    length_type const step = size - m;
+    T *ext = &ext_[0];
+    for (index_type i = 0; i != n; ++i)
+      ext[m + i] = in[i * in_stride];
+
+    length_type const count = phase_ < n ? (n - phase_ + dec - 1) / dec : 0;
+    // Output o needs x[m + phase_ + o*dec - t] for t in [0, m],
+    // so each block starting at s yields outputs for [s + m, s + size).
+    index_type o = 0;
+    for (index_type s = 0; o != count; s += step)
+    {
+      {
+	dda::Data<typename Vector<T>::block_type, dda::out> data(ws.in.block());
+	length_type valid = std::min(size, m + n - s);
+	std::copy(ext + s, ext + s + valid, data.ptr());
+	std::fill(data.ptr() + valid, data.ptr() + size, T(0));
+      }
+      ws.fwd(ws.in, ws.spectrum);
+      ws.spectrum *= ws.kernel_spectrum;
+      ws.inv(ws.spectrum, ws.out);
+      dda::Data<typename Vector<T>::block_type, dda::in> data(ws.out.block());
+      for (; o != count && phase_ + o * dec < s + step; ++o)
+	out[o * out_stride] = data.ptr()[m + phase_ + o * dec - s];
+    }
+
+    if (C == state_save)
+    {
+      std::copy(ext + n, ext + n + m, ext);
+      phase_ = phase_ + count * dec - n;
+    }
+    return count;
+  }
+
+  virtual void reset() VSIP_NOTHROW
+  {
+    phase_ = 0;
+    std::fill(ext_.begin(), ext_.end(), T(0));
+  }
+
+private:
+  void initialize()
+  {
+    length_type const m = this->order_;
+    length_type size = std::min(detail::next_power_of_2(4 * (m + 1)),
+				detail::next_power_of_2(m + this->input_size_));
+    workspace_.reset(new workspace(kernel_, size));
+  }
+
+  length_type phase_;
+  std::vector<T> kernel_;
+  std::vector<T> ext_;
+  std::unique_ptr<workspace> workspace_;
+};
+
+} // namespace ovxx::signal
+
+namespace dispatcher
+{
+template <typename T, symmetry_type S, obj_state C>
+struct Evaluator<op::fir, be::fft_based,
+                 shared_ptr<signal::Fir_backend<T, S, C> >
+                 (aligned_array<T>,
+                  length_type, length_type, length_type,
+                  unsigned, alg_hint_type)>
+{
+  static bool const ct_valid = signal::detail::is_fft_conv_type<T>::value;
+  typedef ovxx::shared_ptr<signal::Fir_backend<T, S, C> > return_type;
+  // Not used with alg_space (see signal::fft_crossover()).
+  static bool rt_valid(aligned_array<T> const &,
+                       length_type ks, length_type, length_type d,
+                       unsigned, alg_hint_type h)
+  {
+    return h != alg_space &&
+      signal::Fir_backend<T, S, C>::order(ks) >= signal::fft_crossover(h) * d;
+  }
+  static return_type exec(aligned_array<T> k, length_type ks,
+                          length_type is, length_type d,
+                          unsigned, alg_hint_type)
+  {
+    return return_type(new signal::Fir_fft<T, S, C>(k, ks, is, d));
+  }
+};
+} // namespace ovxx::dispatcher
+} // namespace ovxx
+
+#endif
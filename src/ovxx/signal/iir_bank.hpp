@@ -0,0 +1,219 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_signal_iir_bank_hpp_
+#define ovxx_signal_iir_bank_hpp_
+
+#include <vsip/support.hpp>
+#include <vsip/impl/signal/types.hpp>
+#include <vsip/matrix.hpp>
+#include <vsip/dda.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <vector>
+#include <algorithm>
+
+namespace ovxx
+{
+namespace signal
+{
+
+/// A bank of IIR filters sharing the same second-order sections.
+///
+/// Each row of the input matrix is an independent channel, filtered
+/// with the same semantics as `vsip::Iir`. Channels are processed in
+/// groups of `width` (64 bytes worth of values), with the state of
+/// each group stored contiguously, so every step of the recurrence
+/// advances a whole group of channels at once. Groups are split across
+/// the default thread pool for large enough problems.
+template <typename T = VSIP_DEFAULT_VALUE_TYPE,
+	  obj_state C = state_save>
+class Iir_bank
+{
+public:
+  /// The number of channels processed together.
+  static length_type const width = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+
+private:
+  struct arguments
+  {
+    T const *in;
+    stride_type in_row, in_col;
+    T *out;
+    stride_type out_row, out_col;
+  };
+
+  // Filter groups [c * groups, (c + 1) * groups), using the c'th
+  // scratch buffer.
+  struct task
+  {
+    Iir_bank *bank;
+    arguments const *args;
+    length_type groups;
+
+    void operator()(index_type c)
+    {
+      index_type const begin = c * groups;
+      bank->apply(*args, begin, std::min(begin + groups, bank->groups()), c);
+    }
+  };
+
+public:
+  static obj_state const continuous_filtering = C;
+
+  template <typename B1, typename B2>
+  Iir_bank(const_Matrix<T, B1> b, const_Matrix<T, B2> a,
+	   length_type channels, length_type input_size)
+    VSIP_THROW((std::bad_alloc))
+  : sections_(a.size(0)),
+    channels_(channels),
+    input_size_(input_size),
+    coeffs_(5 * sections_),
+    state_(2 * sections_ * groups() * width, T()),
+    // One buffer per task (see operator()).
+    buffers_(std::min<length_type>(groups(), thread_pool::get_default()->size())),
+    buffer_(buffers_ * input_size_ * width, T())
+  {
+    OVXX_PRECONDITION(b.size(0) == a.size(0));
+    OVXX_PRECONDITION(b.size(1) == 3);
+    OVXX_PRECONDITION(a.size(1) == 2);
+    OVXX_PRECONDITION(channels_ > 0);
+    OVXX_PRECONDITION(input_size_ > 0);
+
+    for (index_type m = 0; m != sections_; ++m)
+    {
+      coeffs_[5 * m + 0] = b.get(m, 0);
+      coeffs_[5 * m + 1] = b.get(m, 1);
+      coeffs_[5 * m + 2] = b.get(m, 2);
+      coeffs_[5 * m + 3] = a.get(m, 0);
+      coeffs_[5 * m + 4] = a.get(m, 1);
+    }
+  }
+
+  length_type kernel_size()  const VSIP_NOTHROW { return 2 * sections_;}
+  length_type filter_order() const VSIP_NOTHROW { return 2 * sections_;}
+  length_type channels()     const VSIP_NOTHROW { return channels_;}
+  length_type input_size()   const VSIP_NOTHROW { return input_size_;}
+  length_type output_size()  const VSIP_NOTHROW { return input_size_;}
+
+  /// Filter each row of `data` into the same row of `out`.
+  template <typename B1, typename B2>
+  Matrix<T, B2> operator()(const_Matrix<T, B1> data, Matrix<T, B2> out)
+    VSIP_NOTHROW
+  {
+    OVXX_PRECONDITION(data.size(0) == channels_ && data.size(1) == input_size_);
+    OVXX_PRECONDITION(out.size(0) == channels_ && out.size(1) == input_size_);
+
+    typedef typename get_block_layout<B1>::type LP1;
+    typedef typename get_block_layout<B2>::type LP2;
+    typedef typename adjust_layout_storage_format<array, LP1>::type use_LP1;
+    typedef typename adjust_layout_storage_format<array, LP2>::type use_LP2;
+
+    dda::Data<B1, dda::in, use_LP1> data_in(data.block());
+    dda::Data<B2, dda::out, use_LP2> data_out(out.block());
+
+    arguments args =
+    {
+      data_in.ptr(), data_in.stride(0), data_in.stride(1),
+      data_out.ptr(), data_out.stride(0), data_out.stride(1)
+    };
+    // The pool splits the groups into at most buffers_ tasks.
+    if (buffers_ > 1 &&
+	channels_ * input_size_ * sections_ >= thread_pool::threshold())
+    {
+      task t = {this, &args, (groups() + buffers_ - 1) / buffers_};
+      thread_pool *pool = thread_pool::get_default();
+      pool->parallel_for((groups() + t.groups - 1) / t.groups, t);
+    }
+    else
+      apply(args, 0, groups(), 0);
+
+    if (C == state_no_save)
+      this->reset();
+    return out;
+  }
+
+  void reset() VSIP_NOTHROW { std::fill(state_.begin(), state_.end(), T());}
+
+private:
+  length_type groups() const { return (channels_ + width - 1) / width;}
+
+  // Filter the channel groups [begin, end). Samples of a group are
+  // gathered into scratch buffer `b`, with sample i of lane l at
+  // buf[i * width + l], filtered in place, and scattered back.
+  void apply(arguments const &args, index_type begin, index_type end,
+	     index_type b)
+  {
+    T *buf = &buffer_[b * input_size_ * width];
+    for (index_type g = begin; g != end; ++g)
+    {
+      index_type const first = g * width;
+      length_type const lanes = std::min(width, channels_ - first);
+      // Unused lanes (of the last group) are filtered too: keep them zero.
+      if (lanes != width)
+	for (index_type i = 0; i != input_size_; ++i)
+	  std::fill(buf + i * width + lanes, buf + (i + 1) * width, T());
+      for (index_type l = 0; l != lanes; ++l)
+      {
+	T const *in = args.in + (first + l) * args.in_row;
+	for (index_type i = 0; i != input_size_; ++i)
+	  buf[i * width + l] = in[i * args.in_col];
+      }
+      filter(buf, &state_[2 * sections_ * width * g]);
+      for (index_type l = 0; l != lanes; ++l)
+      {
+	T *out = args.out + (first + l) * args.out_row;
+	for (index_type i = 0; i != input_size_; ++i)
+	  out[i * args.out_col] = buf[i * width + l];
+      }
+    }
+  }
+
+  // Run the cascade over one group of channels. The state of section
+  // m is w1 at state[2 * m * width], followed by w2.
+  void filter(T *buf, T *state) const
+  {
+    T const *coeffs = &coeffs_[0];
+    for (index_type i = 0; i != input_size_; ++i)
+    {
+      T *val = buf + i * width;
+      for (index_type m = 0; m != sections_; ++m)
+      {
+	T const b0 = coeffs[5 * m + 0];
+	T const b1 = coeffs[5 * m + 1];
+	T const b2 = coeffs[5 * m + 2];
+	T const a1 = coeffs[5 * m + 3];
+	T const a2 = coeffs[5 * m + 4];
+	T *w1 = state + 2 * m * width;
+	T *w2 = w1 + width;
+	for (index_type l = 0; l != width; ++l)
+	{
+	  T const w0 = val[l] - a1 * w1[l] - a2 * w2[l];
+	  val[l] = b0 * w0 + b1 * w1[l] + b2 * w2[l];
+	  w2[l] = w1[l];
+	  w1[l] = w0;
+	}
+      }
+    }
+  }
+
+  length_type sections_;
+  length_type channels_;
+  length_type input_size_;
+  // b0, b1, b2, a1, a2 for each section.
+  std::vector<T> coeffs_;
+  std::vector<T> state_;
+  length_type buffers_;
+  std::vector<T> buffer_;
+};
+
+template <typename T, obj_state C>
+length_type const Iir_bank<T, C>::width;
+
+} // namespace ovxx::signal
+} // namespace ovxx
+
+#endif
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#include <ovxx/simd/simd.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#include <immintrin.h>
+#include <ovxx/simd/transpose_avx.hpp>
+
+namespace ovxx
+{
+namespace simd
+{
+namespace
+{
+struct avx2_traits : avx_transpose
+{
+  typedef __m256 type;
+  static length_type const size = 8;
+
+  static type load(float const *p) { return _mm256_loadu_ps(p);}
+  static void store(float *p, type v) { _mm256_storeu_ps(p, v);}
+  static type set1(float f) { return _mm256_set1_ps(f);}
+  static type add(type a, type b) { return _mm256_add_ps(a, b);}
+  static type sub(type a, type b) { return _mm256_sub_ps(a, b);}
+  static type mul(type a, type b) { return _mm256_mul_ps(a, b);}
+  static type fma(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c);}
+  static type neg(type a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.f));}
+  static type min(type a, type b) { return _mm256_min_ps(a, b);}
+  static type max(type a, type b) { return _mm256_max_ps(a, b);}
+  // unpack and shuffle work within 128-bit lanes, so the results
+  // need to be reordered.
+  static void zip(float *p, type re, type im)
+  {
+    type lo = _mm256_unpacklo_ps(re, im), hi = _mm256_unpackhi_ps(re, im);
+    _mm256_storeu_ps(p, _mm256_permute2f128_ps(lo, hi, 0x20));
+    _mm256_storeu_ps(p + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+  }
+  static void unzip(float const *p, type &re, type &im)
+  {
+    type a = _mm256_loadu_ps(p), b = _mm256_loadu_ps(p + 8);
+    __m256d r = _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+    __m256d i = _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    re = _mm256_castpd_ps(_mm256_permute4x64_pd(r, 0xd8));
+    im = _mm256_castpd_ps(_mm256_permute4x64_pd(i, 0xd8));
+  }
+
+  typedef __m256d dtype;
+  static length_type const dsize = 4;
+
+  static dtype dload(double const *p) { return _mm256_loadu_pd(p);}
+  static void dstore(double *p, dtype v) { _mm256_storeu_pd(p, v);}
+  static dtype dset1(double d) { return _mm256_set1_pd(d);}
+  static dtype dadd(dtype a, dtype b) { return _mm256_add_pd(a, b);}
+  static dtype dsub(dtype a, dtype b) { return _mm256_sub_pd(a, b);}
+  static dtype dmul(dtype a, dtype b) { return _mm256_mul_pd(a, b);}
+  static dtype dfma(dtype a, dtype b, dtype c) { return _mm256_fmadd_pd(a, b, c);}
+  static void dzip(double *p, dtype re, dtype im)
+  {
+    dtype lo = _mm256_unpacklo_pd(re, im), hi = _mm256_unpackhi_pd(re, im);
+    _mm256_storeu_pd(p, _mm256_permute2f128_pd(lo, hi, 0x20));
+    _mm256_storeu_pd(p + 4, _mm256_permute2f128_pd(lo, hi, 0x31));
+  }
+  static void dunzip(double const *p, dtype &re, dtype &im)
+  {
+    dtype a = _mm256_loadu_pd(p), b = _mm256_loadu_pd(p + 4);
+    re = _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), 0xd8);
+    im = _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), 0xd8);
+  }
+  static type cset(float re, float im)
+  { return _mm256_setr_ps(re, im, re, im, re, im, re, im);}
+  static type conj(type a)
+  {
+    return _mm256_xor_ps(a, _mm256_setr_ps(0.f, -0.f, 0.f, -0.f,
+					   0.f, -0.f, 0.f, -0.f));
+  }
+  static type cmul(type a, type b)
+  {
+    type re = _mm256_moveldup_ps(a);
+    type im = _mm256_movehdup_ps(a);
+    type sw = _mm256_permute_ps(b, 0xb1);
+    return _mm256_fmaddsub_ps(re, b, _mm256_mul_ps(im, sw));
+  }
+  static type hadd_pairs(type a, type b)
+  {
+    // hadd works within 128-bit lanes, so the result needs to be
+    // reordered.
+    __m256d h = _mm256_castps_pd(_mm256_hadd_ps(a, b));
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(h, 0xd8));
+  }
+};
+} // namespace ovxx::simd::<unnamed>
+} // namespace ovxx::simd
+} // namespace ovxx
+
+#include <ovxx/simd/kernels.hpp>
+
+namespace ovxx
+{
+namespace simd
+{
+namespace detail
+{
+extern kernels const avx2_kernels = make_kernels<avx2_traits>(avx2, "avx2");
+} // namespace ovxx::simd::detail
+} // namespace ovxx::simd
+} // namespace ovxx
+
+#pragma GCC pop_options
+
+#endif
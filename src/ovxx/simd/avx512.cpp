@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#include <ovxx/simd/simd.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx2,fma")
+#include <immintrin.h>
+#include <ovxx/simd/transpose_avx.hpp>
+
+namespace ovxx
+{
+namespace simd
+{
+namespace
+{
+struct avx512_traits : avx_transpose
+{
+  typedef __m512 type;
+  static length_type const size = 16;
+
+  static type load(float const *p) { return _mm512_loadu_ps(p);}
+  static void store(float *p, type v) { _mm512_storeu_ps(p, v);}
+  static type set1(float f) { return _mm512_set1_ps(f);}
+  static type add(type a, type b) { return _mm512_add_ps(a, b);}
+  static type sub(type a, type b) { return _mm512_sub_ps(a, b);}
+  static type mul(type a, type b) { return _mm512_mul_ps(a, b);}
+  static type fma(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c);}
+  // AVX-512F has no floating-point xor, so flip sign bits as integers.
+  static type neg(type a)
+  {
+    return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a),
+						_mm512_set1_epi32(0x80000000)));
+  }
+  // The unmasked forms of min, max, and of the shuffles in cmul() pass
+  // an undefined source vector to their masked builtins, which GCC 12
+  // warns about. The zero-masked forms with a full mask compute the same.
+  static type min(type a, type b) { return _mm512_maskz_min_ps(0xffff, a, b);}
+  static type max(type a, type b) { return _mm512_maskz_max_ps(0xffff, a, b);}
+  static void zip(float *p, type re, type im)
+  {
+    __m512i lo = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19,
+				   4, 20, 5, 21, 6, 22, 7, 23);
+    __m512i hi = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27,
+				   12, 28, 13, 29, 14, 30, 15, 31);
+    _mm512_storeu_ps(p, _mm512_permutex2var_ps(re, lo, im));
+    _mm512_storeu_ps(p + 16, _mm512_permutex2var_ps(re, hi, im));
+  }
+  static void unzip(float const *p, type &re, type &im)
+  {
+    __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14,
+				     16, 18, 20, 22, 24, 26, 28, 30);
+    __m512i odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15,
+				    17, 19, 21, 23, 25, 27, 29, 31);
+    type a = _mm512_loadu_ps(p), b = _mm512_loadu_ps(p + 16);
+    re = _mm512_permutex2var_ps(a, even, b);
+    im = _mm512_permutex2var_ps(a, odd, b);
+  }
+
+  typedef __m512d dtype;
+  static length_type const dsize = 8;
+
+  static dtype dload(double const *p) { return _mm512_loadu_pd(p);}
+  static void dstore(double *p, dtype v) { _mm512_storeu_pd(p, v);}
+  static dtype dset1(double d) { return _mm512_set1_pd(d);}
+  static dtype dadd(dtype a, dtype b) { return _mm512_add_pd(a, b);}
+  static dtype dsub(dtype a, dtype b) { return _mm512_sub_pd(a, b);}
+  static dtype dmul(dtype a, dtype b) { return _mm512_mul_pd(a, b);}
+  static dtype dfma(dtype a, dtype b, dtype c) { return _mm512_fmadd_pd(a, b, c);}
+  static void dzip(double *p, dtype re, dtype im)
+  {
+    __m512i lo = _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11);
+    __m512i hi = _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15);
+    _mm512_storeu_pd(p, _mm512_permutex2var_pd(re, lo, im));
+    _mm512_storeu_pd(p + 8, _mm512_permutex2var_pd(re, hi, im));
+  }
+  static void dunzip(double const *p, dtype &re, dtype &im)
+  {
+    __m512i even = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+    __m512i odd = _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15);
+    dtype a = _mm512_loadu_pd(p), b = _mm512_loadu_pd(p + 8);
+    re = _mm512_permutex2var_pd(a, even, b);
+    im = _mm512_permutex2var_pd(a, odd, b);
+  }
+  static type cset(float re, float im) { return _mm512_setr4_ps(re, im, re, im);}
+  static type conj(type a)
+  { return _mm512_mask_mov_ps(a, 0xaaaa, neg(a));}
+  static type cmul(type a, type b)
+  {
+    type re = _mm512_maskz_moveldup_ps(0xffff, a);
+    type im = _mm512_maskz_movehdup_ps(0xffff, a);
+    type sw = _mm512_maskz_permute_ps(0xffff, b, 0xb1);
+    return _mm512_fmaddsub_ps(re, b, _mm512_mul_ps(im, sw));
+  }
+  static type hadd_pairs(type a, type b)
+  {
+    __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14,
+				     16, 18, 20, 22, 24, 26, 28, 30);
+    __m512i odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15,
+				    17, 19, 21, 23, 25, 27, 29, 31);
+    return _mm512_add_ps(_mm512_permutex2var_ps(a, even, b),
+			 _mm512_permutex2var_ps(a, odd, b));
+  }
+};
+} // namespace ovxx::simd::<unnamed>
+} // namespace ovxx::simd
+} // namespace ovxx
+
+#include <ovxx/simd/kernels.hpp>
+
+namespace ovxx
+{
+namespace simd
+{
+namespace detail
+{
+extern kernels const avx512_kernels =
+  make_kernels<avx512_traits>(avx512, "avx512");
+} // namespace ovxx::simd::detail
+} // namespace ovxx::simd
+} // namespace ovxx
+
+#pragma GCC pop_options
+
+#endif
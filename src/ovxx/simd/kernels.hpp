@@ -0,0 +1,846 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_simd_kernels_hpp_
+#define ovxx_simd_kernels_hpp_
+
+// Elementwise kernels, written in terms of a vector traits type V.
+// This file is included by the ISA-specific translation units
+// after they enable the corresponding target options. Everything is
+// defined in an unnamed namespace, so code compiled for one ISA can't be
+// picked up by the linker for another.
+//
+// V provides:
+//
+//   type                  the vector register type
+//   size                  number of floats per register
+//   load(p), store(p, v)  unaligned load and store
+//   set1(f)               broadcast f
+//   add, sub, mul         elementwise arithmetic
+//   fma(a, b, c)          a * b + c
+//   neg(a)                -a
+//   min, max              elementwise minimum and maximum
+//   cset(re, im)          broadcast an interleaved complex value
+//   cmul(a, b)            interleaved complex multiply
+//   conj(a)               interleaved complex conjugate
+//   hadd_pairs(a, b)      sums of adjacent pairs of a, followed by those of b
+//   tile, transpose(a, lda, b, ldb)
+//                         transpose a tile x tile block of floats
+//   tile64, transpose64(a, lda, b, ldb)
+//                         transpose a tile64 x tile64 block of doubles
+//   zip(p, re, im)        store two registers interleaved: p[2i] = re[i],
+//                         p[2i+1] = im[i]
+//   unzip(p, re, im)      the reverse: load 2 * size floats, deinterleaved
+//   dtype, dsize, dload, dstore, dset1, dadd, dsub, dmul, dfma, dzip, dunzip
+//                         the same, for a register of doubles
+
+#include <ovxx/simd/simd.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace ovxx
+{
+namespace simd
+{
+namespace
+{
+
+template <typename V>
+void vmul(float const *a, float const *b, float *r, length_type n)
+{
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+    V::store(r + i, V::mul(V::load(a + i), V::load(b + i)));
+  for (; i < n; ++i)
+    r[i] = a[i] * b[i];
+}
+
+template <typename V>
+void vadd(float const *a, float const *b, float *r, length_type n)
+{
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+    V::store(r + i, V::add(V::load(a + i), V::load(b + i)));
+  for (; i < n; ++i)
+    r[i] = a[i] + b[i];
+}
+
+template <typename V>
+void vma(float const *a, float const *b, float const *c, float *r,
+	 length_type n)
+{
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+    V::store(r + i, V::fma(V::load(a + i), V::load(b + i), V::load(c + i)));
+  for (; i < n; ++i)
+    r[i] = a[i] * b[i] + c[i];
+}
+
+template <typename V>
+void vam(float const *a, float const *b, float const *c, float *r,
+	 length_type n)
+{
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+    V::store(r + i, V::mul(V::add(V::load(a + i), V::load(b + i)),
+			   V::load(c + i)));
+  for (; i < n; ++i)
+    r[i] = (a[i] + b[i]) * c[i];
+}
+
+template <typename V>
+void vmagsq(float const *a, float *r, length_type n)
+{
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+  {
+    typename V::type v = V::load(a + i);
+    V::store(r + i, V::mul(v, v));
+  }
+  for (; i < n; ++i)
+    r[i] = a[i] * a[i];
+}
+
+template <typename V>
+void svmul(float s, float const *b, float *r, length_type n)
+{
+  typename V::type const vs = V::set1(s);
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+    V::store(r + i, V::mul(vs, V::load(b + i)));
+  for (; i < n; ++i)
+    r[i] = s * b[i];
+}
+
+// Scalar complex multiply, used for remainders.
+inline void cmul1(float ar, float ai, float br, float bi, float &rr, float &ri)
+{
+  rr = ar * br - ai * bi;
+  ri = ar * bi + ai * br;
+}
+
+template <typename V>
+void cvmul(float const *a, float const *b, float *r, length_type n)
+{
+  n *= 2;
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+    V::store(r + i, V::cmul(V::load(a + i), V::load(b + i)));
+  for (; i < n; i += 2)
+    cmul1(a[i], a[i+1], b[i], b[i+1], r[i], r[i+1]);
+}
+
+template <typename V>
+void cvma(float const *a, float const *b, float const *c, float *r,
+	  length_type n)
+{
+  n *= 2;
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+    V::store(r + i, V::add(V::cmul(V::load(a + i), V::load(b + i)),
+			   V::load(c + i)));
+  for (; i < n; i += 2)
+  {
+    float rr, ri;
+    cmul1(a[i], a[i+1], b[i], b[i+1], rr, ri);
+    r[i] = rr + c[i];
+    r[i+1] = ri + c[i+1];
+  }
+}
+
+template <typename V>
+void cvam(float const *a, float const *b, float const *c, float *r,
+	  length_type n)
+{
+  n *= 2;
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+    V::store(r + i, V::cmul(V::add(V::load(a + i), V::load(b + i)),
+			    V::load(c + i)));
+  for (; i < n; i += 2)
+    cmul1(a[i] + b[i], a[i+1] + b[i+1], c[i], c[i+1], r[i], r[i+1]);
+}
+
+template <typename V>
+void cvmagsq(float const *a, float *r, length_type n)
+{
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+  {
+    typename V::type v0 = V::load(a + 2*i);
+    typename V::type v1 = V::load(a + 2*i + V::size);
+    V::store(r + i, V::hadd_pairs(V::mul(v0, v0), V::mul(v1, v1)));
+  }
+  for (; i < n; ++i)
+    r[i] = a[2*i] * a[2*i] + a[2*i+1] * a[2*i+1];
+}
+
+template <typename V>
+void cvconj(float const *a, float *r, length_type n)
+{
+  n *= 2;
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+    V::store(r + i, V::conj(V::load(a + i)));
+  for (; i < n; i += 2)
+  {
+    r[i] = a[i];
+    r[i+1] = -a[i+1];
+  }
+}
+
+template <typename V>
+void csvmul(float sr, float si, float const *b, float *r, length_type n)
+{
+  typename V::type const vs = V::cset(sr, si);
+  n *= 2;
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+    V::store(r + i, V::cmul(vs, V::load(b + i)));
+  for (; i < n; i += 2)
+    cmul1(sr, si, b[i], b[i+1], r[i], r[i+1]);
+}
+
+template <typename V>
+void zvmul(float const *ar, float const *ai,
+	   float const *br, float const *bi,
+	   float *rr, float *ri, length_type n)
+{
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+  {
+    typename V::type var = V::load(ar + i), vai = V::load(ai + i);
+    typename V::type vbr = V::load(br + i), vbi = V::load(bi + i);
+    V::store(rr + i, V::fma(var, vbr, V::neg(V::mul(vai, vbi))));
+    V::store(ri + i, V::fma(var, vbi, V::mul(vai, vbr)));
+  }
+  for (; i < n; ++i)
+    cmul1(ar[i], ai[i], br[i], bi[i], rr[i], ri[i]);
+}
+
+template <typename V>
+void zvma(float const *ar, float const *ai,
+	  float const *br, float const *bi,
+	  float const *cr, float const *ci,
+	  float *rr, float *ri, length_type n)
+{
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+  {
+    typename V::type var = V::load(ar + i), vai = V::load(ai + i);
+    typename V::type vbr = V::load(br + i), vbi = V::load(bi + i);
+    typename V::type re = V::fma(var, vbr, V::load(cr + i));
+    typename V::type im = V::fma(var, vbi, V::load(ci + i));
+    V::store(rr + i, V::sub(re, V::mul(vai, vbi)));
+    V::store(ri + i, V::fma(vai, vbr, im));
+  }
+  for (; i < n; ++i)
+  {
+    float re, im;
+    cmul1(ar[i], ai[i], br[i], bi[i], re, im);
+    rr[i] = re + cr[i];
+    ri[i] = im + ci[i];
+  }
+}
+
+template <typename V>
+void zvam(float const *ar, float const *ai,
+	  float const *br, float const *bi,
+	  float const *cr, float const *ci,
+	  float *rr, float *ri, length_type n)
+{
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+  {
+    typename V::type sr = V::add(V::load(ar + i), V::load(br + i));
+    typename V::type si = V::add(V::load(ai + i), V::load(bi + i));
+    typename V::type vcr = V::load(cr + i), vci = V::load(ci + i);
+    V::store(rr + i, V::fma(sr, vcr, V::neg(V::mul(si, vci))));
+    V::store(ri + i, V::fma(sr, vci, V::mul(si, vcr)));
+  }
+  for (; i < n; ++i)
+    cmul1(ar[i] + br[i], ai[i] + bi[i], cr[i], ci[i], rr[i], ri[i]);
+}
+
+template <typename V>
+void zvmagsq(float const *ar, float const *ai, float *r, length_type n)
+{
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+  {
+    typename V::type re = V::load(ar + i), im = V::load(ai + i);
+    V::store(r + i, V::fma(re, re, V::mul(im, im)));
+  }
+  for (; i < n; ++i)
+    r[i] = ar[i] * ar[i] + ai[i] * ai[i];
+}
+
+template <typename V>
+void zvconj(float const *ar, float const *ai, float *rr, float *ri,
+	    length_type n)
+{
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+  {
+    V::store(rr + i, V::load(ar + i));
+    V::store(ri + i, V::neg(V::load(ai + i)));
+  }
+  for (; i < n; ++i)
+  {
+    rr[i] = ar[i];
+    ri[i] = -ai[i];
+  }
+}
+
+template <typename V>
+void zsvmul(float sr, float si, float const *br, float const *bi,
+	    float *rr, float *ri, length_type n)
+{
+  typename V::type const vsr = V::set1(sr), vsi = V::set1(si);
+  index_type i = 0;
+  for (; i + V::size <= n; i += V::size)
+  {
+    typename V::type vbr = V::load(br + i), vbi = V::load(bi + i);
+    V::store(rr + i, V::fma(vsr, vbr, V::neg(V::mul(vsi, vbi))));
+    V::store(ri + i, V::fma(vsr, vbi, V::mul(vsi, vbr)));
+  }
+  for (; i < n; ++i)
+    cmul1(sr, si, br[i], bi[i], rr[i], ri[i]);
+}
+
+template <typename T>
+void transpose_tiles(T const *a, stride_type lda, T *b, stride_type ldb,
+		     length_type rows, length_type cols, length_type tile,
+		     void (*kernel)(T const *, stride_type, T *, stride_type))
+{
+  index_type r = 0;
+  for (; r + tile <= rows; r += tile)
+  {
+    index_type c = 0;
+    for (; c + tile <= cols; c += tile)
+      kernel(a + r * lda + c, lda, b + c * ldb + r, ldb);
+    for (; c < cols; ++c)
+      for (index_type i = r; i != r + tile; ++i)
+	b[c * ldb + i] = a[i * lda + c];
+  }
+  for (; r < rows; ++r)
+    for (index_type c = 0; c != cols; ++c)
+      b[c * ldb + r] = a[r * lda + c];
+}
+
+template <typename V>
+void transpose32(float const *a, stride_type lda, float *b, stride_type ldb,
+		 length_type rows, length_type cols)
+{
+  transpose_tiles(a, lda, b, ldb, rows, cols, V::tile, V::transpose);
+}
+
+template <typename V>
+void transpose64(double const *a, stride_type lda, double *b, stride_type ldb,
+		 length_type rows, length_type cols)
+{
+  transpose_tiles(a, lda, b, ldb, rows, cols, V::tile64, V::transpose64);
+}
+
+// The number of floats summed in single precision before the partial
+// sums are added to the (double precision) result.
+length_type const sum_block = 1024;
+
+template <typename V>
+double hsum(typename V::type v)
+{
+  float t[V::size];
+  V::store(t, v);
+  double sum = 0.;
+  for (index_type i = 0; i != V::size; ++i)
+    sum += t[i];
+  return sum;
+}
+
+// Sum the full vectors in a[i, end) (or their squares), using four
+// independent accumulators. On return, i points past the last
+// vector summed.
+template <typename V, bool Square>
+typename V::type block_sum(float const *a, index_type &i, index_type end)
+{
+  typename V::type s0 = V::set1(0.f), s1 = s0, s2 = s0, s3 = s0;
+  for (; i + 4 * V::size <= end; i += 4 * V::size)
+  {
+    typename V::type v0 = V::load(a + i);
+    typename V::type v1 = V::load(a + i + V::size);
+    typename V::type v2 = V::load(a + i + 2 * V::size);
+    typename V::type v3 = V::load(a + i + 3 * V::size);
+    if (Square)
+    {
+      s0 = V::fma(v0, v0, s0);
+      s1 = V::fma(v1, v1, s1);
+      s2 = V::fma(v2, v2, s2);
+      s3 = V::fma(v3, v3, s3);
+    }
+    else
+    {
+      s0 = V::add(s0, v0);
+      s1 = V::add(s1, v1);
+      s2 = V::add(s2, v2);
+      s3 = V::add(s3, v3);
+    }
+  }
+  for (; i + V::size <= end; i += V::size)
+  {
+    typename V::type v = V::load(a + i);
+    s0 = Square ? V::fma(v, v, s0) : V::add(s0, v);
+  }
+  return V::add(V::add(s0, s1), V::add(s2, s3));
+}
+
+template <typename V, bool Square>
+double vsum(float const *a, length_type n)
+{
+  double sum = 0.;
+  index_type i = 0;
+  while (i + V::size <= n)
+    sum += hsum<V>(block_sum<V, Square>(a, i, std::min(n, i + sum_block)));
+  for (; i < n; ++i)
+    sum += Square ? a[i] * a[i] : a[i];
+  return sum;
+}
+
+template <typename V>
+void cvsum(float const *a, length_type n, double *re, double *im)
+{
+  n *= 2;
+  double r = 0., m = 0.;
+  index_type i = 0;
+  while (i + V::size <= n)
+  {
+    // Even lanes hold real, odd lanes imaginary parts.
+    float t[V::size];
+    V::store(t, block_sum<V, false>(a, i, std::min(n, i + sum_block)));
+    for (index_type l = 0; l != V::size; l += 2)
+    {
+      r += t[l];
+      m += t[l + 1];
+    }
+  }
+  for (; i < n; i += 2)
+  {
+    r += a[i];
+    m += a[i + 1];
+  }
+  *re = r;
+  *im = m;
+}
+
+template <typename V>
+void vstats(float const *a, length_type n, stats *s)
+{
+  stats r = {0., 0., a[0], a[0], 0, 0};
+  for (index_type b = 0; b < n; b += sum_block)
+  {
+    index_type const end = std::min(n, b + sum_block);
+    index_type i = b;
+    float lo = a[b], hi = a[b];
+    if (i + V::size <= end)
+    {
+      typename V::type sum = V::set1(0.f), sumsq = sum;
+      typename V::type vlo = V::load(a + i), vhi = vlo;
+      for (; i + V::size <= end; i += V::size)
+      {
+	typename V::type v = V::load(a + i);
+	sum = V::add(sum, v);
+	sumsq = V::fma(v, v, sumsq);
+	vlo = V::min(vlo, v);
+	vhi = V::max(vhi, v);
+      }
+      r.sum += hsum<V>(sum);
+      r.sumsq += hsum<V>(sumsq);
+      float tlo[V::size], thi[V::size];
+      V::store(tlo, vlo);
+      V::store(thi, vhi);
+      for (index_type l = 0; l != V::size; ++l)
+      {
+	lo = std::min(lo, tlo[l]);
+	hi = std::max(hi, thi[l]);
+      }
+    }
+    for (; i < end; ++i)
+    {
+      r.sum += a[i];
+      r.sumsq += a[i] * a[i];
+      lo = std::min(lo, a[i]);
+      hi = std::max(hi, a[i]);
+    }
+    // The block is still in cache, so locating the extrema is cheap.
+    if (lo < r.min)
+    {
+      r.min = lo;
+      r.min_idx = std::find(a + b, a + end, lo) - a;
+    }
+    if (hi > r.max)
+    {
+      r.max = hi;
+      r.max_idx = std::find(a + b, a + end, hi) - a;
+    }
+  }
+  *s = r;
+}
+
+// The float and double registers of V, behind a common interface.
+template <typename V>
+struct single_lanes
+{
+  typedef float value_type;
+  typedef typename V::type type;
+  static length_type const size = V::size;
+  static type load(float const *p) { return V::load(p);}
+  static void store(float *p, type const &v) { V::store(p, v);}
+  static type set1(float f) { return V::set1(f);}
+  static type add(type const &a, type const &b) { return V::add(a, b);}
+  static type sub(type const &a, type const &b) { return V::sub(a, b);}
+  static type mul(type const &a, type const &b) { return V::mul(a, b);}
+  static type fma(type const &a, type const &b, type const &c)
+  { return V::fma(a, b, c);}
+  static void zip(float *p, type const &re, type const &im)
+  { V::zip(p, re, im);}
+  static void unzip(float const *p, type &re, type &im)
+  { V::unzip(p, re, im);}
+};
+
+template <typename V>
+struct double_lanes
+{
+  typedef double value_type;
+  typedef typename V::dtype type;
+  static length_type const size = V::dsize;
+  static type load(double const *p) { return V::dload(p);}
+  static void store(double *p, type const &v) { V::dstore(p, v);}
+  static type set1(double d) { return V::dset1(d);}
+  static type add(type const &a, type const &b) { return V::dadd(a, b);}
+  static type sub(type const &a, type const &b) { return V::dsub(a, b);}
+  static type mul(type const &a, type const &b) { return V::dmul(a, b);}
+  static type fma(type const &a, type const &b, type const &c)
+  { return V::dfma(a, b, c);}
+  static void zip(double *p, type const &re, type const &im)
+  { V::dzip(p, re, im);}
+  static void unzip(double const *p, type &re, type &im)
+  { V::dunzip(p, re, im);}
+};
+
+// Single values, used for the remainders of vectorized loops.
+template <typename T>
+struct scalar_lanes
+{
+  typedef T value_type;
+  typedef T type;
+  static length_type const size = 1;
+  static type load(T const *p) { return *p;}
+  static void store(T *p, type v) { *p = v;}
+  static type set1(T v) { return v;}
+  static type add(type a, type b) { return a + b;}
+  static type sub(type a, type b) { return a - b;}
+  static type mul(type a, type b) { return a * b;}
+  static type fma(type a, type b, type c) { return a * b + c;}
+  static void zip(T *p, type re, type im) { p[0] = re; p[1] = im;}
+  static void unzip(T const *p, type &re, type &im) { re = p[0]; im = p[1];}
+};
+
+// Split to interleaved complex: c[2i] = re[i], c[2i+1] = im[i].
+template <typename L>
+void interleave(typename L::value_type const *re,
+		typename L::value_type const *im,
+		typename L::value_type *c, length_type n)
+{
+  typedef scalar_lanes<typename L::value_type> S;
+  index_type i = 0;
+  for (; i + L::size <= n; i += L::size)
+    L::zip(c + 2 * i, L::load(re + i), L::load(im + i));
+  for (; i < n; ++i)
+    S::zip(c + 2 * i, re[i], im[i]);
+}
+
+// Interleaved to split complex.
+template <typename L>
+void deinterleave(typename L::value_type const *c,
+		  typename L::value_type *re,
+		  typename L::value_type *im, length_type n)
+{
+  typedef scalar_lanes<typename L::value_type> S;
+  index_type i = 0;
+  for (; i + L::size <= n; i += L::size)
+  {
+    typename L::type r, j;
+    L::unzip(c + 2 * i, r, j);
+    L::store(re + i, r);
+    L::store(im + i, j);
+  }
+  for (; i < n; ++i)
+    S::unzip(c + 2 * i, re[i], im[i]);
+}
+
+// The GEMM micro-kernel: c = a * b, with a a packed k x gemm_mr panel
+// (stored column by column), b a packed k x nr panel (stored row by
+// row, nr being two registers wide), and c a row-major gemm_mr x nr tile.
+// The tile is held in twelve registers, updated with one rank-1
+// product per step.
+template <typename L>
+void gemm(length_type k, typename L::value_type const *a,
+	  typename L::value_type const *b, typename L::value_type *c)
+{
+  typedef typename L::type type;
+  length_type const n = L::size;
+  type const zero = L::set1(0);
+  type c00 = zero, c01 = zero, c10 = zero, c11 = zero;
+  type c20 = zero, c21 = zero, c30 = zero, c31 = zero;
+  type c40 = zero, c41 = zero, c50 = zero, c51 = zero;
+  for (index_type p = 0; p != k; ++p, a += gemm_mr, b += 2 * n)
+  {
+    type const b0 = L::load(b);
+    type const b1 = L::load(b + n);
+    type a0 = L::set1(a[0]);
+    c00 = L::fma(a0, b0, c00);
+    c01 = L::fma(a0, b1, c01);
+    a0 = L::set1(a[1]);
+    c10 = L::fma(a0, b0, c10);
+    c11 = L::fma(a0, b1, c11);
+    a0 = L::set1(a[2]);
+    c20 = L::fma(a0, b0, c20);
+    c21 = L::fma(a0, b1, c21);
+    a0 = L::set1(a[3]);
+    c30 = L::fma(a0, b0, c30);
+    c31 = L::fma(a0, b1, c31);
+    a0 = L::set1(a[4]);
+    c40 = L::fma(a0, b0, c40);
+    c41 = L::fma(a0, b1, c41);
+    a0 = L::set1(a[5]);
+    c50 = L::fma(a0, b0, c50);
+    c51 = L::fma(a0, b1, c51);
+  }
+  L::store(c, c00);
+  L::store(c + n, c01);
+  L::store(c + 2 * n, c10);
+  L::store(c + 3 * n, c11);
+  L::store(c + 4 * n, c20);
+  L::store(c + 5 * n, c21);
+  L::store(c + 6 * n, c30);
+  L::store(c + 7 * n, c31);
+  L::store(c + 8 * n, c40);
+  L::store(c + 9 * n, c41);
+  L::store(c + 10 * n, c50);
+  L::store(c + 11 * n, c51);
+}
+
+// FFT butterflies of radix R, operating on L-wide slices of split
+// complex data. `w` holds the twiddle factors (w[0] is unused), `c` the
+// radix-specific constants set up by `fft` below.
+template <typename L, length_type R> struct butterfly;
+
+template <typename L>
+struct butterfly<L, 2>
+{
+  typedef typename L::value_type T;
+  typedef typename L::type type;
+  static void apply(T const *xr, T const *xi, T *yr, T *yi,
+		    length_type m, stride_type os,
+		    type const *wr, type const *wi, type const *)
+  {
+    type ar = L::load(xr), ai = L::load(xi);
+    type br = L::load(xr + m), bi = L::load(xi + m);
+    type tr = L::sub(L::mul(br, wr[1]), L::mul(bi, wi[1]));
+    type ti = L::fma(br, wi[1], L::mul(bi, wr[1]));
+    L::store(yr, L::add(ar, tr));
+    L::store(yi, L::add(ai, ti));
+    L::store(yr + os, L::sub(ar, tr));
+    L::store(yi + os, L::sub(ai, ti));
+  }
+};
+
+template <typename L>
+struct butterfly<L, 3>
+{
+  typedef typename L::value_type T;
+  typedef typename L::type type;
+  // c[0] = -1/2, c[1] = e * sin(2pi/3)
+  static void apply(T const *xr, T const *xi, T *yr, T *yi,
+		    length_type m, stride_type os,
+		    type const *wr, type const *wi, type const *c)
+  {
+    type ar[3], ai[3];
+    ar[0] = L::load(xr);
+    ai[0] = L::load(xi);
+    for (length_type q = 1; q != 3; ++q)
+    {
+      type r = L::load(xr + q * m), i = L::load(xi + q * m);
+      ar[q] = L::sub(L::mul(r, wr[q]), L::mul(i, wi[q]));
+      ai[q] = L::fma(r, wi[q], L::mul(i, wr[q]));
+    }
+    type sr = L::add(ar[1], ar[2]), si = L::add(ai[1], ai[2]);
+    type dr = L::mul(c[1], L::sub(ar[1], ar[2]));
+    type di = L::mul(c[1], L::sub(ai[1], ai[2]));
+    type hr = L::fma(c[0], sr, ar[0]), hi = L::fma(c[0], si, ai[0]);
+    L::store(yr, L::add(ar[0], sr));
+    L::store(yi, L::add(ai[0], si));
+    L::store(yr + os, L::sub(hr, di));
+    L::store(yi + os, L::add(hi, dr));
+    L::store(yr + 2 * os, L::add(hr, di));
+    L::store(yi + 2 * os, L::sub(hi, dr));
+  }
+};
+
+template <typename L>
+struct butterfly<L, 4>
+{
+  typedef typename L::value_type T;
+  typedef typename L::type type;
+  // c[0] = e
+  static void apply(T const *xr, T const *xi, T *yr, T *yi,
+		    length_type m, stride_type os,
+		    type const *wr, type const *wi, type const *c)
+  {
+    type ar[4], ai[4];
+    ar[0] = L::load(xr);
+    ai[0] = L::load(xi);
+    for (length_type q = 1; q != 4; ++q)
+    {
+      type r = L::load(xr + q * m), i = L::load(xi + q * m);
+      ar[q] = L::sub(L::mul(r, wr[q]), L::mul(i, wi[q]));
+      ai[q] = L::fma(r, wi[q], L::mul(i, wr[q]));
+    }
+    type s0r = L::add(ar[0], ar[2]), s0i = L::add(ai[0], ai[2]);
+    type d0r = L::sub(ar[0], ar[2]), d0i = L::sub(ai[0], ai[2]);
+    type s1r = L::add(ar[1], ar[3]), s1i = L::add(ai[1], ai[3]);
+    // (d1r, d1i) = e * i * (a1 - a3)
+    type d1i = L::mul(c[0], L::sub(ar[1], ar[3]));
+    type d1r = L::mul(c[0], L::sub(ai[3], ai[1]));
+    L::store(yr, L::add(s0r, s1r));
+    L::store(yi, L::add(s0i, s1i));
+    L::store(yr + os, L::add(d0r, d1r));
+    L::store(yi + os, L::add(d0i, d1i));
+    L::store(yr + 2 * os, L::sub(s0r, s1r));
+    L::store(yi + 2 * os, L::sub(s0i, s1i));
+    L::store(yr + 3 * os, L::sub(d0r, d1r));
+    L::store(yi + 3 * os, L::sub(d0i, d1i));
+  }
+};
+
+template <typename L>
+struct butterfly<L, 5>
+{
+  typedef typename L::value_type T;
+  typedef typename L::type type;
+  // c[0] = cos(2pi/5), c[1] = cos(4pi/5),
+  // c[2] = e * sin(2pi/5), c[3] = e * sin(4pi/5)
+  static void apply(T const *xr, T const *xi, T *yr, T *yi,
+		    length_type m, stride_type os,
+		    type const *wr, type const *wi, type const *c)
+  {
+    type ar[5], ai[5];
+    ar[0] = L::load(xr);
+    ai[0] = L::load(xi);
+    for (length_type q = 1; q != 5; ++q)
+    {
+      type r = L::load(xr + q * m), i = L::load(xi + q * m);
+      ar[q] = L::sub(L::mul(r, wr[q]), L::mul(i, wi[q]));
+      ai[q] = L::fma(r, wi[q], L::mul(i, wr[q]));
+    }
+    type b1r = L::add(ar[1], ar[4]), b1i = L::add(ai[1], ai[4]);
+    type b2r = L::add(ar[2], ar[3]), b2i = L::add(ai[2], ai[3]);
+    type d1r = L::sub(ar[1], ar[4]), d1i = L::sub(ai[1], ai[4]);
+    type d2r = L::sub(ar[2], ar[3]), d2i = L::sub(ai[2], ai[3]);
+    type r1r = L::fma(c[0], b1r, L::fma(c[1], b2r, ar[0]));
+    type r1i = L::fma(c[0], b1i, L::fma(c[1], b2i, ai[0]));
+    type r2r = L::fma(c[1], b1r, L::fma(c[0], b2r, ar[0]));
+    type r2i = L::fma(c[1], b1i, L::fma(c[0], b2i, ai[0]));
+    type i1r = L::fma(c[2], d1r, L::mul(c[3], d2r));
+    type i1i = L::fma(c[2], d1i, L::mul(c[3], d2i));
+    type i2r = L::sub(L::mul(c[3], d1r), L::mul(c[2], d2r));
+    type i2i = L::sub(L::mul(c[3], d1i), L::mul(c[2], d2i));
+    L::store(yr, L::add(ar[0], L::add(b1r, b2r)));
+    L::store(yi, L::add(ai[0], L::add(b1i, b2i)));
+    L::store(yr + os, L::sub(r1r, i1i));
+    L::store(yi + os, L::add(r1i, i1r));
+    L::store(yr + 2 * os, L::sub(r2r, i2i));
+    L::store(yi + 2 * os, L::add(r2i, i2r));
+    L::store(yr + 3 * os, L::add(r2r, i2i));
+    L::store(yi + 3 * os, L::sub(r2i, i2r));
+    L::store(yr + 4 * os, L::add(r1r, i1i));
+    L::store(yi + 4 * os, L::sub(r1i, i1r));
+  }
+};
+
+template <typename L, length_type R>
+void fft_column(typename L::value_type const *xr,
+		typename L::value_type const *xi,
+		typename L::value_type *yr, typename L::value_type *yi,
+		length_type m, stride_type os,
+		typename L::value_type const *w, int e)
+{
+  typedef typename L::value_type T;
+  typedef scalar_lanes<T> S;
+  double const pi = 3.14159265358979323846;
+  T const c[4] =
+  {
+    T(R == 3 ? -0.5 : R == 4 ? e : std::cos(2 * pi / 5)),
+    T(R == 3 ? e * std::sin(2 * pi / 3) : std::cos(4 * pi / 5)),
+    T(e * std::sin(2 * pi / 5)),
+    T(e * std::sin(4 * pi / 5))
+  };
+  typename L::type vwr[R], vwi[R], vc[4];
+  T swr[R], swi[R];
+  for (length_type q = 1; q != R; ++q)
+  {
+    swr[q] = w[2 * q - 2];
+    swi[q] = w[2 * q - 1];
+    vwr[q] = L::set1(swr[q]);
+    vwi[q] = L::set1(swi[q]);
+  }
+  for (length_type i = 0; i != 4; ++i) vc[i] = L::set1(c[i]);
+  index_type t = 0;
+  for (; t + L::size <= m; t += L::size)
+    butterfly<L, R>::apply(xr + t, xi + t, yr + t, yi + t, m, os, vwr, vwi, vc);
+  for (; t != m; ++t)
+    butterfly<S, R>::apply(xr + t, xi + t, yr + t, yi + t, m, os, swr, swi, c);
+}
+
+template <typename L>
+void fft(length_type radix,
+	 typename L::value_type const *xr, typename L::value_type const *xi,
+	 typename L::value_type *yr, typename L::value_type *yi,
+	 length_type m, stride_type os, typename L::value_type const *w, int e)
+{
+  switch (radix)
+  {
+    case 2: fft_column<L, 2>(xr, xi, yr, yi, m, os, w, e); break;
+    case 3: fft_column<L, 3>(xr, xi, yr, yi, m, os, w, e); break;
+    case 4: fft_column<L, 4>(xr, xi, yr, yi, m, os, w, e); break;
+    case 5: fft_column<L, 5>(xr, xi, yr, yi, m, os, w, e); break;
+  }
+}
+
+template <typename V>
+kernels make_kernels(isa_type isa, char const *name)
+{
+  kernels k =
+  {
+    isa, name,
+    vmul<V>, vadd<V>, vma<V>, vam<V>, vmagsq<V>, svmul<V>,
+    cvmul<V>, cvma<V>, cvam<V>, cvmagsq<V>, cvconj<V>, csvmul<V>,
+    zvmul<V>, zvma<V>, zvam<V>, zvmagsq<V>, zvconj<V>, zsvmul<V>,
+    transpose32<V>, transpose64<V>,
+    vsum<V, false>, vsum<V, true>, cvsum<V>, vstats<V>,
+    2 * V::size, gemm<single_lanes<V> >, 2 * V::dsize, gemm<double_lanes<V> >,
+    fft<single_lanes<V> >, fft<double_lanes<V> >,
+    interleave<single_lanes<V> >, deinterleave<single_lanes<V> >,
+    interleave<double_lanes<V> >, deinterleave<double_lanes<V> >
+  };
+  return k;
+}
+
+} // namespace ovxx::simd::<unnamed>
+} // namespace ovxx::simd
+} // namespace ovxx
+
+#endif
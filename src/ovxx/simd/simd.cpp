@@ -0,0 +1,220 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#include <ovxx/simd/simd.hpp>
+#include <cstdlib>
+#include <cstring>
+
+namespace ovxx
+{
+namespace simd
+{
+namespace
+{
+// Portable fallback: a 'register' of four floats, operated on with
+// plain loops the compiler is free to vectorize for the baseline ISA.
+struct generic_traits
+{
+  struct type { float v[4];};
+  static length_type const size = 4;
+
+  static type load(float const *p)
+  { type r; for (int i = 0; i != 4; ++i) r.v[i] = p[i]; return r;}
+  static void store(float *p, type const &a)
+  { for (int i = 0; i != 4; ++i) p[i] = a.v[i];}
+  static type set1(float f)
+  { type r; for (int i = 0; i != 4; ++i) r.v[i] = f; return r;}
+  static type add(type const &a, type const &b)
+  { type r; for (int i = 0; i != 4; ++i) r.v[i] = a.v[i] + b.v[i]; return r;}
+  static type sub(type const &a, type const &b)
+  { type r; for (int i = 0; i != 4; ++i) r.v[i] = a.v[i] - b.v[i]; return r;}
+  static type mul(type const &a, type const &b)
+  { type r; for (int i = 0; i != 4; ++i) r.v[i] = a.v[i] * b.v[i]; return r;}
+  static type fma(type const &a, type const &b, type const &c)
+  {
+    type r;
+    for (int i = 0; i != 4; ++i) r.v[i] = a.v[i] * b.v[i] + c.v[i];
+    return r;
+  }
+  static type neg(type const &a)
+  { type r; for (int i = 0; i != 4; ++i) r.v[i] = -a.v[i]; return r;}
+  static type min(type const &a, type const &b)
+  {
+    type r;
+    for (int i = 0; i != 4; ++i) r.v[i] = b.v[i] < a.v[i] ? b.v[i] : a.v[i];
+    return r;
+  }
+  static type max(type const &a, type const &b)
+  {
+    type r;
+    for (int i = 0; i != 4; ++i) r.v[i] = b.v[i] > a.v[i] ? b.v[i] : a.v[i];
+    return r;
+  }
+  static void zip(float *p, type const &re, type const &im)
+  {
+    for (int i = 0; i != 4; ++i)
+    {
+      p[2 * i] = re.v[i];
+      p[2 * i + 1] = im.v[i];
+    }
+  }
+  static void unzip(float const *p, type &re, type &im)
+  {
+    for (int i = 0; i != 4; ++i)
+    {
+      re.v[i] = p[2 * i];
+      im.v[i] = p[2 * i + 1];
+    }
+  }
+
+  struct dtype { double v[2];};
+  static length_type const dsize = 2;
+
+  static dtype dload(double const *p) { dtype r = {{p[0], p[1]}}; return r;}
+  static void dstore(double *p, dtype const &a) { p[0] = a.v[0]; p[1] = a.v[1];}
+  static dtype dset1(double d) { dtype r = {{d, d}}; return r;}
+  static dtype dadd(dtype const &a, dtype const &b)
+  { dtype r = {{a.v[0] + b.v[0], a.v[1] + b.v[1]}}; return r;}
+  static dtype dsub(dtype const &a, dtype const &b)
+  { dtype r = {{a.v[0] - b.v[0], a.v[1] - b.v[1]}}; return r;}
+  static dtype dmul(dtype const &a, dtype const &b)
+  { dtype r = {{a.v[0] * b.v[0], a.v[1] * b.v[1]}}; return r;}
+  static dtype dfma(dtype const &a, dtype const &b, dtype const &c)
+  {
+    dtype r = {{a.v[0] * b.v[0] + c.v[0], a.v[1] * b.v[1] + c.v[1]}};
+    return r;
+  }
+  static void dzip(double *p, dtype const &re, dtype const &im)
+  {
+    p[0] = re.v[0];
+    p[1] = im.v[0];
+    p[2] = re.v[1];
+    p[3] = im.v[1];
+  }
+  static void dunzip(double const *p, dtype &re, dtype &im)
+  {
+    dtype r = {{p[0], p[2]}}, i = {{p[1], p[3]}};
+    re = r;
+    im = i;
+  }
+  static type cset(float re, float im)
+  { type r = {{re, im, re, im}}; return r;}
+  static type conj(type const &a)
+  { type r = {{a.v[0], -a.v[1], a.v[2], -a.v[3]}}; return r;}
+  static type cmul(type const &a, type const &b)
+  {
+    type r;
+    for (int i = 0; i != 4; i += 2)
+    {
+      r.v[i] = a.v[i] * b.v[i] - a.v[i+1] * b.v[i+1];
+      r.v[i+1] = a.v[i] * b.v[i+1] + a.v[i+1] * b.v[i];
+    }
+    return r;
+  }
+  static type hadd_pairs(type const &a, type const &b)
+  {
+    type r = {{a.v[0] + a.v[1], a.v[2] + a.v[3],
+	       b.v[0] + b.v[1], b.v[2] + b.v[3]}};
+    return r;
+  }
+
+  static length_type const tile = 4;
+  static void transpose(float const *a, stride_type lda,
+			float *b, stride_type ldb)
+  {
+    float t[4][4];
+    for (int i = 0; i != 4; ++i)
+      for (int j = 0; j != 4; ++j)
+	t[j][i] = a[i * lda + j];
+    for (int j = 0; j != 4; ++j)
+      for (int i = 0; i != 4; ++i)
+	b[j * ldb + i] = t[j][i];
+  }
+  static length_type const tile64 = 2;
+  static void transpose64(double const *a, stride_type lda,
+			  double *b, stride_type ldb)
+  {
+    double a01 = a[1], a10 = a[lda];
+    b[0] = a[0];
+    b[1] = a10;
+    b[ldb] = a01;
+    b[ldb + 1] = a[lda + 1];
+  }
+};
+} // namespace ovxx::simd::<unnamed>
+} // namespace ovxx::simd
+} // namespace ovxx
+
+#include <ovxx/simd/kernels.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define OVXX_SIMD_X86 1
+#endif
+
+namespace ovxx
+{
+namespace simd
+{
+namespace detail
+{
+kernels const generic_kernels =
+  make_kernels<generic_traits>(generic, "generic");
+#if OVXX_SIMD_X86
+extern kernels const sse2_kernels;
+extern kernels const avx2_kernels;
+extern kernels const avx512_kernels;
+#endif
+
+kernels const *active = &generic_kernels;
+} // namespace ovxx::simd::detail
+
+kernels const *get_kernels(isa_type isa)
+{
+  switch (isa)
+  {
+    case generic:
+      return &detail::generic_kernels;
+#if OVXX_SIMD_X86
+    case sse2:
+      return __builtin_cpu_supports("sse2") ? &detail::sse2_kernels : 0;
+    case avx2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") ?
+	&detail::avx2_kernels : 0;
+    case avx512:
+      return __builtin_cpu_supports("avx512f") &&
+	__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") ?
+	&detail::avx512_kernels : 0;
+#endif
+    default:
+      return 0;
+  }
+}
+
+void initialize()
+{
+#if OVXX_SIMD_X86
+  __builtin_cpu_init();
+#endif
+  isa_type max = avx512;
+#if HAVE_GETENV
+  if (char const *isa = std::getenv("OVXX_SIMD"))
+  {
+    if (!std::strcmp(isa, "generic")) max = generic;
+    else if (!std::strcmp(isa, "sse2")) max = sse2;
+    else if (!std::strcmp(isa, "avx2")) max = avx2;
+  }
+#endif
+  for (int i = max; i >= generic; --i)
+    if (kernels const *k = get_kernels(static_cast<isa_type>(i)))
+    {
+      detail::active = k;
+      break;
+    }
+}
+
+} // namespace ovxx::simd
+} // namespace ovxx
@@ -0,0 +1,292 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_simd_simd_hpp_
+#define ovxx_simd_simd_hpp_
+
+#include <ovxx/support.hpp>
+#include <ovxx/layout.hpp>
+#include <ovxx/c++11.hpp>
+#include <utility>
+
+namespace ovxx
+{
+namespace simd
+{
+
+/// Instruction set extensions the elementwise kernels are built for.
+enum isa_type
+{
+  generic = 0,
+  sse2,
+  avx2,
+  avx512
+};
+
+/// Statistics of an array of floats, as computed by kernels::vstats.
+/// `min_idx` and `max_idx` refer to the first occurrence of the extrema.
+struct stats
+{
+  double sum;
+  double sumsq;
+  float min;
+  float max;
+  index_type min_idx;
+  index_type max_idx;
+};
+
+/// The number of rows of the GEMM micro-kernels' output tiles.
+length_type const gemm_mr = 6;
+
+/// A table of elementwise kernels, all built for one instruction set.
+///
+/// Kernels prefixed with 'c' operate on interleaved complex data,
+/// kernels prefixed with 'z' on split complex data. Sizes are given in
+/// (real or complex) elements.
+struct kernels
+{
+  isa_type isa;
+  char const *name;
+
+  void (*vmul)(float const *a, float const *b, float *r, length_type n);
+  void (*vadd)(float const *a, float const *b, float *r, length_type n);
+  void (*vma)(float const *a, float const *b, float const *c, float *r,
+	      length_type n);
+  void (*vam)(float const *a, float const *b, float const *c, float *r,
+	      length_type n);
+  void (*vmagsq)(float const *a, float *r, length_type n);
+  void (*svmul)(float s, float const *b, float *r, length_type n);
+
+  void (*cvmul)(float const *a, float const *b, float *r, length_type n);
+  void (*cvma)(float const *a, float const *b, float const *c, float *r,
+	       length_type n);
+  void (*cvam)(float const *a, float const *b, float const *c, float *r,
+	       length_type n);
+  void (*cvmagsq)(float const *a, float *r, length_type n);
+  void (*cvconj)(float const *a, float *r, length_type n);
+  void (*csvmul)(float sr, float si, float const *b, float *r, length_type n);
+
+  void (*zvmul)(float const *ar, float const *ai,
+		float const *br, float const *bi,
+		float *rr, float *ri, length_type n);
+  void (*zvma)(float const *ar, float const *ai,
+	       float const *br, float const *bi,
+	       float const *cr, float const *ci,
+	       float *rr, float *ri, length_type n);
+  void (*zvam)(float const *ar, float const *ai,
+	       float const *br, float const *bi,
+	       float const *cr, float const *ci,
+	       float *rr, float *ri, length_type n);
+  void (*zvmagsq)(float const *ar, float const *ai, float *r, length_type n);
+  void (*zvconj)(float const *ar, float const *ai,
+		 float *rr, float *ri, length_type n);
+  void (*zsvmul)(float sr, float si, float const *br, float const *bi,
+		 float *rr, float *ri, length_type n);
+
+  /// Transpose the `rows` x `cols` matrix `a` into `b`, i.e.
+  /// b[c * ldb + r] = a[r * lda + c], for 32-bit and 64-bit elements.
+  void (*transpose32)(float const *a, stride_type lda,
+		      float *b, stride_type ldb,
+		      length_type rows, length_type cols);
+  void (*transpose64)(double const *a, stride_type lda,
+		      double *b, stride_type ldb,
+		      length_type rows, length_type cols);
+
+  /// Reductions. Partial sums are formed in single precision over
+  /// short blocks, using several independent accumulators, and then
+  /// added up in double precision.
+  double (*vsum)(float const *a, length_type n);
+  double (*vsumsq)(float const *a, length_type n);
+  void (*cvsum)(float const *a, length_type n, double *re, double *im);
+  /// Compute all of `stats` in a single pass. Requires n > 0.
+  void (*vstats)(float const *a, length_type n, stats *s);
+
+  /// GEMM micro-kernels: c = a * b, for a `k` x gemm_mr panel `a`
+  /// (packed column by column), a `k` x nr panel `b` (packed row by
+  /// row), and a row-major gemm_mr x nr tile `c`, where nr is
+  /// `sgemm_nr` or `dgemm_nr`.
+  length_type sgemm_nr;
+  void (*sgemm)(length_type k, float const *a, float const *b, float *c);
+  length_type dgemm_nr;
+  void (*dgemm)(length_type k, double const *a, double const *b, double *c);
+
+  /// Split-complex FFT butterflies for one twiddle column of a Stockham
+  /// stage of radix 2, 3, 4, or 5: for t < m, the inputs x_q[t] =
+  /// x[q * m + t] are scaled by the twiddle factors w_q = (w[2q - 2],
+  /// w[2q - 1]) (q > 0), and combined into y_s[t] = y[s * os + t] using
+  /// the radix-th roots of unity exp(e * 2pi i / radix).
+  void (*sfft)(length_type radix, float const *xr, float const *xi,
+	       float *yr, float *yi, length_type m, stride_type os,
+	       float const *w, int e);
+  void (*dfft)(length_type radix, double const *xr, double const *xi,
+	       double *yr, double *yi, length_type m, stride_type os,
+	       double const *w, int e);
+
+  /// Conversion between split and interleaved complex arrays of `n`
+  /// elements: c[2i] = re[i], c[2i+1] = im[i].
+  void (*interleave)(float const *re, float const *im, float *c,
+		     length_type n);
+  void (*deinterleave)(float const *c, float *re, float *im, length_type n);
+  void (*dinterleave)(double const *re, double const *im, double *c,
+		      length_type n);
+  void (*ddeinterleave)(double const *c, double *re, double *im,
+			length_type n);
+};
+
+/// Select the kernels for the best instruction set supported by the
+/// host CPU. The choice may be restricted with the OVXX_SIMD environment
+/// variable (one of 'generic', 'sse2', 'avx2', 'avx512').
+void initialize();
+
+/// Return the kernels for the given instruction set, or 0 if they aren't
+/// supported by this build or the host CPU.
+kernels const *get_kernels(isa_type);
+
+namespace detail
+{
+extern kernels const *active;
+}
+
+/// Return the active kernels.
+inline kernels const &get_kernels() { return *detail::active;}
+
+/// Elementwise operations on arrays of T in storage format F.
+template <typename T, storage_format_type F> struct ops;
+
+template <>
+struct ops<float, array>
+{
+  typedef float const *in_type;
+  typedef float *out_type;
+
+  static void vmul(in_type a, in_type b, out_type r, length_type n)
+  { get_kernels().vmul(a, b, r, n);}
+  static void vadd(in_type a, in_type b, out_type r, length_type n)
+  { get_kernels().vadd(a, b, r, n);}
+  static void vma(in_type a, in_type b, in_type c, out_type r, length_type n)
+  { get_kernels().vma(a, b, c, r, n);}
+  static void vam(in_type a, in_type b, in_type c, out_type r, length_type n)
+  { get_kernels().vam(a, b, c, r, n);}
+  static void vmagsq(in_type a, float *r, length_type n)
+  { get_kernels().vmagsq(a, r, n);}
+  static void svmul(float s, in_type b, out_type r, length_type n)
+  { get_kernels().svmul(s, b, r, n);}
+  static in_type offset(in_type p, index_type i) { return p + i;}
+  static out_type offset(out_type p, index_type i) { return p + i;}
+};
+
+template <>
+struct ops<complex<float>, interleaved_complex>
+{
+  typedef float const *in_type;
+  typedef float *out_type;
+
+  static void vmul(in_type a, in_type b, out_type r, length_type n)
+  { get_kernels().cvmul(a, b, r, n);}
+  static void vadd(in_type a, in_type b, out_type r, length_type n)
+  { get_kernels().vadd(a, b, r, 2*n);}
+  static void vma(in_type a, in_type b, in_type c, out_type r, length_type n)
+  { get_kernels().cvma(a, b, c, r, n);}
+  static void vam(in_type a, in_type b, in_type c, out_type r, length_type n)
+  { get_kernels().cvam(a, b, c, r, n);}
+  static void vmagsq(in_type a, float *r, length_type n)
+  { get_kernels().cvmagsq(a, r, n);}
+  static void vconj(in_type a, out_type r, length_type n)
+  { get_kernels().cvconj(a, r, n);}
+  static void svmul(complex<float> s, in_type b, out_type r, length_type n)
+  { get_kernels().csvmul(s.real(), s.imag(), b, r, n);}
+  static in_type offset(in_type p, index_type i) { return p + 2*i;}
+  static out_type offset(out_type p, index_type i) { return p + 2*i;}
+};
+
+/// complex<float> arrays are laid out as interleaved complex.
+template <>
+struct ops<complex<float>, array>
+{
+  typedef ops<complex<float>, interleaved_complex> base;
+  typedef complex<float> const *in_type;
+  typedef complex<float> *out_type;
+
+  static float const *cast(in_type p)
+  { return reinterpret_cast<float const*>(p);}
+  static float *cast(out_type p) { return reinterpret_cast<float*>(p);}
+
+  static void vmul(in_type a, in_type b, out_type r, length_type n)
+  { base::vmul(cast(a), cast(b), cast(r), n);}
+  static void vadd(in_type a, in_type b, out_type r, length_type n)
+  { base::vadd(cast(a), cast(b), cast(r), n);}
+  static void vma(in_type a, in_type b, in_type c, out_type r, length_type n)
+  { base::vma(cast(a), cast(b), cast(c), cast(r), n);}
+  static void vam(in_type a, in_type b, in_type c, out_type r, length_type n)
+  { base::vam(cast(a), cast(b), cast(c), cast(r), n);}
+  static void vmagsq(in_type a, float *r, length_type n)
+  { base::vmagsq(cast(a), r, n);}
+  static void vconj(in_type a, out_type r, length_type n)
+  { base::vconj(cast(a), cast(r), n);}
+  static void svmul(complex<float> s, in_type b, out_type r, length_type n)
+  { base::svmul(s, cast(b), cast(r), n);}
+  static in_type offset(in_type p, index_type i) { return p + i;}
+  static out_type offset(out_type p, index_type i) { return p + i;}
+};
+
+template <>
+struct ops<complex<float>, split_complex>
+{
+  typedef std::pair<float const *, float const *> in_type;
+  typedef std::pair<float *, float *> out_type;
+
+  static void vmul(in_type a, in_type b, out_type r, length_type n)
+  {
+    get_kernels().zvmul(a.first, a.second, b.first, b.second,
+			r.first, r.second, n);
+  }
+  static void vadd(in_type a, in_type b, out_type r, length_type n)
+  {
+    get_kernels().vadd(a.first, b.first, r.first, n);
+    get_kernels().vadd(a.second, b.second, r.second, n);
+  }
+  static void vma(in_type a, in_type b, in_type c, out_type r, length_type n)
+  {
+    get_kernels().zvma(a.first, a.second, b.first, b.second,
+		       c.first, c.second, r.first, r.second, n);
+  }
+  static void vam(in_type a, in_type b, in_type c, out_type r, length_type n)
+  {
+    get_kernels().zvam(a.first, a.second, b.first, b.second,
+		       c.first, c.second, r.first, r.second, n);
+  }
+  static void vmagsq(in_type a, float *r, length_type n)
+  { get_kernels().zvmagsq(a.first, a.second, r, n);}
+  static void vconj(in_type a, out_type r, length_type n)
+  { get_kernels().zvconj(a.first, a.second, r.first, r.second, n);}
+  static void svmul(complex<float> s, in_type b, out_type r, length_type n)
+  {
+    get_kernels().zsvmul(s.real(), s.imag(), b.first, b.second,
+			 r.first, r.second, n);
+  }
+  static in_type offset(in_type p, index_type i)
+  { return in_type(p.first + i, p.second + i);}
+  static out_type offset(out_type p, index_type i)
+  { return out_type(p.first + i, p.second + i);}
+};
+
+/// True if there are kernels for value-type T in storage format F.
+template <typename T, storage_format_type F>
+struct is_supported : false_type {};
+template <>
+struct is_supported<float, array> : true_type {};
+template <>
+struct is_supported<complex<float>, array> : true_type {};
+template <>
+struct is_supported<complex<float>, interleaved_complex> : true_type {};
+template <>
+struct is_supported<complex<float>, split_complex> : true_type {};
+
+} // namespace ovxx::simd
+} // namespace ovxx
+
+#endif
@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#include <ovxx/simd/simd.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+namespace ovxx
+{
+namespace simd
+{
+namespace
+{
+struct sse2_traits
+{
+  typedef __m128 type;
+  static length_type const size = 4;
+
+  static type load(float const *p) { return _mm_loadu_ps(p);}
+  static void store(float *p, type v) { _mm_storeu_ps(p, v);}
+  static type set1(float f) { return _mm_set1_ps(f);}
+  static type add(type a, type b) { return _mm_add_ps(a, b);}
+  static type sub(type a, type b) { return _mm_sub_ps(a, b);}
+  static type mul(type a, type b) { return _mm_mul_ps(a, b);}
+  static type fma(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c);}
+  static type neg(type a) { return _mm_xor_ps(a, _mm_set1_ps(-0.f));}
+  static type min(type a, type b) { return _mm_min_ps(a, b);}
+  static type max(type a, type b) { return _mm_max_ps(a, b);}
+  static void zip(float *p, type re, type im)
+  {
+    _mm_storeu_ps(p, _mm_unpacklo_ps(re, im));
+    _mm_storeu_ps(p + 4, _mm_unpackhi_ps(re, im));
+  }
+  static void unzip(float const *p, type &re, type &im)
+  {
+    type a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4);
+    re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+  }
+
+  typedef __m128d dtype;
+  static length_type const dsize = 2;
+
+  static dtype dload(double const *p) { return _mm_loadu_pd(p);}
+  static void dstore(double *p, dtype v) { _mm_storeu_pd(p, v);}
+  static dtype dset1(double d) { return _mm_set1_pd(d);}
+  static dtype dadd(dtype a, dtype b) { return _mm_add_pd(a, b);}
+  static dtype dsub(dtype a, dtype b) { return _mm_sub_pd(a, b);}
+  static dtype dmul(dtype a, dtype b) { return _mm_mul_pd(a, b);}
+  static dtype dfma(dtype a, dtype b, dtype c)
+  { return _mm_add_pd(_mm_mul_pd(a, b), c);}
+  static void dzip(double *p, dtype re, dtype im)
+  {
+    _mm_storeu_pd(p, _mm_unpacklo_pd(re, im));
+    _mm_storeu_pd(p + 2, _mm_unpackhi_pd(re, im));
+  }
+  static void dunzip(double const *p, dtype &re, dtype &im)
+  {
+    dtype a = _mm_loadu_pd(p), b = _mm_loadu_pd(p + 2);
+    re = _mm_unpacklo_pd(a, b);
+    im = _mm_unpackhi_pd(a, b);
+  }
+  static type cset(float re, float im) { return _mm_setr_ps(re, im, re, im);}
+  static type conj(type a)
+  { return _mm_xor_ps(a, _mm_setr_ps(0.f, -0.f, 0.f, -0.f));}
+  static type cmul(type a, type b)
+  {
+    type re = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 0, 0));
+    type im = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 1, 1));
+    type sw = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_add_ps(_mm_mul_ps(re, b),
+		      _mm_xor_ps(_mm_mul_ps(im, sw),
+				 _mm_setr_ps(-0.f, 0.f, -0.f, 0.f)));
+  }
+  static type hadd_pairs(type a, type b)
+  {
+    return _mm_add_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)),
+		      _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+  }
+
+  static length_type const tile = 4;
+  static void transpose(float const *a, stride_type lda,
+			float *b, stride_type ldb)
+  {
+    type r0 = load(a), r1 = load(a + lda);
+    type r2 = load(a + 2 * lda), r3 = load(a + 3 * lda);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    store(b, r0);
+    store(b + ldb, r1);
+    store(b + 2 * ldb, r2);
+    store(b + 3 * ldb, r3);
+  }
+  static length_type const tile64 = 2;
+  static void transpose64(double const *a, stride_type lda,
+			  double *b, stride_type ldb)
+  {
+    __m128d r0 = _mm_loadu_pd(a), r1 = _mm_loadu_pd(a + lda);
+    _mm_storeu_pd(b, _mm_unpacklo_pd(r0, r1));
+    _mm_storeu_pd(b + ldb, _mm_unpackhi_pd(r0, r1));
+  }
+};
+} // namespace ovxx::simd::<unnamed>
+} // namespace ovxx::simd
+} // namespace ovxx
+
+#include <ovxx/simd/kernels.hpp>
+
+namespace ovxx
+{
+namespace simd
+{
+namespace detail
+{
+extern kernels const sse2_kernels = make_kernels<sse2_traits>(sse2, "sse2");
+} // namespace ovxx::simd::detail
+} // namespace ovxx::simd
+} // namespace ovxx
+
+#pragma GCC pop_options
+
+#endif
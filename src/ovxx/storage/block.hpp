@@ -181,11 +181,31 @@ public:
     smanager_.admit(update);
   }
 
+  /// Admit the block, updating only the elements in `dom` from user
+  /// storage. The block must have been admitted before, and the other
+  /// elements must not have changed since it was released.
+  void admit(Domain<dim> const &dom) VSIP_NOTHROW
+  {
+    if (admitted()) return;
+    for_each_run(dom, &smanager_type::update_host);
+    smanager_.admit(false);
+  }
+
   void release(bool update = true) VSIP_NOTHROW
   {
     smanager_.release(update);
   }
 
+  /// Release the block, updating only the elements in `dom` in user
+  /// storage. The other elements must not have changed since the
+  /// block was admitted.
+  void release(Domain<dim> const &dom) VSIP_NOTHROW
+  {
+    if (!admitted()) return;
+    for_each_run(dom, &smanager_type::update_user);
+    smanager_.release(false);
+  }
+
   void release(bool update, T *&ptr) VSIP_NOTHROW
   {
     smanager_.release(update, ptr);
@@ -310,6 +330,31 @@ public:
   }
 
 private:
+  // Call `f` for each run of storage elements covering `dom`,
+  // each run being contiguous along the minor dimension.
+  void for_each_run(Domain<dim> const &dom,
+		    void (smanager_type::*f)(Domain<1> const &))
+  {
+    if (!dom.size()) return;
+    dimension_type const minor =
+      dim == 1 ? 0 : dim == 2 ? order_type::impl_dim1 : order_type::impl_dim2;
+    stride_type const stride = layout_.stride(minor) * dom[minor].stride();
+    length_type const runs = dom.size() / dom[minor].size();
+    for (index_type r = 0; r != runs; ++r)
+    {
+      Index<dim> idx;
+      index_type i = r;
+      for (dimension_type d = 0; d != dim; ++d)
+	if (d == minor) idx[d] = dom[d].first();
+	else
+	{
+	  idx[d] = dom[d].impl_nth(i % dom[d].size());
+	  i /= dom[d].size();
+	}
+      (smanager_.*f)(Domain<1>(layout_.index(idx), stride, dom[minor].size()));
+    }
+  }
+
   applied_layout_type layout_;
   smanager_type smanager_;
   map_type map_;
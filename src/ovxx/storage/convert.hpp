@@ -0,0 +1,218 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_storage_convert_hpp_
+#define ovxx_storage_convert_hpp_
+
+#include <ovxx/storage/host.hpp>
+#include <ovxx/storage/user.hpp>
+#include <ovxx/simd/simd.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <vsip/domain.hpp>
+#include <algorithm>
+
+namespace ovxx
+{
+namespace detail
+{
+
+/// Split to interleaved complex: c[2i] = re[i], c[2i+1] = im[i].
+template <typename T>
+inline void
+interleave(T const *re, T const *im, T *c, length_type n)
+{
+  for (index_type i = 0; i != n; ++i)
+  {
+    c[2 * i] = re[i];
+    c[2 * i + 1] = im[i];
+  }
+}
+
+inline void
+interleave(float const *re, float const *im, float *c, length_type n)
+{ simd::get_kernels().interleave(re, im, c, n);}
+
+inline void
+interleave(double const *re, double const *im, double *c, length_type n)
+{ simd::get_kernels().dinterleave(re, im, c, n);}
+
+/// Interleaved to split complex.
+template <typename T>
+inline void
+deinterleave(T const *c, T *re, T *im, length_type n)
+{
+  for (index_type i = 0; i != n; ++i)
+  {
+    re[i] = c[2 * i];
+    im[i] = c[2 * i + 1];
+  }
+}
+
+inline void
+deinterleave(float const *c, float *re, float *im, length_type n)
+{ simd::get_kernels().deinterleave(c, re, im, n);}
+
+inline void
+deinterleave(double const *c, double *re, double *im, length_type n)
+{ simd::get_kernels().ddeinterleave(c, re, im, n);}
+
+/// Convert one chunk of a split / interleaved array pair.
+template <typename T>
+struct interleave_task
+{
+  T const *re;
+  T const *im;
+  T *c;
+  length_type size;
+  length_type chunk;
+
+  void operator()(index_type i)
+  {
+    index_type b = i * chunk;
+    interleave(re + b, im + b, c + 2 * b, std::min(chunk, size - b));
+  }
+};
+
+template <typename T>
+struct deinterleave_task
+{
+  T const *c;
+  T *re;
+  T *im;
+  length_type size;
+  length_type chunk;
+
+  void operator()(index_type i)
+  {
+    index_type b = i * chunk;
+    deinterleave(c + 2 * b, re + b, im + b, std::min(chunk, size - b));
+  }
+};
+
+/// Run a conversion task over `task.size` elements, split across
+/// the thread pool if the array is large enough.
+template <typename F>
+void
+convert_chunks(F &task)
+{
+  thread_pool *pool = 0;
+  length_type chunks = 1;
+  if (task.size >= thread_pool::threshold())
+  {
+    pool = thread_pool::get_default();
+    chunks = std::max<length_type>(1, std::min<length_type>(pool->size(), task.size));
+  }
+  task.chunk = (task.size + chunks - 1) / chunks;
+  if (chunks > 1)
+    pool->parallel_for(chunks, task);
+  else if (task.size)
+    task(0);
+}
+
+/// Copy elements between user storage and host storage. The
+/// generic version copies element by element.
+template <typename T, storage_format_type F>
+struct convert
+{
+  static void to_host(user_storage<T> const &u, host_storage<T, F> &h,
+		      Domain<1> const &r)
+  {
+    for (index_type i = 0; i != r.size(); ++i)
+    {
+      index_type j = r.impl_nth(i);
+      h.put(j, u.get(j));
+    }
+  }
+  static void to_user(host_storage<T, F> &h, user_storage<T> &u,
+		      Domain<1> const &r)
+  {
+    for (index_type i = 0; i != r.size(); ++i)
+    {
+      index_type j = r.impl_nth(i);
+      u.put(j, h.get(j));
+    }
+  }
+};
+
+/// Complex values differing only in their (split vs. interleaved)
+/// storage formats are converted in bulk.
+template <typename T, storage_format_type F>
+struct convert<complex<T>, F>
+{
+  static T *interleaved(complex<T> *p) { return reinterpret_cast<T*>(p);}
+  static T *interleaved(T *p) { return p;}
+
+  // Returns false if the formats don't allow a bulk conversion.
+  static bool bulk_in(user_storage<complex<T> > const &u,
+		      std::pair<T*,T*> h, index_type i, length_type n)
+  {
+    if (u.format() != array_format && u.format() != interleaved_format)
+      return false;
+    deinterleave_task<T> task =
+      {u.template as<interleaved_complex>() + 2 * i, h.first + i, h.second + i, n};
+    convert_chunks(task);
+    return true;
+  }
+  template <typename P>
+  static bool bulk_in(user_storage<complex<T> > const &u,
+		      P h, index_type i, length_type n)
+  {
+    if (u.format() != split_format) return false;
+    std::pair<T const*,T const*> s = u.template as<split_complex>();
+    interleave_task<T> task =
+      {s.first + i, s.second + i, interleaved(h) + 2 * i, n};
+    convert_chunks(task);
+    return true;
+  }
+  static bool bulk_out(std::pair<T*,T*> h, user_storage<complex<T> > &u,
+		       index_type i, length_type n)
+  {
+    if (u.format() != array_format && u.format() != interleaved_format)
+      return false;
+    interleave_task<T> task =
+      {h.first + i, h.second + i, u.template as<interleaved_complex>() + 2 * i, n};
+    convert_chunks(task);
+    return true;
+  }
+  template <typename P>
+  static bool bulk_out(P h, user_storage<complex<T> > &u,
+		       index_type i, length_type n)
+  {
+    if (u.format() != split_format) return false;
+    std::pair<T*,T*> s = u.template as<split_complex>();
+    deinterleave_task<T> task =
+      {interleaved(h) + 2 * i, s.first + i, s.second + i, n};
+    convert_chunks(task);
+    return true;
+  }
+
+  static void to_host(user_storage<complex<T> > const &u,
+		      host_storage<complex<T>, F> &h, Domain<1> const &r)
+  {
+    if (r.stride() != 1 || !bulk_in(u, h.ptr(), r.first(), r.size()))
+      for (index_type i = 0; i != r.size(); ++i)
+      {
+	index_type j = r.impl_nth(i);
+	h.put(j, u.get(j));
+      }
+  }
+  static void to_user(host_storage<complex<T>, F> &h,
+		      user_storage<complex<T> > &u, Domain<1> const &r)
+  {
+    if (r.stride() != 1 || !bulk_out(h.ptr(), u, r.first(), r.size()))
+      for (index_type i = 0; i != r.size(); ++i)
+      {
+	index_type j = r.impl_nth(i);
+	u.put(j, h.get(j));
+      }
+  }
+};
+
+} // namespace ovxx::detail
+} // namespace ovxx
+
+#endif
@@ -11,6 +11,7 @@
 #include <ovxx/storage/storage.hpp>
 #include <ovxx/storage/host.hpp>
 #include <ovxx/storage/user.hpp>
+#include <ovxx/storage/convert.hpp>
 #if OVXX_HAVE_OPENCL
 # include <ovxx/opencl/storage.hpp>
 #endif
@@ -49,7 +50,8 @@ public:
 #if OVXX_HAVE_OPENCL
       opencl_storage_(size, false),
 #endif
-      admitted_(true)
+      admitted_(true),
+      host_state_(host_invalid)
   {
   }
   storage_manager(allocator *a, length_type size, bool allocate = true)
@@ -58,7 +60,8 @@ public:
 #if OVXX_HAVE_OPENCL
       opencl_storage_(size, false),
 #endif
-      admitted_(true)
+      admitted_(true),
+      host_state_(host_invalid)
   {
   }
   // User-storage constructors.
@@ -72,7 +75,8 @@ public:
 #if OVXX_HAVE_OPENCL
       opencl_storage_(size),
 #endif
-      admitted_(false)
+      admitted_(false),
+      host_state_(host_invalid)
   {
   }
   storage_manager(allocator *a, length_type size, T *ptr)
@@ -85,7 +89,8 @@ public:
 #if OVXX_HAVE_OPENCL
       opencl_storage_(size),
 #endif
-      admitted_(false)
+      admitted_(false),
+      host_state_(host_invalid)
   {
   }
   storage_manager(length_type size, uT *ptr)
@@ -98,7 +103,8 @@ public:
 #if OVXX_HAVE_OPENCL
       opencl_storage_(size),
 #endif
-      admitted_(false)
+      admitted_(false),
+      host_state_(host_invalid)
   {
   }
   storage_manager(allocator *a, length_type size, uT *ptr)
@@ -111,7 +117,8 @@ public:
 #if OVXX_HAVE_OPENCL
       opencl_storage_(size),
 #endif
-      admitted_(false)
+      admitted_(false),
+      host_state_(host_invalid)
   {
   }
   storage_manager(length_type size, std::pair<uT*,uT*> ptr)
@@ -124,7 +131,8 @@ public:
 #if OVXX_HAVE_OPENCL
       opencl_storage_(size),
 #endif
-      admitted_(false)
+      admitted_(false),
+      host_state_(host_invalid)
   {
   }
   storage_manager(allocator *a, length_type size, std::pair<uT*,uT*> ptr)
@@ -137,7 +145,8 @@ public:
 #if OVXX_HAVE_OPENCL
       opencl_storage_(size),
 #endif
-      admitted_(false)
+      admitted_(false),
+      host_state_(host_invalid)
   {
   }
   // Allocate storage for 'size' elements of type 'T',
@@ -159,6 +168,7 @@ public:
 #if OVXX_HAVE_OPENCL
     opencl_storage_.resize(size);
 #endif
+    host_state_ = host_invalid;
   }
   void rebind(uT *ptr, length_type size)
   {
@@ -172,6 +182,7 @@ public:
 #if OVXX_HAVE_OPENCL
     opencl_storage_.resize(size);
 #endif
+    host_state_ = host_invalid;
   }
   void rebind(std::pair<uT*,uT*> ptr, length_type size)
   {
@@ -185,6 +196,7 @@ public:
 #if OVXX_HAVE_OPENCL
     opencl_storage_.resize(size);
 #endif
+    host_state_ = host_invalid;
   }
   void find(T *&ptr)
   {
@@ -206,19 +218,34 @@ public:
   }
   void admit(bool update=true)
   {
-    if (!admitted_ && !use_user_storage_ && update)
-      for (index_type i = 0; i < host_storage_.size(); ++i)
-	host_storage_.put(i, user_storage_.get(i));
+    if (!admitted_ && update)
+      update_host(Domain<1>(host_storage_.size()));
     admitted_ = true;
   }
   void release(bool update = true)
   {
     if (!admitted_) return;
-    if (!use_user_storage_ && update)
-      for (index_type i = 0; i < host_storage_.size(); ++i)
-	user_storage_.put(i, host_storage_.get(i));
+    if (update)
+      update_user(Domain<1>(host_storage_.size()));
     admitted_ = false;
   }
+  // Copy the elements in `range` from user storage into host
+  // storage, if the two differ. This allows blocks to admit
+  // part of their data, before calling 'admit(false)'.
+  void update_host(Domain<1> const &range)
+  {
+    OVXX_PRECONDITION(!admitted_);
+    if (!use_user_storage_)
+      detail::convert<T, F>::to_host(user_storage_, host_storage_, range);
+  }
+  // Copy the elements in `range` from host storage back into
+  // user storage, if the two differ.
+  void update_user(Domain<1> const &range)
+  {
+    OVXX_PRECONDITION(admitted_);
+    if (!use_user_storage_)
+      detail::convert<T, F>::to_user(host_storage_, user_storage_, range);
+  }
   void release(bool update, T*&ptr)
   {
     OVXX_PRECONDITION(user_storage_.format() == no_user_format ||
@@ -248,8 +275,7 @@ public:
   {
     //    if (where == 0)
     {
-      sync(0);
-      invalidate(~0);
+      require_host(host_resident);
       return host_storage_.ptr();
     }
 // #if OVXX_HAVE_OPENCL
@@ -266,7 +292,7 @@ public:
   {
     // if (where == 0)
     {
-      sync(0);
+      require_host(host_valid);
       return host_storage_.ptr();
     }
 // #if OVXX_HAVE_OPENCL
@@ -282,39 +308,59 @@ public:
   {
     sync(1); // TODO: define proper location for OpenCL storage
     invalidate(0);
+    host_state_ = host_invalid;
     return opencl_storage_.ptr();
   }
   opencl::buffer buffer() const
   {
     sync(1); // TODO: define proper location for OpenCL storage
     invalidate(0);
+    host_state_ = host_invalid;
     return opencl_storage_.ptr();
   }
 #endif
 
+  // Element access only checks the host state; the actual
+  // synchronization happens once, when the state changes.
   value_type get(index_type i) const
   {
-    sync(0);
+    require_host(host_valid);
     return host_storage_.get(i);
   }
   void put(index_type i, value_type v)
   {
-    sync(0);
+    require_host(host_resident);
     host_storage_.put(i, v);
-    invalidate(~0);
   }
   reference_type at(index_type i)
   {
-    sync(0);
+    require_host(host_resident);
     return host_storage_.at(i);
   }
   const_reference_type at(index_type i) const
   {
-    sync(0);
+    require_host(host_valid);
     return host_storage_.at(i);
   }
 
 private:
+  // The state of host storage relative to other locations:
+  // 'host_valid' means it is allocated and up-to-date,
+  // 'host_resident' additionally that all other replica have
+  // been invalidated, so it may be modified.
+  enum host_state { host_invalid, host_valid, host_resident};
+
+  void require_host(host_state s) const
+  {
+    if (host_state_ < s) acquire_host(s);
+  }
+  void acquire_host(host_state s) const
+  {
+    sync(0);
+    if (s == host_resident) invalidate(~0);
+    host_state_ = s;
+  }
+
   // Make sure storage is available in the given location,
   // and data is valid.
   void sync(location where) const
@@ -371,6 +417,7 @@ private:
   mutable opencl::storage<T, F> opencl_storage_;
 #endif
   bool admitted_;
+  mutable host_state host_state_;
 };
 
 } // namespace ovxx
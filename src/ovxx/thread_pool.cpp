@@ -0,0 +1,350 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#include <ovxx/thread_pool.hpp>
+#include <ovxx/allocator.hpp>
+#include <ovxx/options.hpp>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <exception>
+#if HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+#if HAVE_SCHED_GETAFFINITY || HAVE_PTHREAD_SETAFFINITY_NP
+# include <sched.h>
+# include <pthread.h>
+#endif
+
+namespace
+{
+using ovxx::thread_pool;
+
+#if OVXX_ENABLE_THREADING
+// Set while the current thread executes chunks of a parallel loop,
+// so nested loops are run serially.
+thread_local bool in_parallel_loop = false;
+#endif
+
+// The CPUs this process may run on. Empty if unknown.
+thread_pool::cpu_set available_cpus()
+{
+  thread_pool::cpu_set cpus;
+#if HAVE_SCHED_GETAFFINITY
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    for (unsigned int c = 0; c != CPU_SETSIZE; ++c)
+      if (CPU_ISSET(c, &set)) cpus.push_back(c);
+#endif
+  return cpus;
+}
+
+// The CPUs of the given NUMA node that this process may run on.
+thread_pool::cpu_set numa_cpus(unsigned int node)
+{
+  char path[64];
+  std::sprintf(path, "/sys/devices/system/node/node%u/cpulist", node);
+  std::ifstream ifs(path);
+  std::string list;
+  if (!ifs || !std::getline(ifs, list))
+    OVXX_DO_THROW(std::invalid_argument("unknown NUMA node"));
+  thread_pool::cpu_set cpus = thread_pool::parse_cpus(list);
+  thread_pool::cpu_set available = available_cpus();
+  if (available.empty()) return cpus;
+  thread_pool::cpu_set result;
+  std::set_intersection(cpus.begin(), cpus.end(),
+			available.begin(), available.end(),
+			std::back_inserter(result));
+  return result;
+}
+
+#if OVXX_ENABLE_THREADING
+// Restrict the calling thread to `cpus`, or, if `pin` is set,
+// bind it to `cpus[i % cpus.size()]`.
+void bind_thread(thread_pool::cpu_set const &cpus, bool pin, unsigned int i)
+{
+#if HAVE_PTHREAD_SETAFFINITY_NP
+  if (cpus.empty()) return;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (pin)
+    CPU_SET(cpus[i % cpus.size()], &set);
+  else
+    for (thread_pool::cpu_set::const_iterator c = cpus.begin(); c != cpus.end(); ++c)
+      CPU_SET(*c, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+#endif
+
+unsigned int default_pool_size(thread_pool::cpu_set const &cpus)
+{
+  if (!cpus.empty()) return cpus.size();
+  thread_pool::cpu_set available = available_cpus();
+  if (!available.empty()) return available.size();
+#if OVXX_ENABLE_THREADING && defined(_SC_NPROCESSORS_ONLN)
+  long procs = sysconf(_SC_NPROCESSORS_ONLN);
+  if (procs > 0) return procs;
+#endif
+  return 1;
+}
+
+// Below this size the cost of waking up the workers
+// outweighs the gain.
+ovxx::length_type const default_threshold = 65536;
+}
+
+namespace ovxx
+{
+
+thread_pool *thread_pool::default_ = 0;
+length_type thread_pool::threshold_ = 0;
+
+#if OVXX_ENABLE_THREADING
+
+struct thread_pool::worker
+{
+  worker(thread_pool *p, unsigned int i) : pool(p), index(i) {}
+  void operator()()
+  {
+    bind_thread(pool->cpus_, pool->pin_, index);
+    pool->work();
+  }
+  thread_pool *pool;
+  unsigned int index;
+};
+
+thread_pool::thread_pool(unsigned int size, cpu_set const &cpus, bool pin)
+  : generation_(0),
+    pending_(0),
+    shutdown_(false),
+    function_(0),
+    closure_(0),
+    allocator_(0),
+    chunks_(0),
+    next_(0),
+    size_(size ? size : 1),
+    cpus_(cpus),
+    pin_(pin && !cpus.empty())
+{
+  bind_thread(cpus_, pin_, 0);
+  for (unsigned int i = 1; i < size_; ++i)
+    threads_.push_back(new thread(worker(this, i)));
+}
+
+thread_pool::~thread_pool()
+{
+  {
+    unique_lock<mutex> lock(mutex_);
+    shutdown_ = true;
+    start_.notify_all();
+  }
+  for (std::vector<thread*>::iterator i = threads_.begin();
+       i != threads_.end(); ++i)
+  {
+    (*i)->join();
+    delete *i;
+  }
+}
+
+void thread_pool::run(function_type f, void *closure, length_type chunks)
+{
+  if (chunks == 0) return;
+  if (chunks == 1 || threads_.empty() || in_parallel_loop || !busy_.try_lock())
+  {
+    for (index_type i = 0; i != chunks; ++i)
+      f(closure, i);
+    return;
+  }
+  {
+    unique_lock<mutex> lock(mutex_);
+    function_ = f;
+    closure_ = closure;
+    allocator_ = allocator::get_default();
+    chunks_ = chunks;
+    next_ = 0;
+    pending_ = threads_.size();
+    ++generation_;
+    start_.notify_all();
+  }
+  execute();
+  std::exception_ptr error;
+  {
+    unique_lock<mutex> lock(mutex_);
+    while (pending_) done_.wait(lock);
+    function_ = 0;
+    closure_ = 0;
+    allocator_ = 0;
+    std::swap(error, error_);
+  }
+  busy_.unlock();
+  if (error) std::rethrow_exception(error);
+}
+
+// Run chunks until there are none left. If one of them throws, the
+// exception is recorded (to be rethrown by the caller of `run()`), and
+// the remaining chunks are skipped.
+void thread_pool::execute()
+{
+  in_parallel_loop = true;
+  for (index_type i = __sync_fetch_and_add(&next_, 1); i < chunks_;
+       i = __sync_fetch_and_add(&next_, 1))
+  {
+#if VSIP_HAS_EXCEPTIONS
+    try { function_(closure_, i);}
+    catch (...)
+    {
+      unique_lock<mutex> lock(mutex_);
+      if (!error_) error_ = std::current_exception();
+      __sync_fetch_and_add(&next_, chunks_);
+    }
+#else
+    function_(closure_, i);
+#endif
+  }
+  in_parallel_loop = false;
+}
+
+void thread_pool::work()
+{
+  unsigned int generation = 0;
+  while (true)
+  {
+    {
+      unique_lock<mutex> lock(mutex_);
+      while (!shutdown_ && generation == generation_) start_.wait(lock);
+      if (shutdown_) return;
+      generation = generation_;
+    }
+    // Temporaries are allocated with the caller's allocator.
+    allocator::set_default(allocator_);
+    execute();
+    allocator::set_default(0);
+    {
+      unique_lock<mutex> lock(mutex_);
+      if (--pending_ == 0) done_.notify_one();
+    }
+  }
+}
+
+#else
+
+thread_pool::thread_pool(unsigned int, cpu_set const &cpus, bool pin)
+  : size_(1), cpus_(cpus), pin_(pin && !cpus.empty())
+{}
+
+thread_pool::~thread_pool() {}
+
+void thread_pool::run(function_type f, void *closure, length_type chunks)
+{
+  for (index_type i = 0; i != chunks; ++i)
+    f(closure, i);
+}
+
+#endif
+
+void thread_pool::initialize(int &argc, char **&argv)
+{
+  std::string const threshold =
+    options::get(argc, argv, "ovxx-thread-threshold", "OVXX_THREAD_THRESHOLD");
+  threshold_ = threshold.empty() ?
+    default_threshold : std::strtoul(threshold.c_str(), 0, 10);
+
+  cpu_set cpus;
+  std::string const node =
+    options::get(argc, argv, "ovxx-numa-node", "OVXX_NUMA_NODE");
+  if (!node.empty())
+  {
+    cpus = numa_cpus(std::strtoul(node.c_str(), 0, 10));
+    if (cpus.empty())
+      std::cerr << "WARNING: none of the CPUs of NUMA node " << node
+		<< " is available, ignoring --ovxx-numa-node" << std::endl;
+  }
+
+  bool pin = false;
+  std::string const affinity =
+    options::get(argc, argv, "ovxx-affinity", "OVXX_AFFINITY", "none");
+  if (affinity == "compact")
+  {
+    if (cpus.empty()) cpus = available_cpus();
+    pin = true;
+  }
+  else if (affinity != "none")
+  {
+    // An explicit CPU list, restricted to the NUMA node, if given.
+    // If that leaves no CPUs, use the list as given.
+    cpu_set list = parse_cpus(affinity);
+    if (!cpus.empty())
+    {
+      cpu_set node_cpus;
+      node_cpus.swap(cpus);
+      for (cpu_set::const_iterator c = list.begin(); c != list.end(); ++c)
+	if (std::binary_search(node_cpus.begin(), node_cpus.end(), *c))
+	  cpus.push_back(*c);
+      if (cpus.empty())
+      {
+	std::cerr << "WARNING: none of the CPUs in '" << affinity
+		  << "' is on NUMA node " << node
+		  << ", binding to them regardless" << std::endl;
+	cpus = list;
+      }
+    }
+    else cpus = list;
+    pin = true;
+  }
+
+  unsigned int size = 0;
+  std::string const threads =
+    options::get(argc, argv, "ovxx-num-threads", "OVXX_NUM_THREADS");
+  if (!threads.empty() && std::atoi(threads.c_str()) > 0)
+    size = std::atoi(threads.c_str());
+  else size = default_pool_size(cpus);
+  default_ = new thread_pool(size, cpus, pin);
+}
+
+thread_pool::cpu_set thread_pool::parse_cpus(std::string const &list)
+{
+  cpu_set cpus;
+  std::istringstream iss(list);
+  std::string range;
+  while (std::getline(iss, range, ','))
+  {
+    if (range.empty()) continue;
+    char *end;
+    unsigned long first = std::strtoul(range.c_str(), &end, 10);
+    unsigned long last = first;
+    if (end == range.c_str())
+      OVXX_DO_THROW(std::invalid_argument("invalid CPU list"));
+    if (*end == '-')
+    {
+      char const *second = end + 1;
+      last = std::strtoul(second, &end, 10);
+      if (end == second || last < first)
+	OVXX_DO_THROW(std::invalid_argument("invalid CPU list"));
+    }
+    if (*end != '\0' && *end != '\n')
+      OVXX_DO_THROW(std::invalid_argument("invalid CPU list"));
+    for (unsigned long c = first; c <= last; ++c)
+      cpus.push_back(c);
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+void thread_pool::finalize()
+{
+  delete default_;
+  default_ = 0;
+}
+
+} // namespace ovxx
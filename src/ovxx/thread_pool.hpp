@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+#ifndef ovxx_thread_pool_hpp_
+#define ovxx_thread_pool_hpp_
+
+#include <ovxx/support.hpp>
+#include <ovxx/c++11.hpp>
+#include <ovxx/detail/noncopyable.hpp>
+#if OVXX_ENABLE_THREADING
+# include <ovxx/c++11/thread.hpp>
+#endif
+#include <vector>
+#include <string>
+#include <exception>
+
+namespace ovxx
+{
+class allocator;
+
+/// A persistent pool of worker threads used to run data-parallel
+/// loops. The calling thread participates in the work, so a pool
+/// of size N owns N-1 worker threads.
+///
+/// Without threading support the pool has size 1, and all work is
+/// executed synchronously by the caller.
+///
+/// The library owns a default pool, which is shared by the threaded
+/// evaluators, the FFT backends, and user code, so a process doesn't
+/// use more threads than it was configured for.
+class thread_pool : detail::noncopyable
+{
+public:
+  /// The function executed for each chunk of a parallel loop.
+  typedef void (*function_type)(void *closure, index_type chunk);
+  typedef std::vector<unsigned int> cpu_set;
+
+  /// Create a pool of `size` threads. If `cpus` is non-empty, all
+  /// threads (including the caller) are restricted to the given CPUs.
+  /// If in addition `pin` is true, thread `i` is bound to
+  /// `cpus[i % cpus.size()]`, with the caller being thread 0.
+  explicit thread_pool(unsigned int size,
+		       cpu_set const &cpus = cpu_set(), bool pin = false);
+  ~thread_pool();
+
+  /// The number of threads participating in a parallel loop.
+  unsigned int size() const { return size_;}
+  /// The CPUs the pool's threads run on. Empty if unrestricted.
+  cpu_set const &cpus() const { return cpus_;}
+  /// True if each thread is bound to a single CPU.
+  bool pinned() const { return pin_;}
+
+  /// Call `f(closure, i)` for all `i` in `[0, chunks)`, and return
+  /// once all calls have completed. If the pool is already busy
+  /// (nested or concurrent use), the loop is executed by the caller.
+  /// Each call runs with the caller's default allocator. If a call
+  /// throws, the remaining chunks are skipped, and the first exception
+  /// is rethrown once all threads are done.
+  void run(function_type f, void *closure, length_type chunks);
+
+  /// Call `f(i)` for all `i` in `[0, chunks)`.
+  template <typename F>
+  void parallel_for(length_type chunks, F &f)
+  { run(&call<F>, &f, chunks);}
+
+  /// Create the default pool, configured by the following command-line
+  /// options, or the corresponding environment variables:
+  ///
+  ///   :--ovxx-num-threads (OVXX_NUM_THREADS):
+  ///     the number of threads. Defaults to the number of CPUs available.
+  ///   :--ovxx-numa-node (OVXX_NUMA_NODE):
+  ///     restrict the pool to the CPUs of the given NUMA node.
+  ///   :--ovxx-affinity (OVXX_AFFINITY):
+  ///     'none' (the default) leaves thread placement to the OS,
+  ///     'compact' binds each thread to its own CPU, and a CPU list
+  ///     such as '0-7,16' binds threads to the listed CPUs in turn.
+  ///     With a NUMA node, only the listed CPUs on that node are used,
+  ///     unless there are none, in which case a warning is printed and
+  ///     the list is used as is.
+  ///   :--ovxx-thread-threshold (OVXX_THREAD_THRESHOLD):
+  ///     the minimum problem size (in elements) for which the threaded
+  ///     evaluators are used.
+  static void initialize(int &argc, char **&argv);
+  static void finalize();
+  static thread_pool *get_default()
+  {
+    OVXX_INVARIANT(default_ && "OpenVSIP not properly initialized !");
+    return default_;
+  }
+
+  /// The minimum size (in elements) of an operation to be split
+  /// across the pool.
+  static length_type threshold() { return threshold_;}
+  static void set_threshold(length_type t) { threshold_ = t;}
+
+  /// Parse a CPU list such as '0-3,8,10-11'. Throws
+  /// std::invalid_argument if `list` is malformed.
+  static cpu_set parse_cpus(std::string const &list);
+
+private:
+  template <typename F>
+  static void call(void *closure, index_type chunk)
+  { (*static_cast<F*>(closure))(chunk);}
+
+#if OVXX_ENABLE_THREADING
+  struct worker;
+  friend struct worker;
+
+  void work();
+  void execute();
+
+  mutex busy_;
+  mutex mutex_;
+  condition_variable start_;
+  condition_variable done_;
+  std::vector<thread*> threads_;
+  unsigned int generation_;
+  unsigned int pending_;
+  bool shutdown_;
+
+  function_type function_;
+  void *closure_;
+  allocator *allocator_;
+  length_type chunks_;
+  length_type next_;
+  std::exception_ptr error_;
+#endif
+  unsigned int size_;
+  cpu_set cpus_;
+  bool pin_;
+
+  static thread_pool *default_;
+  static length_type threshold_;
+};
+
+} // namespace ovxx
+
+#endif
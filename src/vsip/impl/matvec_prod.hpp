@@ -12,6 +12,7 @@
 #include <vsip/vector.hpp>
 #include <vsip/matrix.hpp>
 #include <vsip/impl/matvec.hpp>
+#include <ovxx/gemm.hpp>
 #if OVXX_CVSIP_FFT
 # include <ovxx/cvsip/matvec.hpp>
 #endif
@@ -30,6 +31,7 @@ struct List<op::prod>
   typedef make_type_list<be::user,
 			 be::cuda,
 			 be::blas,
+			 be::opt,
 			 be::cvsip,
 			 be::generic>::type type;
 };
@@ -40,10 +42,77 @@ struct List<op::prodj>
   typedef make_type_list<be::user,
                          be::cuda,
 			 be::blas,
+			 be::opt,
 			 be::cvsip,
 			 be::generic>::type type;
 };
 
+/// Matrix-matrix (and matrix-vector) products computed by the
+/// packed, cache-blocked GEMM engine in <ovxx/gemm.hpp>.
+template <typename B0, typename B1, typename B2, bool Conj>
+struct gemm_evaluator
+{
+  typedef typename B0::value_type T;
+  typedef typename gemm::operand<B0, dda::out>::type data0_type;
+  typedef typename gemm::operand<B1, dda::in>::type data1_type;
+  typedef typename gemm::operand<B2, dda::in>::type data2_type;
+
+  static bool const ct_valid =
+    gemm::is_supported<T>::value &&
+    is_same<T, typename B1::value_type>::value &&
+    is_same<T, typename B2::value_type>::value;
+
+  static bool rt_valid(B0 &r, B1 const &a, B2 const &b)
+  {
+    // The number of multiply-adds: one per element of the matrix
+    // for matrix-vector and vector-matrix products.
+    length_type const madds =
+      B1::dim == 1 ? b.size() :
+      B2::dim == 1 ? a.size() :
+      a.size() * b.size(2, 1);
+    return madds >= gemm::threshold;
+  }
+
+  static void exec(B0 &r, B1 const &a, B2 const &b)
+  {
+    data0_type data_r(r);
+    data1_type data_a(a);
+    data2_type data_b(b);
+    if (B1::dim == 1)
+    {
+      // r = a * b is computed as r = b^T * a.
+      gemm::prod<T>(b.size(2, 1), 1, b.size(2, 0),
+		    data_b.ptr(), data_b.stride(1), data_b.stride(0),
+		    data_a.ptr(), data_a.stride(0), 0, Conj,
+		    data_r.ptr(), data_r.stride(0), 0);
+    }
+    else if (B2::dim == 1)
+      gemm::prod<T>(a.size(2, 0), 1, a.size(2, 1),
+		    data_a.ptr(), data_a.stride(0), data_a.stride(1),
+		    data_b.ptr(), data_b.stride(0), 0, Conj,
+		    data_r.ptr(), data_r.stride(0), 0);
+    else
+      gemm::prod<T>(a.size(2, 0), b.size(2, 1), a.size(2, 1),
+		    data_a.ptr(), data_a.stride(0), data_a.stride(1),
+		    data_b.ptr(), data_b.stride(0), data_b.stride(1), Conj,
+		    data_r.ptr(), data_r.stride(0), data_r.stride(1));
+  }
+};
+
+template <typename B0, typename B1, typename B2>
+struct Evaluator<op::prod, be::opt, void(B0 &, B1 const &, B2 const &)>
+  : gemm_evaluator<B0, B1, B2, false>
+{
+  static char const *name() { return "opt";}
+};
+
+template <typename B0, typename B1, typename B2>
+struct Evaluator<op::prodj, be::opt, void(B0 &, B1 const &, B2 const &)>
+  : gemm_evaluator<B0, B1, B2, true>
+{
+  static char const *name() { return "opt";}
+};
+
 /// Generic evaluator for matrix-matrix products.
 template <typename Block0,
 	  typename Block1,
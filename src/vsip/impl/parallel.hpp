@@ -19,23 +19,34 @@ namespace vsip
 
 inline const_Vector<processor_type> processor_set()
 {
+#if defined(OVXX_HAVE_SHM)
+  // Each thread may be a processor of its own (see ovxx/shm/service.hpp),
+  // so the set is built from the calling thread's communicator each time.
+  namespace p = ovxx::parallel;
+  p::Communicator::pvec_type const &pvec = p::default_communicator().pvec();
+  Vector<processor_type> pset(pvec.size());
+  for (index_type i=0; i<pvec.size(); ++i)
+    pset.put(i, pvec[i]);
+  return pset;
+#else
   static Dense<1, processor_type> *pset_block_ = 0;
 
   if (pset_block_ == 0)
   {
-#if OVXX_PARALLEL
+# if OVXX_PARALLEL
     namespace p = ovxx::parallel;
     p::Communicator::pvec_type const &pvec = p::default_communicator().pvec();
     pset_block_ = new Dense<1, processor_type>(Domain<1>(pvec.size()));
     for (index_type i=0; i<pvec.size(); ++i)
       pset_block_->put(i, pvec[i]);
-#else
+# else
     pset_block_ = new Dense<1, processor_type>(1);
     pset_block_->put(0, 0);
-#endif
+# endif
   }
 
   return Vector<processor_type>(*pset_block_);
+#endif
 }
 
 // [view.support.fcn] parallel support functions
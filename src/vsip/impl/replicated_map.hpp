@@ -87,8 +87,9 @@ public:
   Replicated_map() VSIP_THROW((std::bad_alloc))
     : data_(new Data(vsip::num_processors()))
   {
-    for (index_type i=0; i<vsip::num_processors(); ++i)
-      data_->pset.put(i, vsip::processor_set().get(i));
+    const_Vector<processor_type> pset = vsip::processor_set();
+    for (index_type i=0; i<pset.size(); ++i)
+      data_->pset.put(i, pset.get(i));
     data_->init_ll_pset();
   }
 
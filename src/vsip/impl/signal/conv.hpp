@@ -16,6 +16,7 @@
 #include <ovxx/domain_utils.hpp>
 #include <vsip/impl/signal/types.hpp>
 #include <ovxx/signal/conv.hpp>
+#include <ovxx/signal/conv_fft.hpp>
 #if OVXX_HAVE_CVSIP
 # include <ovxx/cvsip/conv.hpp>
 #endif
@@ -34,6 +35,7 @@ struct List<op::conv<D, S, R, T, N, H> >
 {
   typedef make_type_list<be::user,
 			 be::cvsip,
+			 be::fft_based,
 			 be::generic>::type type;
 };
 template <dimension_type D,
@@ -15,6 +15,7 @@
 #include <vsip/matrix.hpp>
 #include <vsip/impl/signal/types.hpp>
 #include <ovxx/signal/corr.hpp>
+#include <ovxx/signal/corr_fft.hpp>
 #if OVXX_HAVE_CVSIP
 # include <ovxx/cvsip/corr.hpp>
 #endif
@@ -34,6 +35,7 @@ struct List<op::corr<D, R, T, N, H> >
                          be::cuda,
 			 be::opt,
 			 be::cvsip,
+			 be::fft_based,
 			 be::generic>::type type;
 };
 
@@ -16,6 +16,7 @@
 #include <vsip/dda.hpp>
 #include <ovxx/aligned_array.hpp>
 #include <ovxx/signal/fir.hpp>
+#include <ovxx/signal/fir_fft.hpp>
 #include <ovxx/dispatch.hpp>
 #if OVXX_HAVE_CVSIP
 # include <ovxx/cvsip/fir.hpp>
@@ -30,6 +31,8 @@ struct List<op::fir>
 {
   typedef make_type_list<be::user,
 			 be::cuda,
+			 be::fft_based,
+			 be::opt,
 			 be::generic,
 			 be::cvsip>::type type;
 };
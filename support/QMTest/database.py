@@ -288,7 +288,8 @@ class Database(CompilationTestDatabase):
         if self.no_exclusions == 'false':
             if self.flags.get('have_mpi') != '1':
                 self.excluded_subdirs.append('mpi')
-                self.excluded_subdirs.append('parallel')
+                if self.flags.get('have_shm') != '1':
+                    self.excluded_subdirs.append('parallel')
             if self.flags.get('enable_threading') != '1':
                 self.excluded_subdirs.append('thread')
             if self.flags.get('have_ipp') != '1':
@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+#include <vsip/vector.hpp>
+#include <vsip/matrix.hpp>
+#include <vsip/signal.hpp>
+#include <vsip/initfin.hpp>
+#include <vsip/random.hpp>
+#include <test.hpp>
+
+using namespace ovxx;
+
+// Compare the FFT-based convolution (selected for large kernels
+// with alg_time) against the direct one (selected with alg_space).
+template <typename T, symmetry_type S, support_region_type R>
+void test_conv(length_type M, length_type N, length_type D)
+{
+  typedef Convolution<const_Vector, S, R, T, 0, alg_time> fast_type;
+  typedef Convolution<const_Vector, S, R, T, 0, alg_space> direct_type;
+
+  Rand<T> rand(0);
+  Vector<T> coeff = rand.randu(M);
+  Vector<T> in = rand.randu(N);
+
+  fast_type fast(coeff, Domain<1>(N), D);
+  direct_type direct(coeff, Domain<1>(N), D);
+  test_assert(fast.output_size().size() == direct.output_size().size());
+  test_assert(fast.uses_fft() ==
+	      (fast.kernel_size().size() >= signal::fft_crossover(alg_time) * D));
+
+  length_type P = fast.output_size().size();
+  Vector<T> out(P, T(-1));
+  Vector<T> ref(P, T(-2));
+  fast(in, out);
+  direct(in, ref);
+  test_assert(test::diff(out, ref) < -80);
+}
+
+template <typename T, support_region_type R>
+void test_conv_2d(length_type Mr, length_type Mc,
+		  length_type Nr, length_type Nc, length_type D)
+{
+  typedef Convolution<const_Matrix, nonsym, R, T, 0, alg_time> fast_type;
+  typedef Convolution<const_Matrix, nonsym, R, T, 0, alg_space> direct_type;
+
+  Rand<T> rand(1);
+  Matrix<T> coeff = rand.randu(Mr, Mc);
+  Matrix<T> in = rand.randu(Nr, Nc);
+
+  fast_type fast(coeff, Domain<2>(Nr, Nc), D);
+  direct_type direct(coeff, Domain<2>(Nr, Nc), D);
+  test_assert(fast.uses_fft());
+
+  Domain<2> const &size = fast.output_size();
+  Matrix<T> out(size[0].size(), size[1].size(), T(-1));
+  Matrix<T> ref(size[0].size(), size[1].size(), T(-2));
+  fast(in, out);
+  direct(in, ref);
+  test_assert(test::diff(out, ref) < -80);
+}
+
+template <typename T, symmetry_type S>
+void cases(length_type M)
+{
+  length_type const sizes[] = {M, 3 * M + 7, 1000};
+  length_type const decimations[] = {1, 2, 3};
+  for (index_type i = 0; i != 3; ++i)
+    for (index_type d = 0; d != 3; ++d)
+    {
+      test_conv<T, S, support_full>(M, sizes[i], decimations[d]);
+      test_conv<T, S, support_same>(M, sizes[i], decimations[d]);
+      if (sizes[i] >= 2 * M)
+	test_conv<T, S, support_min>(M, sizes[i], decimations[d]);
+    }
+}
+
+template <typename T>
+void cases()
+{
+  cases<T, nonsym>(40);
+  cases<T, nonsym>(100);
+  cases<T, sym_even_len_odd>(33);
+  cases<T, sym_even_len_even>(64);
+  // Below the crossover.
+  cases<T, nonsym>(5);
+
+  test_conv_2d<T, support_full>(8, 8, 20, 30, 1);
+  test_conv_2d<T, support_same>(7, 9, 25, 19, 1);
+  test_conv_2d<T, support_min>(6, 6, 32, 17, 1);
+  test_conv_2d<T, support_full>(12, 12, 20, 30, 2);
+}
+
+int main(int argc, char **argv)
+{
+  vsipl init(argc, argv);
+
+  // Without an FFT backend for a given precision, the direct
+  // convolution is used throughout.
+#if OVXX_FFT_HAVE_FLOAT
+  cases<float>();
+  cases<complex<float> >();
+#endif
+#if OVXX_FFT_HAVE_DOUBLE
+  cases<double>();
+  cases<complex<double> >();
+#endif
+}
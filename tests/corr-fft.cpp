@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+#include <vsip/vector.hpp>
+#include <vsip/matrix.hpp>
+#include <vsip/signal.hpp>
+#include <vsip/initfin.hpp>
+#include <vsip/random.hpp>
+#include <test.hpp>
+
+using namespace ovxx;
+
+// Compare the FFT-based correlation (selected for large references
+// with alg_time) against the direct one (selected with alg_space).
+template <typename T, support_region_type R>
+void test_corr(length_type M, length_type N)
+{
+  typedef Correlation<const_Vector, R, T, 0, alg_time> fast_type;
+  typedef Correlation<const_Vector, R, T, 0, alg_space> direct_type;
+
+  Rand<T> rand(0);
+  Vector<T> ref = rand.randu(M);
+  Vector<T> in = rand.randu(N);
+
+  Domain<1> ref_size(M), in_size(N);
+  fast_type fast(ref_size, in_size);
+  direct_type direct(ref_size, in_size);
+  test_assert(fast.uses_fft() == (M >= signal::fft_crossover(alg_time)));
+
+  length_type P = fast.output_size().size();
+  Vector<T> out(P), exp(P);
+  bias_type const biases[] = {biased, unbiased};
+  for (index_type b = 0; b != 2; ++b)
+  {
+    fast(biases[b], ref, in, out);
+    direct(biases[b], ref, in, exp);
+    test_assert(test::diff(out, exp) < -80);
+    // Again, with the cached reference spectrum...
+    in = rand.randu(N);
+    fast(biases[b], ref, in, out);
+    direct(biases[b], ref, in, exp);
+    test_assert(test::diff(out, exp) < -80);
+    // ...and with a new reference.
+    ref.put(M / 2, ref.get(M / 2) + T(1));
+    fast(biases[b], ref, in, out);
+    direct(biases[b], ref, in, exp);
+    test_assert(test::diff(out, exp) < -80);
+  }
+}
+
+template <typename T, support_region_type R>
+void test_corr_2d(length_type Mr, length_type Mc, length_type Nr, length_type Nc)
+{
+  typedef Correlation<const_Matrix, R, T, 0, alg_time> fast_type;
+  typedef Correlation<const_Matrix, R, T, 0, alg_space> direct_type;
+
+  Rand<T> rand(1);
+  Matrix<T> ref = rand.randu(Mr, Mc);
+  Matrix<T> in = rand.randu(Nr, Nc);
+
+  Domain<2> ref_size(Mr, Mc), in_size(Nr, Nc);
+  fast_type fast(ref_size, in_size);
+  direct_type direct(ref_size, in_size);
+  test_assert(fast.uses_fft());
+
+  Domain<2> const &size = fast.output_size();
+  Matrix<T> out(size[0].size(), size[1].size());
+  Matrix<T> exp(size[0].size(), size[1].size());
+  bias_type const biases[] = {biased, unbiased};
+  for (index_type b = 0; b != 2; ++b)
+  {
+    fast(biases[b], ref, in, out);
+    direct(biases[b], ref, in, exp);
+    test_assert(test::diff(out, exp) < -80);
+    ref.put(0, 0, ref.get(0, 0) + T(1));
+    fast(biases[b], ref, in, out);
+    direct(biases[b], ref, in, exp);
+    test_assert(test::diff(out, exp) < -80);
+  }
+}
+
+template <typename T>
+void cases()
+{
+  length_type const refs[] = {8, 40, 64, 101};
+  for (index_type i = 0; i != 4; ++i)
+  {
+    length_type M = refs[i];
+    test_corr<T, support_full>(M, M);
+    test_corr<T, support_full>(M, 5 * M + 3);
+    test_corr<T, support_same>(M, M);
+    test_corr<T, support_same>(M, 5 * M + 3);
+    test_corr<T, support_min>(M, M);
+    test_corr<T, support_min>(M, 5 * M + 3);
+  }
+  test_corr_2d<T, support_full>(6, 7, 16, 20);
+  test_corr_2d<T, support_same>(8, 6, 19, 16);
+  test_corr_2d<T, support_same>(7, 7, 19, 16);
+  test_corr_2d<T, support_min>(6, 6, 20, 13);
+}
+
+int main(int argc, char **argv)
+{
+  vsipl init(argc, argv);
+
+  // Without an FFT backend for a given precision, the direct
+  // correlation is used throughout.
+#if OVXX_FFT_HAVE_FLOAT
+  cases<float>();
+  cases<complex<float> >();
+#endif
+#if OVXX_FFT_HAVE_DOUBLE
+  cases<double>();
+  cases<complex<double> >();
+#endif
+}
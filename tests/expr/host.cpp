@@ -0,0 +1,163 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+/// Description
+///   Tests for elementwise assignments evaluated on host-resident
+///   proxies (expr::Host_block), which access leaf blocks through
+///   raw pointers rather than through their get() / put() methods.
+
+#include <vsip/initfin.hpp>
+#include <vsip/support.hpp>
+#include <vsip/vector.hpp>
+#include <vsip/matrix.hpp>
+#include <vsip/tensor.hpp>
+#include <vsip/math.hpp>
+#include <vsip/selgen.hpp>
+#include <ovxx/expr/host.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <test.hpp>
+
+using namespace ovxx;
+
+// A binary function object with state, which needs to be preserved
+// when its expression block is rebuilt.
+template <typename T>
+struct axpy
+{
+  typedef T first_argument_type;
+  typedef T second_argument_type;
+  typedef T result_type;
+  axpy(T a) : a_(a) {}
+  T operator()(T x, T y) const { return a_ * x + y;}
+  T a_;
+};
+
+template <typename T>
+T value(index_type i) { return T(i % 17) - T(5);}
+
+template <typename B>
+void check_accessible(B const &, bool expected)
+{
+  test_assert(expr::is_host_accessible<B>::value == expected);
+}
+
+template <typename T, storage_format_type F>
+void
+test_vector(length_type size)
+{
+  typedef Layout<1, row1_type, dense, F> layout_type;
+  typedef Strided<1, T, layout_type> block_type;
+  Vector<T, block_type> a(size), b(size), c(size);
+  for (index_type i = 0; i != size; ++i)
+  {
+    a.put(i, T(value<typename scalar_of<T>::type>(i)));
+    b.put(i, T(value<typename scalar_of<T>::type>(i + 3)));
+  }
+
+  check_accessible((a * b).block(), true);
+  c = a * b + T(2);
+  for (index_type i = 0; i != size; ++i)
+    test_assert(equal(c.get(i), a.get(i) * b.get(i) + T(2)));
+
+  // The result aliasing an operand.
+  Vector<T> ref(size);
+  ref = a - b * a;
+  a = a - b * a;
+  for (index_type i = 0; i != size; ++i)
+    test_assert(equal(a.get(i), ref.get(i)));
+
+  // Strided subviews.
+  Domain<1> dom(1, 3, size / 3);
+  Vector<T> d(size / 3, T());
+  d = b(dom) * c(dom);
+  for (index_type i = 0; i != size / 3; ++i)
+    test_assert(equal(d.get(i), b.get(1 + 3 * i) * c.get(1 + 3 * i)));
+  c(dom) = d;
+  for (index_type i = 0; i != size / 3; ++i)
+    test_assert(equal(c.get(1 + 3 * i), d.get(i)));
+
+  // Ternary expressions, and user functions with state.
+  Vector<T> e(size);
+  e = c;
+  c = ma(a, b, c);
+  for (index_type i = 0; i != size; ++i)
+    test_assert(equal(c.get(i), a.get(i) * b.get(i) + e.get(i)));
+  d = binary(axpy<T>(T(3)), b(dom), c(dom));
+  for (index_type i = 0; i != size / 3; ++i)
+    test_assert(equal(d.get(i), T(3) * b.get(1 + 3 * i) + c.get(1 + 3 * i)));
+}
+
+template <typename T, typename O>
+void
+test_matrix(length_type rows, length_type cols)
+{
+  typedef Dense<2, T, O> block_type;
+  Matrix<T, block_type> a(rows, cols), b(rows, cols), c(rows, cols, T());
+  for (index_type i = 0; i != rows; ++i)
+    for (index_type j = 0; j != cols; ++j)
+    {
+      a.put(i, j, T(value<T>(i * cols + j)));
+      b.put(i, j, T(value<T>(i + j * rows)));
+    }
+  c = a * b - a;
+  for (index_type i = 0; i != rows; ++i)
+    for (index_type j = 0; j != cols; ++j)
+      test_assert(equal(c.get(i, j), a.get(i, j) * b.get(i, j) - a.get(i, j)));
+
+  // Transposed views are strided, too.
+  Matrix<T> d(cols, rows);
+  d = a.transpose() + T(1);
+  for (index_type i = 0; i != rows; ++i)
+    for (index_type j = 0; j != cols; ++j)
+      test_assert(equal(d.get(j, i), a.get(i, j) + T(1)));
+}
+
+template <typename T>
+void
+test_tensor(length_type n0, length_type n1, length_type n2)
+{
+  Tensor<T> a(n0, n1, n2), b(n0, n1, n2, T(2));
+  for (index_type i = 0; i != n0; ++i)
+    for (index_type j = 0; j != n1; ++j)
+      for (index_type k = 0; k != n2; ++k)
+	a.put(i, j, k, T(value<T>(i * n1 * n2 + j * n2 + k)));
+  b = a * b;
+  for (index_type i = 0; i != n0; ++i)
+    for (index_type j = 0; j != n1; ++j)
+      for (index_type k = 0; k != n2; ++k)
+	test_assert(equal(b.get(i, j, k), T(2) * a.get(i, j, k)));
+}
+
+int
+main(int argc, char **argv)
+{
+  vsipl init(argc, argv);
+
+  // Exercise the threaded evaluator, too.
+  thread_pool::set_threshold(1);
+
+  // Expression blocks that aren't elementwise, and blocks without
+  // direct data access, are evaluated as before.
+  Vector<float> v(8, 1.f);
+  check_accessible(v.block(), true);
+  check_accessible((v + 1.f).block(), true);
+  Vector<complex<float> > cv(8);
+  check_accessible(cv.real().block(), true);
+  check_accessible(ramp(0.f, 1.f, 8).block(), false);
+  check_accessible((v + ramp(0.f, 1.f, 8)).block(), false);
+
+  test_vector<float, array>(100);
+  test_vector<double, array>(1000);
+  test_vector<int, array>(33);
+  test_vector<complex<float>, interleaved_complex>(100);
+  test_vector<complex<float>, split_complex>(100);
+  test_vector<complex<double>, split_complex>(1000);
+
+  test_matrix<float, row2_type>(7, 13);
+  test_matrix<double, col2_type>(13, 7);
+  test_tensor<float>(3, 4, 5);
+}
@@ -0,0 +1,201 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+#include <vsip/initfin.hpp>
+#include <vsip/vector.hpp>
+#include <vsip/math.hpp>
+#include <ovxx/simd/simd.hpp>
+#include <test.hpp>
+#include <vector>
+
+using namespace ovxx;
+
+// Small integers, so all results are exact regardless of
+// evaluation order or fused multiply-adds.
+float value(index_type i, int seed) { return float((i * 7 + seed * 3) % 17) - 8.f;}
+
+std::vector<float> data(length_type n, int seed)
+{
+  std::vector<float> a(n + 1);
+  for (index_type i = 0; i != n; ++i) a[i] = value(i, seed);
+  return a;
+}
+
+// Check the kernels in k against scalar code, for real, interleaved
+// and split data.
+void test_kernels(simd::kernels const &k, length_type n)
+{
+  std::vector<float> a = data(n, 1), b = data(n, 2), c = data(n, 3);
+  std::vector<float> r(n + 1, 0.f);
+
+  k.vmul(&a[0], &b[0], &r[0], n);
+  for (index_type i = 0; i != n; ++i) test_assert(r[i] == a[i] * b[i]);
+  k.vadd(&a[0], &b[0], &r[0], n);
+  for (index_type i = 0; i != n; ++i) test_assert(r[i] == a[i] + b[i]);
+  k.vma(&a[0], &b[0], &c[0], &r[0], n);
+  for (index_type i = 0; i != n; ++i) test_assert(r[i] == a[i] * b[i] + c[i]);
+  k.vam(&a[0], &b[0], &c[0], &r[0], n);
+  for (index_type i = 0; i != n; ++i) test_assert(r[i] == (a[i] + b[i]) * c[i]);
+  k.vmagsq(&a[0], &r[0], n);
+  for (index_type i = 0; i != n; ++i) test_assert(r[i] == a[i] * a[i]);
+  k.svmul(3.f, &b[0], &r[0], n);
+  for (index_type i = 0; i != n; ++i) test_assert(r[i] == 3.f * b[i]);
+  // Nothing past the end may be touched.
+  test_assert(r[n] == 0.f);
+
+  typedef std::complex<float> C;
+  std::vector<C> ca(n + 1), cb(n + 1), cc(n + 1), cr(n + 1);
+  std::vector<float> ar = data(n, 4), ai = data(n, 5);
+  std::vector<float> br = data(n, 6), bi = data(n, 7);
+  std::vector<float> cre = data(n, 8), cim = data(n, 9);
+  std::vector<float> rr(n + 1), ri(n + 1);
+  for (index_type i = 0; i != n; ++i)
+  {
+    ca[i] = C(ar[i], ai[i]);
+    cb[i] = C(br[i], bi[i]);
+    cc[i] = C(cre[i], cim[i]);
+  }
+  float *pca = reinterpret_cast<float*>(&ca[0]);
+  float *pcb = reinterpret_cast<float*>(&cb[0]);
+  float *pcc = reinterpret_cast<float*>(&cc[0]);
+  float *pcr = reinterpret_cast<float*>(&cr[0]);
+  C const s(2.f, -3.f);
+
+  k.cvmul(pca, pcb, pcr, n);
+  for (index_type i = 0; i != n; ++i) test_assert(cr[i] == ca[i] * cb[i]);
+  k.cvma(pca, pcb, pcc, pcr, n);
+  for (index_type i = 0; i != n; ++i) test_assert(cr[i] == ca[i] * cb[i] + cc[i]);
+  k.cvam(pca, pcb, pcc, pcr, n);
+  for (index_type i = 0; i != n; ++i) test_assert(cr[i] == (ca[i] + cb[i]) * cc[i]);
+  k.cvconj(pca, pcr, n);
+  for (index_type i = 0; i != n; ++i) test_assert(cr[i] == std::conj(ca[i]));
+  k.csvmul(s.real(), s.imag(), pcb, pcr, n);
+  for (index_type i = 0; i != n; ++i) test_assert(cr[i] == s * cb[i]);
+  k.cvmagsq(pca, &r[0], n);
+  for (index_type i = 0; i != n; ++i) test_assert(r[i] == std::norm(ca[i]));
+  test_assert(cr[n] == C() && r[n] == 0.f);
+
+  k.zvmul(&ar[0], &ai[0], &br[0], &bi[0], &rr[0], &ri[0], n);
+  for (index_type i = 0; i != n; ++i)
+    test_assert(C(rr[i], ri[i]) == ca[i] * cb[i]);
+  k.zvma(&ar[0], &ai[0], &br[0], &bi[0], &cre[0], &cim[0], &rr[0], &ri[0], n);
+  for (index_type i = 0; i != n; ++i)
+    test_assert(C(rr[i], ri[i]) == ca[i] * cb[i] + cc[i]);
+  k.zvam(&ar[0], &ai[0], &br[0], &bi[0], &cre[0], &cim[0], &rr[0], &ri[0], n);
+  for (index_type i = 0; i != n; ++i)
+    test_assert(C(rr[i], ri[i]) == (ca[i] + cb[i]) * cc[i]);
+  k.zvconj(&ar[0], &ai[0], &rr[0], &ri[0], n);
+  for (index_type i = 0; i != n; ++i)
+    test_assert(C(rr[i], ri[i]) == std::conj(ca[i]));
+  k.zsvmul(s.real(), s.imag(), &br[0], &bi[0], &rr[0], &ri[0], n);
+  for (index_type i = 0; i != n; ++i)
+    test_assert(C(rr[i], ri[i]) == s * cb[i]);
+  k.zvmagsq(&ar[0], &ai[0], &r[0], n);
+  for (index_type i = 0; i != n; ++i) test_assert(r[i] == std::norm(ca[i]));
+  test_assert(rr[n] == 0.f && ri[n] == 0.f);
+}
+
+template <typename T, typename B>
+void fill(Vector<T, B> v, int seed)
+{
+  for (index_type i = 0; i != v.size(); ++i)
+    v.put(i, T(value(i, seed)));
+}
+
+template <typename T, typename B>
+void fill(Vector<complex<T>, B> v, int seed)
+{
+  for (index_type i = 0; i != v.size(); ++i)
+    v.put(i, complex<T>(value(i, seed), value(i, seed + 1)));
+}
+
+// Evaluate all supported expressions through the view API, with
+// blocks of type B.
+template <typename T, typename B>
+void test_views(length_type n)
+{
+  Vector<T, B> A(n), Bv(n), C(n), Z(n);
+  Vector<float> M(n);
+  fill(A, 1);
+  fill(Bv, 2);
+  fill(C, 3);
+  T const s(3);
+
+  Z = A * Bv;
+  for (index_type i = 0; i != n; ++i) test_assert(Z.get(i) == A.get(i) * Bv.get(i));
+  Z = A + Bv;
+  for (index_type i = 0; i != n; ++i) test_assert(Z.get(i) == A.get(i) + Bv.get(i));
+  Z = A * Bv + C;
+  for (index_type i = 0; i != n; ++i)
+    test_assert(Z.get(i) == A.get(i) * Bv.get(i) + C.get(i));
+  Z = am(A, Bv, C);
+  for (index_type i = 0; i != n; ++i)
+    test_assert(Z.get(i) == (A.get(i) + Bv.get(i)) * C.get(i));
+  Z = s * A;
+  for (index_type i = 0; i != n; ++i) test_assert(Z.get(i) == s * A.get(i));
+  Z = A * s;
+  for (index_type i = 0; i != n; ++i) test_assert(Z.get(i) == A.get(i) * s);
+  M = magsq(A);
+  for (index_type i = 0; i != n; ++i) test_assert(M.get(i) == magsq(A.get(i)));
+  // in-place
+  Z = A;
+  Z = Z * Bv;
+  for (index_type i = 0; i != n; ++i) test_assert(Z.get(i) == A.get(i) * Bv.get(i));
+  // non-unit stride falls back to the generic evaluators
+  Vector<T, B> W(2 * n + 1, T(-1));
+  W(Domain<1>(0, 2, n)) = A * Bv;
+  for (index_type i = 0; i != n; ++i)
+  {
+    test_assert(W.get(2*i) == A.get(i) * Bv.get(i));
+    test_assert(W.get(2*i + 1) == T(-1));
+  }
+}
+
+template <typename T, typename B>
+void test_conj(length_type n)
+{
+  Vector<T, B> A(n), Z(n);
+  fill(A, 1);
+  Z = conj(A);
+  for (index_type i = 0; i != n; ++i) test_assert(Z.get(i) == conj(A.get(i)));
+}
+
+int main(int argc, char **argv)
+{
+  vsipl library(argc, argv);
+
+  length_type sizes[] = {0, 1, 3, 7, 8, 15, 16, 17, 31, 33, 100};
+  length_type const count = sizeof(sizes) / sizeof(*sizes);
+  simd::isa_type isas[] = {simd::generic, simd::sse2, simd::avx2, simd::avx512};
+  for (unsigned int i = 0; i != 4; ++i)
+    if (simd::kernels const *k = simd::get_kernels(isas[i]))
+    {
+      test_assert(k->isa == isas[i]);
+      for (index_type s = 0; s != count; ++s)
+	test_kernels(*k, sizes[s]);
+    }
+  // The generic kernels are always available.
+  test_assert(simd::get_kernels(simd::generic));
+
+  typedef Layout<1, row1_type, dense, split_complex> split_layout;
+  typedef Layout<1, row1_type, dense, interleaved_complex> inter_layout;
+  typedef Strided<1, complex<float>, split_layout> split_block;
+  typedef Strided<1, complex<float>, inter_layout> inter_block;
+
+  for (index_type s = 0; s != count; ++s)
+  {
+    test_views<float, Dense<1, float> >(sizes[s]);
+    test_views<complex<float>, Dense<1, complex<float> > >(sizes[s]);
+    test_views<complex<float>, split_block>(sizes[s]);
+    test_views<complex<float>, inter_block>(sizes[s]);
+    test_conj<complex<float>, Dense<1, complex<float> > >(sizes[s]);
+    test_conj<complex<float>, split_block>(sizes[s]);
+  }
+  // Large enough to be split across threads, if available.
+  test_views<float, Dense<1, float> >(100003);
+  test_views<complex<float>, split_block>(100003);
+}
@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+/// Description
+///   Tests for the fused fast-convolution evaluator, which computes
+///   inv_fftm(vmmul(weights, fwd_fftm(data))) in cache-sized chunks of
+///   rows (or columns), against the same pipeline evaluated in steps.
+
+#include <vsip/initfin.hpp>
+#include <vsip/support.hpp>
+#include <vsip/signal.hpp>
+#include <vsip/math.hpp>
+#include <vsip/random.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <test.hpp>
+#include <cstdlib>
+
+using namespace ovxx;
+
+// Make sure the expression is handled by the fused evaluator.
+template <typename LHS, typename RHS>
+void check_fused(LHS &, RHS const &)
+{
+  typedef typename dispatcher::Dispatcher<
+    dispatcher::op::assign<2>, void(LHS &, RHS const &)>::backend backend_type;
+  test_assert((is_same<backend_type, dispatcher::be::fc_expr>::value));
+}
+
+template <int A>
+Domain<2> line_domain(length_type lines, length_type length)
+{
+  return A == row ? Domain<2>(lines, length) : Domain<2>(length, lines);
+}
+
+template <typename T, int A>
+void
+test_complex(length_type lines, length_type length)
+{
+  typedef complex<T> C;
+  typedef Fftm<C, C, A, fft_fwd, by_value> fwd_type;
+  typedef Fftm<C, C, A, fft_inv, by_value> inv_type;
+
+  Domain<2> dom = line_domain<A>(lines, length);
+  fwd_type fwd(dom, 1.);
+  inv_type inv(dom, 1. / length);
+
+  Rand<C> rand(lines);
+  Matrix<C> in(dom[0].size(), dom[1].size());
+  Vector<C> weights(length);
+  in = rand.randu(dom[0].size(), dom[1].size());
+  weights = rand.randu(length);
+
+  Matrix<C> ref(dom[0].size(), dom[1].size());
+  Matrix<C> tmp(dom[0].size(), dom[1].size());
+  tmp = fwd(in);
+  tmp = vmmul<A>(weights, tmp);
+  ref = inv(tmp);
+
+  Matrix<C> out(dom[0].size(), dom[1].size());
+  check_fused(out.block(), inv(vmmul<A>(weights, fwd(in))).block());
+  out = inv(vmmul<A>(weights, fwd(in)));
+  test_assert(test::diff(ref, out) < -100);
+
+  // in-place
+  out = in;
+  out = inv(vmmul<A>(weights, fwd(out)));
+  test_assert(test::diff(ref, out) < -100);
+
+  // column-major, strided output
+  Matrix<C, Dense<2, C, col2_type> > big(2 * dom[0].size(), dom[1].size());
+  Domain<2> sub(Domain<1>(1, 2, dom[0].size()), dom[1].size());
+  big(sub) = inv(vmmul<A>(weights, fwd(in)));
+  test_assert(test::diff(ref, big(sub)) < -100);
+}
+
+template <typename T>
+void
+test_real(length_type rows, length_type cols)
+{
+  typedef complex<T> C;
+  typedef Fftm<T, C, row, fft_fwd, by_value> fwd_type;
+  typedef Fftm<C, T, row, fft_inv, by_value> inv_type;
+
+  Domain<2> dom(rows, cols);
+  fwd_type fwd(dom, 1.);
+  inv_type inv(dom, 1. / cols);
+
+  Rand<T> rand(rows);
+  Rand<C> crand(cols);
+  Matrix<T> in(rows, cols);
+  Vector<C> weights(cols / 2 + 1);
+  in = rand.randu(rows, cols);
+  weights = crand.randu(cols / 2 + 1);
+
+  Matrix<C> tmp(rows, cols / 2 + 1);
+  Matrix<T> ref(rows, cols);
+  tmp = fwd(in);
+  tmp = vmmul<0>(weights, tmp);
+  ref = inv(tmp);
+
+  Matrix<T> out(rows, cols);
+  check_fused(out.block(), inv(vmmul<0>(weights, fwd(in))).block());
+  out = inv(vmmul<0>(weights, fwd(in)));
+  test_assert(test::diff(ref, out) < -100);
+}
+
+template <typename T>
+void
+cases()
+{
+  test_complex<T, row>(1, 16);
+  test_complex<T, row>(7, 64);
+  // Enough rows for several chunks per thread.
+  test_complex<T, row>(1000, 32);
+  test_complex<T, col>(300, 48);
+  test_complex<T, row>(3, 4096);
+  test_real<T>(300, 64);
+  test_real<T>(5, 30);
+}
+
+int
+main(int argc, char **argv)
+{
+  // Exercise the threaded code path, with its per-thread backends.
+  setenv("OVXX_NUM_THREADS", "4", 1);
+  vsipl init(argc, argv);
+  thread_pool::set_threshold(1);
+
+  cases<float>();
+  cases<double>();
+}
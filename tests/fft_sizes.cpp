@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+/// Description
+///   Tests for 1D Fft of sizes with various factorizations: powers of
+///   two, mixed radices, small and large primes.
+
+#include <vsip/initfin.hpp>
+#include <vsip/support.hpp>
+#include <vsip/signal.hpp>
+#include <vsip/random.hpp>
+#include <test.hpp>
+#include <test/ref/dft.hpp>
+
+using namespace ovxx;
+
+template <typename T, storage_format_type F>
+void
+test_complex(length_type size)
+{
+  typedef complex<T> C;
+  typedef Strided<1, C, Layout<1, row1_type, dense, F> > block_type;
+  typedef Fft<const_Vector, C, C, fft_fwd, by_reference> f_fft_type;
+  typedef Fft<const_Vector, C, C, fft_inv, by_value> i_fft_type;
+
+  f_fft_type f_fft(Domain<1>(size), 1.0);
+  i_fft_type i_fft(Domain<1>(size), 1.0 / size);
+
+  Vector<C, block_type> in(size);
+  Vector<C, block_type> out(size);
+  Vector<C, block_type> ref(size);
+  Rand<C> rand(size);
+  in = rand.randu(size);
+
+  test::ref::dft(in, ref, -1);
+  f_fft(in, out);
+  test_assert(test::diff(ref, out) < -100);
+  test::ref::dft(in, ref, 1);
+  ref /= T(size);
+  out = i_fft(in);
+  test_assert(test::diff(ref, out) < -100);
+
+  // in-place, forward and back
+  out = in;
+  f_fft(out);
+  out = i_fft(out);
+  test_assert(test::diff(in, out) < -100);
+}
+
+template <typename T>
+void
+test_real(length_type size)
+{
+  typedef Fft<const_Vector, T, complex<T>, 0, by_value> f_fft_type;
+  typedef Fft<const_Vector, complex<T>, T, 0, by_value> i_fft_type;
+
+  f_fft_type f_fft(Domain<1>(size), 1.0);
+  i_fft_type i_fft(Domain<1>(size), 1.0 / size);
+
+  Vector<T> in(size);
+  Vector<complex<T> > out(size / 2 + 1);
+  Vector<complex<T> > ref(size / 2 + 1);
+  Vector<T> inv(size);
+  Rand<T> rand(size);
+  in = rand.randu(size);
+
+  out = f_fft(in);
+  test::ref::dft(in, ref, -1);
+  test_assert(test::diff(ref, out) < -100);
+  inv = i_fft(out);
+  test_assert(test::diff(in, inv) < -100);
+}
+
+template <typename T>
+void
+cases()
+{
+  length_type const sizes[] =
+  {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 12, 13, 15, 16, 17, 25, 27, 31, 49,
+    60, 97, 121, 128, 169, 210, 243, 360, 625, 1009, 1024, 2310, 4096
+  };
+  for (index_type i = 0; i != sizeof(sizes) / sizeof(*sizes); ++i)
+  {
+    test_complex<T, interleaved_complex>(sizes[i]);
+    test_complex<T, split_complex>(sizes[i]);
+    if (sizes[i] > 1) test_real<T>(sizes[i]);
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  vsipl init(argc, argv);
+
+  cases<float>();
+  cases<double>();
+}
@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+// Test FFTW FFTMs whose rows (or columns) are split across the
+// default thread pool.
+
+#include <vsip/initfin.hpp>
+#include <vsip/signal.hpp>
+#include <vsip/matrix.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <test.hpp>
+#include <test/ref/dft.hpp>
+#include <cstdlib>
+
+using namespace ovxx;
+
+typedef complex<float> C;
+
+// Random input lines. For complex -> real FFTMs, the input is the
+// non-redundant half of the spectrum of a real signal.
+void make_line(Vector<float> line, length_type) { test::randv(line);}
+void make_line(Vector<C> line, length_type size)
+{
+  if (line.size() == size)
+    test::randv(line);
+  else
+  {
+    Vector<float> signal(size);
+    test::randv(signal);
+    Vector<C> spectrum(size / 2 + 1);
+    test::ref::dft(signal, spectrum, -1);
+    line = spectrum;
+  }
+}
+
+// Reference transforms of a single line.
+template <typename T>
+void ref_line(Vector<T> in, Vector<C> out, int dir)
+{ test::ref::dft(in, out, dir);}
+void ref_line(Vector<C> in, Vector<float> out, int dir)
+{
+  // Complete the Hermitian-symmetric spectrum.
+  length_type const size = out.size();
+  Vector<C> spectrum(size);
+  for (index_type k = 0; k != size; ++k)
+    spectrum.put(k, k < in.size() ? in.get(k) : conj(in.get(size - k)));
+  Vector<C> result(size);
+  test::ref::dft(spectrum, result, dir);
+  out = real(result);
+}
+
+template <typename I, typename O, int A, int D>
+void test_fftm(length_type mult, length_type size)
+{
+  typedef vsip::Fftm<I, O, A, D, vsip::by_value> fftm_type;
+  int const dir = D == vsip::fft_fwd ? -1 : 1;
+  // The length of input and output lines. Only the non-redundant
+  // half of a complex spectrum is stored.
+  length_type const in_size = is_same<O, float>::value ? size/2 + 1 : size;
+  length_type const out_size = is_same<I, float>::value ? size/2 + 1 : size;
+
+  // Lines are rows for A == row, columns otherwise.
+  Matrix<I> in(A == vsip::row ? mult : in_size, A == vsip::row ? in_size : mult);
+  Matrix<O> ref(A == vsip::row ? mult : out_size, A == vsip::row ? out_size : mult);
+  for (index_type i = 0; i != mult; ++i)
+  {
+    Vector<I> line(in_size);
+    Vector<O> result(out_size);
+    make_line(line, size);
+    ref_line(line, result, dir);
+    if (A == vsip::row) { in.row(i) = line; ref.row(i) = result;}
+    else { in.col(i) = line; ref.col(i) = result;}
+  }
+
+  Domain<2> dom(A == vsip::row ? mult : size, A == vsip::row ? size : mult);
+  fftm_type fftm(dom, 1.f);
+  Matrix<O> out = fftm(in);
+  test_assert(test::diff(ref, out) < -100);
+}
+
+int main(int argc, char **argv)
+{
+  setenv("OVXX_NUM_THREADS", "4", 1);
+  vsipl library(argc, argv);
+  // Make sure even small FFTMs take the threaded path.
+  thread_pool::set_threshold(1);
+
+  test_fftm<C, C, vsip::row, vsip::fft_fwd>(13, 32);
+  test_fftm<C, C, vsip::row, vsip::fft_inv>(13, 32);
+  test_fftm<C, C, vsip::col, vsip::fft_fwd>(13, 32);
+  test_fftm<C, C, vsip::col, vsip::fft_inv>(13, 32);
+  test_fftm<float, C, vsip::row, vsip::fft_fwd>(7, 64);
+  test_fftm<float, C, vsip::col, vsip::fft_fwd>(7, 64);
+  test_fftm<C, float, vsip::row, vsip::fft_inv>(7, 64);
+  test_fftm<C, float, vsip::col, vsip::fft_inv>(7, 64);
+  // Fewer rows than threads.
+  test_fftm<C, C, vsip::row, vsip::fft_fwd>(2, 16);
+}
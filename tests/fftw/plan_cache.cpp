@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+// Test that Fft and Fftm objects share FFTW plans through the plan cache,
+// and that objects using cached plans still compute the right results,
+// whether they use the cache's buffers or their own.
+
+#include <vsip/initfin.hpp>
+#include <vsip/signal.hpp>
+#include <vsip/matrix.hpp>
+#include <ovxx/fftw/plan_cache.hpp>
+#include <test.hpp>
+#include <test/ref/dft.hpp>
+
+using namespace ovxx;
+using fftw::plan_cache;
+
+typedef vsip::complex<float> C;
+typedef vsip::Fft<vsip::const_Vector, C, C, vsip::fft_fwd, vsip::by_value>
+  fwd_fft_type;
+typedef vsip::Fft<vsip::const_Vector, C, C, vsip::fft_inv, vsip::by_value>
+  inv_fft_type;
+typedef vsip::Fft<vsip::const_Vector, float, C, 0, vsip::by_value>
+  real_fft_type;
+typedef vsip::Fftm<C, C, vsip::row, vsip::fft_fwd, vsip::by_value>
+  fftm_type;
+
+template <typename I, typename O, typename F>
+void check_fft(F &fft, length_type size, int dir)
+{
+  Vector<I> in(size);
+  test::randv(in);
+  Vector<O> ref(fft.output_size().size());
+  test::ref::dft(in, ref, dir);
+  Vector<O> out = fft(in);
+  test_assert(test::diff(ref, out) < -100);
+}
+
+void check_fftm(fftm_type &fftm, length_type rows, length_type cols)
+{
+  Matrix<C> in(rows, cols);
+  for (index_type r = 0; r != rows; ++r)
+    test::randv(in.row(r));
+  Matrix<C> ref(rows, cols);
+  for (index_type r = 0; r != rows; ++r)
+    test::ref::dft(in.row(r), ref.row(r), -1);
+  Matrix<C> out = fftm(in);
+  test_assert(test::diff(ref, out) < -100);
+}
+
+// Objects with the same parameters share plans, objects
+// with different sizes, directions or types don't.
+void test_sharing()
+{
+  plan_cache::clear();
+  test_assert(plan_cache::size() == 0);
+  {
+    fwd_fft_type f1(Domain<1>(64), 1.f);
+    test_assert(plan_cache::size() == 1);
+    fwd_fft_type f2(Domain<1>(64), 1.f);
+    test_assert(plan_cache::size() == 1);
+    inv_fft_type i1(Domain<1>(64), 1.f);
+    test_assert(plan_cache::size() == 2);
+    fwd_fft_type f3(Domain<1>(128), 1.f);
+    test_assert(plan_cache::size() == 3);
+    real_fft_type r1(Domain<1>(64), 1.f);
+    test_assert(plan_cache::size() == 4);
+    fftm_type m1(Domain<2>(8, 64), 1.f);
+    test_assert(plan_cache::size() == 5);
+
+    check_fft<C, C>(f1, 64, -1);
+    check_fft<C, C>(f2, 64, -1);
+    check_fft<C, C>(i1, 64, 1);
+    check_fft<C, C>(f3, 128, -1);
+    check_fft<float, C>(r1, 64, -1);
+    check_fftm(m1, 8, 64);
+  }
+  // Unreferenced plans stay cached...
+  test_assert(plan_cache::size() == 5);
+  // ...and are reused by new objects.
+  {
+    fwd_fft_type f1(Domain<1>(64), 1.f);
+    inv_fft_type i1(Domain<1>(64), 1.f);
+    test_assert(plan_cache::size() == 5);
+    check_fft<C, C>(f1, 64, -1);
+    check_fft<C, C>(i1, 64, 1);
+  }
+  plan_cache::clear();
+  test_assert(plan_cache::size() == 0);
+}
+
+// The cache keeps at most capacity() unreferenced plans, least
+// recently used first out, but never drops plans that are in use.
+void test_capacity()
+{
+  length_type capacity = plan_cache::capacity();
+  plan_cache::clear();
+  plan_cache::set_capacity(2);
+  {
+    fwd_fft_type f1(Domain<1>(16), 1.f);
+    fwd_fft_type f2(Domain<1>(32), 1.f);
+    fwd_fft_type f3(Domain<1>(64), 1.f);
+    test_assert(plan_cache::size() == 3);
+  }
+  test_assert(plan_cache::size() == 2);
+  {
+    // Objects are destroyed in reverse order, so the 64-point plans
+    // were the first to be released, and the only ones dropped.
+    fwd_fft_type f1(Domain<1>(16), 1.f);
+    fwd_fft_type f2(Domain<1>(32), 1.f);
+    test_assert(plan_cache::size() == 2);
+    check_fft<C, C>(f1, 16, -1);
+    plan_cache::set_capacity(0);
+    test_assert(plan_cache::size() == 2);
+    check_fft<C, C>(f1, 16, -1);
+    check_fft<C, C>(f2, 32, -1);
+  }
+  test_assert(plan_cache::size() == 0);
+  plan_cache::set_capacity(capacity);
+}
+
+// Only one object at a time uses the buffers of cached plans,
+// all others use buffers of their own.
+void test_buffers()
+{
+  plan_cache::entry e;
+  test_assert(e.borrow_buffers());
+  test_assert(!e.borrow_buffers());
+  e.return_buffers();
+  test_assert(e.borrow_buffers());
+  e.return_buffers();
+
+  plan_cache::clear();
+  fwd_fft_type *f1 = new fwd_fft_type(Domain<1>(256), 1.f);
+  fwd_fft_type f2(Domain<1>(256), 1.f);
+  check_fft<C, C>(*f1, 256, -1);
+  check_fft<C, C>(f2, 256, -1);
+  delete f1;
+  // The buffers f1 returned are lent to the next object.
+  fwd_fft_type f3(Domain<1>(256), 1.f);
+  check_fft<C, C>(f3, 256, -1);
+  check_fft<C, C>(f2, 256, -1);
+  test_assert(plan_cache::size() == 1);
+}
+
+int main(int argc, char **argv)
+{
+  vsipl library(argc, argv);
+
+  test_sharing();
+  test_capacity();
+  test_buffers();
+}
@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+#include <vsip/vector.hpp>
+#include <vsip/matrix.hpp>
+#include <vsip/signal.hpp>
+#include <vsip/initfin.hpp>
+#include <vsip/random.hpp>
+#include <ovxx/signal/fir_bank.hpp>
+#include <test.hpp>
+#include <vector>
+
+using namespace ovxx;
+
+// Compare a Fir_bank against one Fir per channel, over several calls.
+template <typename T, symmetry_type S, obj_state C>
+void test_bank(length_type k, length_type channels, length_type N, length_type D)
+{
+  typedef Fir<T, S, C, 0, alg_space> fir_type;
+  Rand<T> rand(0);
+  Vector<T> kernel = rand.randu(k);
+
+  signal::Fir_bank<T, S, C> bank(kernel, channels, N, D);
+  std::vector<fir_type> firs(channels, fir_type(kernel, N, D));
+  test_assert(bank.output_size() == firs[0].output_size());
+
+  Matrix<T> out(channels, bank.output_size());
+  Vector<T> exp(bank.output_size());
+  for (index_type i = 0; i != 3; ++i)
+  {
+    Matrix<T> in = rand.randu(channels, N);
+    length_type count = bank(in, out);
+    for (index_type c = 0; c != channels; ++c)
+    {
+      test_assert(firs[c](in.row(c), exp) == count);
+      test_assert(test::diff(out.row(c)(Domain<1>(count)), exp(Domain<1>(count))) < -80);
+    }
+  }
+  bank.reset();
+  for (index_type c = 0; c != channels; ++c)
+    firs[c].reset();
+  // Transposed input and output.
+  Matrix<T, Dense<2, T, col2_type> > in(channels, N);
+  Matrix<T, Dense<2, T, col2_type> > tout(channels, bank.output_size());
+  in = rand.randu(channels, N);
+  length_type count = bank(in, tout);
+  for (index_type c = 0; c != channels; ++c)
+  {
+    test_assert(firs[c](in.row(c), exp) == count);
+    test_assert(test::diff(tout.row(c)(Domain<1>(count)), exp(Domain<1>(count))) < -80);
+  }
+}
+
+template <typename T>
+void cases()
+{
+  length_type const channels[] = {1, 7, 64};
+  for (index_type i = 0; i != 3; ++i)
+  {
+    length_type c = channels[i];
+    test_bank<T, nonsym, state_save>(8, c, 32, 1);
+    test_bank<T, nonsym, state_save>(12, c, 41, 3);
+    test_bank<T, nonsym, state_no_save>(12, c, 41, 3);
+    test_bank<T, sym_even_len_even, state_save>(5, c, 20, 2);
+    test_bank<T, sym_even_len_odd, state_save>(5, c, 23, 4);
+    // The smallest input size, one less than the filter order M.
+    test_bank<T, nonsym, state_save>(8, c, 7, 1);
+    test_bank<T, nonsym, state_no_save>(8, c, 7, 3);
+    test_bank<T, sym_even_len_even, state_save>(5, c, 9, 2);
+    test_bank<T, sym_even_len_odd, state_save>(5, c, 8, 4);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  vsipl init(argc, argv);
+
+  // Exercise the threaded code path.
+  thread_pool::set_threshold(1);
+
+  cases<float>();
+  cases<complex<float> >();
+  cases<double>();
+  cases<complex<double> >();
+}
@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+#include <vsip/vector.hpp>
+#include <vsip/signal.hpp>
+#include <vsip/initfin.hpp>
+#include <vsip/random.hpp>
+#include <test.hpp>
+
+using namespace ovxx;
+
+// Filter `in` (preceded by `history`, the earlier input) directly,
+// per the definition of Fir, starting at output phase `phase`.
+template <typename T>
+Vector<T>
+reference(Vector<T> h, Vector<T> history, Vector<T> in,
+	  length_type D, length_type phase)
+{
+  length_type const M = h.size();
+  length_type const H = history.size();
+  length_type const count = phase < in.size() ? (in.size() - phase + D - 1) / D : 0;
+  Vector<T> out(count, T());
+  for (index_type o = 0; o != count; ++o)
+  {
+    stride_type const n = H + phase + o * D;
+    T sum = T();
+    for (index_type k = 0; k != M; ++k)
+      if (n >= stride_type(k))
+      {
+	index_type i = n - k;
+	sum += h.get(k) * (i < H ? history.get(i) : in.get(i - H));
+      }
+    out.put(o, sum);
+  }
+  return out;
+}
+
+template <typename T, symmetry_type S>
+Vector<T> full_kernel(Vector<T> coeffs)
+{
+  length_type const k = coeffs.size();
+  length_type const M = signal::Fir_backend<T, S, state_save>::order(k);
+  Vector<T> h(M);
+  for (index_type j = 0; j != k; ++j)
+  {
+    h.put(j, coeffs.get(j));
+    if (S != nonsym) h.put(M - 1 - j, coeffs.get(j));
+  }
+  return h;
+}
+
+// Filter several chunks of input, and compare to the direct result
+// computed over the concatenated input.
+template <typename T, symmetry_type S, alg_hint_type H>
+void test_fir(length_type k, length_type N, length_type D)
+{
+  Rand<T> rand(0);
+  Vector<T> coeffs = rand.randu(k);
+  Vector<T> h = full_kernel<T, S>(coeffs);
+
+  Fir<T, S, state_save, 0, H> fir(coeffs, N, D);
+  Fir<T, S, state_no_save, 0, H> fir_ns(coeffs, N, D);
+  Vector<T> out(fir.output_size());
+
+  length_type const chunks = 4;
+  Vector<T> all(chunks * N);
+  length_type phase = 0;
+  for (index_type c = 0; c != chunks; ++c)
+  {
+    Vector<T> in = rand.randu(N);
+    all(Domain<1>(c * N, 1, N)) = in;
+    Vector<T> history = all(Domain<1>(c * N));
+    Vector<T> exp = reference(h, history, in, D, phase);
+    length_type count = fir(in, out);
+    test_assert(count == exp.size());
+    test_assert(test::diff(out(Domain<1>(count)), exp) < -80);
+
+    // Without state, each chunk is filtered as if it was the first.
+    Vector<T> none(0);
+    Vector<T> exp_ns = reference(h, none, in, D, 0);
+    length_type count_ns = fir_ns(in, out);
+    test_assert(count_ns == exp_ns.size());
+    test_assert(test::diff(out(Domain<1>(count_ns)), exp_ns) < -80);
+
+    phase = phase + count * D - N;
+  }
+
+  // A copy carries on from the same state, and reset clears it.
+  Fir<T, S, state_save, 0, H> copy(fir);
+  Vector<T> in = rand.randu(N);
+  Vector<T> out2(fir.output_size());
+  length_type count = fir(in, out);
+  test_assert(copy(in, out2) == count);
+  test_assert(test::diff(out(Domain<1>(count)), out2(Domain<1>(count))) < -80);
+  copy.reset();
+  Vector<T> none(0);
+  Vector<T> exp = reference(h, none, in, D, 0);
+  count = copy(in, out2);
+  test_assert(count == exp.size());
+  test_assert(test::diff(out2(Domain<1>(count)), exp) < -80);
+}
+
+template <typename T, alg_hint_type H>
+void cases()
+{
+  length_type const kernels[] = {4, 17, 40, 100};
+  length_type const decimations[] = {1, 2, 3, 5};
+  for (index_type i = 0; i != 4; ++i)
+    for (index_type d = 0; d != 4 && decimations[d] < kernels[i]; ++d)
+    {
+      length_type k = kernels[i], D = decimations[d];
+      test_fir<T, nonsym, H>(k, 2 * k + 1, D);
+      test_fir<T, nonsym, H>(k, 5 * k, D);
+      test_fir<T, sym_even_len_even, H>(k, 4 * k + 3, D);
+      test_fir<T, sym_even_len_odd, H>(k, 4 * k + 2, D);
+    }
+  // The largest decimations the kernels allow, with a single tap in
+  // some polyphase sub-filters. For symmetric kernels these exceed the
+  // number of coefficients.
+  test_fir<T, nonsym, H>(4, 9, 3);
+  test_fir<T, sym_even_len_even, H>(4, 19, 7);
+  test_fir<T, sym_even_len_odd, H>(4, 18, 6);
+  test_fir<T, sym_even_len_even, H>(2, 10, 3);
+}
+
+template <typename T>
+void cases()
+{
+  cases<T, alg_time>();
+  cases<T, alg_space>();
+}
+
+int main(int argc, char **argv)
+{
+  vsipl init(argc, argv);
+
+  cases<float>();
+  cases<complex<float> >();
+  cases<double>();
+  cases<complex<double> >();
+}
@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+#include <vsip/vector.hpp>
+#include <vsip/matrix.hpp>
+#include <vsip/signal.hpp>
+#include <vsip/initfin.hpp>
+#include <vsip/random.hpp>
+#include <ovxx/signal/iir_bank.hpp>
+#include <test.hpp>
+#include <vector>
+#include <cstdlib>
+
+using namespace ovxx;
+
+// Compare an Iir_bank against one Iir per channel, over several calls.
+template <typename T, obj_state C, typename O>
+void test_bank(length_type sections, length_type channels, length_type N)
+{
+  typedef Iir<T, C> iir_type;
+  typedef Dense<2, T, O> block_type;
+
+  Rand<T> rand(0);
+  Matrix<T> b = rand.randu(sections, 3);
+  // Keep the poles well inside the unit circle.
+  Matrix<T> a = rand.randu(sections, 2);
+  a *= T(0.3);
+
+  signal::Iir_bank<T, C> bank(b, a, channels, N);
+  std::vector<iir_type> iirs(channels, iir_type(b, a, N));
+  test_assert(bank.output_size() == N);
+  test_assert(bank.kernel_size() == iirs[0].kernel_size());
+
+  Matrix<T, block_type> in(channels, N);
+  Matrix<T, block_type> out(channels, N);
+  Vector<T> exp(N);
+  for (index_type i = 0; i != 3; ++i)
+  {
+    in = rand.randu(channels, N);
+    bank(in, out);
+    for (index_type c = 0; c != channels; ++c)
+    {
+      iirs[c](in.row(c), exp);
+      test_assert(test::diff(out.row(c), exp) < -100);
+    }
+  }
+  bank.reset();
+  for (index_type c = 0; c != channels; ++c)
+    iirs[c].reset();
+  bank(in, out);
+  for (index_type c = 0; c != channels; ++c)
+  {
+    iirs[c](in.row(c), exp);
+    test_assert(test::diff(out.row(c), exp) < -100);
+  }
+}
+
+template <typename T>
+void cases()
+{
+  length_type const channels[] = {1, 5, 37};
+  for (index_type i = 0; i != 3; ++i)
+  {
+    length_type c = channels[i];
+    test_bank<T, state_save, row2_type>(1, c, 16);
+    test_bank<T, state_save, row2_type>(3, c, 33);
+    test_bank<T, state_no_save, row2_type>(3, c, 33);
+    test_bank<T, state_save, col2_type>(2, c, 20);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  setenv("OVXX_NUM_THREADS", "4", 1);
+  vsipl init(argc, argv);
+
+  // Exercise the threaded code path.
+  thread_pool::set_threshold(1);
+
+  cases<float>();
+  cases<complex<float> >();
+  cases<double>();
+  cases<complex<double> >();
+}
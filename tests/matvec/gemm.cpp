@@ -0,0 +1,170 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+/// Description
+///   Tests for the blocked matrix product engine, with problem sizes
+///   spanning several cache blocks. As the summation order differs from
+///   the reference's, errors are allowed to grow with the inner
+///   dimension.
+
+#include <vsip/initfin.hpp>
+#include <vsip/support.hpp>
+#include <vsip/math.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <test/ref/matvec.hpp>
+#include <test.hpp>
+#include "prod.hpp"
+
+using namespace ovxx;
+
+template <typename T, typename B>
+Matrix<typename scalar_of<T>::type>
+make_gauge(const_Matrix<T, B> g)
+{
+  typedef typename scalar_of<T>::type scalar_type;
+  Matrix<scalar_type> gauge(g.size(0), g.size(1));
+  gauge = mag(g);
+  for (index_type i = 0; i != gauge.size(0); ++i)
+    for (index_type j = 0; j != gauge.size(1); ++j)
+      if (!(gauge(i, j) > scalar_type()))
+	gauge(i, j) = scalar_type(1);
+  return gauge;
+}
+
+float tolerance(length_type k) { return std::max(10.f, float(k));}
+
+template <typename T, typename OA, typename OB, typename OR,
+	  storage_format_type F>
+void
+test_prod(length_type m, length_type n, length_type k)
+{
+  typedef Layout<2, OA, dense, F> layout_a;
+  typedef Layout<2, OB, dense, F> layout_b;
+  typedef Layout<2, OR, dense, F> layout_r;
+  Matrix<T, Strided<2, T, layout_a> > a(m, k);
+  Matrix<T, Strided<2, T, layout_b> > b(k, n);
+  Matrix<T, Strided<2, T, layout_r> > r(m, n);
+  test::randm(a);
+  test::randm(b);
+
+  r = prod(a, b);
+  check_prod(r, test::ref::prod(a, b),
+	     make_gauge(test::ref::prod(mag(a), mag(b))), tolerance(k));
+}
+
+template <typename T>
+void
+test_prodj(length_type m, length_type n, length_type k)
+{
+  Matrix<T> a(m, k);
+  Matrix<T> b(k, n);
+  Matrix<T> c(n, k);
+  Matrix<T> r(m, n);
+  test::randm(a);
+  test::randm(b);
+  test::randm(c);
+
+  r = prodj(a, b);
+  check_prod(r, test::ref::prod(a, conj(b)),
+	     make_gauge(test::ref::prod(mag(a), mag(b))), tolerance(k));
+  r = prodh(a, c);
+  check_prod(r, test::ref::prod(a, herm(c)),
+	     make_gauge(test::ref::prod(mag(a), mag(herm(c)))), tolerance(k));
+}
+
+template <typename T, typename O>
+void
+test_matvec(length_type m, length_type k)
+{
+  Matrix<T, Dense<2, T, O> > a(m, k);
+  Vector<T> x(k);
+  Vector<T> y(m);
+  test::randm(a);
+  test::randv(x);
+
+  Matrix<T> xm(k, 1);
+  xm.col(0) = x;
+  Matrix<T> ym(m, 1);
+  ym = test::ref::prod(a, xm);
+  Matrix<typename scalar_of<T>::type> gauge =
+    make_gauge(test::ref::prod(mag(a), mag(xm)));
+
+  y = prod(a, x);
+  Matrix<T> yc(m, 1);
+  yc.col(0) = y;
+  check_prod(yc, ym, gauge, tolerance(k));
+
+  // x^T * a^T
+  y = prod(x, a.transpose());
+  yc.col(0) = y;
+  check_prod(yc, ym, gauge, tolerance(k));
+
+  // A non-dense x is packed first.
+  Vector<T> xs(2 * k);
+  xs(Domain<1>(1, 2, k)) = x;
+  y = prod(a, xs(Domain<1>(1, 2, k)));
+  yc.col(0) = y;
+  check_prod(yc, ym, gauge, tolerance(k));
+}
+
+template <typename T>
+void
+test_subview(length_type m, length_type n, length_type k)
+{
+  Matrix<T> a(2 * m, 3 * k);
+  Matrix<T> b(k, 2 * n);
+  Matrix<T> r(m, n);
+  test::randm(a);
+  test::randm(b);
+  Domain<2> da(Domain<1>(0, 2, m), Domain<1>(1, 3, k));
+  Domain<2> db(Domain<1>(k), Domain<1>(0, 2, n));
+
+  r = prod(a(da), b(db));
+  check_prod(r, test::ref::prod(a(da), b(db)),
+	     make_gauge(test::ref::prod(mag(a(da)), mag(b(db)))), tolerance(k));
+}
+
+template <typename T>
+void
+cases()
+{
+  // Sizes chosen to cross the cache-block and micro-tile boundaries.
+  test_prod<T, row2_type, row2_type, row2_type, array>(131, 67, 300);
+  test_prod<T, col2_type, row2_type, row2_type, array>(67, 131, 29);
+  test_prod<T, row2_type, col2_type, col2_type, array>(250, 9, 41);
+  test_prod<T, col2_type, col2_type, row2_type, array>(13, 4100, 7);
+  test_matvec<T, row2_type>(301, 77);
+  test_matvec<T, col2_type>(1111, 31);
+  // Small enough to stay on the generic path.
+  test_matvec<T, row2_type>(5, 7);
+  test_subview<T>(37, 45, 53);
+}
+
+template <typename T>
+void
+complex_cases()
+{
+  cases<complex<T> >();
+  test_prod<complex<T>, row2_type, col2_type, row2_type, split_complex>(61, 70, 260);
+  test_prodj<complex<T> >(45, 39, 270);
+}
+
+int
+main(int argc, char **argv)
+{
+  vsipl init(argc, argv);
+
+  test::precision<float>::init();
+  test::precision<double>::init();
+  // Exercise the threaded code path.
+  thread_pool::set_threshold(1);
+
+  cases<float>();
+  cases<double>();
+  complex_cases<float>();
+  complex_cases<double>();
+}
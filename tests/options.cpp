@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+#include <vsip/initfin.hpp>
+#include <vsip/signal.hpp>
+#include <ovxx/options.hpp>
+#if OVXX_FFTW
+# include <ovxx/fftw/wisdom.hpp>
+# include <unistd.h>
+# include <cstdio>
+# include <set>
+# include <sstream>
+#endif
+#include <test.hpp>
+#include <cstdlib>
+#include <cstring>
+
+using namespace ovxx;
+
+void test_extract()
+{
+  char arg0[] = "program", arg1[] = "--ovxx-foo=1", arg2[] = "-v";
+  char arg3[] = "--ovxx-bar", arg4[] = "two", arg5[] = "--ovxx-foobar=3";
+  char *args[] = {arg0, arg1, arg2, arg3, arg4, arg5, 0};
+  int argc = 6;
+  char **argv = args;
+  std::string value;
+
+  test_assert(!options::extract(argc, argv, "ovxx-baz", value));
+  test_assert(argc == 6);
+  test_assert(options::extract(argc, argv, "ovxx-foo", value));
+  test_assert(value == "1");
+  test_assert(argc == 5);
+  test_assert(options::extract(argc, argv, "ovxx-bar", value));
+  test_assert(value == "two");
+  test_assert(argc == 3);
+  test_assert(!std::strcmp(argv[1], "-v"));
+  test_assert(!std::strcmp(argv[2], "--ovxx-foobar=3"));
+  test_assert(argv[3] == 0);
+  // Options without a value are left alone.
+  char *noval[] = {arg0, arg3, 0};
+  argc = 2;
+  argv = noval;
+  test_assert(!options::extract(argc, argv, "ovxx-bar", value));
+  test_assert(argc == 2);
+}
+
+void test_get()
+{
+  char arg0[] = "program", arg1[] = "--ovxx-foo=cmd";
+  char *args[] = {arg0, arg1, 0};
+  int argc = 2;
+  char **argv = args;
+  setenv("OVXX_TEST_FOO", "env", 1);
+  test_assert(options::get(argc, argv, "ovxx-foo", "OVXX_TEST_FOO") == "cmd");
+  test_assert(options::get(argc, argv, "ovxx-foo", "OVXX_TEST_FOO") == "env");
+  unsetenv("OVXX_TEST_FOO");
+  test_assert(options::get(argc, argv, "ovxx-foo", "OVXX_TEST_FOO", "x") == "x");
+}
+
+#if OVXX_FFTW
+// FFTW exports wisdom from a hash table, so the order of its entries
+// depends on the order they were added in. Compare them as a set.
+std::multiset<std::string> wisdom_entries(std::string const &wisdom)
+{
+  std::multiset<std::string> entries;
+  std::istringstream iss(wisdom);
+  std::string line;
+  while (std::getline(iss, line)) entries.insert(line);
+  return entries;
+}
+
+void test_wisdom()
+{
+  fftw::forget_wisdom();
+  {
+    // Ask for a measured plan, so there is wisdom to save.
+    vsip::Fft<vsip::const_Vector, vsip::complex<float>, vsip::complex<float>,
+              vsip::fft_fwd, vsip::by_value, 20>
+      fft(vsip::Domain<1>(256), 1.f);
+  }
+  std::string wisdom = fftw::export_wisdom<float>();
+  test_assert(!wisdom.empty());
+  fftw::forget_wisdom();
+  test_assert(fftw::import_wisdom<float>(wisdom));
+  test_assert(wisdom_entries(fftw::export_wisdom<float>()) ==
+              wisdom_entries(wisdom));
+
+  char path[] = "/tmp/ovxx-wisdom-XXXXXX";
+  int fd = mkstemp(path);
+  test_assert(fd != -1);
+  close(fd);
+  test_assert(fftw::save_wisdom(path));
+  fftw::forget_wisdom();
+  test_assert(fftw::load_wisdom(path));
+  test_assert(wisdom_entries(fftw::export_wisdom<float>()) ==
+              wisdom_entries(wisdom));
+  std::remove(path);
+  std::remove((std::string(path) + ".float").c_str());
+  std::remove((std::string(path) + ".double").c_str());
+}
+#endif
+
+int main(int argc, char **argv)
+{
+  vsipl library(argc, argv);
+  test_extract();
+  test_get();
+#if OVXX_FFTW
+  test_wisdom();
+#endif
+}
@@ -146,7 +146,7 @@ test_par_assign_cases(int loop)
 
 
 int
-main(int argc, char** argv)
+test_main(int argc, char **argv)
 {
   vsipl vpp(argc, argv);
 
@@ -173,3 +173,9 @@ main(int argc, char** argv)
 
   return 0;
 }
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
+}
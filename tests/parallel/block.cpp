@@ -386,7 +386,7 @@ test_matrix(int loop)
 
 
 int
-main(int argc, char** argv)
+test_main(int argc, char **argv)
 {
   vsipl vpp(argc, argv);
 
@@ -434,3 +434,9 @@ main(int argc, char** argv)
 
   return 0;
 }
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
+}
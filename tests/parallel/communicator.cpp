@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+/// Description
+///   Tests for the parallel service's communicator.
+
+#include <vsip/vector.hpp>
+#include <vsip/initfin.hpp>
+#include <vsip/support.hpp>
+#include <vsip/parallel.hpp>
+#include <test.hpp>
+#include <vector>
+
+using namespace ovxx;
+typedef parallel::Communicator::request_type request_type;
+typedef parallel::Communicator::chain_type chain_type;
+
+// Pass a message around the ring of processors.
+template <typename T>
+void
+ring(parallel::Communicator &comm, length_type size)
+{
+  processor_type rank = comm.rank();
+  processor_type next = (rank + 1) % comm.size();
+  processor_type prev = (rank + comm.size() - 1) % comm.size();
+
+  std::vector<T> out(size), in(size);
+  for (index_type i = 0; i != size; ++i)
+    out[i] = T(rank * size + i);
+
+  request_type req;
+  comm.send(next, &out[0], size, req);
+  comm.recv(prev, &in[0], size);
+  comm.wait(req);
+  for (index_type i = 0; i != size; ++i)
+    test_assert(in[i] == T(prev * size + i));
+}
+
+// Buffered sends complete right away, so the buffer may be
+// overwritten before the message is received.
+void
+buffered(parallel::Communicator &comm)
+{
+  processor_type rank = comm.rank();
+  processor_type next = (rank + 1) % comm.size();
+  processor_type prev = (rank + comm.size() - 1) % comm.size();
+
+  int value = rank;
+  comm.buf_send(next, &value, 1);
+  value = -1;
+  comm.buf_send(next, &value, 1);
+  comm.recv(prev, &value, 1);
+  test_assert(value == static_cast<int>(prev));
+  comm.recv(prev, &value, 1);
+  test_assert(value == -1);
+}
+
+// Send the odd columns of a (row-major) matrix to the next
+// processor's even columns with persistent requests.
+void
+persistent(parallel::Communicator &comm, length_type loop)
+{
+  length_type const rows = 5, cols = 8;
+  processor_type rank = comm.rank();
+  processor_type next = (rank + 1) % comm.size();
+  processor_type prev = (rank + comm.size() - 1) % comm.size();
+
+  std::vector<float> src(rows * cols), dst(rows * cols, -1.f);
+
+  parallel::Chain_builder odd;
+  odd.add<float>(sizeof(float), cols, rows, 2, cols / 2);
+  chain_type odd_chain = odd.get_chain();
+  parallel::Chain_builder even;
+  even.add<float>(0, cols, rows, 2, cols / 2);
+  chain_type even_chain = even.get_chain();
+
+  parallel::Chain_builder send_builder;
+  send_builder.stitch(&src[0], odd_chain);
+  chain_type send_chain = send_builder.get_chain();
+  parallel::Chain_builder recv_builder;
+  recv_builder.stitch(&dst[0], even_chain);
+  chain_type recv_chain = recv_builder.get_chain();
+
+  std::vector<request_type> send_reqs(1), recv_reqs(1);
+  comm.send_init(next, send_chain, send_reqs[0]);
+  comm.recv_init(prev, recv_chain, recv_reqs[0]);
+
+  for (index_type l = 0; l != loop; ++l)
+  {
+    for (index_type i = 0; i != src.size(); ++i)
+      src[i] = l * 1000 + rank * 100 + i;
+    comm.start(recv_reqs);
+    comm.start(send_reqs);
+    comm.wait(recv_reqs);
+    comm.wait(send_reqs);
+    for (index_type r = 0; r != rows; ++r)
+      for (index_type c = 0; c != cols; ++c)
+	if (c % 2)
+	  test_assert(dst[r * cols + c] == -1.f);
+	else
+	  test_assert(dst[r * cols + c] == l * 1000 + prev * 100 + r * cols + c + 1);
+  }
+  comm.free(send_reqs[0]);
+  comm.free(recv_reqs[0]);
+  parallel::free_chain(send_chain);
+  parallel::free_chain(recv_chain);
+  parallel::free_chain(odd_chain);
+  parallel::free_chain(even_chain);
+}
+
+void
+collectives(parallel::Communicator &comm)
+{
+  processor_type rank = comm.rank();
+  length_type size = comm.size();
+
+  for (processor_type root = 0; root != size; ++root)
+  {
+    complex<float> values[3];
+    for (index_type i = 0; i != 3; ++i)
+      values[i] = rank == root ? complex<float>(root, i) : complex<float>();
+    comm.broadcast(root, values, 3);
+    for (index_type i = 0; i != 3; ++i)
+      test_assert(values[i] == complex<float>(root, i));
+
+    // Large enough not to fit into any buffer set up by the above.
+    std::vector<double> data(5000, rank == root ? root + 0.5 : -1.);
+    comm.broadcast(root, &data[0], data.size());
+    for (index_type i = 0; i != data.size(); ++i)
+      test_assert(data[i] == root + 0.5);
+  }
+
+  test_assert(comm.allreduce(reduce_sum, int(rank + 1)) ==
+	      static_cast<int>(size * (size + 1) / 2));
+  test_assert(comm.allreduce(reduce_max, float(rank)) == size - 1);
+  test_assert(comm.allreduce(reduce_min, double(rank) + 1) == 1.);
+  test_assert(comm.allreduce(reduce_all_true_bool, true));
+  test_assert(!comm.allreduce(reduce_all_true_bool, rank != 0));
+  test_assert(comm.allreduce(reduce_any_true_bool, rank == size - 1));
+  comm.barrier();
+}
+
+// Split the processors into those of even and odd rank, the latter
+// ranked in reverse order, and communicate within each subset.
+void
+split(parallel::Communicator &comm)
+{
+  processor_type rank = comm.rank();
+  length_type size = comm.size();
+  int color = rank % 2;
+  parallel::Communicator sub = comm.split(color, color ? -int(rank) : 0);
+  length_type sub_size = (size + 1 - color) / 2;
+  test_assert(sub.size() == sub_size);
+  if (color)
+    test_assert(sub.rank() == sub_size - 1 - rank / 2);
+  else
+    test_assert(sub.rank() == rank / 2);
+  ring<int>(sub, 10);
+  collectives(sub);
+  comm.barrier();
+}
+
+int
+test_main(int argc, char **argv)
+{
+  vsipl library(argc, argv);
+
+  parallel::Communicator &comm = parallel::default_communicator();
+  test_assert(comm.size() == num_processors());
+  test_assert(comm.rank() == local_processor());
+
+  ring<int>(comm, 1);
+  ring<float>(comm, 1000);
+  ring<complex<double> >(comm, 17);
+  buffered(comm);
+  persistent(comm, 3);
+  collectives(comm);
+  split(comm);
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
+}
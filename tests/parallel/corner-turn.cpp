@@ -60,7 +60,7 @@ corner_turn(length_type rows,
 
 
 int
-main(int argc, char** argv)
+test_main(int argc, char **argv)
 {
   vsipl vpp(argc, argv);
 
@@ -95,3 +95,9 @@ main(int argc, char** argv)
 
   return 0;
 }
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
+}
@@ -528,7 +528,7 @@ test_matrix_assign(int loop)
 
 
 int
-main(int argc, char** argv)
+test_main(int argc, char **argv)
 {
   vsipl vpp(argc, argv);
 
@@ -556,4 +556,11 @@ main(int argc, char** argv)
 			       loop);
   test_vector_assign<float>(loop);
   test_matrix_assign<float>(loop);
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
 }
@@ -491,7 +491,7 @@ test_cases()
 };
 
 int
-main(int argc, char** argv)
+test_main(int argc, char **argv)
 {
   
   vsipl init(argc, argv);
@@ -527,3 +527,9 @@ main(int argc, char** argv)
 
   return 0;
 }
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
+}
@@ -117,7 +117,7 @@ test_assign_local(length_type rows, length_type cols)
 
 
 int
-main(int argc, char** argv)
+test_main(int argc, char **argv)
 {
   vsipl vpp(argc, argv);
 
@@ -144,3 +144,9 @@ main(int argc, char** argv)
 
   return 0;
 }
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
+}
@@ -68,7 +68,7 @@ test_maxval_nd(Domain<Dim> const& dom)
 }
 
 int
-main(int argc, char** argv)
+test_main(int argc, char **argv)
 {
   vsipl init(argc, argv);
 
@@ -96,3 +96,9 @@ main(int argc, char** argv)
 
   return 0;
 }
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
+}
@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+/// Description
+///   Tests for reusable redistribution plans.
+
+#include <vsip/initfin.hpp>
+#include <vsip/support.hpp>
+#include <vsip/map.hpp>
+#include <vsip/matrix.hpp>
+#include <vsip/parallel.hpp>
+#include <test.hpp>
+#include "util.hpp"
+
+using namespace ovxx;
+
+// Repeatedly corner-turn a matrix with the same plan, changing its
+// values between executions.
+template <typename T>
+void
+corner_turn(length_type rows, length_type cols, length_type loop)
+{
+  typedef Map<Block_dist, Block_dist>      map_type;
+  typedef Dense<2, T, row2_type, map_type> block_type;
+  typedef Matrix<T, block_type>            view_type;
+
+  processor_type np = num_processors();
+
+  map_type row_map(np, 1);
+  map_type col_map(1, np);
+
+  view_type A(rows, cols, row_map);
+  view_type B(rows, cols, T(-1), col_map);
+
+  parallel::Redistribution<view_type, view_type> turn(B, A);
+
+  for (index_type l = 0; l != loop; ++l)
+  {
+    for (index_type r = 0; r != A.local().size(0); ++r)
+      for (index_type c = 0; c != A.local().size(1); ++c)
+      {
+	index_type gr = global_from_local_index(A, 0, r);
+	index_type gc = global_from_local_index(A, 1, c);
+	A.local().put(r, c, T(l * rows * cols + gr * cols + gc));
+      }
+    turn();
+    for (index_type r = 0; r != B.local().size(0); ++r)
+      for (index_type c = 0; c != B.local().size(1); ++c)
+      {
+	index_type gr = global_from_local_index(B, 0, r);
+	index_type gc = global_from_local_index(B, 1, c);
+	test_assert(equal(B.local().get(r, c),
+			  T(l * rows * cols + gr * cols + gc)));
+      }
+  }
+}
+
+// Repeatedly redistribute a block-distributed vector.
+template <typename T>
+void
+vector_redist(length_type size, length_type loop)
+{
+  typedef Map<Block_dist>               map_type;
+  typedef Dense<1, T, row1_type, map_type> block_type;
+  typedef Vector<T, block_type>            view_type;
+
+  processor_type np = num_processors();
+
+  map_type src_map(np);
+  map_type dst_map(np > 1 ? np - 1 : 1);
+
+  view_type src(size, src_map);
+  view_type dst(size, T(), dst_map);
+
+  parallel::Redistribution<view_type, view_type> redist(dst, src);
+
+  for (index_type l = 0; l != loop; ++l)
+  {
+    for (index_type i = 0; i != src.local().size(); ++i)
+      src.local().put(i, T(l + global_from_local_index(src, 0, i)));
+    redist();
+    for (index_type i = 0; i != dst.local().size(); ++i)
+      test_assert(equal(dst.local().get(i),
+			T(l + global_from_local_index(dst, 0, i))));
+  }
+}
+
+// Double-buffer a corner turn: while one buffer is in transit, the
+// other one is filled and checked.
+template <typename T>
+void
+split_phase(length_type rows, length_type cols, length_type loop)
+{
+  typedef Map<Block_dist, Block_dist>      map_type;
+  typedef Dense<2, T, row2_type, map_type> block_type;
+  typedef Matrix<T, block_type>            view_type;
+  typedef parallel::Redistribution<view_type, view_type> plan_type;
+
+  processor_type np = num_processors();
+
+  map_type row_map(np, 1);
+  map_type col_map(1, np);
+
+  view_type A0(rows, cols, row_map), A1(rows, cols, row_map);
+  view_type B0(rows, cols, col_map), B1(rows, cols, col_map);
+  view_type *A[] = {&A0, &A1};
+  view_type *B[] = {&B0, &B1};
+  plan_type turn0(B0, A0), turn1(B1, A1);
+  plan_type *turn[] = {&turn0, &turn1};
+
+  for (index_type l = 0; l != loop; ++l)
+  {
+    view_type &src = *A[l % 2];
+    for (index_type r = 0; r != src.local().size(0); ++r)
+      for (index_type c = 0; c != src.local().size(1); ++c)
+	src.local().put(r, c, T(l + global_from_local_index(src, 0, r)
+				+ rows * global_from_local_index(src, 1, c)));
+    turn[l % 2]->start();
+    if (l == 0) continue;
+    // Collect the previous iteration's result.
+    turn[(l - 1) % 2]->wait();
+    view_type &dst = *B[(l - 1) % 2];
+    for (index_type r = 0; r != dst.local().size(0); ++r)
+      for (index_type c = 0; c != dst.local().size(1); ++c)
+	test_assert(equal(dst.local().get(r, c),
+			  T(l - 1 + global_from_local_index(dst, 0, r)
+			    + rows * global_from_local_index(dst, 1, c))));
+  }
+  // The last redistribution is completed by its plan's destructor.
+}
+
+int
+test_main(int argc, char **argv)
+{
+  vsipl library(argc, argv);
+
+  corner_turn<float>(32, 64, 5);
+  corner_turn<complex<float> >(31, 15, 5);
+  corner_turn<complex<float> >(11, 3, 3);
+
+  vector_redist<float>(100, 5);
+  vector_redist<complex<float> >(37, 3);
+
+  split_phase<float>(32, 16, 6);
+  split_phase<complex<float> >(15, 31, 5);
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
+}
@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+/// Description
+///   Test value reductions of distributed views.
+
+#include <vsip/initfin.hpp>
+#include <vsip/support.hpp>
+#include <vsip/vector.hpp>
+#include <vsip/matrix.hpp>
+#include <vsip/math.hpp>
+#include <vsip/parallel.hpp>
+#include <test.hpp>
+
+using namespace ovxx;
+
+template <typename T, typename M>
+void
+test_vector(M const &map, length_type size)
+{
+  Vector<T, Dense<1, T, row1_type, M> > view(size, map);
+  for (index_type i = 0; i != size; ++i)
+    view.put(i, T(i % 7));
+
+  T sum = T(), sumsq = T();
+  for (index_type i = 0; i != size; ++i)
+  {
+    sum += T(i % 7);
+    sumsq += T(i % 7) * T(i % 7);
+  }
+  test_assert(equal(sumval(view), sum));
+  test_assert(equal(sumsqval(view), sumsq));
+  test_assert(!alltrue(view > T(0)));
+  test_assert(alltrue(view >= T(0)));
+  test_assert(anytrue(view == T(1)));
+  test_assert(!anytrue(view == T(7)));
+
+  Vector<bool, Dense<1, bool, row1_type, M> > flags(size, map);
+  flags = view >= T(0);
+  test_assert(alltrue(flags));
+  flags = view > T(0);
+  test_assert(!alltrue(flags));
+  test_assert(anytrue(flags));
+  flags = view > T(6);
+  test_assert(!anytrue(flags));
+}
+
+template <typename T, typename M>
+void
+test_matrix(M const &map, length_type rows, length_type cols)
+{
+  Matrix<T, Dense<2, T, row2_type, M> > view(rows, cols, map);
+  T sum = T();
+  for (index_type r = 0; r != rows; ++r)
+    for (index_type c = 0; c != cols; ++c)
+    {
+      view.put(r, c, T(r + c));
+      sum += T(r + c);
+    }
+  test_assert(equal(sumval(view), sum));
+}
+
+int
+test_main(int argc, char **argv)
+{
+  vsipl library(argc, argv);
+
+  length_type np = num_processors();
+  Vector<processor_type> pvec = processor_set();
+
+  test_vector<float>(Map<>(np), 64);
+  test_vector<double>(Map<>(np), 61);
+  test_vector<int>(Map<>(np), 5);
+  test_vector<float>(Map<Cyclic_dist>(np), 19);
+  test_vector<float>(Replicated_map<1>(), 16);
+  // Only the first processor holds data.
+  test_vector<float>(Map<>(pvec(Domain<1>(1)), 1), 16);
+
+  test_matrix<float>(Map<>(np, 1), 16, 8);
+  test_matrix<float>(Map<>(1, np), 5, 33);
+  test_matrix<double>(Map<>(np, 1), 3, 4);
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
+}
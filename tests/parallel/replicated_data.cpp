@@ -280,8 +280,44 @@ test_repl_to_block(int modulo)
 
 
 
+// Test repeated assignments into a matrix replicated on all processors.
+// With several processors per node (see --ovxx-node-size), only node
+// leaders receive the data, and replicate it within their node.
+
+template <typename T>
+void
+test_block_to_repl_2d(length_type rows, length_type cols)
+{
+  length_type np = num_processors();
+
+  Map<>             src_map(np, 1);
+  Replicated_map<2> dst_map;
+
+  typedef Dense<2, T, row2_type, Map<> >             src_block_type;
+  typedef Dense<2, T, row2_type, Replicated_map<2> > dst_block_type;
+
+  Matrix<T, src_block_type> src(rows, cols, src_map);
+  Matrix<T, dst_block_type> dst(rows, cols, dst_map);
+
+  for (index_type pass=0; pass<3; ++pass)
+  {
+    for (index_type r=0; r<rows; ++r)
+      for (index_type c=0; c<cols; ++c)
+	src.put(r, c, T(pass * rows * cols + r * cols + c));
+
+    dst = src;
+
+    typename Matrix<T, dst_block_type>::local_type l_dst = dst.local();
+    for (index_type r=0; r<rows; ++r)
+      for (index_type c=0; c<cols; ++c)
+	test_assert(l_dst.get(r, c) == T(pass * rows * cols + r * cols + c));
+  }
+}
+
+
+
 int
-main(int argc, char** argv)
+test_main(int argc, char **argv)
 {
   vsipl vpp(argc, argv);
 
@@ -319,4 +355,14 @@ main(int argc, char** argv)
   test_repl_to_block<float>(1);
   test_repl_to_block<float>(2);
   test_repl_to_block<float>(4);
+
+  test_block_to_repl_2d<float>(16, 64);
+  test_block_to_repl_2d<complex<float> >(64, 256);
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
 }
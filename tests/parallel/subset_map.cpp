@@ -527,7 +527,7 @@ test_src_dst_type(SrcMapT&         src_map,
 ***********************************************************************/
 
 int
-main(int argc, char** argv)
+test_main(int argc, char **argv)
 {
   vsipl init(argc, argv);
 
@@ -603,4 +603,11 @@ main(int argc, char** argv)
     test_src_dst_type<float>(x_map, x_map, 256, 128, dom[i], dom[i+1]);
   }
 #endif
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
 }
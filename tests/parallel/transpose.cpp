@@ -175,7 +175,7 @@ test_x(MapT &map, length_type rows, length_type cols)
 
 
 int
-main(int argc, char** argv)
+test_main(int argc, char **argv)
 {
   vsipl init(argc, argv);
 
@@ -242,4 +242,11 @@ main(int argc, char** argv)
     map_type map;
     test_subviews(map, 4, 8, false);
   }
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
 }
@@ -139,7 +139,7 @@ test1(
 
 
 int
-main(int argc, char** argv)
+test_main(int argc, char **argv)
 {
   vsipl init(argc, argv);
 
@@ -168,4 +168,11 @@ main(int argc, char** argv)
   Map<Cyclic_dist> map2 = Map<Cyclic_dist>(Cyclic_dist(np));
   test1<float>(Domain<1>(10), map2, false);
 #endif
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
 }
@@ -141,7 +141,7 @@ par_vmmul_cases()
 
 
 int
-main(int argc, char** argv)
+test_main(int argc, char **argv)
 {
   vsipl init(argc, argv);
 
@@ -149,4 +149,11 @@ main(int argc, char** argv)
   par_vmmul_cases<col2_type, float>();
   par_vmmul_cases<row2_type, complex<float> >();
   par_vmmul_cases<col2_type, complex<float> >();
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
 }
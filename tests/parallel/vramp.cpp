@@ -213,7 +213,8 @@ int test_vramp(Domain<ViewT::dim> sz)
 }
 
 
-int main(int argc, char **argv)
+int
+test_main(int argc, char **argv)
 {
   length_type size=16;
 
@@ -234,3 +235,9 @@ int main(int argc, char **argv)
 
   return 0;
 }
+
+int
+main(int argc, char **argv)
+{
+  return parallel::run(test_main, argc, argv);
+}
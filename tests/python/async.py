@@ -0,0 +1,48 @@
+#
+# Copyright (c) 2014 Stefan Seefeld
+# All rights reserved.
+#
+# This file is part of OpenVSIP. It is made available under the
+# license contained in the accompanying LICENSE.BSD file.
+
+from vsip import vector
+from vsip.selgen.generation import ramp
+from vsip.math import elementwise as elm
+from vsip.signal import *
+from vsip.signal.fft import fft
+from vsip.signal.fir import fir
+from vsip.signal.conv import conv
+import numpy as np
+
+# Asynchronous calls run in threads of their own, and must compute
+# the same as synchronous ones, even if they create temporary blocks.
+
+x = elm.sin(ramp(float, 0, 0.1, 1024))
+k = elm.cos(ramp(float, 0, 0.5, 16))
+
+# fft
+f = fft(float, fwd, 1024, 1., 1, alg_hint.time)
+ref = vector(complex, 513)
+f(x, ref)
+out = vector(complex, 513)
+future = f.call_async(x, out)
+future.wait()
+assert future.done()
+assert np.isclose(ref, out).all()
+
+# fir
+f = fir(k, symmetry.none, 1024, 1, obj_state.no_save, 1, alg_hint.time)
+ref = vector(float, 1024)
+f(x, ref)
+f = fir(k, symmetry.none, 1024, 1, obj_state.no_save, 1, alg_hint.time)
+out = vector(float, 1024)
+f.call_async(x, out).wait()
+assert np.isclose(ref, out).all()
+
+# conv
+c = conv(k, symmetry.none, support_region.full, 1024, 1, 1, alg_hint.time)
+ref = vector(float, c.output_size)
+c(x, ref)
+out = vector(float, c.output_size)
+c.call_async(x, out).wait()
+assert np.isclose(ref, out).all()
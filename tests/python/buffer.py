@@ -0,0 +1,100 @@
+#
+# Copyright (c) 2014 Stefan Seefeld
+# All rights reserved.
+#
+# This file is part of OpenVSIP. It is made available under the
+# license contained in the accompanying LICENSE.BSD file.
+
+from numpy import arange, asarray, asfortranarray
+from vsip import vector, matrix
+from ctypes import pythonapi, py_object, c_int, c_void_p, create_string_buffer
+
+# Request a buffer with the given flags from obj, as a C consumer would.
+# Returns True on success, and False if a BufferError was raised.
+def get_buffer(obj, flags):
+    view = create_string_buffer(256) # large enough for a Py_buffer
+    pythonapi.PyObject_GetBuffer.argtypes = [py_object, c_void_p, c_int]
+    pythonapi.PyBuffer_Release.argtypes = [c_void_p]
+    try:
+        pythonapi.PyObject_GetBuffer(obj, view, flags)
+    except BufferError:
+        return False
+    pythonapi.PyBuffer_Release(view)
+    return True
+
+PyBUF_SIMPLE = 0
+PyBUF_STRIDES = 0x18
+PyBUF_C_CONTIGUOUS = 0x20 | PyBUF_STRIDES
+PyBUF_F_CONTIGUOUS = 0x40 | PyBUF_STRIDES
+PyBUF_ANY_CONTIGUOUS = 0x80 | PyBUF_STRIDES
+
+# Adopt a 1D array without copying
+a = arange(8, dtype=float)
+v = vector(array=a)
+a[2] = 42.
+assert v[2] == 42.
+v[3] = 13.
+assert a[3] == 13.
+
+# Export it again through the buffer protocol
+m = memoryview(v.block)
+assert m.ndim == 1
+assert m.shape == (8,)
+assert m.strides == (8,)
+assert m.format == 'd'
+b = asarray(m)
+assert b.shape == (8,)
+b[4] = 7.
+assert v[4] == 7. and a[4] == 7.
+del m, b
+
+# Adopt a strided array
+a = arange(16, dtype=float)
+v = vector(array=a[1::2])
+a[3] = 5.
+assert v[1] == 5.
+m = memoryview(v.block)
+assert m.shape == (8,)
+assert m.strides == (16,)
+b = asarray(m)
+b[2] = -1.
+assert a[5] == -1.
+del m, b
+
+# Adopt 2D arrays in C and Fortran order
+for a in (arange(12, dtype=float).reshape(3, 4),
+          asfortranarray(arange(12, dtype=float).reshape(3, 4))):
+    mat = matrix(array=a)
+    a[1, 2] = 42.
+    assert mat[1, 2] == 42.
+    m = memoryview(mat.block)
+    assert m.shape == (3, 4)
+    assert m.strides == a.strides
+    b = asarray(m)
+    assert (b == a).all()
+    b[2, 3] = 13.
+    assert mat[2, 3] == 13. and a[2, 3] == 13.
+    del m, b
+
+# Complex data
+a = arange(8, dtype=complex)
+v = vector(array=a)
+m = memoryview(v.block)
+assert m.shape == (8,)
+assert m.itemsize == 16
+b = asarray(m)
+b[1] = 1j
+assert v[1] == 1j and a[1] == 1j
+del m, b
+
+# Contiguity requests that can't be met raise BufferError
+a = arange(12, dtype=float).reshape(3, 4)
+for a, c, f in ((a, True, False),
+                (asfortranarray(a), False, True),
+                (a[:, ::2], False, False)):
+    mat = matrix(array=a)
+    assert get_buffer(mat.block, PyBUF_STRIDES)
+    assert get_buffer(mat.block, PyBUF_SIMPLE) == c
+    assert get_buffer(mat.block, PyBUF_C_CONTIGUOUS) == c
+    assert get_buffer(mat.block, PyBUF_F_CONTIGUOUS) == f
+    assert get_buffer(mat.block, PyBUF_ANY_CONTIGUOUS) == (c or f)
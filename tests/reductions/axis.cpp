@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+/// Description
+///   Tests for reductions along one axis of a matrix or tensor.
+
+#include <vsip/initfin.hpp>
+#include <vsip/support.hpp>
+#include <vsip/math.hpp>
+#include <vsip/random.hpp>
+#include <ovxx/reductions/axis.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <test.hpp>
+#include <cstdlib>
+
+using namespace ovxx;
+
+template <typename T, typename O>
+void test_matrix(length_type rows, length_type cols)
+{
+  Matrix<T, Dense<2, T, O> > m(rows, cols);
+  Rand<T> rand(rows * cols);
+  m = rand.randu(rows, cols);
+
+  for (dimension_type axis = 0; axis != 2; ++axis)
+  {
+    length_type const size = m.size(1 - axis);
+    Vector<T> sum = sumval(m, axis);
+    Vector<T> mean = meanval(m, axis);
+    Vector<T> max = maxval(m, axis);
+    Vector<T> min = minval(m, axis);
+    test_assert(sum.size() == size);
+    for (index_type i = 0; i != size; ++i)
+    {
+      Vector<T> v(m.size(axis));
+      if (axis == 0) v = m.col(i);
+      else v = m.row(i);
+      test_assert(equal(sum.get(i), sumval(v)));
+      test_assert(equal(mean.get(i), meanval(v)));
+      Index<1> idx;
+      test_assert(equal(max.get(i), vsip::maxval(v, idx)));
+      test_assert(equal(min.get(i), vsip::minval(v, idx)));
+    }
+  }
+
+  // A strided subview.
+  if (rows > 2 && cols > 3)
+  {
+    Domain<2> sub(Domain<1>(1, 2, rows / 2), Domain<1>(0, 3, cols / 3));
+    Vector<T> sum = sumval(m(sub), 1);
+    for (index_type i = 0; i != sum.size(); ++i)
+      test_assert(equal(sum.get(i), sumval(m(sub).row(i))));
+  }
+
+  // An expression.
+  Vector<T> sumsq = sumsqval(m * T(2), 0);
+  for (index_type i = 0; i != sumsq.size(); ++i)
+    test_assert(equal(sumsq.get(i), sumsqval(m.col(i) * T(2))));
+}
+
+template <typename T>
+void test_complex(length_type rows, length_type cols)
+{
+  Matrix<complex<T> > m(rows, cols);
+  Rand<complex<T> > rand(rows + cols);
+  m = rand.randu(rows, cols);
+
+  Vector<complex<T> > sum = sumval(m, 0);
+  Vector<T> power = meansqval(m, 0);
+  Vector<T> peak = maxmgsqval(m, 1);
+  for (index_type i = 0; i != cols; ++i)
+  {
+    test_assert(equal(sum.get(i), sumval(m.col(i))));
+    test_assert(equal(power.get(i), meansqval(m.col(i))));
+  }
+  for (index_type i = 0; i != rows; ++i)
+  {
+    Index<1> idx;
+    test_assert(equal(peak.get(i), vsip::maxmgsqval(m.row(i), idx)));
+  }
+}
+
+template <typename T, typename O>
+void test_tensor(length_type size0, length_type size1, length_type size2)
+{
+  Tensor<T, Dense<3, T, O> > t(size0, size1, size2);
+  for (index_type i = 0; i != size0; ++i)
+    for (index_type j = 0; j != size1; ++j)
+      for (index_type k = 0; k != size2; ++k)
+	t.put(i, j, k, T(i * 100 + j * 10 + k));
+
+  Matrix<T> sum0 = sumval(t, 0);
+  Matrix<T> sum1 = sumval(t, 1);
+  Matrix<T> max2 = maxval(t, 2);
+  test_assert(sum0.size(0) == size1 && sum0.size(1) == size2);
+  test_assert(sum1.size(0) == size0 && sum1.size(1) == size2);
+  test_assert(max2.size(0) == size0 && max2.size(1) == size1);
+  for (index_type j = 0; j != size1; ++j)
+    for (index_type k = 0; k != size2; ++k)
+    {
+      T s = T();
+      for (index_type i = 0; i != size0; ++i) s += t.get(i, j, k);
+      test_assert(equal(sum0.get(j, k), s));
+    }
+  for (index_type i = 0; i != size0; ++i)
+    for (index_type k = 0; k != size2; ++k)
+    {
+      T s = T();
+      for (index_type j = 0; j != size1; ++j) s += t.get(i, j, k);
+      test_assert(equal(sum1.get(i, k), s));
+    }
+  for (index_type i = 0; i != size0; ++i)
+    for (index_type j = 0; j != size1; ++j)
+      test_assert(equal(max2.get(i, j), t.get(i, j, size2 - 1)));
+}
+
+template <typename T>
+void cases()
+{
+  test_matrix<T, row2_type>(1, 1);
+  test_matrix<T, row2_type>(7, 9);
+  test_matrix<T, col2_type>(7, 9);
+  test_matrix<T, row2_type>(33, 2049);
+  test_matrix<T, col2_type>(2049, 33);
+  test_tensor<T, row3_type>(3, 4, 5);
+  test_tensor<T, col3_type>(3, 4, 5);
+  test_tensor<T, tuple<1, 0, 2> >(5, 3, 4);
+  test_tensor<T, tuple<2, 0, 1> >(4, 5, 3);
+}
+
+int
+main(int argc, char **argv)
+{
+  setenv("OVXX_NUM_THREADS", "4", 1);
+  vsipl init(argc, argv);
+
+  // Exercise the threaded code path.
+  thread_pool::set_threshold(1);
+
+  cases<float>();
+  cases<double>();
+  test_matrix<int, row2_type>(17, 13);
+  test_complex<float>(16, 40);
+  test_complex<double>(40, 16);
+}
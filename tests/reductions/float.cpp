@@ -54,6 +54,11 @@ simple_tests()
   test_assert(equal(sumsqval(ten),  54.0f));
   test_assert(equal(meansqval(ten), 13.5f));
 
+  // Empty views, such as the local subblocks of small distributed ones.
+  Vector<float> empty(0);
+  test_assert(equal(sumval(empty), 0.0f));
+  test_assert(equal(sumsqval(empty), 0.0f));
+
   Vector<complex<float> > cvec(2);
 
   cvec(0) = complex<float>(3.f,  4.f); // -7 + 24i
@@ -0,0 +1,293 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+/// Description
+///   Tests for summarized reductions and the fused stats() API.
+
+#include <vsip/initfin.hpp>
+#include <vsip/support.hpp>
+#include <vsip/math.hpp>
+#include <vsip/random.hpp>
+#include <vsip/signal.hpp>
+#include <ovxx/reductions/stats.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <test.hpp>
+#include <cmath>
+#include <cstdlib>
+
+using namespace ovxx;
+
+template <typename T>
+struct reference
+{
+  typedef typename scalar_of<T>::type scalar_type;
+
+  template <typename V>
+  reference(V view)
+    : sum(), sumsq(), min(), max(), min_idx(0), max_idx(0)
+  {
+    for (index_type i = 0; i != view.size(); ++i)
+    {
+      T value = view.get(i);
+      long double k = key(value);
+      sum += complex<long double>(value);
+      sumsq += magsq(complex<long double>(value));
+      if (i == 0 || k < min) { min = k; min_idx = i;}
+      if (i == 0 || k > max) { max = k; max_idx = i;}
+    }
+  }
+  static long double key(scalar_type v) { return v;}
+  static long double key(complex<scalar_type> const &v) { return magsq(v);}
+
+  complex<long double> sum;
+  long double sumsq;
+  long double min;
+  long double max;
+  index_type min_idx;
+  index_type max_idx;
+};
+
+template <typename T>
+bool close(T value, long double expected)
+{
+  long double tolerance = is_same<typename scalar_of<T>::type, float>::value ?
+    1e-6 : 1e-10;
+  return std::abs(value - expected) <= tolerance * (1 + std::abs(expected));
+}
+
+template <typename T>
+bool close(complex<T> value, complex<long double> const &expected)
+{
+  return close(value.real(), expected.real()) &&
+    close(value.imag(), expected.imag());
+}
+
+template <typename T>
+bool close(T value, complex<long double> const &expected)
+{ return close(value, expected.real());}
+
+template <typename T, storage_format_type F>
+void test_vector(length_type size)
+{
+  typedef Layout<1, row1_type, dense, F> layout_type;
+  typedef typename scalar_of<T>::type scalar_type;
+  Vector<T, Strided<1, T, layout_type> > view(size);
+  Rand<T> rand(size);
+  view = rand.randu(size) - T(0.5);
+  // A large offset makes naive single-precision summation inaccurate.
+  view += T(100);
+  reference<T> ref(view);
+
+  test_assert(close(sumval(view), ref.sum));
+  test_assert(close(meanval(view), ref.sum / (long double)size));
+  test_assert(close(meansqval(view), ref.sumsq / size));
+
+  Statistics<T, 1> s = stats(view);
+  test_assert(close(s.sum, ref.sum));
+  test_assert(close(s.mean, ref.sum / (long double)size));
+  test_assert(close(s.sumsq, ref.sumsq));
+  test_assert(close(s.meansq, ref.sumsq / size));
+  test_assert(equal(s.min, scalar_type(ref.min)));
+  test_assert(equal(s.max, scalar_type(ref.max)));
+  test_assert(s.min_idx[0] == ref.min_idx);
+  test_assert(s.max_idx[0] == ref.max_idx);
+}
+
+template <typename T>
+void test_sumsq(length_type size)
+{
+  Vector<T> view(size);
+  Rand<T> rand(size);
+  view = rand.randu(size);
+  reference<T> ref(view);
+  test_assert(close(sumsqval(view), ref.sumsq));
+}
+
+// For complex views, stats() reports the sum of the magnitudes
+// squared, not the complex sum of squares sumsqval() computes.
+template <typename T>
+void test_complex_sumsq(length_type size)
+{
+  Vector<complex<T> > view(size);
+  Rand<complex<T> > rand(size);
+  view = rand.randu(size) - complex<T>(0.5, 0.5);
+  reference<complex<T> > ref(view);
+  complex<long double> sumsq;
+  for (index_type i = 0; i != size; ++i)
+  {
+    complex<long double> value(view.get(i));
+    sumsq += value * value;
+  }
+
+  Statistics<complex<T>, 1> s = stats(view);
+  test_assert(close(s.sumsq, ref.sumsq));
+  test_assert(close(s.meansq, ref.sumsq / size));
+  test_assert(close(s.meansq, (long double)meansqval(view)));
+  // The terms of sum(z^2) cancel, so compare relative to sum(|z|^2).
+  long double tolerance = is_same<T, float>::value ? 1e-6 : 1e-10;
+  complex<long double> error = complex<long double>(sumsqval(view)) - sumsq;
+  test_assert(std::abs(error) <= tolerance * (1 + ref.sumsq));
+  test_assert(!close(sumsqval(view), complex<long double>(s.sumsq)));
+}
+
+template <typename T>
+void test_extrema(length_type size)
+{
+  Vector<T> view(size, T(1));
+  Index<1> idx;
+  // Ties resolve to the first occurrence.
+  index_type i = size / 3;
+  view.put(i, T(5));
+  view.put(size - 1, T(5));
+  view.put(size / 2, T(-7));
+  view.put(size / 4, T(-7));
+  test_assert(equal(maxval(view, idx), T(5)));
+  test_assert(idx[0] == std::min(i, size - 1));
+  test_assert(equal(minval(view, idx), T(-7)));
+  test_assert(idx[0] == std::min(size / 2, size / 4));
+
+  Vector<complex<T> > cview(size, complex<T>(1, 1));
+  cview.put(i, complex<T>(3, -4));
+  cview.put(size / 2, complex<T>(0, 0.5));
+  test_assert(equal(maxmgsqval(cview, idx), T(25)));
+  test_assert(idx[0] == i);
+  test_assert(equal(maxmgval(cview, idx), T(5)));
+  test_assert(idx[0] == i);
+  test_assert(equal(minmgsqval(cview, idx), T(0.25)));
+  test_assert(idx[0] == size / 2);
+}
+
+// Expressions and strided views are read in tiles.
+template <typename T>
+void test_tiled(length_type size)
+{
+  typedef typename scalar_of<T>::type scalar_type;
+  Vector<T> a(2 * size), b(size);
+  Rand<T> rand(size);
+  a = rand.randu(2 * size) + T(100);
+  b = rand.randu(size) + T(0.5);
+  reference<T> ref(a(Domain<1>(0, 2, size)) * b);
+  test_assert(close(sumval(a(Domain<1>(0, 2, size)) * b), ref.sum));
+  reference<T> ref_strided(a(Domain<1>(1, 2, size)));
+  test_assert(close(sumval(a(Domain<1>(1, 2, size))), ref_strided.sum));
+
+  Statistics<T, 1> s = stats(a(Domain<1>(0, 2, size)) * b);
+  test_assert(close(s.sum, ref.sum));
+  test_assert(close(s.sumsq, ref.sumsq));
+  test_assert(equal(s.min, scalar_type(ref.min)));
+  test_assert(equal(s.max, scalar_type(ref.max)));
+  test_assert(s.min_idx[0] == ref.min_idx);
+  test_assert(s.max_idx[0] == ref.max_idx);
+}
+
+// The result doesn't depend on whether (or how many) threads are used.
+template <typename T>
+void test_deterministic(length_type size)
+{
+  Vector<T> view(size);
+  Rand<T> rand(size);
+  view = rand.randu(size) + T(100);
+  length_type const threshold = thread_pool::threshold();
+  thread_pool::set_threshold(size + 1);
+  T serial = sumval(view);
+  T serial_expr = sumval(view * view);
+  thread_pool::set_threshold(1);
+  T threaded = sumval(view);
+  T threaded_expr = sumval(view * view);
+  thread_pool::set_threshold(threshold);
+  test_assert(serial == threaded);
+  test_assert(serial_expr == threaded_expr);
+}
+
+// Non-elementwise operands (here an FFT) are evaluated lazily on
+// their first element access, which must not happen concurrently.
+template <typename T>
+void test_nonelementwise(length_type size)
+{
+  typedef complex<T> C;
+  typedef Fft<const_Vector, C, C, fft_fwd, by_value, 1> fft_type;
+  fft_type fft(Domain<1>(size), T(1));
+  Vector<C> x(size);
+  Rand<C> rand(size);
+  x = rand.randu(size);
+  Vector<C> y = fft(x);
+  // The terms cancel, so compare relative to their magnitudes.
+  long double tolerance = is_same<T, float>::value ? 1e-6 : 1e-10;
+  long double scale = 1 + sumval(mag(y));
+  reference<C> ref(y);
+  for (index_type i = 0; i != 10; ++i)
+  {
+    complex<long double> error = complex<long double>(sumval(fft(x))) - ref.sum;
+    test_assert(std::abs(error) <= tolerance * scale);
+    error = complex<long double>(sumval(T(2) * fft(x))) - 2.L * ref.sum;
+    test_assert(std::abs(error) <= 2 * tolerance * scale);
+  }
+}
+
+template <typename T, typename O>
+void test_matrix(length_type rows, length_type cols)
+{
+  Matrix<T, Dense<2, T, O> > view(rows, cols, T(0));
+  view.put(rows - 1, cols / 2, T(4));
+  view.put(rows / 2, cols - 1, T(-3));
+  Statistics<T, 2> s = stats(view);
+  test_assert(equal(s.sum, T(1)));
+  test_assert(equal(s.sumsq, T(25)));
+  test_assert(s.max_idx == Index<2>(rows - 1, cols / 2));
+  test_assert(s.min_idx == Index<2>(rows / 2, cols - 1));
+
+  Index<2> idx;
+  test_assert(equal(maxval(view, idx), T(4)));
+  test_assert(idx == Index<2>(rows - 1, cols / 2));
+  test_assert(equal(sumval(view), T(1)));
+
+  // A non-dense subview.
+  Domain<2> sub(Domain<1>(0, 2, rows / 2), Domain<1>(cols));
+  test_assert(equal(maxval(view(sub), idx), T(0)));
+  test_assert(equal(minval(view(sub), idx), T(-3)) == (rows / 2 % 2 == 0));
+
+  // An expression, read in tiles of the view's dimension order.
+  test_assert(equal(maxval(T(2) * view, idx), T(8)));
+  test_assert(idx == Index<2>(rows - 1, cols / 2));
+  test_assert(equal(minval(T(2) * view, idx), T(-6)));
+  test_assert(idx == Index<2>(rows / 2, cols - 1));
+}
+
+template <typename T>
+void cases()
+{
+  length_type const sizes[] = {1, 7, 1023, 1024, 1025, 100003};
+  for (index_type i = 0; i != 6; ++i)
+  {
+    test_vector<T, array>(sizes[i]);
+    test_vector<complex<T>, array>(sizes[i]);
+    test_vector<complex<T>, split_complex>(sizes[i]);
+    test_sumsq<T>(sizes[i]);
+    test_complex_sumsq<T>(sizes[i]);
+    test_extrema<T>(sizes[i] + 8);
+    test_tiled<T>(sizes[i]);
+    test_tiled<complex<T> >(sizes[i]);
+  }
+  test_deterministic<T>(100003);
+  test_deterministic<complex<T> >(100003);
+  test_nonelementwise<T>(1 << 18);
+  test_matrix<T, row2_type>(40, 64);
+  test_matrix<T, col2_type>(40, 64);
+}
+
+int
+main(int argc, char **argv)
+{
+  setenv("OVXX_NUM_THREADS", "4", 1);
+  vsipl init(argc, argv);
+
+  // Exercise the threaded code path.
+  thread_pool::set_threshold(1);
+
+  cases<float>();
+  cases<double>();
+}
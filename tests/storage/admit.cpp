@@ -0,0 +1,171 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.BSD file.
+
+/// Description
+///   Tests for admit and release of user-storage blocks whose storage
+///   format differs from the user's, for whole blocks as well as
+///   sub-domains.
+
+#include <vsip/initfin.hpp>
+#include <vsip/support.hpp>
+#include <vsip/dense.hpp>
+#include <ovxx/strided.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <test.hpp>
+#include <vector>
+
+using namespace ovxx;
+
+template <typename C>
+C value(index_type i, int k)
+{
+  typedef typename C::value_type T;
+  return C(T(i + k), -T(i) * k);
+}
+
+// User-storage buffers of either format.
+template <typename T>
+struct buffer
+{
+  buffer(length_type size, user_storage_type f)
+    : format(f), re(size), im(size), ri(2 * size) {}
+
+  complex<T> get(index_type i) const
+  {
+    if (format == split_format) return complex<T>(re[i], im[i]);
+    else return complex<T>(ri[2 * i], ri[2 * i + 1]);
+  }
+  void put(index_type i, complex<T> v)
+  {
+    if (format == split_format) { re[i] = v.real(); im[i] = v.imag();}
+    else { ri[2 * i] = v.real(); ri[2 * i + 1] = v.imag();}
+  }
+
+  user_storage_type format;
+  std::vector<T> re, im, ri;
+};
+
+template <typename B, typename T>
+B *make_block(Domain<B::dim> const &dom, buffer<T> &b)
+{
+  if (b.format == split_format)
+    return new B(dom, &b.re[0], &b.im[0]);
+  else
+    return new B(dom, &b.ri[0]);
+}
+
+template <typename T, storage_format_type F>
+void
+test_vector(length_type size, user_storage_type format)
+{
+  typedef complex<T> C;
+  typedef Strided<1, C, Layout<1, row1_type, dense, F> > block_type;
+  buffer<T> data(size, format);
+  for (index_type i = 0; i != size; ++i) data.put(i, value<C>(i, 1));
+
+  block_type *block = make_block<block_type>(Domain<1>(size), data);
+  block->admit(true);
+  for (index_type i = 0; i != size; ++i)
+    test_assert(block->get(i) == value<C>(i, 1));
+  for (index_type i = 0; i != size; ++i) block->put(i, value<C>(i, 2));
+  block->release(true);
+  for (index_type i = 0; i != size; ++i)
+    test_assert(data.get(i) == value<C>(i, 2));
+
+  // If the formats match, the block operates on user storage directly,
+  // so elements outside the windows below are shared, too.
+  bool const shared = (F == split_complex) == (format == split_format);
+
+  // Modify a window of the user data, and admit only that.
+  Domain<1> window(size / 3, 1, size / 2);
+  for (index_type i = 0; i != size; ++i) data.put(i, value<C>(i, 3));
+  block->admit(window);
+  test_assert(block->admitted());
+  for (index_type i = 0; i != size; ++i)
+    if (i >= window.first() && i < window.first() + window.size())
+      test_assert(block->get(i) == value<C>(i, 3));
+    else
+      test_assert(block->get(i) == value<C>(i, shared ? 3 : 2));
+
+  // Release a strided window.
+  Domain<1> strided(1, 3, size / 3);
+  for (index_type i = 0; i != size; ++i) block->put(i, value<C>(i, 4));
+  block->release(strided);
+  test_assert(!block->admitted());
+  for (index_type i = 0; i != size; ++i)
+    if (i % 3 == 1 && i / 3 < size / 3)
+      test_assert(data.get(i) == value<C>(i, 4));
+    else
+      test_assert(data.get(i) == value<C>(i, shared ? 4 : 3));
+  block->decrement_count();
+}
+
+// The storage offset of element (i, j) in a dense matrix.
+template <typename O>
+index_type offset(index_type i, index_type j, length_type rows, length_type cols)
+{
+  return is_same<O, row2_type>::value ? i * cols + j : j * rows + i;
+}
+
+template <typename T, typename O, storage_format_type F>
+void
+test_matrix(length_type rows, length_type cols, user_storage_type format)
+{
+  typedef complex<T> C;
+  typedef Strided<2, C, Layout<2, O, dense, F> > block_type;
+  buffer<T> data(rows * cols, format);
+  block_type *block = make_block<block_type>(Domain<2>(rows, cols), data);
+  Matrix<C, block_type> view(*block);
+  block->decrement_count();
+
+  block->admit(false);
+  for (index_type i = 0; i != rows; ++i)
+    for (index_type j = 0; j != cols; ++j)
+      view.put(i, j, value<C>(offset<O>(i, j, rows, cols), 1));
+  block->release(true);
+
+  // Change everything, but only admit a window.
+  for (index_type i = 0; i != rows * cols; ++i) data.put(i, value<C>(i, 2));
+  Domain<2> window(Domain<1>(1, 1, rows / 2), Domain<1>(2, 2, cols / 3));
+  block->admit(window);
+  for (index_type i = 0; i != rows; ++i)
+    for (index_type j = 0; j != cols; ++j)
+    {
+      bool inside = i >= 1 && i < 1 + rows / 2 &&
+	j >= 2 && (j - 2) % 2 == 0 && (j - 2) / 2 < cols / 3;
+      test_assert(view.get(i, j) == value<C>(offset<O>(i, j, rows, cols), inside ? 2 : 1));
+    }
+  block->release(false);
+}
+
+template <typename T>
+void
+cases()
+{
+  length_type const sizes[] = { 1, 7, 33, 1000, 4099};
+  for (index_type i = 0; i != sizeof(sizes) / sizeof(*sizes); ++i)
+  {
+    test_vector<T, split_complex>(sizes[i], interleaved_format);
+    test_vector<T, interleaved_complex>(sizes[i], split_format);
+    test_vector<T, array>(sizes[i], split_format);
+    test_vector<T, split_complex>(sizes[i], split_format);
+  }
+  test_matrix<T, row2_type, split_complex>(7, 35, interleaved_format);
+  test_matrix<T, col2_type, interleaved_complex>(35, 7, split_format);
+}
+
+int
+main(int argc, char **argv)
+{
+  vsipl init(argc, argv);
+
+  // Exercise the threaded conversion.
+  thread_pool::set_threshold(1);
+
+  cases<float>();
+  cases<double>();
+}
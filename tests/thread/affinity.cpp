@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+/// Description
+///   Tests for the configuration of the library's thread pool:
+///   thread count and CPU affinity.
+
+#include <vsip/initfin.hpp>
+#include <vsip/vector.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <test.hpp>
+#include <stdexcept>
+#include <cstring>
+#if HAVE_SCHED_GETAFFINITY
+# include <sched.h>
+#endif
+
+using namespace ovxx;
+
+typedef thread_pool::cpu_set cpu_set;
+
+void test_parse()
+{
+  cpu_set cpus = thread_pool::parse_cpus("0-3,8,10-11\n");
+  unsigned int const expected[] = {0, 1, 2, 3, 8, 10, 11};
+  test_assert(cpus.size() == 7);
+  test_assert(std::equal(cpus.begin(), cpus.end(), expected));
+  // Duplicates are removed, and the result is sorted.
+  cpus = thread_pool::parse_cpus("5,2,2-3");
+  test_assert(cpus.size() == 3 && cpus[0] == 2 && cpus[1] == 3 && cpus[2] == 5);
+  test_assert(thread_pool::parse_cpus("").empty());
+
+#if VSIP_HAS_EXCEPTIONS
+  char const *invalid[] = {"a", "3-1", "1-", "1;2"};
+  for (unsigned int i = 0; i != sizeof(invalid) / sizeof(*invalid); ++i)
+  {
+    bool thrown = false;
+    try { thread_pool::parse_cpus(invalid[i]);}
+    catch (std::invalid_argument const &) { thrown = true;}
+    test_assert(thrown);
+  }
+#endif
+}
+
+// Record the CPUs each chunk could run on.
+struct probe
+{
+  probe(length_type n) : cpus(n) {}
+  void operator()(index_type i)
+  {
+#if HAVE_SCHED_GETAFFINITY
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    sched_getaffinity(0, sizeof(set), &set);
+    cpus[i] = CPU_COUNT(&set);
+#endif
+  }
+  std::vector<int> cpus;
+};
+
+// A pool restricted to the CPU the process is running on
+// still runs all chunks, and only runs them on that CPU.
+void test_pinned(unsigned int threads)
+{
+#if HAVE_SCHED_GETAFFINITY
+  cpu_set_t original;
+  CPU_ZERO(&original);
+  sched_getaffinity(0, sizeof(original), &original);
+  unsigned int cpu = 0;
+  while (!CPU_ISSET(cpu, &original)) ++cpu;
+  {
+    thread_pool pool(threads, cpu_set(1, cpu), true);
+    test_assert(pool.pinned());
+    test_assert(pool.cpus().size() == 1 && pool.cpus()[0] == cpu);
+    probe p(4 * threads);
+    pool.parallel_for(4 * threads, p);
+    for (index_type i = 0; i != 4 * threads; ++i)
+      test_assert(p.cpus[i] == 1);
+  }
+  // Undo the binding of the calling thread.
+  sched_setaffinity(0, sizeof(original), &original);
+#endif
+}
+
+int
+main(int argc, char **argv)
+{
+  char arg1[] = "--ovxx-num-threads=3", arg2[] = "--ovxx-affinity", arg3[] = "none";
+  char arg4[] = "-v";
+  std::vector<char *> args(argv, argv + argc);
+  args.push_back(arg1);
+  args.push_back(arg2);
+  args.push_back(arg3);
+  args.push_back(arg4);
+  args.push_back(0);
+  int args_count = argc + 4;
+  char **args_values = &args[0];
+  vsipl init(args_count, args_values);
+
+  // The library's options are consumed, others are left alone.
+  test_assert(args_count == argc + 1);
+  test_assert(!std::strcmp(args_values[argc], "-v"));
+#if OVXX_ENABLE_THREADING
+  test_assert(thread_pool::get_default()->size() == 3);
+#endif
+  test_assert(!thread_pool::get_default()->pinned());
+
+  test_parse();
+  test_pinned(1);
+  test_pinned(4);
+
+  // The default pool is used by the threaded evaluators.
+  thread_pool::set_threshold(1);
+  Vector<float> a(1000, 1.f), b(1000, 2.f), c(1000);
+  c = a + b;
+  for (index_type i = 0; i != 1000; ++i)
+    test_assert(c.get(i) == 3.f);
+}
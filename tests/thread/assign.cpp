@@ -0,0 +1,199 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+#include <vsip/initfin.hpp>
+#include <vsip/vector.hpp>
+#include <vsip/matrix.hpp>
+#include <vsip/tensor.hpp>
+#include <vsip/math.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <test.hpp>
+#include <cstdlib>
+#include <stdexcept>
+
+using namespace ovxx;
+
+struct counter
+{
+  counter(length_type n) : hits(n, 0) {}
+  void operator()(index_type i) { ++hits[i];}
+  std::vector<int> hits;
+};
+
+// Every chunk of a parallel loop must be run exactly once.
+void test_pool(unsigned int threads, length_type chunks)
+{
+  thread_pool pool(threads);
+  test_assert(pool.size() == threads);
+  for (int iter = 0; iter != 10; ++iter)
+  {
+    counter c(chunks);
+    pool.parallel_for(chunks, c);
+    for (index_type i = 0; i != chunks; ++i)
+      test_assert(c.hits[i] == 1);
+  }
+}
+
+struct thrower
+{
+  thrower(index_type t) : target(t) {}
+  void operator()(index_type i)
+  { if (i == target) throw std::runtime_error("chunk failed");}
+  index_type target;
+};
+
+// Chunks run on worker threads use the caller's allocator.
+struct allocating
+{
+  allocating(length_type n) : sums(n, 0.f) {}
+  void operator()(index_type i)
+  {
+    Vector<float> v(16, float(i));
+    sums[i] = sumval(v);
+  }
+  std::vector<float> sums;
+};
+
+// An exception thrown by any chunk is rethrown by the caller,
+// and leaves the pool usable.
+void test_pool_exception(unsigned int threads, length_type chunks)
+{
+  thread_pool pool(threads);
+  for (index_type target = 0; target < chunks; target += chunks / 3 + 1)
+  {
+    thrower t(target);
+    bool caught = false;
+    try { pool.parallel_for(chunks, t);}
+    catch (std::runtime_error const &) { caught = true;}
+    test_assert(caught);
+    counter c(chunks);
+    pool.parallel_for(chunks, c);
+    for (index_type i = 0; i != chunks; ++i)
+      test_assert(c.hits[i] == 1);
+  }
+  allocating a(chunks);
+  pool.parallel_for(chunks, a);
+  for (index_type i = 0; i != chunks; ++i)
+    test_assert(equal(a.sums[i], 16.f * i));
+}
+
+template <typename T>
+void test_vector(length_type size)
+{
+  Vector<T> A(size), B(size), C(size), Z(size);
+  for (index_type i = 0; i != size; ++i)
+  {
+    A.put(i, T(i));
+    B.put(i, T(2));
+    C.put(i, T(i % 7));
+  }
+  Z = A * B + C;
+  for (index_type i = 0; i != size; ++i)
+    test_assert(equal(Z.get(i), T(i) * T(2) + T(i % 7)));
+  Z = -A;
+  for (index_type i = 0; i != size; ++i)
+    test_assert(equal(Z.get(i), -T(i)));
+  // strided destination
+  Vector<T> W(2 * size, T(-1));
+  W(Domain<1>(0, 2, size)) = A + B;
+  for (index_type i = 0; i != size; ++i)
+  {
+    test_assert(equal(W.get(2*i), T(i) + T(2)));
+    test_assert(equal(W.get(2*i + 1), T(-1)));
+  }
+}
+
+template <typename T, typename O>
+void test_matrix(length_type rows, length_type cols)
+{
+  typedef Dense<2, T, O> block_type;
+  Matrix<T, block_type> A(rows, cols), B(rows, cols, T(3)), Z(rows, cols);
+  for (index_type r = 0; r != rows; ++r)
+    for (index_type c = 0; c != cols; ++c)
+      A.put(r, c, T(r * cols + c));
+  Z = A * B - A;
+  for (index_type r = 0; r != rows; ++r)
+    for (index_type c = 0; c != cols; ++c)
+      test_assert(equal(Z.get(r, c), T(r * cols + c) * T(2)));
+}
+
+// Chunks of non-dense matrices start in the middle of rows (or columns).
+template <typename T, typename O>
+void test_submatrix(length_type rows, length_type cols)
+{
+  typedef Dense<2, T, O> block_type;
+  Matrix<T, block_type> A(rows, cols), Z(rows + 2, cols + 3, T(-1));
+  for (index_type r = 0; r != rows; ++r)
+    for (index_type c = 0; c != cols; ++c)
+      A.put(r, c, T(r * cols + c));
+  Domain<2> sub(Domain<1>(1, 1, rows), Domain<1>(2, 1, cols));
+  Z(sub) = T(2) * A;
+  for (index_type r = 0; r != rows + 2; ++r)
+    for (index_type c = 0; c != cols + 3; ++c)
+    {
+      bool inside = r >= 1 && r <= rows && c >= 2 && c < cols + 2;
+      T expected = inside ? T(2) * T((r - 1) * cols + c - 2) : T(-1);
+      test_assert(equal(Z.get(r, c), expected));
+    }
+}
+
+template <typename T, typename O>
+void test_tensor(length_type size0, length_type size1, length_type size2)
+{
+  typedef Dense<3, T, O> block_type;
+  Tensor<T, block_type> A(size0, size1, size2), B(size0, size1, size2, T(2));
+  Tensor<T, block_type> Z(size0, size1, size2);
+  for (index_type i = 0; i != size0; ++i)
+    for (index_type j = 0; j != size1; ++j)
+      for (index_type k = 0; k != size2; ++k)
+	A.put(i, j, k, T((i * size1 + j) * size2 + k));
+  Z = A + B;
+  for (index_type i = 0; i != size0; ++i)
+    for (index_type j = 0; j != size1; ++j)
+      for (index_type k = 0; k != size2; ++k)
+	test_assert(equal(Z.get(i, j, k), T((i * size1 + j) * size2 + k) + T(2)));
+  // A non-dense destination.
+  Tensor<T, block_type> W(size0, size1 + 1, size2, T(-1));
+  Domain<3> sub(size0, size1, size2);
+  W(sub) = A - B;
+  for (index_type i = 0; i != size0; ++i)
+    for (index_type j = 0; j != size1 + 1; ++j)
+      for (index_type k = 0; k != size2; ++k)
+	test_assert(equal(W.get(i, j, k), j == size1 ? T(-1) :
+			  T((i * size1 + j) * size2 + k) - T(2)));
+}
+
+int main(int argc, char **argv)
+{
+  setenv("OVXX_NUM_THREADS", "4", 1);
+  vsipl library(argc, argv);
+
+  test_pool(1, 5);
+  test_pool(3, 1);
+  test_pool(4, 100);
+  test_pool_exception(1, 5);
+  test_pool_exception(4, 100);
+
+  test_assert(thread_pool::get_default()->size() == 4);
+  // Make sure even small problems take the threaded path.
+  thread_pool::set_threshold(16);
+
+  test_vector<float>(3);
+  test_vector<float>(1000);
+  test_vector<float>(100003);
+  test_vector<complex<float> >(4097);
+  test_vector<int>(20000);
+  test_matrix<float, row2_type>(67, 33);
+  test_matrix<float, col2_type>(67, 33);
+  test_matrix<complex<double>, row2_type>(5, 200);
+  test_submatrix<float, row2_type>(67, 33);
+  test_submatrix<float, col2_type>(67, 33);
+  test_submatrix<complex<float>, row2_type>(3, 100);
+  test_tensor<float, tuple<0, 1, 2> >(9, 8, 7);
+  test_tensor<float, tuple<2, 0, 1> >(9, 8, 7);
+  test_tensor<float, tuple<1, 2, 0> >(2, 3, 50);
+}
@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2014 Stefan Seefeld
+// All rights reserved.
+//
+// This file is part of OpenVSIP. It is made available under the
+// license contained in the accompanying LICENSE.GPL file.
+
+#include <vsip/initfin.hpp>
+#include <vsip/support.hpp>
+#include <vsip/matrix.hpp>
+#include <ovxx/thread_pool.hpp>
+#include <test.hpp>
+#include <vector>
+
+using namespace ovxx;
+
+template <typename T>
+T value(index_type r, index_type c) { return T(r * 1000 + c);}
+
+template <typename T, typename O1, typename O2, storage_format_type F>
+void test_transpose(length_type rows, length_type cols)
+{
+  typedef Layout<2, O1, dense, F> lhs_layout;
+  typedef Layout<2, O2, dense, F> rhs_layout;
+  Matrix<T, Strided<2, T, lhs_layout> > dst(rows, cols, T(-1));
+  Matrix<T, Strided<2, T, rhs_layout> > src(rows, cols);
+  for (index_type r = 0; r != rows; ++r)
+    for (index_type c = 0; c != cols; ++c)
+      src.put(r, c, value<T>(r, c));
+  dst = src;
+  for (index_type r = 0; r != rows; ++r)
+    for (index_type c = 0; c != cols; ++c)
+      test_assert(dst.get(r, c) == value<T>(r, c));
+
+  // Subviews have non-unit strides in the major dimension.
+  Domain<2> sub(Domain<1>(1, 1, rows - 2), Domain<1>(2, 1, cols - 3));
+  dst = T(-1);
+  dst(sub) = src(sub);
+  for (index_type r = 0; r != rows; ++r)
+    for (index_type c = 0; c != cols; ++c)
+    {
+      bool inside = r >= 1 && r < rows - 1 && c >= 2 && c < cols - 1;
+      test_assert(dst.get(r, c) == (inside ? value<T>(r, c) : T(-1)));
+    }
+}
+
+// Transpose a non-square matrix in place, by assigning between two
+// blocks of different dimension-ordering sharing the same storage.
+template <typename T, typename O1, typename O2>
+void test_in_place(length_type rows, length_type cols)
+{
+  typedef Dense<2, T, O1> lhs_block_type;
+  typedef Dense<2, T, O2> rhs_block_type;
+  std::vector<T> storage(rows * cols);
+  lhs_block_type *lhs_block =
+    new lhs_block_type(Domain<2>(rows, cols), &storage[0]);
+  rhs_block_type *rhs_block =
+    new rhs_block_type(Domain<2>(rows, cols), &storage[0]);
+  Matrix<T, lhs_block_type> dst(*lhs_block);
+  Matrix<T, rhs_block_type> src(*rhs_block);
+  // The views own the blocks from here on.
+  lhs_block->decrement_count();
+  rhs_block->decrement_count();
+
+  src.block().admit(false);
+  for (index_type r = 0; r != rows; ++r)
+    for (index_type c = 0; c != cols; ++c)
+      src.put(r, c, value<T>(r, c));
+  src.block().release(true);
+  src.block().admit(true);
+  dst.block().admit(false);
+  dst = src;
+  for (index_type r = 0; r != rows; ++r)
+    for (index_type c = 0; c != cols; ++c)
+      test_assert(dst.get(r, c) == value<T>(r, c));
+}
+
+template <typename T>
+void square_in_place(length_type size)
+{
+  Matrix<T> a(size, size);
+  for (index_type r = 0; r != size; ++r)
+    for (index_type c = 0; c != size; ++c)
+      a.put(r, c, value<T>(r, c));
+  a = a.transpose();
+  for (index_type r = 0; r != size; ++r)
+    for (index_type c = 0; c != size; ++c)
+      test_assert(a.get(r, c) == value<T>(c, r));
+}
+
+template <typename T, storage_format_type F>
+void cases()
+{
+  length_type const sizes[][2] = {{5, 7}, {16, 16}, {64, 33}, {130, 67}, {200, 300}};
+  for (index_type i = 0; i != 5; ++i)
+  {
+    test_transpose<T, row2_type, col2_type, F>(sizes[i][0], sizes[i][1]);
+    test_transpose<T, col2_type, row2_type, F>(sizes[i][0], sizes[i][1]);
+  }
+}
+
+template <typename T>
+void cases()
+{
+  cases<T, array>();
+  length_type const sizes[][2] = {{1, 7}, {5, 7}, {16, 16}, {64, 33}, {130, 67}};
+  for (index_type i = 0; i != 5; ++i)
+  {
+    test_in_place<T, row2_type, col2_type>(sizes[i][0], sizes[i][1]);
+    test_in_place<T, col2_type, row2_type>(sizes[i][0], sizes[i][1]);
+  }
+  square_in_place<T>(7);
+  square_in_place<T>(64);
+  square_in_place<T>(131);
+}
+
+int main(int argc, char **argv)
+{
+  vsipl init(argc, argv);
+
+  // Exercise the threaded code path.
+  thread_pool::set_threshold(1);
+
+  cases<float>();
+  cases<double>();
+  cases<int>();
+  cases<complex<float> >();
+  cases<complex<double> >();
+  cases<complex<float>, interleaved_complex>();
+  cases<complex<double>, interleaved_complex>();
+  cases<complex<float>, split_complex>();
+  cases<complex<double>, split_complex>();
+}